@@ -50,6 +50,24 @@ void BlockMatrix::ConstructSystem() {
     delete [] nnz;
 }
 
+/**
+ * Construct the matrix, preallocating exactly the given
+ * number of non-zero elements in each row (instead of the
+ * number given for each sub-equation).
+ *
+ * nnz: Number of non-zero elements in each row of the matrix.
+ */
+void BlockMatrix::ConstructSystem(const vector<PetscInt>& nnz) {
+    const PetscInt mSize = this->next_subindex;
+    if ((PetscInt)nnz.size() != mSize)
+        throw BlockMatrixException(
+            "Number of rows in non-zero pattern (" LEN_T_PRINTF_FMT ") does not "
+            "match the size of the matrix (%d).", nnz.size(), mSize
+        );
+
+    this->Construct(mSize, mSize, 0, nnz.data());
+}
+
 /**
  * Defines a new "sub-equation" to include in the matrix. The
  * sub-equation appears by getting its own (square) matrix block
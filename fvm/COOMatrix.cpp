@@ -0,0 +1,134 @@
+/**
+ * Implementation of the 'COOMatrix' class, which buffers matrix
+ * elements in coordinate (COO) format so that they can be added
+ * to a PETSc matrix at a later time.
+ *
+ * Since elements are buffered, only ADD_VALUES is supported as
+ * insert mode (the result of INSERT_VALUES would depend on the
+ * order in which buffers are added to the target matrix).
+ */
+
+#include <petscmat.h>
+#include "FVM/COOMatrix.hpp"
+
+
+using namespace DREAM::FVM;
+using namespace std;
+
+
+/**
+ * Constructor.
+ *
+ * m: Number of rows in matrix which the buffer will be added to.
+ * n: Number of columns in matrix which the buffer will be added to.
+ */
+COOMatrix::COOMatrix(const PetscInt m, const PetscInt n) {
+    this->m = m;
+    this->n = n;
+}
+
+/**
+ * Destructor.
+ */
+COOMatrix::~COOMatrix() { }
+
+/**
+ * Add all elements in this buffer to the given matrix. Consecutive
+ * elements belonging to the same row are inserted with a single call
+ * to 'MatSetValues()'. The offsets of the target matrix are ignored
+ * (the offsets of this buffer were applied when the elements were
+ * set). The buffer is cleared afterwards.
+ *
+ * mat: Matrix to add elements to.
+ */
+void COOMatrix::AddTo(Matrix *mat) {
+    const len_t N = this->vals.size();
+    len_t start = 0;
+    while (start < N) {
+        len_t end = start+1;
+        while (end < N && this->rows[end] == this->rows[start])
+            end++;
+
+        PetscErrorCode ierr = MatSetValues(
+            mat->mat(), 1, &this->rows[start], end-start,
+            &this->cols[start], &this->vals[start], ADD_VALUES
+        );
+        if (ierr)
+            throw MatrixException(
+                "COOMatrix: Failed to add elements of row %d to matrix. Error code: %d",
+                this->rows[start], ierr
+            );
+
+        start = end;
+    }
+
+    this->Clear();
+}
+
+/**
+ * Remove all elements from this buffer (without releasing the
+ * memory, so that it can be reused for the next matrix), and
+ * reset the count of touched elements.
+ */
+void COOMatrix::Clear() {
+    this->nTouched = 0;
+    this->rows.clear();
+    this->cols.clear();
+    this->vals.clear();
+}
+
+/**
+ * Add an element to the buffer. As in 'Matrix::SetElement()', zero
+ * elements are not stored, so that the buffered and unbuffered paths
+ * insert exactly the same elements into the target matrix. The element
+ * is however still counted as touched (see 'NumberOfTouched()').
+ *
+ * irow: Row index (relative to current row offset).
+ * icol: Column index (relative to current column offset).
+ * v:    Value to add.
+ * im:   Insert mode (must be ADD_VALUES).
+ */
+void COOMatrix::SetElement(
+    const PetscInt irow, const PetscInt icol,
+    const PetscScalar v, InsertMode im
+) {
+    if (im != ADD_VALUES)
+        throw MatrixException("COOMatrix: Only the insert mode 'ADD_VALUES' is supported.");
+
+    this->nTouched++;
+    if (v == 0)
+        return;
+
+    this->rows.push_back(this->rowOffset+irow);
+    this->cols.push_back(this->colOffset+icol);
+    this->vals.push_back(v);
+}
+
+/**
+ * Add the values of (part of) one row to the buffer. As in
+ * 'Matrix::SetRow()' (which calls 'MatSetValues()'), explicit
+ * zeros are kept.
+ */
+void COOMatrix::SetRow(
+    PetscInt irow, const PetscInt ncol,
+    PetscInt *icol, const PetscScalar *v,
+    InsertMode im
+) {
+    if (im != ADD_VALUES)
+        throw MatrixException("COOMatrix: Only the insert mode 'ADD_VALUES' is supported.");
+
+    this->nTouched += ncol;
+    for (PetscInt i = 0; i < ncol; i++) {
+        this->rows.push_back(this->rowOffset+irow);
+        this->cols.push_back(this->colOffset+icol[i]);
+        this->vals.push_back(v[i]);
+    }
+}
+
+/**
+ * Setting diagonal elements overwrites existing values and
+ * can therefore not be buffered.
+ */
+void COOMatrix::SetDiagonalConstant(const PetscInt, const PetscInt[], const PetscReal) {
+    throw MatrixException("COOMatrix: Diagonal elements cannot be overwritten in a buffered matrix.");
+}
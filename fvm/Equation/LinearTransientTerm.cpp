@@ -2,6 +2,9 @@
  * Implementation of an Euler backward transient term multiplied
  * by an arbitrary grid-dependent weight function. 
  * Evaluation of weights must be implemented in derived classes. 
+ * If second-order time integration is enabled in the
+ * UnknownQuantityHandler, the variable-step BDF2 formula is used
+ * instead.
  */
 
 #include <iostream>
@@ -29,6 +32,11 @@ void LinearTransientTerm::Rebuild(const real_t, const real_t dt, UnknownQuantity
     this->dt = dt;
     this->xn = uqty->GetUnknownDataPrevious(this->unknownId);
 
+    if (uqty->GetTransientCoefficients(this->unknownId, dt, this->coeff) >= 2)
+        this->xnm1 = uqty->GetUnknownDataOld(this->unknownId, 1);
+    else
+        this->xnm1 = nullptr;
+
     if(!hasBeenInitialized){
         InitializeWeights();
         hasBeenInitialized = true;
@@ -62,11 +70,16 @@ void LinearTransientTerm::SetMatrixElements(Matrix *mat, real_t *rhs) {
 
     const len_t N = grid->GetNCells();
     for (len_t i = 0; i < N; i++)
-        mat->SetElement(i, i, weights[i]/this->dt, ADD_VALUES);
+        mat->SetElement(i, i, coeff[0]*weights[i]/this->dt, ADD_VALUES);
 
-    if (rhs != nullptr)
+    if (rhs != nullptr) {
         for (len_t i = 0; i < N; i++)
-            rhs[i] -= weights[i]*this->xn[i] / this->dt;
+            rhs[i] += coeff[1]*weights[i]*this->xn[i] / this->dt;
+
+        if (this->xnm1 != nullptr)
+            for (len_t i = 0; i < N; i++)
+                rhs[i] += coeff[2]*weights[i]*this->xnm1[i] / this->dt;
+    }
 }
 
 /**
@@ -86,6 +99,10 @@ void LinearTransientTerm::SetVectorElements(real_t *vec, const real_t *xnp1) {
     const len_t N = grid->GetNCells();
 
     for (len_t i = 0; i < N; i++)
-        vec[i] += weights[i]*(xnp1[i] - xn[i]) / this->dt;
+        vec[i] += weights[i]*(coeff[0]*xnp1[i] + coeff[1]*xn[i]) / this->dt;
+
+    if (this->xnm1 != nullptr)
+        for (len_t i = 0; i < N; i++)
+            vec[i] += coeff[2]*weights[i]*this->xnm1[i] / this->dt;
 }
 
@@ -241,6 +241,44 @@ len_t Operator::GetNumberOfNonZerosPerRow_jac() const {
     return nnz;
 }
 
+/**
+ * Returns the number of non-zero elements inserted by this
+ * operator object into the block of a jacobian matrix which
+ * corresponds to differentiation with respect to 'derivId'.
+ *
+ * operandId: ID of the unknown quantity the operator is applied to.
+ * derivId:   ID of the unknown quantity to differentiate with respect to.
+ */
+len_t Operator::GetNumberOfNonZerosPerRow_jac(const len_t operandId, const len_t derivId) const {
+    // The block of the operand contains the linear part of
+    // the operator (which we do not try to separate from the
+    // non-linear contributions)
+    if (derivId == operandId)
+        return GetNumberOfNonZerosPerRow_jac();
+
+    len_t nnz = 0, nMultiples;
+    for (auto it = terms.begin(); it != terms.end(); it++)
+        if ((*it)->HasJacobianContribution(derivId, &nMultiples))
+            nnz += nMultiples;
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+        if ((*it)->HasJacobianContribution(derivId, &nMultiples))
+            nnz += nMultiples;
+
+    // The advection-diffusion term counts every unknown once
+    if (this->adterm != nullptr) {
+        len_t nAD = 0;
+        for (AdvectionTerm *a : adterm->GetAdvectionTerms())
+            if (a->HasJacobianContribution(derivId, &nMultiples))
+                nAD = max(nAD, nMultiples);
+        for (DiffusionTerm *d : adterm->GetDiffusionTerms())
+            if (d->HasJacobianContribution(derivId, &nMultiples))
+                nAD = max(nAD, nMultiples);
+        nnz += nAD;
+    }
+
+    return nnz;
+}
+
 /**
  * Make the given equation term identifiable.
  *
@@ -267,21 +305,175 @@ void Operator::RebuildTerms(const real_t t, const real_t dt, UnknownQuantityHand
         return;
     }
 
+    // Index of term (for timing)
+    len_t k = 0;
+
     // Evaluatable equation terms
-    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++, k++) {
+        StartRebuildTimer(k);
         (*it)->Rebuild(t, dt, uqty);
+        StopRebuildTimer(k);
+    }
 
     // Other equation terms
-    for (auto it = terms.begin(); it != terms.end(); it++)
+    for (auto it = terms.begin(); it != terms.end(); it++, k++) {
+        StartRebuildTimer(k);
         (*it)->Rebuild(t, dt, uqty);
+        StopRebuildTimer(k);
+    }
 
     // Advection-diffusion term
-    if (adterm != nullptr)
+    if (adterm != nullptr) {
+        StartRebuildTimer(k);
         adterm->Rebuild(t, dt, uqty);
+        StopRebuildTimer(k);
+        k++;
+    }
 
     // Boundary conditions
-    for (auto it = boundaryConditions.begin(); it != boundaryConditions.end(); it++)
+    for (auto it = boundaryConditions.begin(); it != boundaryConditions.end(); it++, k++) {
+        StartRebuildTimer(k);
         (*it)->Rebuild(t, uqty);
+        StopRebuildTimer(k);
+    }
+}
+
+/**
+ * Append to 'deps' the list of objects which hold data modified
+ * when rebuilding this operator. This includes all terms of the
+ * operator themselves, as well as any objects which the terms have
+ * declared (via 'EquationTerm::AddRebuildDependency()') that they
+ * share with other terms. Two operators which have any dependency
+ * in common may not be rebuilt concurrently.
+ *
+ * deps: List to append dependencies to.
+ */
+void Operator::GetRebuildDependencies(vector<const void*>& deps) const {
+    if (predetermined != nullptr) {
+        deps.push_back(predetermined);
+        return;
+    }
+
+    auto addTerm = [&deps](const EquationTerm *term) {
+        deps.push_back(term);
+        const vector<const void*>& d = term->GetRebuildDependencies();
+        deps.insert(deps.end(), d.begin(), d.end());
+    };
+
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+        addTerm(*it);
+    for (auto it = terms.begin(); it != terms.end(); it++)
+        addTerm(*it);
+
+    if (adterm != nullptr) {
+        deps.push_back(static_cast<const AdvectionTerm*>(adterm));
+        for (AdvectionTerm *a : adterm->GetAdvectionTerms())
+            addTerm(a);
+        for (DiffusionTerm *d : adterm->GetDiffusionTerms())
+            addTerm(d);
+    }
+
+    for (auto it = boundaryConditions.begin(); it != boundaryConditions.end(); it++)
+        deps.push_back(*it);
+}
+
+/**
+ * Returns true if all terms of this operator have declared
+ * (via 'EquationTerm::SetRebuildThreadSafe()') that they may be
+ * rebuilt and differentiated concurrently with other terms.
+ * Operators with a predetermined parameter or boundary conditions
+ * are never considered thread-safe.
+ */
+bool Operator::IsRebuildThreadSafe() const {
+    if (predetermined != nullptr || boundaryConditions.size() > 0)
+        return false;
+
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+        if (!(*it)->IsRebuildThreadSafe())
+            return false;
+    for (auto it = terms.begin(); it != terms.end(); it++)
+        if (!(*it)->IsRebuildThreadSafe())
+            return false;
+
+    if (adterm != nullptr) {
+        for (AdvectionTerm *a : adterm->GetAdvectionTerms())
+            if (!a->IsRebuildThreadSafe())
+                return false;
+        for (DiffusionTerm *d : adterm->GetDiffusionTerms())
+            if (!d->IsRebuildThreadSafe())
+                return false;
+    }
+
+    return true;
+}
+
+/**
+ * Returns true if the jacobian block obtained by differentiating
+ * this operator with respect to 'derivId' is structurally non-zero,
+ * i.e. if 'derivId' is the unknown 'operandId' to which the operator
+ * is applied (in which case the linear part of the terms contributes),
+ * or if any term has declared a jacobian contribution with respect to
+ * 'derivId' (via 'EquationTerm::AddUnknownForJacobian()'). Unlike the
+ * values set by 'SetJacobianBlock()', this does not depend on the
+ * current values of the unknowns.
+ *
+ * operandId: ID of the unknown quantity the operator is applied to.
+ * derivId:   ID of the unknown quantity to differentiate with respect to.
+ */
+bool Operator::HasJacobianContribution(const len_t operandId, const len_t derivId) const {
+    if (derivId == operandId)
+        return (predetermined == nullptr);
+
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+        if ((*it)->HasJacobianContribution(derivId))
+            return true;
+    for (auto it = terms.begin(); it != terms.end(); it++)
+        if ((*it)->HasJacobianContribution(derivId))
+            return true;
+
+    if (adterm != nullptr) {
+        for (AdvectionTerm *a : adterm->GetAdvectionTerms())
+            if (a->HasJacobianContribution(derivId))
+                return true;
+        for (DiffusionTerm *d : adterm->GetDiffusionTerms())
+            if (d->HasJacobianContribution(derivId))
+                return true;
+    }
+
+    return false;
+}
+
+/**
+ * Assign a TimeKeeper to use for timing the rebuild of each term
+ * in this operator. One timer is added to the TimeKeeper for each
+ * term (with the advection-diffusion term counted as one).
+ *
+ * tk:        TimeKeeper to add timers to.
+ * shortname: Prefix of short names of timers to add.
+ * longname:  Prefix of long names of timers to add.
+ */
+void Operator::SetRebuildTimeKeeper(
+    TimeKeeper *tk, const string& shortname, const string& longname
+) {
+    this->rebuildTimeKeeper = tk;
+    this->rebuildTimers.clear();
+
+    if (tk == nullptr)
+        return;
+
+    auto addTimer = [this,tk,&shortname,&longname](const string& termname) {
+        const string sn = shortname + "_" + to_string(this->rebuildTimers.size());
+        this->rebuildTimers.push_back(tk->AddTimer(sn, longname + ": " + termname));
+    };
+
+    for (auto it = eval_terms.begin(); it != eval_terms.end(); it++)
+        addTimer((*it)->GetName());
+    for (auto it = terms.begin(); it != terms.end(); it++)
+        addTimer((*it)->GetName());
+    if (adterm != nullptr)
+        addTimer("Advection-diffusion");
+    for (auto it = boundaryConditions.begin(); it != boundaryConditions.end(); it++)
+        addTimer((*it)->GetName());
 }
 
 /**
@@ -144,6 +144,21 @@ bool AnalyticBRadialGridGenerator::Rebuild(const real_t, RadialGrid *rGrid) {
         BtorGOverR0, BtorGOverR0_f, psiPrimeRef, psiPrimeRef_f, R0
     );
 
+    // Tabulate the inverse flux-surface mapping in the box
+    // enclosing the plasma (with some margin)
+    const real_t a = r_f[GetNr()];
+    real_t Xmin = 0, Xmax = 0, Ymin = 0, Ymax = 0;
+    for (len_t j = 0; j < INVERSE_MAPPING_NPOINTS; j++) {
+        real_t theta = 2*M_PI*j/INVERSE_MAPPING_NPOINTS;
+        real_t X = Delta_f[GetNr()] + a*cos(theta + delta_f[GetNr()]*sin(theta));
+        real_t Y = a*kappa_f[GetNr()]*sin(theta);
+
+        Xmin = std::min(Xmin, X); Xmax = std::max(Xmax, X);
+        Ymin = std::min(Ymin, Y); Ymax = std::max(Ymax, Y);
+    }
+    const real_t margin = 0.05*std::max(Xmax-Xmin, Ymax-Ymin);
+    BuildInverseMapping(Xmin-margin, Xmax+margin, Ymin-margin, Ymax+margin, a);
+
     this->isBuilt = true;
     return true;
 }
@@ -497,7 +512,9 @@ real_t AnalyticBRadialGridGenerator::InterpolateInputShafranovShiftDeriv(real_t
  * The coordinate transformation is solved numerically using a bisection scheme until
  * a precision of lengthScale*CartesianCoordinatesTol is achieved. The initial search 
  * intervall is r = startingGuess +/- lengthScale, translated by a multiple of 2*lengthScale
- * until the search interval contains a sign change
+ * until the search interval contains a sign change. Inside the plasma, the bisection
+ * is normally avoided by taking the starting guess from the inverse mapping table
+ * built in Rebuild(), and refining it using Newton's method.
  *
  * See doc/notes/SPICoordinates.pdf for more information
  */
@@ -549,7 +566,29 @@ void AnalyticBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t* r, real_t*
     else if(RMinusR0>RMinusR0_crit && y<0)
         quadrant=4;
 	
-	// Bisection to find radial coordinate corresponding
+	// Use the inverse mapping table (if available) to get an
+	// accurate starting guess, and polish it with a few Newton
+	// iterations...
+	if (InverseMappingGuess(RMinusR0, y, r_tmp) &&
+	    FindMinorRadiusNewton(RMinusR0, y, quadrant, rmin, lengthScale, r_tmp)) {
+	    delta = InterpolateInputTriangularity(r_tmp);
+	    Delta = InterpolateInputShafranovShift(r_tmp);
+	    kappa = InterpolateInputElongation(r_tmp);
+	    real_t st = y/(r_tmp*kappa);
+
+	    *r=r_tmp;
+	    if(quadrant==1)
+	        *theta=asin(st);
+	    else if(quadrant==4)
+	        *theta=2*M_PI+asin(st);
+	    else if(RMinusR0<Delta-r_tmp*sin(delta))
+	        *theta=M_PI-asin(st);
+
+	    *phi = atan2(z,(R0+x));
+	    return;
+	}
+	
+	// ...otherwise, use bisection to find radial coordinate corresponding
 	// to 'r' at 'Z=y'...
 	// We make a guess for a valid search intervall of startingGuessR+/-lengthScale, 
 	// and check if it has to be moved before actually starting with the bisection
@@ -651,41 +690,6 @@ void AnalyticBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t* r, real_t*
         }
 	}while(std::abs(rb-ra) > lengthScale*CartesianCoordinateTol);
 	
-	// Newton solver (disabled for now)
-	/*r_tmp=startingGuessR;
-	
-	real_t Delta_p;
-	real_t delta_p;
-	real_t st;
-	real_t st_p;
-	real_t ct;
-	real_t ct_p;
-	real_t RMinusR0_newton;
-	real_t ddrRMinusR0_newton;
-	do {
-	    kappa   = InterpolateInputElongation(r_tmp);
-	    kappa_p = InterpolateInputElongationDeriv(r_tmp);
-	    delta   = InterpolateInputTriangularity(r_tmp);
-	    delta_p = InterpolateInputTriangularityDeriv(r_tmp);
-	    Delta   = InterpolateInputShafranovShift(r_tmp);
-	    Delta_p = InterpolateInputShafranovShiftDeriv(r_tmp);
-	    
-	    st = y/(r_tmp*kappa);
-	    st_p = -y/(r_tmp*r_tmp*kappa*kappa)*(kappa+r*kappa_p);
-	    
-	    if(quadrant==1 || quadrant==4)
-	        ct = sqrt(1-st*st);
-	    else
-	        ct = -sqrt(1-st*st);
-	    ct_p = -st/ct*st_p;
-	    
-        RMinusR0_newton = Delta + r_tmp*(ct*cos(delta*st)-st*sin(delta*st));
-        ddrRMinusR0_newton = Delta_p + ct*cos(delta*st)-st*sin(delta*st)+
-                             r_tmp*(ct_p*cos(delta*st) - st_p*sin(delta*st)-
-                             (ct*sin(delta*st)+st*cos(delta*st))*(delta_p*st+delta*st_p));
-        r_tmp = r_tmp - (RMinusR0_newton - RMinusR0)/ddrRMinusR0_newton;
-	} while(std::abs(RMinusR0_newton-RMinusR0) > lengthScale * CartesianCoordinateTol);*/
-	
 	// Set the output values for the flux surface coordinates
 	*r=r_tmp;
 	
@@ -701,6 +705,68 @@ void AnalyticBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t* r, real_t*
     
 }
 
+/**
+ * Solve for the minor radius coordinate 'r' of the flux surface
+ * passing through the point (R-R0, Z) = (RMinusR0, y) in the given
+ * quadrant, using Newton's method. On entry, 'r' should contain a
+ * starting guess close to the solution.
+ *
+ * Returns false if the iteration did not converge to a radius
+ * inside the plasma, in which case the caller should fall back
+ * on bisection.
+ */
+bool AnalyticBRadialGridGenerator::FindMinorRadiusNewton(
+    const real_t RMinusR0, const real_t y, const len_t quadrant,
+    const real_t rmin, const real_t lengthScale, real_t &r
+) {
+    const len_t MAX_ITERATIONS = 10;
+    real_t r_tmp = r;
+
+    for (len_t iter = 0; iter < MAX_ITERATIONS; iter++) {
+        if (r_tmp <= 0)
+            return false;
+
+        real_t kappa   = InterpolateInputElongation(r_tmp);
+        real_t kappa_p = InterpolateInputElongationDeriv(r_tmp);
+        real_t delta   = InterpolateInputTriangularity(r_tmp);
+        real_t delta_p = InterpolateInputTriangularityDeriv(r_tmp);
+        real_t Delta   = InterpolateInputShafranovShift(r_tmp);
+        real_t Delta_p = InterpolateInputShafranovShiftDeriv(r_tmp);
+
+        real_t st = y/(r_tmp*kappa);
+        if (std::abs(st) >= 1)
+            return false;
+
+        real_t st_p = -y/(r_tmp*r_tmp*kappa*kappa)*(kappa+r_tmp*kappa_p);
+        real_t ct;
+        if (quadrant==1 || quadrant==4)
+            ct = sqrt(1-st*st);
+        else
+            ct = -sqrt(1-st*st);
+        real_t ct_p = -st/ct*st_p;
+
+        real_t cd = cos(delta*st), sd = sin(delta*st);
+        real_t RMinusR0_newton = Delta + r_tmp*(ct*cd-st*sd);
+        real_t ddrRMinusR0_newton = Delta_p + ct*cd-st*sd +
+            r_tmp*(ct_p*cd - st_p*sd - (ct*sd+st*cd)*(delta_p*st+delta*st_p));
+
+        real_t dr = (RMinusR0_newton-RMinusR0) / ddrRMinusR0_newton;
+        if (!std::isfinite(dr))
+            return false;
+
+        r_tmp -= dr;
+
+        if (r_tmp < rmin || r_tmp >= this->r_f[GetNr()])
+            return false;
+        else if (std::abs(dr) <= lengthScale*CartesianCoordinateTol) {
+            r = r_tmp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * Calculates the gradient of the minor radius coordinate 'r' in cartesian coordinates
  *
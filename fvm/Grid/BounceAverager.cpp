@@ -17,9 +17,13 @@
  * be called _after_ the FluxSurfaceAverager has been Rebuilt.
  */
 
+#include <exception>
 #include "FVM/Grid/BounceAverager.hpp"
 #include <gsl/gsl_roots.h>
 #include <gsl/gsl_errno.h>
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
 
 using namespace std;
 using namespace DREAM::FVM;
@@ -48,8 +52,13 @@ BounceAverager::BounceAverager(
 
     // Use the Brent algorithm for root finding when determining the theta bounce points
     const gsl_root_fsolver_type *GSL_rootsolver_type = gsl_root_fsolver_brent;
-    gsl_fsolver = gsl_root_fsolver_alloc (GSL_rootsolver_type);
-    gsl_adaptive = gsl_integration_workspace_alloc(1000);
+    nThreads = FluxSurfaceAverager::GetMaxThreads();
+    gsl_fsolver = new gsl_root_fsolver*[nThreads];
+    gsl_adaptive = new gsl_integration_workspace*[nThreads];
+    for(len_t k=0; k<nThreads; k++){
+        gsl_fsolver[k] = gsl_root_fsolver_alloc (GSL_rootsolver_type);
+        gsl_adaptive[k] = gsl_integration_workspace_alloc(1000);
+    }
     qaws_table = gsl_integration_qaws_table_alloc(-0.5, -0.5, 0, 0);    
 }
 
@@ -57,8 +66,12 @@ BounceAverager::BounceAverager(
  * Destructor.
  */
 BounceAverager::~BounceAverager(){
-    gsl_root_fsolver_free(gsl_fsolver);
-    gsl_integration_workspace_free(gsl_adaptive);
+    for(len_t k=0; k<nThreads; k++){
+        gsl_root_fsolver_free(gsl_fsolver[k]);
+        gsl_integration_workspace_free(gsl_adaptive[k]);
+    }
+    delete [] gsl_fsolver;
+    delete [] gsl_adaptive;
     gsl_integration_qaws_table_free(qaws_table);
     
     if(!integrateTrappedAdaptive)
@@ -126,20 +139,31 @@ void BounceAverager::InitializeQuadrature(FluxSurfaceAverager::quadrature_method
 /**
  * Rebuilds quantities needed to perform bounce averages.
  * Should be called after FluxSurfaceAverager->Rebuild().
+ *
+ * bounceDataLoaded: If true, the trapping parameters and bounce-
+ *                   averaged metric have already been handed to the
+ *                   grid (e.g. from a GridCache) and are not
+ *                   re-evaluated; only the quantities needed for
+ *                   subsequent bounce averages are set.
  */
-void BounceAverager::Rebuild(){
+void BounceAverager::Rebuild(bool bounceDataLoaded){
     UpdateGridResolution();
     
     // If data has been generated already, deallocate.
-    if(isTrapped!=nullptr){
+    if(isBuilt){
         Metric->DeallocateData();
         BOverBmin->DeallocateData();
         ROverR0->DeallocateData();
         NablaR2->DeallocateData();
     }
+    isBuilt = true;
 
     // Initialize isTrapped and theta bounce points. True if any isTrapped.
-    bool hasTrapped = InitializeBounceIntegralQuantities();
+    bool hasTrapped;
+    if(bounceDataLoaded)
+        hasTrapped = grid->HasTrapped();
+    else
+        hasTrapped = InitializeBounceIntegralQuantities();
 
     // true if data should be stored on trapped grid (ie not adaptive quad) 
     bool storeTrapped =  hasTrapped && !integrateTrappedAdaptive;
@@ -169,6 +193,9 @@ void BounceAverager::Rebuild(){
         Metric ->SetDataForTrapped(ntheta_interp_trapped,theta_trapped_ref);
     }
 
+    if(bounceDataLoaded)
+        return;
+
     // Calculate bounce-averaged metric and hand over to grid 
     real_t **Vp, **Vp_fr, **Vp_f1, **Vp_f2, **VpOverP2AtZero;
     bool isPXiGrid = true; 
@@ -203,24 +230,40 @@ void BounceAverager::SetVp(real_t**&Vp, fluxGridType fluxGridType){
         p = grid->GetMomentumGrid(0)->GetP();
 
     bool isPXiGrid = true; 
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(omp_get_level()==0)
+#endif
     for(len_t ir = 0; ir<nr; ir++){
         Vp[ir] = new real_t[n1*n2];
-        for(len_t j = 0; j<n2; j++){
-            if(isPXiGrid){ // assume Vp scales as ~p^2
-                real_t Vp0 = EvaluateBounceIntegralOverP2(
-                    ir,0,j,fluxGridType,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY
-                );
-                for(len_t i = 0; i<n1; i++)
-                    Vp[ir][j*n1+i] = p[i]*p[i]*Vp0;
-            } else 
-                for(len_t i = 0; i<n1; i++){
-                    len_t pind = j*n1+i;
-                    Vp[ir][pind] = p[pind]*p[pind]*EvaluateBounceIntegralOverP2(
-                        ir,i,j,fluxGridType,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY
+        try {
+            for(len_t j = 0; j<n2; j++){
+                if(isPXiGrid){ // assume Vp scales as ~p^2
+                    real_t Vp0 = EvaluateBounceIntegralOverP2(
+                        ir,0,j,fluxGridType,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY
                     );
-                }
+                    for(len_t i = 0; i<n1; i++)
+                        Vp[ir][j*n1+i] = p[i]*p[i]*Vp0;
+                } else 
+                    for(len_t i = 0; i<n1; i++){
+                        len_t pind = j*n1+i;
+                        Vp[ir][pind] = p[pind]*p[pind]*EvaluateBounceIntegralOverP2(
+                            ir,i,j,fluxGridType,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY
+                        );
+                    }
+            }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
+            }
         }
     }
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
 }
 
 
@@ -236,21 +279,37 @@ void BounceAverager::SetVpsPXi(real_t**&Vp, real_t **&Vp_f1, real_t **&VpOverP2)
     
     const real_t *p = grid->GetMomentumGrid(0)->GetP1();
     const real_t *p_f = grid->GetMomentumGrid(0)->GetP1_f();
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(omp_get_level()==0)
+#endif
     for(len_t ir = 0; ir<nr; ir++){
         len_t n1 = np1[ir];
         len_t n2 = np2[ir];
         Vp[ir]       = new real_t[n1*n2];
         Vp_f1[ir]    = new real_t[(n1+1)*n2];
         VpOverP2[ir] = new real_t[n2];
-        for(len_t j = 0; j<n2; j++){
-            VpOverP2[ir][j] = EvaluateBounceIntegralOverP2(ir,0,j,FLUXGRIDTYPE_DISTRIBUTION,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY);
-            for(len_t i = 0; i<n1; i++){
-                Vp[ir][j*n1+i] = VpOverP2[ir][j] * p[i]*p[i];
-                Vp_f1[ir][j*(n1+1)+i] = VpOverP2[ir][j] * p_f[i]*p_f[i];
+        try {
+            for(len_t j = 0; j<n2; j++){
+                VpOverP2[ir][j] = EvaluateBounceIntegralOverP2(ir,0,j,FLUXGRIDTYPE_DISTRIBUTION,RadialGrid::BA_FUNC_UNITY, nullptr, RadialGrid::BA_PARAM_UNITY);
+                for(len_t i = 0; i<n1; i++){
+                    Vp[ir][j*n1+i] = VpOverP2[ir][j] * p[i]*p[i];
+                    Vp_f1[ir][j*(n1+1)+i] = VpOverP2[ir][j] * p_f[i]*p_f[i];
+                }
+                Vp_f1[ir][j*(n1+1)+n1] = VpOverP2[ir][j] * p_f[n1]*p_f[n1];                
+            }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
             }
-            Vp_f1[ir][j*(n1+1)+n1] = VpOverP2[ir][j] * p_f[n1]*p_f[n1];                
         }
     }
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
 }
 
 
@@ -401,11 +460,12 @@ real_t BounceAverager::EvaluateBounceIntegralOverP2(len_t ir, len_t i, len_t j,
 
         GSL_func.function = &(FluxSurfaceAverager::BounceIntegralFunction);
         GSL_func.params = &params;
-        real_t epsabs = 0, epsrel = 1e-6, lim = gsl_adaptive->limit, error;
+        gsl_integration_workspace *gsl_ad_w = gsl_adaptive[FluxSurfaceAverager::GetThreadIndex(nThreads)];
+        real_t epsabs = 0, epsrel = 1e-6, lim = gsl_ad_w->limit, error;
         if(params.integrateQAWS) // use QAWS if integrand is singular
-            gsl_integration_qaws(&GSL_func, theta_b1, theta_b2, qaws_table,epsabs,epsrel,lim,gsl_adaptive,&BounceIntegral, &error);
+            gsl_integration_qaws(&GSL_func, theta_b1, theta_b2, qaws_table,epsabs,epsrel,lim,gsl_ad_w,&BounceIntegral, &error);
         else
-            gsl_integration_qag(&GSL_func, theta_b1, theta_b2,epsabs,epsrel,lim, QAG_KEY,gsl_adaptive,&BounceIntegral, &error);
+            gsl_integration_qag(&GSL_func, theta_b1, theta_b2,epsabs,epsrel,lim, QAG_KEY,gsl_ad_w,&BounceIntegral, &error);
         return SingularPointCorrection*BounceIntegral;
     }
 
@@ -430,6 +490,11 @@ real_t BounceAverager::EvaluateBounceIntegralOverP2(len_t ir, len_t i, len_t j,
     }
         
     bool hasFList = (Flist_eval != nullptr);
+    if(hasFList && FluxSurfaceAverager::EvaluateBounceIntegralKernel(
+        Flist_eval, ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2, BounceIntegral
+    ))
+        return SingularPointCorrection*2*M_PI*weightScaleFactor*BounceIntegral;
+
     for (len_t it = 0; it<ntheta; it++) {
         // treat the singular cylindrical case 
         real_t xiOverXi0 = MomentumGrid::evaluateXiOverXi0(xi0, BOverBmin[it]);
@@ -468,17 +533,20 @@ bool BounceAverager::InitializeBounceIntegralQuantities(){
  */
 bool BounceAverager::SetIsTrapped(bool **&isTrapped, real_t **&theta_b1, real_t **&theta_b2, fluxGridType fluxGridType){
     bool hasTrapped = false;
-    real_t Bmin, Bmax;
     /**
      * XXX: Here we assume same grid at all radii.
      */
     len_t nr = this->nr + (fluxGridType == FLUXGRIDTYPE_RADIAL);
     len_t n1 = np1[0] + (fluxGridType == FLUXGRIDTYPE_P1);
     len_t n2 = np2[0]+ (fluxGridType == FLUXGRIDTYPE_P2);
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(||:hasTrapped) if(omp_get_level()==0)
+#endif
     for(len_t ir = 0; ir<nr; ir++){
         real_t theta_Bmin = 0, theta_Bmax = 0;
-        Bmin = fluxSurfaceAverager->GetBmin(ir,fluxGridType, &theta_Bmin);
-        Bmax = fluxSurfaceAverager->GetBmax(ir,fluxGridType, &theta_Bmax);
+        real_t Bmin = fluxSurfaceAverager->GetBmin(ir,fluxGridType, &theta_Bmin);
+        real_t Bmax = fluxSurfaceAverager->GetBmax(ir,fluxGridType, &theta_Bmax);
 
         // in cylindrical grid or at r=0, isTrapped is false and we skip to next radius 
         if(Bmin==Bmax){
@@ -487,25 +555,39 @@ bool BounceAverager::SetIsTrapped(bool **&isTrapped, real_t **&theta_b1, real_t
             continue;
         }
 
-        for(len_t j = 0; j<n2; j++)
-            for(len_t i = 0; i<n1; i++){
-                len_t pind = j*n1+i;
-                real_t xi0 = GetXi0(ir,i,j,fluxGridType);
-                if((1-xi0*xi0) > Bmin/Bmax){
-                    isTrapped[ir][pind] = true;
-                    hasTrapped = true;
-                    if(std::abs(xi0)<100*realeps){ // xi0=0 case: infinitely deeply trapped
-                        theta_b1[ir][pind] = theta_Bmin;
-                        theta_b2[ir][pind] = theta_Bmin;
+        try {
+            gsl_root_fsolver *gsl_fsolver = this->gsl_fsolver[FluxSurfaceAverager::GetThreadIndex(nThreads)];
+            for(len_t j = 0; j<n2; j++)
+                for(len_t i = 0; i<n1; i++){
+                    len_t pind = j*n1+i;
+                    real_t xi0 = GetXi0(ir,i,j,fluxGridType);
+                    if((1-xi0*xi0) > Bmin/Bmax){
+                        isTrapped[ir][pind] = true;
+                        hasTrapped = true;
+                        if(std::abs(xi0)<100*realeps){ // xi0=0 case: infinitely deeply trapped
+                            theta_b1[ir][pind] = theta_Bmin;
+                            theta_b2[ir][pind] = theta_Bmin;
+                        } else 
+                            FluxSurfaceAverager::FindBouncePoints(
+                                ir,Bmin, theta_Bmin, theta_Bmax, fluxSurfaceAverager, xi0, fluxGridType,
+                                &theta_b1[ir][pind],&theta_b2[ir][pind], gsl_fsolver, geometryIsSymmetric
+                            );
                     } else 
-                        FluxSurfaceAverager::FindBouncePoints(
-                            ir,Bmin, theta_Bmin, theta_Bmax, fluxSurfaceAverager, xi0, fluxGridType,
-                            &theta_b1[ir][pind],&theta_b2[ir][pind], gsl_fsolver, geometryIsSymmetric
-                        );
-                } else 
-                    isTrapped[ir][n1*j+i] = false;
+                        isTrapped[ir][n1*j+i] = false;
+                }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
             }
+        }
     }
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
+
     return hasTrapped;
 }
 
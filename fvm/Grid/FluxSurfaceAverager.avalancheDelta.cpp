@@ -171,7 +171,10 @@ real_t FluxSurfaceAverager::EvaluateAvalancheDeltaHat(len_t ir, real_t p, real_t
     h_gsl_func.params = &h_params;
     
     // settings for integral
-    real_t epsabs = 0, epsrel = 1e-4, lim = gsl_adaptive->limit, error;
+    const len_t ithread = GetThreadIndex(nThreads);
+    gsl_integration_workspace *gsl_ad_w = gsl_adaptive[ithread];
+    gsl_root_fsolver *gsl_fsolver = this->gsl_fsolver[ithread];
+    real_t epsabs = 0, epsrel = 1e-4, lim = gsl_ad_w->limit, error;
     real_t deltaHat;
 
     gsl_function gsl_func;
@@ -189,7 +192,7 @@ real_t FluxSurfaceAverager::EvaluateAvalancheDeltaHat(len_t ir, real_t p, real_t
         if(RESign==-1)
             orderIntegrationIndicesLFS(&theta_l1,&theta_l2);
         
-        gsl_integration_qag(&h_gsl_func,theta_l1,theta_l2,epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&deltaHat, &error);
+        gsl_integration_qag(&h_gsl_func,theta_l1,theta_l2,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&deltaHat, &error);
         return deltaHat / FSA_B;
     }
 
@@ -202,7 +205,7 @@ real_t FluxSurfaceAverager::EvaluateAvalancheDeltaHat(len_t ir, real_t p, real_t
         if(RESign==-1)
             orderIntegrationIndicesHFS(&theta_u1,&theta_u2);
 
-        gsl_integration_qag(&h_gsl_func,theta_u1,theta_u2,epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&deltaHat, &error);
+        gsl_integration_qag(&h_gsl_func,theta_u1,theta_u2,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&deltaHat, &error);
         return deltaHat / FSA_B;        
     }
 
@@ -215,8 +218,8 @@ real_t FluxSurfaceAverager::EvaluateAvalancheDeltaHat(len_t ir, real_t p, real_t
     FindThetas(theta_Bmin,theta_Bmax,&theta_l1, &theta_l2, gsl_func, gsl_fsolver);
 
     real_t deltaHat1, deltaHat2;
-    gsl_integration_qag(&h_gsl_func,min(theta_l1,theta_u1),max(theta_l1,theta_u1),epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&deltaHat1, &error);
-    gsl_integration_qag(&h_gsl_func,min(theta_l2,theta_u2),max(theta_l2,theta_u2),epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&deltaHat2, &error);
+    gsl_integration_qag(&h_gsl_func,min(theta_l1,theta_u1),max(theta_l1,theta_u1),epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&deltaHat1, &error);
+    gsl_integration_qag(&h_gsl_func,min(theta_l2,theta_u2),max(theta_l2,theta_u2),epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&deltaHat2, &error);
 
     return (deltaHat1+deltaHat2)/FSA_B;
 }
@@ -8,8 +8,12 @@
  * SetReferenceMagneticFieldData(...).
  */
 
+#include <exception>
 #include "FVM/Grid/FluxSurfaceAverager.hpp"
 #include "gsl/gsl_errno.h"
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
 using namespace std;
 using namespace DREAM::FVM;
 
@@ -38,6 +42,7 @@ FluxSurfaceAverager::FluxSurfaceAverager(
             throw FVMException("Interpolation method '%d' not supported by FluxSurfaceAverager.", i_method);
     }
 
+    this->nThreads = GetMaxThreads();
     InitializeQuadrature(q_method);
 
     BOverBmin = new FluxSurfaceQuantity(rGrid, [rgg,g](len_t ir, real_t theta){if(!g->GetBmin(ir)) return 1.0; else return rgg->BAtTheta(ir,theta)/g->GetBmin(ir);}, [rgg,g](len_t ir, real_t theta){if(!g->GetBmin_f(ir)) return 1.0; else return rgg->BAtTheta_f(ir,theta)/g->GetBmin_f(ir);}, interpolationMethod);
@@ -47,7 +52,9 @@ FluxSurfaceAverager::FluxSurfaceAverager(
 
     // Use the Brent algorithm for root finding in determining the theta bounce points
     const gsl_root_fsolver_type *GSL_rootsolver_type = gsl_root_fsolver_brent;
-    gsl_fsolver = gsl_root_fsolver_alloc (GSL_rootsolver_type);
+    gsl_fsolver = new gsl_root_fsolver*[nThreads];
+    for(len_t k=0; k<nThreads; k++)
+        gsl_fsolver[k] = gsl_root_fsolver_alloc (GSL_rootsolver_type);
     qaws_table = gsl_integration_qaws_table_alloc(-0.5, -0.5, 0, 0);
 }
 
@@ -55,7 +62,9 @@ FluxSurfaceAverager::FluxSurfaceAverager(
  * Destructor
  */
 FluxSurfaceAverager::~FluxSurfaceAverager(){
-    gsl_root_fsolver_free(gsl_fsolver);
+    for(len_t k=0; k<nThreads; k++)
+        gsl_root_fsolver_free(gsl_fsolver[k]);
+    delete [] gsl_fsolver;
 
     DeallocateQuadrature();
     DeallocateReferenceData();
@@ -65,12 +74,55 @@ FluxSurfaceAverager::~FluxSurfaceAverager(){
     delete NablaR2;
 }
 
+/**
+ * Returns the number of threads for which GSL workspaces
+ * should be allocated.
+ */
+len_t FluxSurfaceAverager::GetMaxThreads(){
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Returns the index of the GSL workspaces to be used by the
+ * calling thread. Averages are only evaluated in parallel in
+ * the outermost parallel region (nested regions, such as when
+ * averages are evaluated during a parallel rebuild of the
+ * equation terms, are executed serially), and so the thread
+ * number in the outermost team identifies the workspaces.
+ *
+ * nThreads: Number of workspaces allocated by the caller.
+ */
+len_t FluxSurfaceAverager::GetThreadIndex(const len_t nThreads){
+#ifdef _OPENMP
+    len_t ithread = (omp_get_level() > 0) ? omp_get_ancestor_thread_num(1) : 0;
+    if(ithread >= nThreads)
+        throw FVMException(
+            "FluxSurfaceAverager: Thread " LEN_T_PRINTF_FMT " has no GSL workspace. "
+            "Only " LEN_T_PRINTF_FMT " threads were available when the grid was created.",
+            ithread, nThreads
+        );
+    return ithread;
+#else
+    (void)nThreads;
+    return 0;
+#endif
+}
+
 
 /**
  * (Re-)Initializes everyting required to perform flux surface averages.
  * Should be called after SetReferenceMagneticFieldData(...).
+ *
+ * evaluateVpVol: If false, the flux-surface averaged Jacobian VpVol is
+ *                not evaluated and must instead be handed to the
+ *                RadialGrid by the caller (e.g. when it is loaded from
+ *                a GridCache).
  */
-void FluxSurfaceAverager::Rebuild(){
+void FluxSurfaceAverager::Rebuild(bool evaluateVpVol){
     this->nr = rGrid->GetNr();
 
     // if using fixed quadrature, store all quantities on the theta grid
@@ -81,13 +133,34 @@ void FluxSurfaceAverager::Rebuild(){
         NablaR2->InterpolateMagneticDataToTheta(theta, ntheta_interp);
     }
 
+    if(!evaluateVpVol)
+        return;
+
     // Calculate flux-surface averaged Jacobian and hand over to RadialGrid.
+    // (flux grid radius ir=nr is evaluated together with distribution grid radius 0)
     real_t *VpVol   = new real_t[nr];
     real_t *VpVol_f = new real_t[nr+1];    
-    for(len_t ir=0; ir<nr;  ir++)
-        VpVol[ir]   = EvaluateFluxSurfaceIntegral(ir, FLUXGRIDTYPE_DISTRIBUTION, RadialGrid::FSA_FUNC_UNITY, nullptr, RadialGrid::FSA_PARAM_UNITY);
-    for(len_t ir=0; ir<=nr; ir++)
-        VpVol_f[ir] = EvaluateFluxSurfaceIntegral(ir, FLUXGRIDTYPE_RADIAL, RadialGrid::FSA_FUNC_UNITY, nullptr, RadialGrid::FSA_PARAM_UNITY);
+    std::exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(omp_get_level()==0)
+#endif
+    for(len_t ir=0; ir<=nr; ir++){
+        try {
+            if(ir<nr)
+                VpVol[ir] = EvaluateFluxSurfaceIntegral(ir, FLUXGRIDTYPE_DISTRIBUTION, RadialGrid::FSA_FUNC_UNITY, nullptr, RadialGrid::FSA_PARAM_UNITY);
+            VpVol_f[ir] = EvaluateFluxSurfaceIntegral(ir, FLUXGRIDTYPE_RADIAL, RadialGrid::FSA_FUNC_UNITY, nullptr, RadialGrid::FSA_PARAM_UNITY);
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = std::current_exception();
+            }
+        }
+    }
+    if (eptr != nullptr)
+        std::rethrow_exception(eptr);
     
     rGrid->SetVpVol(VpVol,VpVol_f);
 }
@@ -152,11 +225,15 @@ real_t FluxSurfaceAverager::EvaluateFluxSurfaceIntegral(len_t ir, fluxGridType f
         const real_t *ROverR0   = this->ROverR0->GetData(ir, fluxGridType);
         const real_t *NablaR2   = this->NablaR2->GetData(ir, fluxGridType);
 
+        // use a specialized kernel if available for this F_list
         bool hasFlist = (F_list!=nullptr);    
-        for (len_t it = 0; it<ntheta_interp; it++)
-            fluxSurfaceIntegral += weights[it] * Jacobian[it] 
-                * (hasFlist ? AssembleFSAFunc(BOverBmin[it], ROverR0[it], NablaR2[it], F_list) 
-                    : F(BOverBmin[it], ROverR0[it], NablaR2[it], par));
+        if(!hasFlist || !EvaluateFluxSurfaceIntegralKernel(
+            F_list, ntheta_interp, weights, Jacobian, BOverBmin, ROverR0, NablaR2, fluxSurfaceIntegral
+        ))
+            for (len_t it = 0; it<ntheta_interp; it++)
+                fluxSurfaceIntegral += weights[it] * Jacobian[it] 
+                    * (hasFlist ? AssembleFSAFunc(BOverBmin[it], ROverR0[it], NablaR2[it], F_list) 
+                        : F(BOverBmin[it], ROverR0[it], NablaR2[it], par));
         fluxSurfaceIntegral *= 2*M_PI;
     // or by using adaptive quadrature:
     } else {
@@ -164,8 +241,9 @@ real_t FluxSurfaceAverager::EvaluateFluxSurfaceIntegral(len_t ir, fluxGridType f
         FluxSurfaceIntegralParams params = {F, par, F_list, ir, GetBmin(ir,fluxGridType), this, fluxGridType}; 
         GSL_func.function = &(FluxSurfaceIntegralFunction);
         GSL_func.params = &params;
-        real_t epsabs = 0, epsrel = 1e-4, lim = gsl_adaptive->limit, error;
-        gsl_integration_qag(&GSL_func, 0, theta_max,epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&fluxSurfaceIntegral, &error);
+        gsl_integration_workspace *gsl_ad_w = gsl_adaptive[GetThreadIndex(nThreads)];
+        real_t epsabs = 0, epsrel = 1e-4, lim = gsl_ad_w->limit, error;
+        gsl_integration_qag(&GSL_func, 0, theta_max,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&fluxSurfaceIntegral, &error);
     }
     return fluxSurfaceIntegral;  
 } 
@@ -176,8 +254,12 @@ real_t FluxSurfaceAverager::EvaluateFluxSurfaceIntegral(len_t ir, fluxGridType f
  * Deallocate quadrature.
  */
 void FluxSurfaceAverager::DeallocateQuadrature(){
-    gsl_integration_workspace_free(gsl_adaptive);
-    gsl_integration_workspace_free(gsl_adaptive_outer);
+    for(len_t k=0; k<nThreads; k++){
+        gsl_integration_workspace_free(gsl_adaptive[k]);
+        gsl_integration_workspace_free(gsl_adaptive_outer[k]);
+    }
+    delete [] gsl_adaptive;
+    delete [] gsl_adaptive_outer;
     gsl_integration_qaws_table_free(qaws_table);
     if(gsl_w != nullptr)
         gsl_integration_fixed_free(gsl_w);
@@ -196,8 +278,12 @@ void FluxSurfaceAverager::DeallocateQuadrature(){
  *      https://www.gnu.org/software/gsl/doc/html/integration.html
  */
 void FluxSurfaceAverager::InitializeQuadrature(quadrature_method q_method){
-    gsl_adaptive = gsl_integration_workspace_alloc(1000);
-    gsl_adaptive_outer = gsl_integration_workspace_alloc(1000);
+    gsl_adaptive = new gsl_integration_workspace*[nThreads];
+    gsl_adaptive_outer = new gsl_integration_workspace*[nThreads];
+    for(len_t k=0; k<nThreads; k++){
+        gsl_adaptive[k] = gsl_integration_workspace_alloc(1000);
+        gsl_adaptive_outer[k] = gsl_integration_workspace_alloc(1000);
+    }
     std::function<real_t(real_t,real_t,real_t)>  QuadWeightFunction;
     if(geometryIsSymmetric)
         theta_max = M_PI;
@@ -328,6 +414,12 @@ real_t FluxSurfaceAverager::GetVpVol(len_t ir,fluxGridType fluxGridType){
  */
 #include "FluxSurfaceAverager.avalancheDelta.cpp"
 
+/**
+ * Compile-time specialized quadrature kernels for the
+ * functions averaged when building the grid
+ */
+#include "FluxSurfaceAverager.kernels.cpp"
+
 
 /**
  * Evalutes the singular product sqrt(g) * sqrt(theta-theta_b1)*sqrt(theta_b2-theta)
@@ -438,7 +530,7 @@ real_t FluxSurfaceAverager::EvaluatePXiBounceIntegralAtP(len_t ir, real_t xi0, f
                 Flist_eval[4] *= 2;
         }
         F_eval = BA_FUNC_TRAPPED;
-        FindBouncePoints(ir, Bmin, theta_Bmin, theta_Bmax, this, xi0, fluxGridType, &theta_b1, &theta_b2,gsl_fsolver,geometryIsSymmetric);
+        FindBouncePoints(ir, Bmin, theta_Bmin, theta_Bmax, this, xi0, fluxGridType, &theta_b1, &theta_b2,gsl_fsolver[GetThreadIndex(nThreads)],geometryIsSymmetric);
         if(theta_b1==theta_b2)
             return 0;
 
@@ -478,11 +570,12 @@ real_t FluxSurfaceAverager::EvaluatePXiBounceIntegralAtP(len_t ir, real_t xi0, f
     GSL_func.params = &params;
     real_t bounceIntegral, error; 
 
-    real_t epsabs = 0, epsrel = 1e-3, lim = gsl_adaptive->limit; 
+    gsl_integration_workspace *gsl_ad_w = gsl_adaptive[GetThreadIndex(nThreads)];
+    real_t epsabs = 0, epsrel = 1e-3, lim = gsl_ad_w->limit; 
     if(params.integrateQAWS)
-        gsl_integration_qaws(&GSL_func,theta_b1,theta_b2,qaws_table,epsabs,epsrel,lim,gsl_adaptive,&bounceIntegral,&error);
+        gsl_integration_qaws(&GSL_func,theta_b1,theta_b2,qaws_table,epsabs,epsrel,lim,gsl_ad_w,&bounceIntegral,&error);
     else
-        gsl_integration_qag(&GSL_func,theta_b1,theta_b2,epsabs,epsrel,lim,QAG_KEY,gsl_adaptive,&bounceIntegral,&error);
+        gsl_integration_qag(&GSL_func,theta_b1,theta_b2,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&bounceIntegral,&error);
     
     return bounceIntegral;
 }
@@ -752,8 +845,9 @@ real_t FluxSurfaceAverager::EvaluateCellAveragedBounceIntegralOverP2(len_t ir, r
     real_t 
         epsabs = 0,
         epsrel = 1e-3,
-        lim = gsl_adaptive->limit,
         error;
+    gsl_integration_workspace *gsl_ad_w = gsl_adaptive_outer[GetThreadIndex(nThreads)];
+    real_t lim = gsl_ad_w->limit;
     
     real_t xiT;
     if(fluxGridType == FLUXGRIDTYPE_RADIAL)
@@ -770,26 +864,26 @@ real_t FluxSurfaceAverager::EvaluateCellAveragedBounceIntegralOverP2(len_t ir, r
         real_t pts[2] = {xi_l,-xiT};
         int npts = 2;
         if(xi_u < -xiT)
-            gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_adaptive_outer,&partResult1,&error);
+            gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_ad_w,&partResult1,&error);
         else if( xi_u>0 ) // if xi_u<=0, this is a "negative pitch trapped" cel which is mirrored and should have Vp=0
-            gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_adaptive_outer,&partResult1,&error);
+            gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_ad_w,&partResult1,&error);
     }
     // contribution from positive pitch trapped region
     if(xi_u>0 && xi_l<xiT){
         if(xi_u<xiT){
             if(xi_l<0)
-                gsl_integration_qag(&gsl_func,0,xi_u,epsabs,epsrel,lim,key,gsl_adaptive_outer,&partResult2,&error);
+                gsl_integration_qag(&gsl_func,0,xi_u,epsabs,epsrel,lim,key,gsl_ad_w,&partResult2,&error);
             else 
-                gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_adaptive_outer,&partResult2,&error);
+                gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_ad_w,&partResult2,&error);
         } else {
             if(xi_l<0){
                 real_t pts[2] = {0,xiT};
                 int npts = 2;
-                gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_adaptive_outer,&partResult2,&error);
+                gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_ad_w,&partResult2,&error);
             } else {
                 real_t pts[2] = {xi_l,xiT};
                 int npts = 2;
-                gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_adaptive_outer,&partResult2,&error);
+                gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_ad_w,&partResult2,&error);
             }
         }
     }
@@ -798,9 +892,9 @@ real_t FluxSurfaceAverager::EvaluateCellAveragedBounceIntegralOverP2(len_t ir, r
         real_t pts[2] = {xiT,xi_u};
         int npts = 2;
         if(xi_l<=xiT)
-            gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_adaptive_outer,&partResult3,&error);
+            gsl_integration_qagp(&gsl_func,pts,npts,epsabs,epsrel,lim,gsl_ad_w,&partResult3,&error);
         else 
-            gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_adaptive_outer,&partResult3,&error);
+            gsl_integration_qag(&gsl_func,xi_l,xi_u,epsabs,epsrel,lim,key,gsl_ad_w,&partResult3,&error);
     }    
 
     return (partResult1+partResult2+partResult3)/dxi;
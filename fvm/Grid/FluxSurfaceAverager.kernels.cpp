@@ -0,0 +1,143 @@
+/**
+ * In this file, compile-time specialized kernels for the fixed-quadrature
+ * flux surface and bounce integrals are collected.
+ *
+ * When the function to be averaged is given as a list of exponents
+ * (e.g. RadialGrid::FSA_PARAM_B or RadialGrid::BA_PARAM_XI), the integrand
+ * is normally assembled point by point by AssembleFSAFunc()/AssembleBAFunc(),
+ * which loop over the exponents at run time. For the exponent lists used
+ * when building the grid, the integrand is instead expanded at compile
+ * time, so that the quadrature reduces to a branch-free multiply-add loop
+ * over theta which the compiler can vectorize.
+ */
+
+
+namespace {
+    /**
+     * Returns x^N, with the product expanded at compile time.
+     */
+    template<int_t N>
+    inline real_t IntPow(const real_t x) {
+        if constexpr (N == 0)
+            return 1;
+        else if constexpr (N < 0)
+            return 1/IntPow<-N>(x);
+        else
+            return x*IntPow<N-1>(x);
+    }
+
+    /**
+     * Returns the sum
+     *      sum_i w_i J_i * BOverBmin_i^EB * ROverR0_i^ER * NablaR2_i^EN
+     * over the theta quadrature points.
+     */
+    template<int_t EB, int_t ER, int_t EN>
+    real_t FluxSurfaceIntegralKernel(
+        const len_t ntheta, const real_t *weights, const real_t *Jacobian,
+        const real_t *BOverBmin, const real_t *ROverR0, const real_t *NablaR2
+    ) {
+        real_t s = 0;
+        for (len_t it = 0; it < ntheta; it++)
+            s += weights[it] * Jacobian[it]
+                * IntPow<EB>(BOverBmin[it]) * IntPow<ER>(ROverR0[it]) * IntPow<EN>(NablaR2[it]);
+        return s;
+    }
+
+    /**
+     * Returns the sum
+     *      sum_i w_i sqrt(g)_i * (xi/xi0)_i^EXi * BOverBmin_i^EB * ROverR0_i^ER * NablaR2_i^EN
+     * over the theta quadrature points. xi/xi0 is only evaluated if
+     * the integrand depends on it.
+     */
+    template<int_t EXi, int_t EB, int_t ER, int_t EN>
+    real_t BounceIntegralKernel(
+        const len_t ntheta, const real_t xi0, const real_t *weights, const real_t *Metric,
+        const real_t *BOverBmin, const real_t *ROverR0, const real_t *NablaR2
+    ) {
+        real_t s = 0;
+        for (len_t it = 0; it < ntheta; it++) {
+            real_t F = weights[it] * Metric[it]
+                * IntPow<EB>(BOverBmin[it]) * IntPow<ER>(ROverR0[it]) * IntPow<EN>(NablaR2[it]);
+            if constexpr (EXi != 0)
+                F *= IntPow<EXi>(MomentumGrid::evaluateXiOverXi0(xi0, BOverBmin[it]));
+            s += F;
+        }
+        return s;
+    }
+
+    /**
+     * Returns true if the first 'n' exponents of the two lists agree.
+     */
+    inline bool ParamMatches(const int_t *Flist, const int_t *param, const len_t n) {
+        for (len_t k = 0; k < n; k++)
+            if (Flist[k] != param[k])
+                return false;
+        return true;
+    }
+}
+
+
+/**
+ * Evaluates the fixed-quadrature flux surface integral
+ *      sum_i w_i J_i * FSA_Func_i
+ * using a compile-time specialized kernel, where FSA_Func is
+ * given by the exponent list 'Flist' (see AssembleFSAFunc()).
+ *
+ * Returns false (and leaves 'integral' untouched) if no
+ * specialized kernel exists for 'Flist', in which case the
+ * caller should fall back on the generic evaluation.
+ */
+bool FluxSurfaceAverager::EvaluateFluxSurfaceIntegralKernel(
+    const int_t *Flist, const len_t ntheta, const real_t *weights, const real_t *Jacobian,
+    const real_t *BOverBmin, const real_t *ROverR0, const real_t *NablaR2, real_t &integral
+) {
+    real_t s;
+    if (ParamMatches(Flist, RadialGrid::FSA_PARAM_UNITY, 3))
+        s = FluxSurfaceIntegralKernel<0,0,0>(ntheta, weights, Jacobian, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::FSA_PARAM_ONE_OVER_R_SQUARED, 3))
+        s = FluxSurfaceIntegralKernel<0,-2,0>(ntheta, weights, Jacobian, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::FSA_PARAM_B, 3))
+        s = FluxSurfaceIntegralKernel<1,0,0>(ntheta, weights, Jacobian, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::FSA_PARAM_B_SQUARED, 3))
+        s = FluxSurfaceIntegralKernel<2,0,0>(ntheta, weights, Jacobian, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::FSA_PARAM_NABLA_R_SQUARED_OVER_R_SQUARED, 3))
+        s = FluxSurfaceIntegralKernel<0,-2,1>(ntheta, weights, Jacobian, BOverBmin, ROverR0, NablaR2);
+    else
+        return false;
+
+    integral = Flist[3] * s;
+    return true;
+}
+
+/**
+ * Evaluates the fixed-quadrature bounce integral
+ *      sum_i w_i sqrt(g)_i * BA_Func_i
+ * using a compile-time specialized kernel, where BA_Func is
+ * given by the exponent list 'Flist' (see AssembleBAFunc()).
+ *
+ * Returns false (and leaves 'integral' untouched) if no
+ * specialized kernel exists for 'Flist', in which case the
+ * caller should fall back on the generic evaluation.
+ */
+bool FluxSurfaceAverager::EvaluateBounceIntegralKernel(
+    const int_t *Flist, const len_t ntheta, const real_t xi0, const real_t *weights,
+    const real_t *Metric, const real_t *BOverBmin, const real_t *ROverR0,
+    const real_t *NablaR2, real_t &integral
+) {
+    real_t s;
+    if (ParamMatches(Flist, RadialGrid::BA_PARAM_UNITY, 4))
+        s = BounceIntegralKernel<0,0,0,0>(ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::BA_PARAM_XI, 4))
+        s = BounceIntegralKernel<1,0,0,0>(ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::BA_PARAM_XI_SQUARED_OVER_B, 4))
+        s = BounceIntegralKernel<2,-1,0,0>(ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::BA_PARAM_B_CUBED, 4))
+        s = BounceIntegralKernel<0,3,0,0>(ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2);
+    else if (ParamMatches(Flist, RadialGrid::BA_PARAM_XI_SQUARED_B_SQUARED, 4))
+        s = BounceIntegralKernel<2,2,0,0>(ntheta, xi0, weights, Metric, BOverBmin, ROverR0, NablaR2);
+    else
+        return false;
+
+    integral = Flist[4] * s;
+    return true;
+}
@@ -3,8 +3,13 @@
  */
 
 #include <algorithm>
+#include <exception>
 #include <vector>
 #include "FVM/Grid/Grid.hpp"
+#include "FVM/Grid/GridCache.hpp"
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
 
 
 using namespace std;
@@ -55,18 +60,10 @@ Grid::~Grid() {
     DeallocateVprime();
     DeallocateBAvg();
     DeallocateBounceParameters();
+    DeallocateAvalancheDeltaHat();
     delete [] this->momentumGrids;
     delete this->rgrid;
     delete this->bounceAverager;
-
-    if(avalancheDeltaHat != nullptr){
-        for(len_t ir=0; ir<nr; ir++){
-            delete [] avalancheDeltaHat[ir];
-            delete [] avalancheDeltaHatNegativePitch[ir];
-        }
-        delete [] avalancheDeltaHat;
-        delete [] avalancheDeltaHatNegativePitch;
-    }
 }
 
 /*****************************
@@ -235,8 +232,33 @@ bool Grid::Rebuild(const real_t t) {
  */
 void Grid::RebuildJacobians(){ 
     this->rgrid->RebuildJacobians(); 
-    this->bounceAverager->Rebuild();
-    RebuildBounceAveragedQuantities();
+
+    // Load bounce averages from the geometry cache if they
+    // have been stored there by a previous run
+    if(geometryCache != nullptr && geometryCache->Contains(geometryCacheName)){
+        geometryCache->Load(this, geometryCacheName);
+        this->bounceAverager->Rebuild(true);
+    } else {
+        this->bounceAverager->Rebuild();
+        RebuildBounceAveragedQuantities();
+        if(geometryCache != nullptr)
+            geometryCache->Save(this, geometryCacheName);
+    }
+}
+
+/**
+ * Set the cache from which flux surface and bounce averages
+ * are loaded (or to which they are saved) when the jacobians
+ * of this grid are rebuilt. The cache is also set on the
+ * radial grid.
+ *
+ * gc:   Cache to use (or 'nullptr' to disable caching).
+ * name: Name identifying this grid in the cache.
+ */
+void Grid::SetGeometryCache(GridCache *gc, const string& name){
+    this->geometryCache = gc;
+    this->geometryCacheName = name;
+    this->rgrid->SetGeometryCache(gc);
 }
 
 /**
@@ -305,6 +327,10 @@ void Grid::SetBounceAverage(real_t **&BA_quantity, fluxGridType fluxGridType, re
     len_t nr = GetNr() + (fluxGridType==FLUXGRIDTYPE_RADIAL);
     len_t np1, np2;
     BA_quantity = new real_t*[nr];
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) private(np1,np2) if(omp_get_level()==0)
+#endif
     for(len_t ir=0; ir<nr; ir++){
         MomentumGrid *mg = momentumGrids[ir];
         np1 = mg->GetNp1() + (fluxGridType==FLUXGRIDTYPE_P1);
@@ -318,21 +344,33 @@ void Grid::SetBounceAverage(real_t **&BA_quantity, fluxGridType fluxGridType, re
             pIsZero = (mg->GetP(0,0)==0);
 
         BA_quantity[ir] = new real_t[np1*np2];
-        for(len_t j=0;j<np2;j++){
-            if(pIsZero){
-                real_t xi0;
-                if(fluxGridType==FLUXGRIDTYPE_P1)
-                    xi0 = mg->GetXi0_f1(0,j);
-                else if(fluxGridType==FLUXGRIDTYPE_P2)
-                    xi0 = mg->GetXi0_f2(0,j);
-                else 
-                    xi0 = mg->GetXi0(0,j);
-                BA_quantity[ir][j*np1] = this->rgrid->CalculatePXiBounceAverageAtP(ir,xi0,fluxGridType,F,par,Flist);
-            } 
-            for(len_t i=pIsZero;i<np1;i++)
-                BA_quantity[ir][j*np1+i] = CalculateBounceAverage(ir,i,j,fluxGridType,F,par,Flist);
+        try {
+            for(len_t j=0;j<np2;j++){
+                if(pIsZero){
+                    real_t xi0;
+                    if(fluxGridType==FLUXGRIDTYPE_P1)
+                        xi0 = mg->GetXi0_f1(0,j);
+                    else if(fluxGridType==FLUXGRIDTYPE_P2)
+                        xi0 = mg->GetXi0_f2(0,j);
+                    else 
+                        xi0 = mg->GetXi0(0,j);
+                    BA_quantity[ir][j*np1] = this->rgrid->CalculatePXiBounceAverageAtP(ir,xi0,fluxGridType,F,par,Flist);
+                } 
+                for(len_t i=pIsZero;i<np1;i++)
+                    BA_quantity[ir][j*np1+i] = CalculateBounceAverage(ir,i,j,fluxGridType,F,par,Flist);
+            }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
+            }
         }
     }    
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
 }
 /**
  * Optimized helper method to set one bounce averaged coefficient on the entire grid,
@@ -347,28 +385,44 @@ void Grid::SetBounceAveragePXi(real_t **&BA_quantity, fluxGridType fluxGridType,
     np1 = mg->GetNp1() + (fluxGridType==FLUXGRIDTYPE_P1);
     np2 = mg->GetNp2() + (fluxGridType==FLUXGRIDTYPE_P2);
     BA_quantity = new real_t*[nr];
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(omp_get_level()==0)
+#endif
     for(len_t ir=0; ir<nr; ir++){
 //        bool pIsZero = false; // set to 1 if p(0)=0 since metric is singular
 //        if(fluxGridType==FLUXGRIDTYPE_P1)
 //            pIsZero = (mg->GetP1_f(0)==0);
 
         BA_quantity[ir] = new real_t[np1*np2];
-        for(len_t j=0;j<np2;j++){
-            /*
-            if(pIsZero){
-                real_t xi0;
-                if(fluxGridType==FLUXGRIDTYPE_P2)
-                    xi0 = mg->GetP2_f(j);
-                else 
-                    xi0 = mg->GetP2(j);
-                BA_quantity[ir][j*np1] = this->rgrid->CalculatePXiBounceAverageAtP(ir,xi0,fluxGridType,F,Flist);
-            } 
-            */
-            real_t BA = CalculateBounceAverage(ir,0,j,fluxGridType,F,par,Flist);
-            for(len_t i=0;i<np1;i++)
-                BA_quantity[ir][j*np1+i] = BA;
+        try {
+            for(len_t j=0;j<np2;j++){
+                /*
+                if(pIsZero){
+                    real_t xi0;
+                    if(fluxGridType==FLUXGRIDTYPE_P2)
+                        xi0 = mg->GetP2_f(j);
+                    else 
+                        xi0 = mg->GetP2(j);
+                    BA_quantity[ir][j*np1] = this->rgrid->CalculatePXiBounceAverageAtP(ir,xi0,fluxGridType,F,Flist);
+                } 
+                */
+                real_t BA = CalculateBounceAverage(ir,0,j,fluxGridType,F,par,Flist);
+                for(len_t i=0;i<np1;i++)
+                    BA_quantity[ir][j*np1+i] = BA;
+            }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
+            }
         }
     }    
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
 }
 
 /**
@@ -377,18 +431,15 @@ void Grid::SetBounceAveragePXi(real_t **&BA_quantity, fluxGridType fluxGridType,
  * See documentation in doc/notes/theory for more details.
  */
 void Grid::CalculateAvalancheDeltaHat(){
-    if(avalancheDeltaHat != nullptr){
-        for(len_t ir=0; ir<GetNr(); ir++){
-            delete [] avalancheDeltaHat[ir];
-            delete [] avalancheDeltaHatNegativePitch[ir];
-        }
-        delete [] avalancheDeltaHat;
-        delete [] avalancheDeltaHatNegativePitch;
-    }
+    DeallocateAvalancheDeltaHat();
 
     avalancheDeltaHat = new real_t*[GetNr()];
     avalancheDeltaHatNegativePitch = new real_t*[GetNr()];
 
+    exception_ptr eptr = nullptr;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(omp_get_level()==0)
+#endif
     for(len_t ir=0; ir<GetNr(); ir++){
         MomentumGrid *mg = momentumGrids[ir];
         real_t VpVol = GetVpVol(ir);
@@ -400,27 +451,55 @@ void Grid::CalculateAvalancheDeltaHat(){
             avalancheDeltaHat[ir][i] = 0;
             avalancheDeltaHatNegativePitch[ir][i] = 0;
         }  
-        for(len_t i=0; i<np1; i++)
-            for(len_t j=0; j<np2; j++){
-                real_t p = mg->GetP1(i);
-                real_t xi_l = mg->GetP2_f(j);
-                real_t xi_u = mg->GetP2_f(j+1);
-
-                len_t j_tmp=j;
-                // if negative-pitch trapped boundary, find index containing 
-                // mirrored (-xi) cell to which we instead add the contribution
-                if(IsNegativePitchTrappedIgnorableCell(ir,j))
-                    while(mg->GetP2_f(j_tmp+1)<=-mg->GetP2(j) && j_tmp<np2)
-                        j_tmp++;    
-
-                // normalize contribution with dxi in new cell
-                real_t fac = mg->GetDp2(j)/mg->GetDp2(j_tmp);
-                real_t Vp = this->Vp[ir][j_tmp*np1+i];
-                avalancheDeltaHat[ir][j_tmp*np1+i] += fac*rgrid->GetFluxSurfaceAverager()->EvaluateAvalancheDeltaHat(ir,p,xi_l,xi_u,Vp, VpVol);
-                avalancheDeltaHatNegativePitch[ir][j_tmp*np1+i] += fac*rgrid->GetFluxSurfaceAverager()->EvaluateAvalancheDeltaHat(ir,p,xi_l,xi_u,Vp, VpVol,-1);
-            }        
+        try {
+            for(len_t i=0; i<np1; i++)
+                for(len_t j=0; j<np2; j++){
+                    real_t p = mg->GetP1(i);
+                    real_t xi_l = mg->GetP2_f(j);
+                    real_t xi_u = mg->GetP2_f(j+1);
+
+                    len_t j_tmp=j;
+                    // if negative-pitch trapped boundary, find index containing 
+                    // mirrored (-xi) cell to which we instead add the contribution
+                    if(IsNegativePitchTrappedIgnorableCell(ir,j))
+                        while(mg->GetP2_f(j_tmp+1)<=-mg->GetP2(j) && j_tmp<np2)
+                            j_tmp++;    
+
+                    // normalize contribution with dxi in new cell
+                    real_t fac = mg->GetDp2(j)/mg->GetDp2(j_tmp);
+                    real_t Vp = this->Vp[ir][j_tmp*np1+i];
+                    avalancheDeltaHat[ir][j_tmp*np1+i] += fac*rgrid->GetFluxSurfaceAverager()->EvaluateAvalancheDeltaHat(ir,p,xi_l,xi_u,Vp, VpVol);
+                    avalancheDeltaHatNegativePitch[ir][j_tmp*np1+i] += fac*rgrid->GetFluxSurfaceAverager()->EvaluateAvalancheDeltaHat(ir,p,xi_l,xi_u,Vp, VpVol,-1);
+                }        
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
+            }
+        }
     }
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
+}
 
+/**
+ * Deallocator
+ */
+void Grid::DeallocateAvalancheDeltaHat(){
+    if(avalancheDeltaHat == nullptr)
+        return;
+
+    for(len_t ir=0; ir<GetNr(); ir++){
+        delete [] avalancheDeltaHat[ir];
+        delete [] avalancheDeltaHatNegativePitch[ir];
+    }
+    delete [] avalancheDeltaHat;
+    delete [] avalancheDeltaHatNegativePitch;
+    avalancheDeltaHat = nullptr;
+    avalancheDeltaHatNegativePitch = nullptr;
 }
 
 /**
@@ -574,3 +653,106 @@ void Grid::DeallocateVprime() {
     
     delete [] this->VpOverP2AtZero;
 }
+
+
+/**
+ * Write the trapping parameters and bounce averaged quantities
+ * of this grid to the given geometry cache file.
+ * XXX: Assumes the same momentum grid at all radii.
+ *
+ * sf:   SFile object to write data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void Grid::SaveGeometryCache(SFile *sf, const string& path){
+    const string group = path + "/";
+    const len_t nr = GetNr();
+    const len_t n1 = GetNp1(0), n2 = GetNp2(0);
+
+    sf->WriteScalar(group + "hasTrapped", hasTrapped ? 1.0 : 0.0);
+
+    GridCache::SaveArray(sf, group + "Vp", Vp, nr, n1*n2);
+    GridCache::SaveArray(sf, group + "Vp_fr", Vp_fr, nr+1, n1*n2);
+    GridCache::SaveArray(sf, group + "Vp_f1", Vp_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "Vp_f2", Vp_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "VpOverP2AtZero", VpOverP2AtZero, nr, n2);
+
+    GridCache::SaveArray(sf, group + "isTrapped", isTrapped, nr, n1*n2);
+    GridCache::SaveArray(sf, group + "isTrapped_fr", isTrapped_fr, nr+1, n1*n2);
+    GridCache::SaveArray(sf, group + "isTrapped_f1", isTrapped_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "isTrapped_f2", isTrapped_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "theta_b1", theta_b1, nr, n1*n2);
+    GridCache::SaveArray(sf, group + "theta_b1_fr", theta_b1_fr, nr+1, n1*n2);
+    GridCache::SaveArray(sf, group + "theta_b1_f1", theta_b1_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "theta_b1_f2", theta_b1_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "theta_b2", theta_b2, nr, n1*n2);
+    GridCache::SaveArray(sf, group + "theta_b2_fr", theta_b2_fr, nr+1, n1*n2);
+    GridCache::SaveArray(sf, group + "theta_b2_f1", theta_b2_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "theta_b2_f2", theta_b2_f2, nr, n1*(n2+1));
+
+    GridCache::SaveArray(sf, group + "BA_xi_fr", BA_xi_fr, nr+1, n1*n2);
+    GridCache::SaveArray(sf, group + "BA_xi_f1", BA_xi_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "BA_xi_f2", BA_xi_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "BA_xi2OverB_f1", BA_xi2OverB_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "BA_xi2OverB_f2", BA_xi2OverB_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "BA_B3_f1", BA_B3_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "BA_B3_f2", BA_B3_f2, nr, n1*(n2+1));
+    GridCache::SaveArray(sf, group + "BA_xi2B2_f1", BA_xi2B2_f1, nr, (n1+1)*n2);
+    GridCache::SaveArray(sf, group + "BA_xi2B2_f2", BA_xi2B2_f2, nr, n1*(n2+1));
+
+    GridCache::SaveArray(sf, group + "avalancheDeltaHat", avalancheDeltaHat, nr, n1*n2);
+    GridCache::SaveArray(sf, group + "avalancheDeltaHatNegativePitch", avalancheDeltaHatNegativePitch, nr, n1*n2);
+}
+
+/**
+ * Load the trapping parameters and bounce averaged quantities
+ * of this grid from the given geometry cache file (previously
+ * written by 'SaveGeometryCache()').
+ *
+ * sf:   SFile object to read data from.
+ * path: Group in the file to read data from.
+ */
+void Grid::LoadGeometryCache(SFile *sf, const string& path){
+    const string group = path + "/";
+    const len_t nr = GetNr();
+    const len_t n1 = GetNp1(0), n2 = GetNp2(0);
+
+    SetVp(
+        GridCache::LoadArray(sf, group + "Vp", nr, n1*n2),
+        GridCache::LoadArray(sf, group + "Vp_fr", nr+1, n1*n2),
+        GridCache::LoadArray(sf, group + "Vp_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "Vp_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "VpOverP2AtZero", nr, n2)
+    );
+
+    SetBounceParameters(
+        (sf->GetScalar(group + "hasTrapped") != 0),
+        GridCache::LoadBoolArray(sf, group + "isTrapped", nr, n1*n2),
+        GridCache::LoadBoolArray(sf, group + "isTrapped_fr", nr+1, n1*n2),
+        GridCache::LoadBoolArray(sf, group + "isTrapped_f1", nr, (n1+1)*n2),
+        GridCache::LoadBoolArray(sf, group + "isTrapped_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "theta_b1", nr, n1*n2),
+        GridCache::LoadArray(sf, group + "theta_b1_fr", nr+1, n1*n2),
+        GridCache::LoadArray(sf, group + "theta_b1_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "theta_b1_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "theta_b2", nr, n1*n2),
+        GridCache::LoadArray(sf, group + "theta_b2_fr", nr+1, n1*n2),
+        GridCache::LoadArray(sf, group + "theta_b2_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "theta_b2_f2", nr, n1*(n2+1))
+    );
+
+    InitializeBAvg(
+        GridCache::LoadArray(sf, group + "BA_xi_fr", nr+1, n1*n2),
+        GridCache::LoadArray(sf, group + "BA_xi_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "BA_xi_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "BA_xi2OverB_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "BA_xi2OverB_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "BA_B3_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "BA_B3_f2", nr, n1*(n2+1)),
+        GridCache::LoadArray(sf, group + "BA_xi2B2_f1", nr, (n1+1)*n2),
+        GridCache::LoadArray(sf, group + "BA_xi2B2_f2", nr, n1*(n2+1))
+    );
+
+    DeallocateAvalancheDeltaHat();
+    avalancheDeltaHat = GridCache::LoadArray(sf, group + "avalancheDeltaHat", nr, n1*n2);
+    avalancheDeltaHatNegativePitch = GridCache::LoadArray(sf, group + "avalancheDeltaHatNegativePitch", nr, n1*n2);
+}
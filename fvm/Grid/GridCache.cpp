@@ -0,0 +1,266 @@
+/**
+ * Implementation of an on-disk cache of the grid geometry.
+ *
+ * Evaluating the flux surface averages, bounce averages and trapping
+ * parameters of a grid requires a large number of numerical
+ * quadratures and root solves, which can dominate the initialization
+ * of a simulation. When many simulations are run with identical grids
+ * (e.g. in parameter scans), these quantities can instead be stored
+ * in an HDF5 file by the first simulation and loaded by all later
+ * simulations. The name of the file should identify the grid
+ * settings (this is the responsibility of the caller, see
+ * SimulationGenerator::ConstructGridCache()).
+ *
+ * If the file exists when the cache is created, data is read from
+ * it. Otherwise, data is written to a temporary file, which is moved
+ * to its final location when the cache is closed, so that a cache
+ * file is never seen partially written by another simulation. If the
+ * cache is destroyed without being closed (e.g. because building the
+ * grids failed), the temporary file is removed instead.
+ */
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "FVM/Grid/GridCache.hpp"
+
+
+using namespace std;
+using namespace DREAM::FVM;
+
+
+/**
+ * Constructor.
+ *
+ * filename: Name of cache file to read from or write to.
+ */
+GridCache::GridCache(const string& filename) : filename(filename) {
+    FILE *f = fopen(filename.c_str(), "r");
+    if (f != nullptr) {
+        fclose(f);
+        this->sfRead = SFile::Create(filename, SFILE_MODE_READ);
+    }
+}
+
+/**
+ * Destructor. If the cache has not been closed, any data
+ * written to it is discarded (since it may be incomplete),
+ * and the temporary file is removed. This method never throws.
+ */
+GridCache::~GridCache() {
+    try {
+        if (this->sfRead != nullptr)
+            this->sfRead->Close();
+    } catch (...) {}
+    delete this->sfRead;
+
+    if (this->sfWrite != nullptr) {
+        try {
+            this->sfWrite->Close();
+        } catch (...) {}
+        delete this->sfWrite;
+
+        std::remove(this->tmpfilename.c_str());
+    }
+}
+
+/**
+ * Close the cache file. If data has been written to the cache,
+ * the temporary file is moved to its final location.
+ */
+void GridCache::Close() {
+    if (this->sfRead != nullptr) {
+        this->sfRead->Close();
+        delete this->sfRead;
+        this->sfRead = nullptr;
+    }
+
+    if (this->sfWrite != nullptr) {
+        this->sfWrite->Close();
+        delete this->sfWrite;
+        this->sfWrite = nullptr;
+
+        if (std::rename(tmpfilename.c_str(), filename.c_str()) != 0)
+            throw GridCacheException(
+                "Unable to move grid cache file '%s' to '%s'.",
+                tmpfilename.c_str(), filename.c_str()
+            );
+    }
+}
+
+/**
+ * Returns true if the cache file contains data for the
+ * named grid.
+ */
+bool GridCache::Contains(const string& name) {
+    return (this->sfRead != nullptr && this->sfRead->HasVariable(name + "/nr"));
+}
+
+/**
+ * Returns the SFile object to write cache data to, creating
+ * the (temporary) cache file if necessary. The process ID is
+ * included in the temporary file name so that simultaneous
+ * simulations with the same grid do not overwrite each
+ * other's files.
+ */
+SFile *GridCache::GetWriter() {
+    if (this->sfWrite == nullptr) {
+        this->tmpfilename = this->filename + "." + to_string(getpid()) + ".tmp";
+        this->sfWrite = SFile::Create(this->tmpfilename, SFILE_MODE_WRITE);
+    }
+
+    return this->sfWrite;
+}
+
+/**
+ * Verify that the number of radial grid points of the named
+ * grid in the cache file matches the expected value.
+ */
+void GridCache::CheckNr(const string& name, const len_t nr) {
+    len_t n = (len_t)this->sfRead->GetScalar(name + "/nr");
+    if (n != nr)
+        throw GridCacheException(
+            "%s: Invalid number of radial grid points in grid cache file '%s': "
+            LEN_T_PRINTF_FMT ". Expected " LEN_T_PRINTF_FMT ".",
+            name.c_str(), filename.c_str(), n, nr
+        );
+}
+
+/**
+ * Load the flux surface averaged quantities of the given
+ * radial grid from the cache.
+ */
+void GridCache::Load(RadialGrid *rg) {
+    CheckNr(RADIALGRID, rg->GetNr());
+    rg->LoadGeometryCache(this->sfRead, RADIALGRID);
+}
+
+/**
+ * Load the bounce averaged quantities of the given grid from
+ * the cache.
+ *
+ * name: Name of the grid in the cache file.
+ */
+void GridCache::Load(Grid *g, const string& name) {
+    CheckNr(name, g->GetNr());
+    g->LoadGeometryCache(this->sfRead, name);
+}
+
+/**
+ * Store the flux surface averaged quantities of the given
+ * radial grid in the cache. Nothing is written if the cache
+ * was read from an existing file, or if the radial grid has
+ * already been stored.
+ */
+void GridCache::Save(RadialGrid *rg) {
+    if (IsHit() || this->stored.count(RADIALGRID))
+        return;
+
+    SFile *sf = GetWriter();
+    sf->CreateStruct(RADIALGRID);
+    rg->SaveGeometryCache(sf, RADIALGRID);
+    sf->WriteScalar(string(RADIALGRID) + "/nr", (real_t)rg->GetNr());
+
+    this->stored.insert(RADIALGRID);
+}
+
+/**
+ * Store the bounce averaged quantities of the given grid in
+ * the cache.
+ *
+ * name: Name of the grid in the cache file.
+ */
+void GridCache::Save(Grid *g, const string& name) {
+    if (IsHit() || this->stored.count(name))
+        return;
+
+    SFile *sf = GetWriter();
+    sf->CreateStruct(name);
+    g->SaveGeometryCache(sf, name);
+    sf->WriteScalar(name + "/nr", (real_t)g->GetNr());
+
+    this->stored.insert(name);
+}
+
+
+/*******************************
+ * HELPER ROUTINES             *
+ *******************************/
+/**
+ * Load a list of 'n' real numbers from the given file.
+ */
+real_t *GridCache::LoadList(SFile *sf, const string& name, const len_t n) {
+    sfilesize_t nv;
+    real_t *v = sf->GetList(name, &nv);
+
+    if (nv != n) {
+        delete [] v;
+        throw GridCacheException(
+            "%s: Invalid number of elements in grid cache: " LEN_T_PRINTF_FMT
+            ". Expected " LEN_T_PRINTF_FMT ".",
+            name.c_str(), (len_t)nv, n
+        );
+    }
+
+    return v;
+}
+
+/**
+ * Load an array of size nr x n, stored as a flat list by
+ * 'SaveArray()', from the given file.
+ */
+real_t **GridCache::LoadArray(SFile *sf, const string& name, const len_t nr, const len_t n) {
+    real_t *v = LoadList(sf, name, nr*n);
+    real_t **arr = new real_t*[nr];
+    for (len_t ir = 0; ir < nr; ir++) {
+        arr[ir] = new real_t[n];
+        for (len_t i = 0; i < n; i++)
+            arr[ir][i] = v[ir*n + i];
+    }
+
+    delete [] v;
+    return arr;
+}
+
+/**
+ * Load a boolean array of size nr x n from the given file.
+ */
+bool **GridCache::LoadBoolArray(SFile *sf, const string& name, const len_t nr, const len_t n) {
+    real_t *v = LoadList(sf, name, nr*n);
+    bool **arr = new bool*[nr];
+    for (len_t ir = 0; ir < nr; ir++) {
+        arr[ir] = new bool[n];
+        for (len_t i = 0; i < n; i++)
+            arr[ir][i] = (v[ir*n + i] != 0);
+    }
+
+    delete [] v;
+    return arr;
+}
+
+/**
+ * Store an array of size nr x n as a flat list in the
+ * given file.
+ */
+void GridCache::SaveArray(SFile *sf, const string& name, const real_t *const* arr, const len_t nr, const len_t n) {
+    real_t *v = new real_t[nr*n];
+    for (len_t ir = 0; ir < nr; ir++)
+        for (len_t i = 0; i < n; i++)
+            v[ir*n + i] = arr[ir][i];
+
+    sf->WriteList(name, v, nr*n);
+    delete [] v;
+}
+
+/**
+ * Store a boolean array of size nr x n in the given file.
+ */
+void GridCache::SaveArray(SFile *sf, const string& name, const bool *const* arr, const len_t nr, const len_t n) {
+    real_t *v = new real_t[nr*n];
+    for (len_t ir = 0; ir < nr; ir++)
+        for (len_t i = 0; i < n; i++)
+            v[ir*n + i] = arr[ir][i] ? 1 : 0;
+
+    sf->WriteList(name, v, nr*n);
+    delete [] v;
+}
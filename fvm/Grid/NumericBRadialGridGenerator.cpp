@@ -452,6 +452,21 @@ bool NumericBRadialGridGenerator::Rebuild(const real_t, RadialGrid *rGrid) {
 		this->Rp
 	);
 
+    // Tabulate the inverse flux-surface mapping in the box
+    // enclosing the plasma (with some margin)
+    const real_t a = this->r_f[GetNr()];
+    real_t Xmin = 0, Xmax = 0, Ymin = 0, Ymax = 0;
+    for (len_t j = 0; j < this->ntheta; j++) {
+        real_t
+            X = gsl_spline2d_eval(this->spline_R, a, this->theta[j], this->acc_r, this->acc_theta) - this->Rp,
+            Y = gsl_spline2d_eval(this->spline_Z, a, this->theta[j], this->acc_r, this->acc_theta) - this->Zp;
+
+        Xmin = std::min(Xmin, X); Xmax = std::max(Xmax, X);
+        Ymin = std::min(Ymin, Y); Ymax = std::max(Ymax, Y);
+    }
+    const real_t margin = 0.05*std::max(Xmax-Xmin, Ymax-Ymin);
+    BuildInverseMapping(Xmin-margin, Xmax+margin, Ymin-margin, Ymax+margin, a);
+
     this->isBuilt = true;
     return true;
 }
@@ -474,13 +489,13 @@ real_t NumericBRadialGridGenerator::JacobianAtTheta(
 ) {
     real_t t = this->_thetaBounded(theta);
 
-    real_t dRdr = gsl_spline2d_eval_deriv_x(this->spline_R, r, t, this->acc_r, this->acc_theta);
-    real_t dRdt = gsl_spline2d_eval_deriv_y(this->spline_R, r, t, this->acc_r, this->acc_theta);
+    real_t dRdr = gsl_spline2d_eval_deriv_x(this->spline_R, r, t, nullptr, nullptr);
+    real_t dRdt = gsl_spline2d_eval_deriv_y(this->spline_R, r, t, nullptr, nullptr);
 
-    real_t dZdr = gsl_spline2d_eval_deriv_x(this->spline_Z, r, t, this->acc_r, this->acc_theta);
-    real_t dZdt = gsl_spline2d_eval_deriv_y(this->spline_Z, r, t, this->acc_r, this->acc_theta);
+    real_t dZdr = gsl_spline2d_eval_deriv_x(this->spline_Z, r, t, nullptr, nullptr);
+    real_t dZdt = gsl_spline2d_eval_deriv_y(this->spline_Z, r, t, nullptr, nullptr);
 
-    real_t R    = gsl_spline2d_eval(this->spline_R, r, t, this->acc_r, this->acc_theta);
+    real_t R    = gsl_spline2d_eval(this->spline_R, r, t, nullptr, nullptr);
 
     if (_R != nullptr) *_R = R;
     if (_dRdt != nullptr) *_dRdt = dRdt;
@@ -499,7 +514,7 @@ real_t NumericBRadialGridGenerator::ROverR0AtTheta(
     const real_t r, const real_t theta
 ) {
     real_t t = this->_thetaBounded(theta);
-    return gsl_spline2d_eval(this->spline_R, r, t, this->acc_r, this->acc_theta) / this->Rp;
+    return gsl_spline2d_eval(this->spline_R, r, t, nullptr, nullptr) / this->Rp;
 }
 
 /**
@@ -539,7 +554,7 @@ void NumericBRadialGridGenerator::EvaluateGeometricQuantities(
     ROverR0  = R/this->Rp;
     NablaR2  = r==0 ? 0 : (R*R/(Jacobian*Jacobian) * (dRdt*dRdt + dZdt*dZdt));
 
-    B = gsl_spline2d_eval(this->spline_B, r, t, this->acc_r, this->acc_theta);
+    B = gsl_spline2d_eval(this->spline_B, r, t, nullptr, nullptr);
 }
 
 /**
@@ -548,7 +563,7 @@ void NumericBRadialGridGenerator::EvaluateGeometricQuantities(
  */
 real_t NumericBRadialGridGenerator::EvalB(const real_t r, const real_t theta) {
     real_t t    = this->_thetaBounded(theta);
-    return gsl_spline2d_eval(this->spline_B, r, t, this->acc_r, this->acc_theta);
+    return gsl_spline2d_eval(this->spline_B, r, t, nullptr, nullptr);
 }
 
 real_t NumericBRadialGridGenerator::BAtTheta(const len_t ir, const real_t theta) {
@@ -564,6 +579,10 @@ real_t NumericBRadialGridGenerator::BAtTheta_f(const len_t ir, const real_t thet
  *
  * (The Cartesian coordinate system is oriented such that x and y span
  * the poloidal plane. The origin of x and y is the magnetic axis.)
+ *
+ * Inside the plasma, 'r' is obtained from the inverse mapping table
+ * built in Rebuild() and refined using Newton's method. Elsewhere (or
+ * if the Newton iteration fails), a bisection scheme is used.
  */
 void NumericBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t *r, real_t *theta, real_t *phi,
     real_t x, real_t y, real_t z, real_t lengthScale, real_t startingGuessR
@@ -592,9 +611,20 @@ void NumericBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t *r, real_t *t
         theta_tmp+=2*M_PI;
         
     *theta=theta_tmp;
-        
 
-	// Bisection to find radial coordinate corresponding
+    // Use the inverse mapping table (if available) to get an
+    // accurate starting guess, and polish it with a few Newton
+    // iterations...
+    real_t X = (R >= Rp ? 1 : -1) * hypot(rhox, rhoz);
+    r_tmp = 0;
+    if (InverseMappingGuess(X, rhoy, r_tmp) &&
+        FindMinorRadiusNewton(rho, *theta, lengthScale, r_tmp)) {
+        *r = r_tmp;
+        *phi = atan2(z,(Rp+x));
+        return;
+    }
+
+	// ...otherwise, use bisection to find radial coordinate corresponding
 	// to 'r' at 'theta'...
 	// We make a guess for a valid search intervall of startingGuessR+/-lengthScale, 
 	// and check if it has to be expanded before actually starting with the bisection
@@ -664,40 +694,68 @@ void NumericBRadialGridGenerator::GetRThetaPhiFromCartesian(real_t *r, real_t *t
         *r=this->r_f[GetNr()]+1e-2; // Arbitrary value outside the radial grid
     }
 
-	// Newton solver (disabled for now)
-	/*r_tmp=startingGuessR;
-	do {
-	    real_t
-	        xx = gsl_spline2d_eval(
-	            this->spline_R, r_tmp, *theta,
-	            this->acc_r, this->acc_theta
-	        ),
-	        yy = gsl_spline2d_eval(
-	            this->spline_Z, r_tmp, *theta,
-	            this->acc_r, this->acc_theta
-	        );
-	        
-	    // note that r_tmp is here the x-variable given to gsl_spline2d_eval_deriv_x, 
-	    // so that it should really be the x-derivative which is evaluated for both xx and yy
-	    real_t
-	        dxxdr = gsl_spline2d_eval_deriv_x(
-	            this->spline_R, r_tmp, *theta,
-	            this->acc_r, this->acc_theta
-	        ),
-	        dyydr = gsl_spline2d_eval_deriv_x(
-	            this->spline_Z, r_tmp, *theta,
-	            this->acc_r, this->acc_theta
-	        );
-	        
-	    real_t rho_newton=hypot(xx,yy);
-	    r_tmp=r_tmp-(rho_newton-rho)/((xx*dxxdr+yy*dyydr)/rho_newton);
-	} while(std::abs(rho_newton-rho) > lengthScale * tolFactor);
-	*r=r_tmp;*/
 	
 	*phi = atan2(z,(Rp+x)); 
 	
 }
 
+/**
+ * Solve for the minor radius coordinate 'r' of the point at
+ * distance 'rho' from the magnetic axis, at poloidal angle
+ * 'theta', using Newton's method. On entry, 'r' should contain
+ * a starting guess close to the solution.
+ *
+ * Returns false if the iteration did not converge to a radius
+ * inside the plasma, in which case the caller should fall back
+ * on bisection.
+ */
+bool NumericBRadialGridGenerator::FindMinorRadiusNewton(
+    const real_t rho, const real_t theta, const real_t lengthScale, real_t &r
+) {
+    const len_t MAX_ITERATIONS = 10;
+    real_t r_tmp = r;
+
+    for (len_t iter = 0; iter < MAX_ITERATIONS; iter++) {
+        real_t
+            xx = gsl_spline2d_eval(
+                this->spline_R, r_tmp, theta,
+                this->acc_r, this->acc_theta
+            ) - Rp,
+            yy = gsl_spline2d_eval(
+                this->spline_Z, r_tmp, theta,
+                this->acc_r, this->acc_theta
+            ) - this->Zp,
+            dxxdr = gsl_spline2d_eval_deriv_x(
+                this->spline_R, r_tmp, theta,
+                this->acc_r, this->acc_theta
+            ),
+            dyydr = gsl_spline2d_eval_deriv_x(
+                this->spline_Z, r_tmp, theta,
+                this->acc_r, this->acc_theta
+            );
+
+        real_t rho_newton = hypot(xx, yy);
+        if (rho_newton == 0)
+            return false;
+
+        real_t drhodr = (xx*dxxdr + yy*dyydr) / rho_newton;
+        if (!(drhodr > 0))
+            return false;
+
+        real_t dr = (rho_newton-rho) / drhodr;
+        r_tmp -= dr;
+
+        if (r_tmp < this->input_r[0] || r_tmp >= this->r_f[GetNr()])
+            return false;
+        else if (std::abs(dr) <= lengthScale*CartesianCoordinateTol) {
+            r = r_tmp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * Calculates the gradient of the minor radius coordinate 'r' in cartesian coordinates
  */
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <vector>
+#include "FVM/Grid/GridCache.hpp"
 #include "FVM/Grid/RadialGrid.hpp"
 #include "FVM/Grid/RadialGridGenerator.hpp"
 #include "gsl/gsl_integration.h"
@@ -76,8 +77,20 @@ bool RadialGrid::Rebuild(const real_t t) {
  */
 void RadialGrid::RebuildJacobians(){ 
     this->generator->RebuildJacobians(this);
-    fluxSurfaceAverager->Rebuild();
-    RebuildFluxSurfaceAveragedQuantities();
+
+    // Load flux surface averages from the geometry cache if
+    // they have been stored there by a previous run
+    bool cached = (geometryCache != nullptr && geometryCache->Contains(GridCache::RADIALGRID));
+    fluxSurfaceAverager->Rebuild(!cached);
+
+    if(cached){
+        geometryCache->Load(this);
+        RebuildToroidalFlux();
+    } else {
+        RebuildFluxSurfaceAveragedQuantities();
+        if(geometryCache != nullptr)
+            geometryCache->Save(this);
+    }
 }
 
 
@@ -194,6 +207,14 @@ void RadialGrid::RebuildFluxSurfaceAveragedQuantities(){
     InitializeFSAvg(effectivePassingFraction,effectivePassingFraction_f,
         FSA_B,FSA_B_f,FSA_B2,FSA_B2_f,FSA_1OverR2, FSA_1OverR2_f,FSA_nablaR2OverR2,FSA_nablaR2OverR2_f);
 
+    RebuildToroidalFlux();
+}
+
+/**
+ * Calculate and store the toroidal flux. Should be called
+ * after the flux surface averages have been set.
+ */
+void RadialGrid::RebuildToroidalFlux(){
     // set toroidal flux psi_t defined by dpsi_t/dpsi_p = qR0 (safety factor)
     // or equivalently as the toroidal magnetic field integrated over a 
     // poloidal cross section
@@ -313,3 +334,56 @@ void RadialGrid::DeallocateFSAvg(){
     delete [] this->FSA_1OverR2_f;
 }
 
+
+
+/**
+ * Write the flux surface averaged quantities of this grid to
+ * the given geometry cache file.
+ *
+ * sf:   SFile object to write data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void RadialGrid::SaveGeometryCache(SFile *sf, const string& path) {
+    const string group = path + "/";
+
+    sf->WriteList(group + "VpVol", this->VpVol, nr);
+    sf->WriteList(group + "VpVol_f", this->VpVol_f, nr+1);
+    sf->WriteList(group + "effectivePassingFraction", this->effectivePassingFraction, nr);
+    sf->WriteList(group + "FSA_B", this->FSA_B, nr);
+    sf->WriteList(group + "FSA_B_f", this->FSA_B_f, nr+1);
+    sf->WriteList(group + "FSA_B2", this->FSA_B2, nr);
+    sf->WriteList(group + "FSA_B2_f", this->FSA_B2_f, nr+1);
+    sf->WriteList(group + "FSA_1OverR2", this->FSA_1OverR2, nr);
+    sf->WriteList(group + "FSA_1OverR2_f", this->FSA_1OverR2_f, nr+1);
+    sf->WriteList(group + "FSA_nablaR2OverR2", this->FSA_nablaR2OverR2, nr);
+    sf->WriteList(group + "FSA_nablaR2OverR2_f", this->FSA_nablaR2OverR2_f, nr+1);
+}
+
+/**
+ * Load the flux surface averaged quantities of this grid from
+ * the given geometry cache file (previously written by
+ * 'SaveGeometryCache()').
+ *
+ * sf:   SFile object to read data from.
+ * path: Group in the file to read data from.
+ */
+void RadialGrid::LoadGeometryCache(SFile *sf, const string& path) {
+    const string group = path + "/";
+
+    real_t
+        *VpVol   = GridCache::LoadList(sf, group + "VpVol", nr),
+        *VpVol_f = GridCache::LoadList(sf, group + "VpVol_f", nr+1);
+    SetVpVol(VpVol, VpVol_f);
+
+    InitializeFSAvg(
+        GridCache::LoadList(sf, group + "effectivePassingFraction", nr), nullptr,
+        GridCache::LoadList(sf, group + "FSA_B", nr),
+        GridCache::LoadList(sf, group + "FSA_B_f", nr+1),
+        GridCache::LoadList(sf, group + "FSA_B2", nr),
+        GridCache::LoadList(sf, group + "FSA_B2_f", nr+1),
+        GridCache::LoadList(sf, group + "FSA_1OverR2", nr),
+        GridCache::LoadList(sf, group + "FSA_1OverR2_f", nr+1),
+        GridCache::LoadList(sf, group + "FSA_nablaR2OverR2", nr),
+        GridCache::LoadList(sf, group + "FSA_nablaR2OverR2_f", nr+1)
+    );
+}
@@ -16,6 +16,9 @@ RadialGridGenerator::RadialGridGenerator(const len_t nr) : nr(nr) {
 
 RadialGridGenerator::~RadialGridGenerator(){
     gsl_min_fminimizer_free(gsl_fmin);
+
+    if (this->invMapR != nullptr)
+        delete [] this->invMapR;
 }
 
 
@@ -244,3 +247,94 @@ real_t RadialGridGenerator::FindClosestApproach(
     return r;
 }
 
+
+/**
+ * Tabulate the minor radius coordinate 'r' on a regular grid
+ * in the poloidal plane, spanning Xmin <= X <= Xmax and
+ * Ymin <= Y <= Ymax (with X = R-R0 and Y = Z). Each point
+ * is evaluated using the (accurate, but expensive)
+ * GetRThetaPhiFromCartesian() of the derived class, with the
+ * neighbouring point used as starting guess.
+ *
+ * rmax: Largest value of 'r' inside which the table may be
+ *       used (usually the plasma edge).
+ */
+void RadialGridGenerator::BuildInverseMapping(
+    const real_t Xmin, const real_t Xmax,
+    const real_t Ymin, const real_t Ymax, const real_t rmax
+) {
+    const len_t N = INVERSE_MAPPING_NPOINTS;
+
+    // Make sure the old table is not used while the new one is built
+    if (this->invMapR != nullptr) {
+        delete [] this->invMapR;
+        this->invMapR = nullptr;
+    }
+
+    real_t *rTable = new real_t[N*N];
+    const real_t dX = (Xmax-Xmin) / (N-1);
+    const real_t dY = (Ymax-Ymin) / (N-1);
+    const real_t lengthScale = std::max(dX, dY);
+
+    real_t r, theta, phi;
+    for (len_t iy = 0; iy < N; iy++) {
+        for (len_t ix = 0; ix < N; ix++) {
+            real_t guess = 0;
+            if (ix > 0)
+                guess = rTable[iy*N + ix-1];
+            else if (iy > 0)
+                guess = rTable[(iy-1)*N];
+
+            this->GetRThetaPhiFromCartesian(
+                &r, &theta, &phi, Xmin + ix*dX, Ymin + iy*dY, 0,
+                lengthScale, std::min(guess, rmax)
+            );
+            rTable[iy*N + ix] = r;
+        }
+    }
+
+    this->invMapXmin = Xmin;
+    this->invMapYmin = Ymin;
+    this->invMapDX   = dX;
+    this->invMapDY   = dY;
+    this->invMapRmax = rmax;
+    this->invMapR    = rTable;
+}
+
+/**
+ * Estimate the minor radius coordinate 'r' of the point (X,Y)
+ * in the poloidal plane (with X = R-R0 and Y = Z) by
+ * bilinear interpolation in the inverse mapping table.
+ *
+ * Returns false if no table has been built, or if the point
+ * is not surrounded by table points inside the plasma (in which
+ * case 'r' is left untouched).
+ */
+bool RadialGridGenerator::InverseMappingGuess(
+    const real_t X, const real_t Y, real_t &r
+) const {
+    if (this->invMapR == nullptr)
+        return false;
+
+    const len_t N = INVERSE_MAPPING_NPOINTS;
+    const real_t sx = (X-this->invMapXmin) / this->invMapDX;
+    const real_t sy = (Y-this->invMapYmin) / this->invMapDY;
+
+    if (sx < 0 || sy < 0 || sx >= N-1 || sy >= N-1)
+        return false;
+
+    const len_t ix = (len_t)sx, iy = (len_t)sy;
+    const real_t
+        r00 = this->invMapR[iy*N + ix],
+        r10 = this->invMapR[iy*N + ix+1],
+        r01 = this->invMapR[(iy+1)*N + ix],
+        r11 = this->invMapR[(iy+1)*N + ix+1];
+
+    if (r00 >= invMapRmax || r10 >= invMapRmax || r01 >= invMapRmax || r11 >= invMapRmax)
+        return false;
+
+    const real_t wx = sx-ix, wy = sy-iy;
+    r = (1-wy)*((1-wx)*r00 + wx*r10) + wy*((1-wx)*r01 + wx*r11);
+
+    return true;
+}
@@ -10,6 +10,116 @@ using namespace DREAM::FVM;
 using namespace std;
 
 
+// Name under which the ordering is attached to the matrix
+#define ORDERING_KEY "DREAM_ordering"
+
+/**
+ * PETSc matrix ordering routine which returns the permutation
+ * attached to the matrix by 'MatrixInverter::SetOperator()'. If
+ * no permutation is attached, the natural ordering is used.
+ */
+static PetscErrorCode MatGetOrdering_DREAM(Mat mat, MatOrderingType, IS *irow, IS *icol) {
+    IS perm = nullptr;
+    PetscObjectQuery((PetscObject)mat, ORDERING_KEY, (PetscObject*)&perm);
+
+    if (perm == nullptr)
+        return MatGetOrdering(mat, MATORDERINGNATURAL, irow, icol);
+
+    ISDuplicate(perm, irow);
+    ISDuplicate(perm, icol);
+
+    return 0;
+}
+
+/**
+ * Destructor.
+ */
+MatrixInverter::~MatrixInverter() {
+    if (this->ordering != nullptr)
+        ISDestroy(&this->ordering);
+}
+
+
+/**
+ * Set the matrix to invert on the KSP object of this inverter.
+ * If 'reuseFactorization' is set, the factorization of the
+ * previously inverted matrix is kept and the new values of the
+ * matrix are ignored. When a different matrix object is given
+ * than in the previous call (e.g. after the jacobian matrix has
+ * been reallocated), any previous factorization (including a
+ * reused ordering) is discarded.
+ *
+ * A: Matrix to invert.
+ */
+void MatrixInverter::SetOperator(Matrix *A) {
+    if (this->operatorMat != nullptr && A->mat() != this->operatorMat) {
+        PC pc;
+        KSPGetPC(this->ksp, &pc);
+        PCReset(pc);
+
+        // A factorization of another matrix can not be reused
+        this->reuseFactorization = false;
+    }
+
+    // Make the ordering available to 'MatGetOrdering_DREAM()'
+    if (this->ordering != nullptr)
+        PetscObjectCompose((PetscObject)A->mat(), ORDERING_KEY, (PetscObject)this->ordering);
+
+    KSPSetOperators(this->ksp, A->mat(), A->mat());
+    KSPSetReusePreconditioner(this->ksp, this->reuseFactorization ? PETSC_TRUE : PETSC_FALSE);
+
+    this->operatorMat = A->mat();
+}
+
+/**
+ * Set the ordering to use for the matrix rows and columns when
+ * factorizing matrices with this inverter. Element 'i' of 'perm'
+ * is the index of the row/column of the original matrix which
+ * should be placed in position 'i' of the permuted matrix. If
+ * 'perm' is empty, the default ordering is used.
+ * Inverters which do not support external orderings ignore
+ * this setting.
+ *
+ * perm: Permutation of the matrix rows/columns.
+ */
+void MatrixInverter::SetOrdering(const vector<PetscInt>& perm) {
+    static bool registered = false;
+
+    if (!this->SupportsOrdering())
+        return;
+
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+
+    // Any previous factorization used a different ordering
+    if (this->operatorMat != nullptr) {
+        PCReset(pc);
+        this->reuseFactorization = false;
+        this->operatorMat = nullptr;
+    }
+
+    if (this->ordering != nullptr) {
+        ISDestroy(&this->ordering);
+
+        // Restore the default ordering of PETSc
+        if (perm.empty())
+            PCFactorSetMatOrderingType(pc, MATORDERINGND);
+    }
+
+    if (perm.empty())
+        return;
+
+    if (!registered) {
+        MatOrderingRegister(MATORDERING_DREAM, MatGetOrdering_DREAM);
+        registered = true;
+    }
+
+    ISCreateGeneral(PETSC_COMM_SELF, (PetscInt)perm.size(), perm.data(), PETSC_COPY_VALUES, &this->ordering);
+    ISSetPermutation(this->ordering);
+
+    PCFactorSetMatOrderingType(pc, MATORDERING_DREAM);
+}
+
 /**
  * Print info about the most recently factored matrix.
  */
@@ -83,6 +83,7 @@ void QuantityData::AllocateData() {
     this->idxVec = new PetscInt[this->nElements];
 
     this->nOldSaved = 0;
+    this->nOldValid = 0;
 
     for (len_t i = 0; i < nElements; i++)
         this->data[i] = 0;
@@ -112,7 +113,10 @@ bool QuantityData::CanRollbackSaveStep() const {
  */
 void QuantityData::SaveStep(const real_t t, bool trueSave) {
     // Move old data...
-    len_t nMin = min(this->nOldSaved, N_SAVE_OLD_STEPS-1);
+    // (all valid steps are moved, and not only those which can be
+    // rolled back, so that 'olddata' always holds a consecutive
+    // history of the solution)
+    len_t nMin = min(this->nOldValid, N_SAVE_OLD_STEPS-1);
     for (len_t i = nMin; i > 0; i--) {
         for (len_t j = 0; j < this->nElements; j++)
             this->olddata[i][j] = this->olddata[i-1][j];
@@ -122,6 +126,8 @@ void QuantityData::SaveStep(const real_t t, bool trueSave) {
 
     if (this->nOldSaved < N_SAVE_OLD_STEPS)
         this->nOldSaved++;
+    if (this->nOldValid < N_SAVE_OLD_STEPS)
+        this->nOldValid++;
 
     // Copy previous solution...
     for (len_t i = 0; i < this->nElements; i++)
@@ -146,6 +152,24 @@ void QuantityData::SaveStep(const real_t t, bool trueSave) {
     }
 }
 
+/**
+ * Release the memory used by the steps saved to the 'store'
+ * array (e.g. after they have been written to file). The data
+ * in the current and previous time steps is not affected.
+ *
+ * keep: Number of steps to keep at the beginning of the 'store'
+ *       array (set to 1 to keep the initial value).
+ */
+void QuantityData::ClearSavedSteps(const len_t keep) {
+    for (len_t i = keep; i < this->store.size(); i++)
+        delete [] this->store[i];
+
+    if (this->store.size() > keep) {
+        this->store.resize(keep);
+        this->times.resize(keep);
+    }
+}
+
 /**
  * Roll back a previously saved time step. This method is
  * the inverse of the method 'SaveStep()' with 'trueSave = false'.
@@ -157,7 +181,7 @@ void QuantityData::RollbackSaveStep() {
     for (len_t i = 0; i < this->nElements; i++)
         this->data[i] = this->olddata[0][i];
 
-    len_t nMin = min(this->nOldSaved, this->N_SAVE_OLD_STEPS);
+    len_t nMin = min(this->nOldValid, this->N_SAVE_OLD_STEPS);
     for (len_t i = 0; i < nMin-1; i++) {
         for (len_t j = 0; j < this->nElements; j++)
             this->olddata[i][j] = this->olddata[i+1][j];
@@ -166,6 +190,7 @@ void QuantityData::RollbackSaveStep() {
     }
 
     this->nOldSaved--;
+    this->nOldValid--;
 }
 
 /**
@@ -419,26 +444,8 @@ void QuantityData::SaveSFile_internal(
         }
     }
 
-    sfilesize_t ndims = 1;
     sfilesize_t dims[5] = {nt,0,0,0,0};
-
-    if (this->nMultiples > 1) dims[ndims++] = this->nMultiples;
-    //if (nr > 1 || np2 > 1 || np1 > 1) dims[ndims++] = nr;
-
-    // Always include radial dimension
-    if (this->fluxGridType == FLUXGRIDTYPE_RADIAL)
-        dims[ndims++] = nr+1;
-    else dims[ndims++] = nr;
-
-    if (np2 > 1 || np1 > 1) {
-        if (this->fluxGridType == FLUXGRIDTYPE_P2)
-            dims[ndims++] = np2+1;
-        else dims[ndims++] = np2;
-
-        if (this->fluxGridType == FLUXGRIDTYPE_P1)
-            dims[ndims++] = np1+1;
-        else dims[ndims++] = np1;
-    }
+    sfilesize_t ndims = 1 + this->GetStepDimensions(dims+1);
 
     // Compute number of elements
     len_t nel = dims[0];
@@ -462,6 +469,44 @@ void QuantityData::SaveSFile_internal(
     delete [] data;
 }
 
+/**
+ * Get the dimensions of the data in a single time step, in
+ * the order used when writing the data to file.
+ *
+ * dims: Array to store dimensions in (must be able to hold
+ *       at least 4 elements).
+ *
+ * RETURNS the number of dimensions.
+ */
+len_t QuantityData::GetStepDimensions(sfilesize_t *dims) const {
+    const len_t
+        nr  = this->grid->GetNr(),
+        // XXX Here we assume that all momentum grids are the same
+        np1 = this->grid->GetMomentumGrid(0)->GetNp1(),
+        np2 = this->grid->GetMomentumGrid(0)->GetNp2();
+
+    len_t ndims = 0;
+    if (this->nMultiples > 1) dims[ndims++] = this->nMultiples;
+    //if (nr > 1 || np2 > 1 || np1 > 1) dims[ndims++] = nr;
+
+    // Always include radial dimension
+    if (this->fluxGridType == FLUXGRIDTYPE_RADIAL)
+        dims[ndims++] = nr+1;
+    else dims[ndims++] = nr;
+
+    if (np2 > 1 || np1 > 1) {
+        if (this->fluxGridType == FLUXGRIDTYPE_P2)
+            dims[ndims++] = np2+1;
+        else dims[ndims++] = np2;
+
+        if (this->fluxGridType == FLUXGRIDTYPE_P1)
+            dims[ndims++] = np1+1;
+        else dims[ndims++] = np1;
+    }
+
+    return ndims;
+}
+
 /**
  * Set the initial value of the specified unknown quantity. If
  * the initial value has previously been specified, it is overwritten.
@@ -495,6 +540,7 @@ void QuantityData::SetInitialValue(const real_t *val, const real_t t0) {
         // Reset nOldSaved since we didn't push new data just now,
         // but rather just replace it.
         this->nOldSaved = 0;
+        this->nOldValid = 1;
 
         // Overwrite previously stored value
         real_t *iv = this->store[0];
@@ -508,3 +554,121 @@ void QuantityData::SetInitialValue(const real_t *val, const real_t t0) {
         delete [] init;
 }
 
+
+/**
+ * Write the complete state of this object to the given
+ * checkpoint file. This includes the data in the current
+ * and previous time steps, as well as all steps which have
+ * been saved to the 'store' array.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void QuantityData::SaveCheckpoint(SFile *sf, const string& path) {
+    const string group = path + "/";
+    const len_t nt = this->store.size();
+
+    sf->WriteList(group + "data", this->data, this->nElements);
+    sf->WriteList(group + "olddata", this->olddata[0], N_SAVE_OLD_STEPS*this->nElements);
+    sf->WriteList(group + "oldtime", this->oldtime, N_SAVE_OLD_STEPS);
+
+    int64_t nOld = (int64_t)this->nOldSaved;
+    sf->WriteInt64List(group + "nOldSaved", &nOld, 1);
+    int64_t nValid = (int64_t)this->nOldValid;
+    sf->WriteInt64List(group + "nOldValid", &nValid, 1);
+
+    if (nt > 0) {
+        real_t *s = new real_t[nt*this->nElements];
+        for (len_t i = 0; i < nt; i++)
+            for (len_t j = 0; j < this->nElements; j++)
+                s[i*this->nElements + j] = this->store[i][j];
+
+        sf->WriteList(group + "times", this->times.data(), nt);
+        sf->WriteList(group + "store", s, nt*this->nElements);
+
+        delete [] s;
+    }
+}
+
+/**
+ * Restore the state of this object from the given checkpoint
+ * file (previously written by 'SaveCheckpoint()').
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void QuantityData::LoadCheckpoint(SFile *sf, const string& path) {
+    const string group = path + "/";
+    sfilesize_t n;
+
+    // Current data
+    real_t *v = sf->GetList(group + "data", &n);
+    if (n != this->nElements) {
+        delete [] v;
+        throw FVMException(
+            "QuantityData: %s: Invalid number of elements in checkpoint: "
+            LEN_T_PRINTF_FMT ". Expected " LEN_T_PRINTF_FMT ".",
+            path.c_str(), (len_t)n, this->nElements
+        );
+    }
+    for (len_t i = 0; i < this->nElements; i++)
+        this->data[i] = v[i];
+    delete [] v;
+
+    // Previous time steps
+    v = sf->GetList(group + "olddata", &n);
+    if (n != N_SAVE_OLD_STEPS*this->nElements) {
+        delete [] v;
+        throw FVMException(
+            "QuantityData: %s: Invalid number of previous time steps in checkpoint.",
+            path.c_str()
+        );
+    }
+    for (len_t i = 0; i < N_SAVE_OLD_STEPS*this->nElements; i++)
+        this->olddata[0][i] = v[i];
+    delete [] v;
+
+    v = sf->GetList(group + "oldtime", &n);
+    for (len_t i = 0; i < N_SAVE_OLD_STEPS && i < n; i++)
+        this->oldtime[i] = v[i];
+    delete [] v;
+
+    this->nOldSaved = (len_t)sf->GetInt(group + "nOldSaved");
+    // (checkpoints written by older versions only contain the
+    // number of steps which can be rolled back)
+    if (sf->HasVariable(group + "nOldValid"))
+        this->nOldValid = (len_t)sf->GetInt(group + "nOldValid");
+    else
+        this->nOldValid = max(this->nOldSaved, (len_t)1);
+
+    // Saved time steps
+    this->ClearSavedSteps(0);
+    if (sf->HasVariable(group + "store")) {
+        sfilesize_t nt;
+        real_t *t = sf->GetList(group + "times", &nt);
+        v = sf->GetList(group + "store", &n);
+
+        if (n != nt*this->nElements) {
+            delete [] t;
+            delete [] v;
+            throw FVMException(
+                "QuantityData: %s: Invalid size of saved time steps in checkpoint.",
+                path.c_str()
+            );
+        }
+
+        for (len_t i = 0; i < nt; i++) {
+            real_t *s = new real_t[this->nElements];
+            for (len_t j = 0; j < this->nElements; j++)
+                s[j] = v[i*this->nElements + j];
+
+            this->times.push_back(t[i]);
+            this->store.push_back(s);
+        }
+
+        delete [] t;
+        delete [] v;
+    }
+
+    this->hasChanged = true;
+}
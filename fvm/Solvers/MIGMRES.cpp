@@ -1,10 +1,16 @@
 /**
  * Implementation of matrix invertor utilizing an iterative
- * Generalized Minimal Residual (GMRES) method with an LU preconditioner.
+ * Generalized Minimal Residual (GMRES) method. By default, GMRES is
+ * preconditioned with a block-Jacobi preconditioner using one block
+ * per unknown quantity. Alternatively, a field-split preconditioner
+ * coupling groups of unknown quantities can be used (see
+ * 'SetFieldSplit()').
  */
 
 #include <petscksp.h>
 #include <petscvec.h>
+#include <map>
+#include <string>
 #include <vector>
 #include "FVM/config.h"
 #include "FVM/Matrix.hpp"
@@ -27,6 +33,8 @@ MIGMRES::MIGMRES(
 ) {
     KSPCreate(PETSC_COMM_WORLD, &this->ksp);
     this->xn = n;
+    this->nontrivial_unknowns = nontrivial_unknowns;
+    this->unknowns = unknowns;
 
     // Construct a vector indicating to PETSc how to
     // partition the matrix into blocks (we divide the
@@ -49,6 +57,8 @@ MIGMRES::MIGMRES(
     PCSetType(pc, PCBJACOBI);
     PCBJacobiSetTotalBlocks(pc, this->nBlocks, this->blocks);
 
+    KSPSetType(this->ksp, KSPGMRES);
+
     if (converge != nullptr)
         this->SetConvergenceTest(converge, context);
 }
@@ -77,11 +87,188 @@ MIGMRES::~MIGMRES() {
  *    of size n at least.
  */
 void MIGMRES::Invert(Matrix *A, Vec *b, Vec *x) {
-    KSPSetOperators(this->ksp, A->mat(), A->mat());
+    // Keep the preconditioner if the matrix is unchanged, or
+    // if allowed by the reuse policy
+    bool requested = this->reuseFactorization;
+    this->reuseFactorization = requested || this->ReusePreconditioner();
+
+    this->SetOperator(A);
+    bool reusedPC = this->reuseFactorization;
+    this->reuseFactorization = (requested && reusedPC);
+
+    // Create the field splits and configure their solvers
+    // before the outer solver is set up, so that PETSc does
+    // not first set up its default solvers for the splits
+    if (!this->splitDirect.empty() && !reusedPC) {
+        PC pc;
+        KSPGetPC(this->ksp, &pc);
+        PCSetUp(pc);
+        this->SetFieldSplitSolvers();
+        KSPSetUp(this->ksp);
+    }
 
     // Solve
-    KSPSetType(this->ksp, KSPGMRES);
-    KSPSolve(this->ksp, *b, *x);
+    this->errorcode = KSPSolve(this->ksp, *b, *x);
+
+    // If GMRES failed with an old preconditioner, try again
+    // with a preconditioner built from the current matrix
+    KSPConvergedReason reason;
+    KSPGetConvergedReason(this->ksp, &reason);
+    if (reusedPC && reason < 0) {
+        KSPSetReusePreconditioner(this->ksp, PETSC_FALSE);
+        this->errorcode = KSPSolve(this->ksp, *b, *x);
+        reusedPC = false;
+    }
+
+    KSPGetIterationNumber(this->ksp, &this->lastIterations);
+    this->pcAge = (reusedPC ? this->pcAge+1 : 0);
+}
+
+/**
+ * Returns true if the preconditioner built in a previous
+ * solve may be reused in the next solve, according to the
+ * reuse policy set with 'SetPreconditionerReuse()'.
+ */
+bool MIGMRES::ReusePreconditioner() const {
+    if (this->maxPCReuse == 0 || this->operatorMat == nullptr)
+        return false;
+    else if (this->pcAge >= this->maxPCReuse)
+        return false;
+    else if (this->maxPCIterations > 0 && (len_t)this->lastIterations > this->maxPCIterations)
+        return false;
+    else
+        return true;
+}
+
+/**
+ * Set the policy for reusing the preconditioner between
+ * consecutive solves (e.g. Newton iterations or time steps).
+ * Since consecutive jacobian matrices are usually very similar,
+ * the preconditioner of a previous matrix is often good enough
+ * for GMRES to converge, saving the cost of rebuilding it.
+ *
+ * maxReuse:      Maximum number of consecutive solves in which
+ *                the preconditioner may be reused. If 0, the
+ *                preconditioner is rebuilt in every solve.
+ * maxIterations: The preconditioner is rebuilt if the previous
+ *                solve needed more than this number of GMRES
+ *                iterations. If 0, there is no limit.
+ */
+void MIGMRES::SetPreconditionerReuse(const len_t maxReuse, const len_t maxIterations) {
+    this->maxPCReuse = maxReuse;
+    this->maxPCIterations = maxIterations;
+}
+
+/**
+ * Enable Krylov subspace recycling. If 'nvec' > 0, the deflated
+ * GMRES method (DGMRES) is used, which extracts approximate
+ * eigenvectors of the preconditioned matrix corresponding to its
+ * smallest eigenvalues and uses them to deflate later restarts
+ * and solves (the deflation space is kept between solves).
+ *
+ * nvec: Number of deflation vectors to add at each restart
+ *       (0 = use ordinary GMRES).
+ */
+void MIGMRES::SetKrylovRecycling(const len_t nvec) {
+    if (nvec > 0) {
+        KSPSetType(this->ksp, KSPDGMRES);
+        KSPDGMRESSetEigen(this->ksp, (PetscInt)nvec);
+    } else
+        KSPSetType(this->ksp, KSPGMRES);
+}
+
+/**
+ * Replace the block-Jacobi preconditioner with a field-split
+ * preconditioner. The matrix is divided into the given groups
+ * of unknowns ("splits"), and each split is inverted in turn
+ * (multiplicatively), so that the couplings between unknowns
+ * in the same split are fully accounted for and the couplings
+ * between splits are accounted for in a Gauss-Seidel fashion.
+ *
+ * If 'schur' is true and exactly two splits are non-empty, the
+ * preconditioner is instead based on the full Schur complement
+ * factorization of the 2x2 block system. The first split is then
+ * eliminated, and the Schur complement of the second split,
+ *
+ *   S = A11 - A10*inv(A00)*A01,
+ *
+ * is preconditioned using an approximation in which inv(A00) is
+ * replaced by the inverse of the diagonal of A00.
+ *
+ * Unknowns which are not in any split are not preconditioned.
+ *
+ * splits: List of groups of unknowns.
+ * schur:  If true, use a Schur complement factorization.
+ */
+void MIGMRES::SetFieldSplit(const vector<struct split>& splits, const bool schur) {
+    // Offset of each unknown in the matrix
+    map<len_t, PetscInt> offsets;
+    PetscInt offs = 0;
+    for (len_t id : this->nontrivial_unknowns) {
+        offsets[id] = offs;
+        offs += this->unknowns->GetUnknown(id)->NumberOfElements();
+    }
+
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+    PCSetType(pc, PCFIELDSPLIT);
+
+    this->splitDirect.clear();
+    for (auto &sp : splits) {
+        vector<PetscInt> idx;
+        for (len_t id : sp.unknowns) {
+            // Skip unknowns which do not appear in the matrix
+            if (offsets.find(id) == offsets.end())
+                continue;
+
+            const len_t N = this->unknowns->GetUnknown(id)->NumberOfElements();
+            for (len_t k = 0; k < N; k++)
+                idx.push_back(offsets[id] + (PetscInt)k);
+        }
+
+        if (idx.empty())
+            continue;
+
+        IS is;
+        ISCreateGeneral(PETSC_COMM_SELF, (PetscInt)idx.size(), idx.data(), PETSC_COPY_VALUES, &is);
+        PCFieldSplitSetIS(pc, sp.name.c_str(), is);
+        ISDestroy(&is);
+
+        this->splitDirect.push_back(sp.direct);
+    }
+
+    if (schur && this->splitDirect.size() == 2) {
+        PCFieldSplitSetType(pc, PC_COMPOSITE_SCHUR);
+        PCFieldSplitSetSchurFactType(pc, PC_FIELDSPLIT_SCHUR_FACT_FULL);
+        PCFieldSplitSetSchurPre(pc, PC_FIELDSPLIT_SCHUR_PRE_SELFP, nullptr);
+    } else
+        PCFieldSplitSetType(pc, PC_COMPOSITE_MULTIPLICATIVE);
+}
+
+/**
+ * Set the solvers of the splits of the field-split preconditioner.
+ * Each split is inverted by applying its preconditioner once,
+ * which is either an exact or incomplete LU factorization. The
+ * sub-solvers are only created when the field-split preconditioner
+ * is set up for a matrix, and so this method must be called after
+ * 'PCSetUp()', but before 'KSPSetUp()' sets up the sub-solvers.
+ */
+void MIGMRES::SetFieldSplitSolvers() {
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+
+    PetscInt n;
+    KSP *subksp;
+    PCFieldSplitGetSubKSP(pc, &n, &subksp);
+
+    for (PetscInt i = 0; i < n && i < (PetscInt)this->splitDirect.size(); i++) {
+        PC subpc;
+        KSPSetType(subksp[i], KSPPREONLY);
+        KSPGetPC(subksp[i], &subpc);
+        PCSetType(subpc, this->splitDirect[i] ? PCLU : PCILU);
+    }
+
+    PetscFree(subksp);
 }
 
 /*
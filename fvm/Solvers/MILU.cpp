@@ -16,8 +16,15 @@ using namespace DREAM::FVM;
  * n: Number of elements in solution vector.
  */
 MILU::MILU(const len_t n) {
+    PC pc;
+
     KSPCreate(PETSC_COMM_WORLD, &this->ksp);
     this->xn = n;
+
+    // Set direct LU factorization
+    KSPGetPC(this->ksp, &pc);
+    PCSetType(pc, PCLU);
+    KSPSetType(this->ksp, KSPPREONLY);
 }
 
 /**
@@ -41,16 +48,23 @@ MILU::~MILU() {
  *    of size n at least.
  */
 void MILU::Invert(Matrix *A, Vec *b, Vec *x) {
-    PC pc;
-
-    KSPSetOperators(this->ksp, A->mat(), A->mat());
-    
-    // Set direct LU factorization
-    KSPGetPC(this->ksp, &pc);
-    PCSetType(pc, PCLU);
-    KSPSetType(this->ksp, KSPPREONLY);
+    this->SetOperator(A);
 
     // Solve
     this->errorcode = KSPSolve(this->ksp, *b, *x);
 }
 
+/**
+ * Enable/disable reuse of the symbolic factorization. If enabled,
+ * the ordering and fill computed in the first factorization of a
+ * matrix are reused in subsequent factorizations, even if the
+ * non-zero pattern of the matrix changes.
+ */
+void MILU::SetReuseSymbolicFactorization(const bool reuse) {
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+
+    PCFactorSetReuseOrdering(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+    PCFactorSetReuseFill(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+}
+
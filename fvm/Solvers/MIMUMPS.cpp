@@ -18,6 +18,16 @@ using namespace DREAM::FVM;
 MIMUMPS::MIMUMPS(const len_t n) {
     KSPCreate(PETSC_COMM_WORLD, &this->ksp);
     this->xn = n;
+
+#ifdef PETSC_HAVE_MUMPS
+    PC pc;
+
+    // Set direct LU factorization
+    KSPGetPC(this->ksp, &pc);
+    PCSetType(pc, PCLU);
+    PCFactorSetMatSolverType(pc, MATSOLVERMUMPS);
+    KSPSetType(this->ksp, KSPPREONLY);
+#endif
 }
 
 /**
@@ -48,14 +58,16 @@ void MIMUMPS::Invert(Matrix *A, Vec *b, Vec *x) {
     PC pc;
     Mat F;
 
-    KSPSetOperators(this->ksp, A->mat(), A->mat());
-    
-    // Set direct LU factorization
+    this->SetOperator(A);
     KSPGetPC(this->ksp, &pc);
-    PCSetType(pc, PCLU);
-    PCFactorSetMatSolverType(pc, MATSOLVERMUMPS);
-    //PCFactorSetUpMatSolverType(pc);
-    KSPSetType(this->ksp, KSPPREONLY);
+
+    // Make MUMPS use the ordering computed by PETSc
+    // (ICNTL(7) = 1: ordering given by the user)
+    if (this->ordering != nullptr) {
+        PCFactorSetUpMatSolverType(pc);
+        PCFactorGetMatrix(pc, &F);
+        MatMumpsSetIcntl(F, 7, 1);
+    }
 
     // Solve
     KSPSolve(this->ksp, *b, *x);
@@ -75,3 +87,16 @@ void MIMUMPS::Invert(Matrix*, Vec*, Vec*) {
 #endif
 }
 
+/**
+ * Enable/disable reuse of the symbolic factorization. If enabled,
+ * the ordering and fill computed in the first factorization of a
+ * matrix are reused in subsequent factorizations, even if the
+ * non-zero pattern of the matrix changes.
+ */
+void MIMUMPS::SetReuseSymbolicFactorization(const bool reuse) {
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+
+    PCFactorSetReuseOrdering(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+    PCFactorSetReuseFill(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+}
@@ -0,0 +1,119 @@
+/**
+ * Implementation of a mixed-precision matrix invertor. The matrix is
+ * factorized approximately, with an accuracy comparable to a single
+ * precision factorization, and the solution is then refined to full
+ * (double) precision using GMRES preconditioned by the approximate
+ * factorization (GMRES-based iterative refinement, GMRES-IR).
+ *
+ * Since PETSc is built for a single scalar type, the reduced-precision
+ * factorization is obtained from the Block Low-Rank (BLR) factorization
+ * of MUMPS, in which blocks of the factors are compressed to low rank
+ * with the dropping parameter 'epsilon'. With 'epsilon' at the level of
+ * single precision round-off, this reduces the memory and bandwidth
+ * required by the factors by a similar amount as storing them in
+ * single precision.
+ *
+ * If the refinement does not converge, the inverter reports an error
+ * so that the solver can switch to its backup inverter.
+ */
+
+#include <petscvec.h>
+#include "FVM/config.h"
+#include "FVM/Matrix.hpp"
+#include "FVM/Solvers/MIMixedPrecision.hpp"
+
+using namespace DREAM::FVM;
+
+/**
+ * Constructor.
+ *
+ * n:       Number of elements in solution vector.
+ * epsilon: Relative accuracy of the approximate factorization.
+ * reltol:  Relative tolerance of the iterative refinement.
+ * maxiter: Maximum number of refinement (GMRES) iterations.
+ */
+MIMixedPrecision::MIMixedPrecision(
+    const len_t n, const real_t epsilon, const real_t reltol, const len_t maxiter
+) : xn(n), epsilon(epsilon) {
+    KSPCreate(PETSC_COMM_WORLD, &this->ksp);
+
+#ifdef PETSC_HAVE_MUMPS
+    PC pc;
+
+    // Approximate LU factorization as preconditioner...
+    KSPGetPC(this->ksp, &pc);
+    PCSetType(pc, PCLU);
+    PCFactorSetMatSolverType(pc, MATSOLVERMUMPS);
+
+    // ...for GMRES applied to the full precision matrix
+    KSPSetType(this->ksp, KSPGMRES);
+    KSPSetTolerances(this->ksp, reltol, PETSC_DEFAULT, PETSC_DEFAULT, (PetscInt)maxiter);
+#endif
+}
+
+/**
+ * Destructor.
+ */
+MIMixedPrecision::~MIMixedPrecision() {
+    KSPDestroy(&this->ksp);
+}
+
+/**
+ * Solves the linear equation system represented by
+ *
+ *   Ax = b
+ *
+ * where A is a matrix, and b and x are vectors. A
+ * pointer is returned to the solution, x.
+ *
+ * A: Matrix of size m-by-n representing the linear system.
+ * b: Right-hand-side vector containing n elements.
+ * x: Solution vector. Contains solution on return. Must be
+ *    of size n at least.
+ */
+#ifdef PETSC_HAVE_MUMPS
+void MIMixedPrecision::Invert(Matrix *A, Vec *b, Vec *x) {
+    PC pc;
+    Mat F;
+
+    this->SetOperator(A);
+    KSPGetPC(this->ksp, &pc);
+
+    PCFactorSetUpMatSolverType(pc);
+    PCFactorGetMatrix(pc, &F);
+
+    // ICNTL(35) = 2: use BLR factorization and solve
+    // CNTL(7):       BLR dropping parameter
+    MatMumpsSetIcntl(F, 35, 2);
+    MatMumpsSetCntl(F, 7, this->epsilon);
+
+    // Use the ordering computed by PETSc (if set)
+    if (this->ordering != nullptr)
+        MatMumpsSetIcntl(F, 7, 1);
+
+    // Solve
+    this->errorcode = KSPSolve(this->ksp, *b, *x);
+
+    // Iterative refinement failed
+    KSPConvergedReason reason;
+    KSPGetConvergedReason(this->ksp, &reason);
+    if (this->errorcode == 0 && reason < 0)
+        this->errorcode = reason;
+#else
+void MIMixedPrecision::Invert(Matrix*, Vec*, Vec*) {
+#endif
+}
+
+/**
+ * Enable/disable reuse of the symbolic factorization. If enabled,
+ * the ordering and fill computed in the first factorization of a
+ * matrix are reused in subsequent factorizations, even if the
+ * non-zero pattern of the matrix changes.
+ */
+void MIMixedPrecision::SetReuseSymbolicFactorization(const bool reuse) {
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+
+    PCFactorSetReuseOrdering(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+    PCFactorSetReuseFill(pc, reuse ? PETSC_TRUE : PETSC_FALSE);
+}
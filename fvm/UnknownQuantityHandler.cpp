@@ -88,6 +88,54 @@ const real_t *UnknownQuantityHandler::GetLongVectorPrevious(const len_t n, const
     return vec;
 }
 
+/**
+ * Same as 'GetLongVectorPrevious()', but returns the solution
+ * from an older time step.
+ *
+ * nontrivial_unknowns: List of unknowns to include in the vector.
+ * i:                   Index of time step to return ('0' is the most
+ *                      recent step, i.e. same as 'GetLongVectorPrevious()').
+ *                      Must be less than 'GetNOldSteps()'.
+ * vec:                 Vector to store data in (allocated if 'nullptr').
+ */
+const real_t *UnknownQuantityHandler::GetLongVectorOld(
+    const vector<len_t>& nontrivial_unknowns, const len_t i, real_t *vec
+) {
+    const len_t size = GetLongVectorSize(nontrivial_unknowns);
+
+    if (vec == nullptr)
+        vec = new real_t[size];
+
+    len_t offset = 0;
+    for (len_t id : nontrivial_unknowns) {
+        UnknownQuantity *uqn = unknowns[id];
+        const len_t N = uqn->NumberOfElements();
+        const real_t *data = uqn->GetDataOld(i);
+
+        for (len_t j = 0; j < N; j++)
+            vec[offset + j] = data[j];
+
+        offset += N;
+    }
+
+    return vec;
+}
+
+/**
+ * Returns the number of previous time steps which are available
+ * for all of the given unknowns (through 'GetLongVectorOld()').
+ */
+len_t UnknownQuantityHandler::GetNOldSteps(const vector<len_t>& nontrivial_unknowns) {
+    len_t n = 0;
+    for (len_t i = 0; i < nontrivial_unknowns.size(); i++) {
+        len_t m = unknowns[nontrivial_unknowns[i]]->GetNOldSteps();
+        if (i == 0 || m < n)
+            n = m;
+    }
+
+    return n;
+}
+
 /**
  * Returns the data for all unknowns in a single long vector.
  *
@@ -197,6 +245,53 @@ real_t *UnknownQuantityHandler::GetUnknownInitialData(const len_t qty) {
     return unknowns[qty]->GetInitialData();
 }
 
+/**
+ * Evaluate the coefficients of the backward differentiation
+ * formula used to discretize the time derivative of the given
+ * unknown in the next time step, so that
+ *
+ *   dx/dt ~ (c[0]*x_{n+1} + c[1]*x_n + c[2]*x_{n-1}) / dt.
+ *
+ * With second order (BDF2), the coefficients account for the
+ * ratio w = dt/dt_old of the current and previous time steps:
+ *
+ *   c[0] = (1+2w)/(1+w),  c[1] = -(1+w),  c[2] = w^2/(1+w).
+ *
+ * If the history of the unknown does not contain enough time
+ * steps (e.g. in the first time step), the backward Euler
+ * formula (c = {1, -1, 0}) is used instead.
+ *
+ * id: ID of unknown quantity to evaluate coefficients for.
+ * dt: Length of the next time step.
+ * c:  Array (of length 3) to store coefficients in.
+ *
+ * Returns the order of the formula used.
+ */
+len_t UnknownQuantityHandler::GetTransientCoefficients(
+    const len_t id, const real_t dt, real_t *c
+) {
+    UnknownQuantity *uqn = unknowns[id];
+
+    if (this->timeIntegrationOrder >= 2 && uqn->GetNOldSteps() >= 2 && dt > 0) {
+        const real_t dtOld = uqn->GetOldTime(0) - uqn->GetOldTime(1);
+
+        if (dtOld > 0) {
+            const real_t w = dt / dtOld;
+            c[0] = (1+2*w) / (1+w);
+            c[1] = -(1+w);
+            c[2] = w*w / (1+w);
+
+            return 2;
+        }
+    }
+
+    c[0] = 1;
+    c[1] = -1;
+    c[2] = 0;
+
+    return 1;
+}
+
 /**
  * Returns the ID of the named unknown.
  *
@@ -362,6 +457,41 @@ void UnknownQuantityHandler::SaveSFileCurrent(
         (*it)->SaveSFileCurrent(sf, path, saveMeta);
 }
 
+/**
+ * Write the full state of all unknown quantities to the
+ * given checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void UnknownQuantityHandler::SaveCheckpoint(SFile *sf, const string& path) {
+    for (auto it = unknowns.begin(); it != unknowns.end(); it++) {
+        const string group = path + "/" + (*it)->GetName();
+        sf->CreateStruct(group);
+        (*it)->GetQuantityData()->SaveCheckpoint(sf, group);
+    }
+}
+
+/**
+ * Restore the state of all unknown quantities from the
+ * given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void UnknownQuantityHandler::LoadCheckpoint(SFile *sf, const string& path) {
+    for (auto it = unknowns.begin(); it != unknowns.end(); it++) {
+        const string group = path + "/" + (*it)->GetName();
+        if (!sf->HasVariable(group + "/data"))
+            throw FVMException(
+                "Unknown quantity '%s' is missing from the checkpoint file '%s'.",
+                (*it)->GetName().c_str(), sf->filename.c_str()
+            );
+
+        (*it)->GetQuantityData()->LoadCheckpoint(sf, group);
+    }
+}
+
 /**
  * Set the initial value of the specified unknown quantity. If
  * the initial value has previously been specified, it is overwritten.
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <iostream>
 #include <H5Cpp.h>
+#include <getopt.h>
 #include <string>
 #include <unistd.h>
 
@@ -37,7 +38,8 @@ struct cmd_args {
     bool print_adas=false;
     bool splash=true;
     string
-        input_filename;
+        input_filename,
+        restart_filename;
 };
 
 void display_settings(DREAM::Settings *s=nullptr) {
@@ -66,6 +68,8 @@ void print_help() {
     cout << "  -a           Print list of elements in ADAS database." << endl;
     cout << "  -h           Print this help." << endl;
     cout << "  -l           List all available settings in DREAM." << endl;
+    cout << "  -r, --restart CHECKPOINT" << endl;
+    cout << "               Resume the simulation from the given checkpoint file." << endl;
     cout << "  -s           Do not show the splash screen." << endl;
 }
 
@@ -81,7 +85,12 @@ struct cmd_args *parse_args(int argc, char *argv[]) {
     struct cmd_args *a = new struct cmd_args;
     a->display_settings = false;
 
-    while ((c = getopt(argc, argv, "ahls")) != -1) {
+    static struct option long_options[] = {
+        {"restart", required_argument, nullptr, 'r'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    while ((c = getopt_long(argc, argv, "ahlr:s", long_options, nullptr)) != -1) {
         switch (c) {
             case 'a':
                 a->print_adas = true;
@@ -92,6 +101,9 @@ struct cmd_args *parse_args(int argc, char *argv[]) {
             case 'l':
                 display_settings();
                 break;
+            case 'r':
+                a->restart_filename = string(optarg);
+                break;
             case 's':
                 a->splash = false;
                 break;
@@ -220,6 +232,9 @@ int main(int argc, char *argv[]) {
 
         sim = DREAM::SimulationGenerator::ProcessSettings(settings);
 
+        if (!a->restart_filename.empty())
+            sim->GetEquationSystem()->LoadCheckpoint(a->restart_filename);
+
         if (a->print_adas)
             display_adas(sim);
 
@@ -6,17 +6,24 @@
 #include "DREAM/ADASRateInterpolator.hpp"
 #include "FVM/FVMException.hpp"
 
+struct adas_rate;
+
 namespace DREAM {
     class ADAS {
     private:
-        std::unordered_map<len_t, ADASRateInterpolator**> intp;
+        // Entries of the compiled-in ADAS rate table, by isotope index
+        std::unordered_map<len_t, const struct adas_rate*> rates;
+        // Interpolation objects, constructed the first time data for
+        // an element is requested (indexed by isotope index)
+        mutable std::unordered_map<len_t, ADASRateInterpolator**> intp;
+        const gsl_interp2d_type *interp;
 
         static const len_t
             IDX_ACD, IDX_CCD, IDX_SCD, IDX_PLT, IDX_PRB;
 
         len_t get_isotope_index(const len_t, const len_t A=0) const;
-        std::unordered_map<len_t, ADASRateInterpolator**>::const_iterator
-            get_element(const len_t, const len_t A=0) const;
+        ADASRateInterpolator **get_element(const len_t, const len_t A=0) const;
+        ADASRateInterpolator **construct_element(const struct adas_rate*) const;
 
         // Maximum possible atomic mass (or larger; should just be an
         // arbitrary large number to help with indexing...)
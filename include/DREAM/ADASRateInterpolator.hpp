@@ -26,10 +26,36 @@ namespace DREAM {
          */
         bool shiftZ0=false;
 
-        // Interpolation objects
-        gsl_interp_accel **nacc, **Tacc;
-        //gsl_spline2d **splines;
-        gsl_interp2d **interp_c, **interp_l;
+        // If true, interpolate using bicubic splines inside the
+        // table (bilinear interpolation is always used outside)
+        bool bicubic=true;
+        // Derivatives of the tabulated data with respect to log(n),
+        // log(T) and both, as used by the bicubic spline (each of
+        // size Z*nn*nT; only allocated when 'bicubic == true')
+        real_t *zn=nullptr, *zT=nullptr, *znT=nullptr;
+
+        /**
+         * Location of an (n, T) point in the table. Since
+         * all charge states share the same grid, this is
+         * shared between all charge states.
+         */
+        struct point {
+            // Index of lower-left corner of table cell
+            len_t in, iT;
+            // Cell widths
+            real_t dn, dT;
+            // Hermite basis functions (and their derivatives) in
+            // the log(n) (a, b) and log(T) (c, d) directions
+            real_t a0, a1, b0, b1, da0, da1, db0, db1;
+            real_t c0, c1, d0, d1, dc0, dc1, dd0, dd1;
+            // If true, the point lies outside the table and
+            // bilinear extrapolation is used
+            bool linear;
+        };
+
+        void ComputeSplineDerivatives();
+        void Locate(const real_t, const real_t, struct point&) const;
+        real_t EvalPoint(const len_t, const struct point&, real_t *dfdn=nullptr, real_t *dfdT=nullptr) const;
 
     public:
         ADASRateInterpolator(
@@ -41,6 +67,10 @@ namespace DREAM {
         virtual ~ADASRateInterpolator();
 
         real_t Eval(const len_t Z0, const real_t n, const real_t T);
+        void Eval(
+            const len_t nr, const real_t *n, const real_t *T, real_t *rate,
+            real_t *drate_dn=nullptr, real_t *drate_dT=nullptr
+        );
 
         real_t Eval_deriv_n(const len_t Z0, const real_t n, const real_t T);
         real_t Eval_deriv_T(const len_t Z0, const real_t n, const real_t T);
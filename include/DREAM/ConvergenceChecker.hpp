@@ -23,6 +23,10 @@ namespace DREAM {
         real_t *x_2norm=nullptr;
         real_t *dx_2norm=nullptr;
 
+        // Largest norm of the step, relative to its tolerance, in
+        // the most recent (and the previous) call to 'IsConverged()'
+        real_t stepMeasure=0, prevStepMeasure=0;
+
     public:
         ConvergenceChecker(
             FVM::UnknownQuantityHandler*, const std::vector<len_t>&,
@@ -39,6 +43,9 @@ namespace DREAM {
         bool IsConverged(const real_t*, const real_t*, bool verbose=false);
         bool IsConverged(const real_t*, const real_t*, const real_t*, bool verbose=false);
 
+        real_t GetConvergenceRate() const;
+        void ResetConvergenceRate() { this->stepMeasure = this->prevStepMeasure = 0; }
+
         const real_t *GetErrorNorms() { return this->dx_2norm; }
         const real_t GetErrorScale(const len_t);
 
@@ -2,6 +2,7 @@
 #define _DREAM_EQUATION_SYSTEM_HPP
 
 namespace DREAM { class EquationSystem; }
+namespace DREAM { class OutputGenerator; }
 
 #include <map>
 #include <string>
@@ -62,6 +63,8 @@ namespace DREAM {
         AnalyticDistributionHottail *distHT = nullptr;
 
         OtherQuantityHandler *otherQuantityHandler=nullptr;
+        // Output generator to notify of saved time steps (optional)
+        OutputGenerator *outputGenerator=nullptr;
 
         std::string initializerFile;
         std::vector<std::string> initializerFileIgnore;
@@ -76,6 +79,15 @@ namespace DREAM {
         bool timingStdout = false;
         bool timingFile = false;
 
+        // Name of checkpoint file (empty = no checkpoints written)
+        std::string checkpointFilename;
+        // Number of time steps and wall-clock time (in seconds)
+        // between checkpoints (0 = disabled)
+        len_t checkpointSteps = 0;
+        real_t checkpointWalltime = 0;
+        // True if the state of the system was loaded from a checkpoint
+        bool restarted = false;
+
     public:
         EqsysInitializer *initializer=nullptr;
 
@@ -196,6 +208,7 @@ namespace DREAM {
             this->initializer->SetIonHandler(ih);
         }
         void SetOtherQuantityHandler(OtherQuantityHandler *oqh) { this->otherQuantityHandler = oqh; }
+        void SetOutputGenerator(OutputGenerator *og) { this->outputGenerator = og; }
         void SetSolver(Solver*);
         void SetTimeStepper(TimeStepper *ts) { this->timestepper = ts; }
 
@@ -203,6 +216,13 @@ namespace DREAM {
         void SaveTimings(SFile*, const std::string&);
 
         void Solve();
+
+        // Checkpoint routines
+        bool IsRestarted() const { return this->restarted; }
+        void LoadCheckpoint(const std::string&);
+        void SaveCheckpoint(const std::string&);
+        void SetCheckpointing(const std::string&, const len_t, const real_t);
+
         // Info routines
         void PrintNonTrivialUnknowns();
         void PrintTrivialUnknowns();
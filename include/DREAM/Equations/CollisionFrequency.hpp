@@ -3,6 +3,7 @@
 
 #include "CollisionQuantity.hpp"
 #include "DREAM/Equations/CoulombLogarithm.hpp"
+#include "DREAM/Equations/PsiFunctionTable.hpp"
 
 namespace DREAM {
     class CollisionFrequency : public CollisionQuantity {
@@ -96,6 +97,8 @@ namespace DREAM {
         gsl_integration_fixed_workspace **gsl_w = nullptr;
         gsl_integration_workspace *gsl_ad_w = nullptr;
         int QAG_KEY = GSL_INTEG_GAUSS31;
+        // Table of Psi functions (nullptr = evaluate using quadrature)
+        const PsiFunctionTable *psiTable = nullptr;
 
         void setPreFactor(real_t *&preFactor, const real_t *pIn, len_t np1, len_t np2);
         void setElectronTerm(real_t **&nColdTerm, const real_t *pIn, len_t nr, len_t np1, len_t np2);
@@ -32,6 +32,8 @@ namespace DREAM {
                         pstar_mode = OptionConstants::COLLQTY_PSTAR_MODE_COLLISIONLESS;
             enum OptionConstants::collqty_screened_diffusion_mode
                         screened_diffusion = OptionConstants::COLLQTY_SCREENED_DIFFUSION_MODE_MAXWELLIAN;
+            enum OptionConstants::collqty_psi_mode
+                        psi_mode = OptionConstants::COLLQTY_PSI_MODE_QUADRATURE;
         };
         
     private:
@@ -13,6 +13,11 @@ namespace DREAM {
         
         real_t dt;
         real_t *nions_prev;
+        // Ion densities two time steps back (only used with
+        // the second-order time discretization)
+        const real_t *nions_prev2 = nullptr;
+        // Coefficients of the time discretization
+        real_t coeff[3] = {1, -1, 0};
     protected:
         virtual bool TermDependsOnUnknowns() override {return true;}
         virtual len_t GetNumberOfWeightsElements() override
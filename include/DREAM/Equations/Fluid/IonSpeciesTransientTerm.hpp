@@ -2,9 +2,12 @@
 #define _DREAM_EQUATION_FLUID_ION_SPECIES_TRANSIENT_TERM_HPP
 
 /**
- * Implementation of an equation term representing the
- * (backward euler) time derivative on an ion species 
- * with index iz. (which can be scaled using scalefactor)
+ * Implementation of an equation term representing the time
+ * derivative on an ion species with index iz (which can be
+ * scaled using scalefactor). The time derivative is discretized
+ * using the backward Euler method, or the variable-step BDF2
+ * method if second-order time integration is enabled (see
+ * 'UnknownQuantityHandler::GetTransientCoefficients()').
  */
 
 #include "FVM/Equation/EquationTerm.hpp"
@@ -18,15 +21,28 @@ namespace DREAM{
         len_t iz;
         real_t scaleFactor;
         real_t dt;
+        // Value in the previous time step
         real_t *xPrev;
+        // Value two time steps back (only used with the
+        // second-order time discretization)
+        const real_t *xPrev2 = nullptr;
+        // Coefficients of the time discretization
+        real_t coeff[3] = {1, -1, 0};
     public:
         IonSpeciesTransientTerm(FVM::Grid *g, len_t iz, const len_t id, real_t scaleFactor=1.0) 
-            : FVM::EquationTerm(g), unknownId(id), iz(iz), scaleFactor(scaleFactor){}
+            : FVM::EquationTerm(g), unknownId(id), iz(iz), scaleFactor(scaleFactor){
+            SetRebuildThreadSafe();
+        }
         virtual len_t GetNumberOfNonZerosPerRow() const override { return 1; }
         virtual len_t GetNumberOfNonZerosPerRow_jac() const override { return 1; }
         virtual void Rebuild(const real_t, const real_t dt, FVM::UnknownQuantityHandler *u) override {
             this->dt = dt;
             this->xPrev = u->GetUnknownDataPrevious(this->unknownId);
+
+            if (u->GetTransientCoefficients(this->unknownId, dt, this->coeff) >= 2)
+                this->xPrev2 = u->GetUnknownDataOld(this->unknownId, 1);
+            else
+                this->xPrev2 = nullptr;
         }
 
         virtual bool SetJacobianBlock(const len_t uqtyId, const len_t derivId, FVM::Matrix *jac, const real_t*) override {
@@ -36,14 +52,21 @@ namespace DREAM{
         }
         virtual void SetMatrixElements(FVM::Matrix *mat, real_t *rhs) override {
             for(len_t ir=0; ir<nr; ir++)
-                mat->SetElement(iz*nr+ir,iz*nr+ir,scaleFactor/dt);
-            if(rhs!=nullptr)
+                mat->SetElement(iz*nr+ir,iz*nr+ir,scaleFactor*coeff[0]/dt);
+            if(rhs!=nullptr) {
                 for(len_t ir=0; ir<nr; ir++)
-                    rhs[iz*nr+ir] -= scaleFactor/dt;
+                    rhs[iz*nr+ir] += scaleFactor*coeff[1]*xPrev[iz*nr+ir]/dt;
+                if(xPrev2!=nullptr)
+                    for(len_t ir=0; ir<nr; ir++)
+                        rhs[iz*nr+ir] += scaleFactor*coeff[2]*xPrev2[iz*nr+ir]/dt;
+            }
         }
         virtual void SetVectorElements(real_t *vec, const real_t *xi) override {
             for(len_t ir=0; ir<nr; ir++)
-                vec[iz*nr+ir] += scaleFactor*(xi[iz*nr+ir]-xPrev[iz*nr+ir])/dt;
+                vec[iz*nr+ir] += scaleFactor*(coeff[0]*xi[iz*nr+ir]+coeff[1]*xPrev[iz*nr+ir])/dt;
+            if(xPrev2!=nullptr)
+                for(len_t ir=0; ir<nr; ir++)
+                    vec[iz*nr+ir] += scaleFactor*coeff[2]*xPrev2[iz*nr+ir]/dt;
         }
     };
 }
@@ -12,6 +12,11 @@ namespace DREAM {
 
         // Ion densities in the previous time step
         real_t *xn;
+        // Ion densities two time steps back (only used with
+        // the second-order time discretization)
+        const real_t *xnm1 = nullptr;
+        // Coefficients of the time discretization
+        real_t coeff[3] = {1, -1, 0};
 
     public:
         IonTransientTerm(FVM::Grid*, IonHandler*, const len_t iIon, const len_t unknownId);
@@ -30,6 +30,20 @@ namespace DREAM {
             bremsRel2;
             
         bool includePRB = true;
+
+        // Work arrays holding ADAS rate coefficients (or their derivatives)
+        // for all charge states of one ion species at all radii
+        real_t *PLT=nullptr, *PRB=nullptr, *ACD=nullptr, *SCD=nullptr;
+        len_t nRateElements = 0;
+
+        enum adas_rate_mode {
+            ADAS_RATE_VALUE,
+            ADAS_RATE_DERIV_N,
+            ADAS_RATE_DERIV_T
+        };
+
+        void DeallocateRateBuffers();
+        void EvaluateADASRates(const len_t, const real_t*, const real_t*, enum adas_rate_mode);
     protected:
         virtual len_t GetNumberOfWeightsElements() override 
             {return ionHandler->GetNzs() * grid->GetNCells();}
@@ -42,6 +56,7 @@ namespace DREAM {
 
     public:
         RadiatedPowerTerm(FVM::Grid*, FVM::UnknownQuantityHandler*, IonHandler*, ADAS*, NIST*, AMJUEL*,enum OptionConstants::ion_opacity_mode*, bool);
+        ~RadiatedPowerTerm();
     };
 }
 
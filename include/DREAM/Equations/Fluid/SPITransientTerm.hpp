@@ -19,6 +19,11 @@ namespace DREAM {
 
         // Differentiated quantity at the previous time step
         real_t *xn;
+        // Differentiated quantity two time steps back (only
+        // used with the second-order time discretization)
+        const real_t *xnm1 = nullptr;
+        // Coefficients of the time discretization
+        real_t coeff[3] = {1, -1, 0};
     public:
         SPITransientTerm(FVM::Grid*, const len_t unknownId, len_t nShard, real_t scaleFactor=1.0);
         ~SPITransientTerm(){}
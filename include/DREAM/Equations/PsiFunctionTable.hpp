@@ -0,0 +1,58 @@
+#ifndef _DREAM_EQUATIONS_PSI_FUNCTION_TABLE_HPP
+#define _DREAM_EQUATIONS_PSI_FUNCTION_TABLE_HPP
+
+#include <gsl/gsl_integration.h>
+#include "FVM/config.h"
+
+namespace DREAM {
+    class PsiFunctionTable {
+    public:
+        // Tabulated quantities: Psi0, Psi1-Psi0 and Psi2-Psi1
+        static const len_t NQUANTITIES = 3;
+
+        // Range of the table: the table covers the region between the
+        // low-energy limit (Theta < THETA_MIN) and the superthermal
+        // limit (E > 10*Theta) of the Psi functions, for Theta <= THETA_MAX
+        static constexpr real_t THETA_MIN = 0.005;
+        static constexpr real_t THETA_MAX = 1.0;
+        static constexpr real_t U_MIN = 0.1;
+
+    private:
+        // Number of points in the u = sqrt((gamma-1)/Theta) and
+        // log(Theta) directions
+        len_t nu=0, nl=0;
+        real_t u0, u1, hu;
+        real_t l0, l1, hl;
+
+        // Tabulated (normalized) values and derivatives with respect
+        // to u and log(Theta) (size NQUANTITIES*nu*nl each)
+        real_t *F=nullptr, *Fu=nullptr, *Fl=nullptr, *Ful=nullptr;
+
+        // Maximum relative error of the interpolation (measured in the
+        // cell mid-points) and requested tolerance
+        real_t maxError=0, reltol;
+        bool valid = false;
+
+        gsl_integration_workspace *gsl_ad_w = nullptr;
+
+        void Allocate(const len_t, const len_t);
+        void Build();
+        void Deallocate();
+        real_t EvaluateExact(const len_t, const real_t, const real_t);
+        real_t Interpolate(const len_t, const real_t, const real_t) const;
+        real_t MeasureError();
+        static real_t Normalization(const len_t, const real_t, const real_t);
+
+    public:
+        PsiFunctionTable(const real_t reltol=1e-6);
+        ~PsiFunctionTable();
+
+        bool Evaluate(const len_t, const real_t, const real_t, real_t*) const;
+        bool IsValid() const { return this->valid; }
+        real_t GetMaxError() const { return this->maxError; }
+
+        static const PsiFunctionTable *Get();
+    };
+}
+
+#endif/*_DREAM_EQUATIONS_PSI_FUNCTION_TABLE_HPP*/
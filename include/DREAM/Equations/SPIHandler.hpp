@@ -6,6 +6,9 @@
 
 namespace DREAM { class SPIHandler; }
 #include <iostream>
+#include <string>
+#include <vector>
+#include <softlib/SFile.h>
 
 #include "FVM/Grid/Grid.hpp"
 #include "FVM/Matrix.hpp"
@@ -18,6 +21,42 @@ namespace DREAM { class SPIHandler; }
 
 namespace DREAM{
     class SPIHandler{
+    public:
+        /**
+         * Sparse storage of a radial profile for each shard. The
+         * profile of shard 'ip' is only non-zero in the cells
+         * irStart[ip] <= ir < irEnd[ip], where its values are stored
+         * contiguously in 'values', starting at index offset[ip].
+         */
+        struct shard_profiles {
+            std::vector<len_t> irStart, irEnd, offset;
+            std::vector<real_t> values;
+
+            void Resize(const len_t nShard) {
+                irStart.assign(nShard, 0);
+                irEnd.assign(nShard, 0);
+                offset.assign(nShard, 0);
+                values.clear();
+            }
+
+            // Reserve (zero-initialized) storage for the profile of
+            // shard 'ip' in cells is <= ir < ie, and return a pointer
+            // to it (valid until the next call to this method)
+            real_t *SetRange(const len_t ip, const len_t is, const len_t ie) {
+                irStart[ip] = is;
+                irEnd[ip]   = (ie > is ? ie : is);
+                offset[ip]  = values.size();
+                values.resize(offset[ip] + irEnd[ip]-irStart[ip], 0);
+                return values.data() + offset[ip];
+            }
+
+            real_t At(const len_t ip, const len_t ir) const {
+                if (ir < irStart[ip] || ir >= irEnd[ip])
+                    return 0;
+                return values[offset[ip] + ir-irStart[ip]];
+            }
+        };
+
     private:
         //FVM::ScalarGrid *sGrid;
         FVM::RadialGrid *rGrid;
@@ -70,8 +109,8 @@ namespace DREAM{
         real_t *Ypdot=nullptr;
         real_t *rCld=nullptr;
         real_t *depositionRate=nullptr;
-        real_t *depositionProfilesAllShards=nullptr;
-        real_t *heatAbsorbtionProfilesAllShards=nullptr;
+        shard_profiles depositionProfilesAllShards;
+        shard_profiles heatAbsorbtionProfilesAllShards;
         real_t *heatAbsorbtionRate=nullptr;
         real_t *rCoordPPrevious=nullptr;
         real_t *thetaCoordPPrevious=nullptr;
@@ -104,8 +143,10 @@ namespace DREAM{
 
         real_t rSourceMax; 
         real_t rSourceMin;
-        void CalculateTimeAveragedDeltaSourceLocal(real_t *timeAveragedDeltaSource);
-        void CalculateGaussianSourceLocal(real_t *gaussianSource);
+        void CalculateTimeAveragedDeltaSourceLocal(shard_profiles &timeAveragedDeltaSource);
+        void CalculateGaussianSourceLocal(shard_profiles &gaussianSource);
+        void ShiftDepositionProfilesLastFluxTube(shard_profiles &profiles);
+        void FindCellRange(real_t rMin, real_t rMax, len_t &irStart, len_t &irEnd);
         real_t CalculateRDotDepositionLocal(len_t ir);
 
         void CalculateIrp();
@@ -141,6 +182,9 @@ namespace DREAM{
         
         len_t GetNShard(){return this->nShard;}
 
+        void SaveCheckpoint(SFile*, const std::string&);
+        void LoadCheckpoint(SFile*, const std::string&);
+
 
     };
 }
@@ -1,6 +1,7 @@
 #ifndef _DREAM_TRANSPORT_PRESCRIBED_HPP
 #define _DREAM_TRANSPORT_PRESCRIBED_HPP
 
+#include <future>
 #include "FVM/Equation/AdvectionTerm.hpp"
 #include "FVM/Equation/DiffusionTerm.hpp"
 #include "FVM/Interpolator1D.hpp"
@@ -23,8 +24,38 @@ namespace DREAM {
 
         real_t **interpolateddata=nullptr;
 
+        // If 'true', only the two time slices bracketing the current
+        // time are kept interpolated onto the simulation grid, and new
+        // slices are interpolated lazily as time advances (instead of
+        // interpolating all 'nt' slices up front).
+        bool windowed = false;
+        // If 'true' (and 'windowed' is 'true'), the slice following
+        // the current window is interpolated on a background thread.
+        bool prefetch = false;
+        // Interpolated time slices of the current window, and the
+        // indices of the slices they contain ('nt' = empty)
+        real_t *window[2] = {nullptr, nullptr};
+        len_t windowIndex[2];
+        bool tIncreasing = true;
+        // Copy of the grid onto which slices are interpolated (so
+        // that slices can be interpolated in the background)
+        len_t gridNr=0, gridNp1=0, gridNp2=0;
+        real_t *gridR=nullptr, *gridP1=nullptr, *gridP2=nullptr;
+        // Slice being (or having been) interpolated in the background
+        real_t *prefetchBuffer = nullptr;
+        len_t prefetchIndex;
+        std::future<void> prefetchTask;
+
         void _setcoeff(const len_t, const len_t, const real_t);
 
+        void AllocateWindow(const len_t);
+        void DeallocateWindow();
+        len_t FindTimeIndex(const real_t);
+        const real_t *GetSlice(const len_t, const len_t);
+        void InterpolateSlice(const len_t, real_t*);
+        void StartPrefetch(const len_t);
+        void WaitForPrefetch();
+
     public:
         TransportPrescribed<T>(
             FVM::Grid*,
@@ -33,6 +64,7 @@ namespace DREAM {
             const real_t*, const real_t*, enum FVM::Interpolator3D::momentumgrid_type,
             enum FVM::Interpolator3D::momentumgrid_type,
             enum FVM::Interpolator3D::interp_method interpmethod=FVM::Interpolator3D::INTERP_LINEAR,
+            bool windowed=false, bool prefetch=false,
             bool allocCoefficients=false
         );
         virtual ~TransportPrescribed<T>();
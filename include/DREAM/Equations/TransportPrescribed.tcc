@@ -4,6 +4,7 @@
  * coefficient in time and phase space.
  */
 
+#include <algorithm>
 #include <type_traits>
 #include "DREAM/Equations/TransportPrescribed.hpp"
 #include "FVM/Interpolator1D.hpp"
@@ -21,13 +22,17 @@ DREAM::TransportPrescribed<T>::TransportPrescribed(
     const real_t *p1, const real_t *p2, enum DREAM::FVM::Interpolator3D::momentumgrid_type inptype,
     enum DREAM::FVM::Interpolator3D::momentumgrid_type gridtype,
     enum DREAM::FVM::Interpolator3D::interp_method interpmethod,
-    bool allocCoefficients
+    bool windowed, bool prefetch, bool allocCoefficients
 ) : T(grid, allocCoefficients),
     nt(nt), nr(nr), np1(np1), np2(np2),
     coeff(coeff), t(t), r(r), p1(p1), p2(p2),
-    momtype(inptype), gridtype(gridtype), interpmethod(interpmethod) {
+    momtype(inptype), gridtype(gridtype), interpmethod(interpmethod),
+    windowed(windowed), prefetch(windowed && prefetch) {
 
     this->T::SetName("TransportPrescribed");
+
+    if (nt > 1)
+        this->tIncreasing = (t[1] > t[0]);
     
     // Interpolate input coefficient onto 'grid'...
     InterpolateCoefficient();
@@ -45,6 +50,8 @@ TransportPrescribed<T>::~TransportPrescribed() {
         delete [] this->interpolateddata[0];
         delete [] this->interpolateddata;
     }
+
+    DeallocateWindow();
 }
 }
 
@@ -72,6 +79,15 @@ bool DREAM::TransportPrescribed<T>::GridRebuilt() {
  */
 template<typename T>
 void DREAM::TransportPrescribed<T>::InterpolateCoefficient() {
+    // In windowed mode, slices are interpolated lazily
+    // in 'Rebuild()'...
+    if (this->windowed) {
+        AllocateWindow(
+            this->grid->GetNCells() + this->grid->GetMomentumGrid(0)->GetNCells()
+        );
+        return;
+    }
+
     real_t **newdata = new real_t*[nt];
     // Drr is defined on the radial flux grid so we
     // XXX assume that all momentum grids are the same
@@ -117,10 +133,46 @@ template<typename T>
 void DREAM::TransportPrescribed<T>::Rebuild(
     const real_t t, const real_t, DREAM::FVM::UnknownQuantityHandler*
 ) {
-    const real_t *c = this->prescribedCoeff->Eval(t);
     const len_t nr = this->grid->GetNr();
     // XXX here we assume that all momentum grids are the same...
     const len_t N = this->grid->GetMomentumGrid(0)->GetNCells();
+
+    if (this->windowed) {
+        const len_t ix = FindTimeIndex(t);
+
+        // Only a single time slice given
+        if (ix+1 >= this->nt) {
+            const real_t *c = GetSlice(this->nt-1, this->nt);
+            for (len_t ir = 0, offset = 0; ir < nr+1; ir++, offset += N)
+                for (len_t j = 0; j < N; j++)
+                    this->_setcoeff(ir, j, c[offset+j]);
+
+            return;
+        }
+
+        // Linear interpolation between the two bracketing
+        // slices (same as in 'Interpolator1D')
+        const real_t *y1 = GetSlice(ix, ix+1);
+        const real_t *y2 = GetSlice(ix+1, ix);
+        const real_t ddx = (t - this->t[ix]) / (this->t[ix+1] - this->t[ix]);
+
+        for (len_t ir = 0, offset = 0; ir < nr+1; ir++, offset += N)
+            for (len_t j = 0; j < N; j++)
+                this->_setcoeff(ir, j, (1-ddx)*y1[offset+j] + ddx*y2[offset+j]);
+
+        // Start interpolating the slice that will be needed
+        // once time has passed the current window
+        if (this->prefetch) {
+            if (this->tIncreasing && ix+2 < this->nt)
+                StartPrefetch(ix+2);
+            else if (!this->tIncreasing && ix > 0)
+                StartPrefetch(ix-1);
+        }
+
+        return;
+    }
+
+    const real_t *c = this->prescribedCoeff->Eval(t);
     
     // Iterate over the radial flux grid...
     for (len_t ir = 0, offset = 0; ir < nr+1; ir++) {
@@ -132,3 +184,171 @@ void DREAM::TransportPrescribed<T>::Rebuild(
     }
 }
 
+
+/**
+ * Allocate memory for the time slices of the interpolation
+ * window, each containing 'N' elements, and make a copy of
+ * the (radial flux) grid onto which the slices are to be
+ * interpolated. Any previously interpolated slices are
+ * discarded.
+ */
+template<typename T>
+void DREAM::TransportPrescribed<T>::AllocateWindow(const len_t N) {
+    DeallocateWindow();
+
+    this->window[0] = new real_t[N];
+    this->window[1] = new real_t[N];
+    this->windowIndex[0] = this->windowIndex[1] = this->nt;
+
+    if (this->prefetch)
+        this->prefetchBuffer = new real_t[N];
+    this->prefetchIndex = this->nt;
+
+    // XXX here we assume that all momentum grids are the same...
+    const FVM::MomentumGrid *mg = this->grid->GetMomentumGrid(0);
+    this->gridNr  = this->grid->GetNr()+1;
+    this->gridNp1 = mg->GetNp1();
+    this->gridNp2 = mg->GetNp2();
+
+    this->gridR  = new real_t[this->gridNr];
+    this->gridP1 = new real_t[this->gridNp1];
+    this->gridP2 = new real_t[this->gridNp2];
+
+    std::copy(this->grid->GetRadialGrid()->GetR_f(), this->grid->GetRadialGrid()->GetR_f()+this->gridNr, this->gridR);
+    std::copy(mg->GetP1(), mg->GetP1()+this->gridNp1, this->gridP1);
+    std::copy(mg->GetP2(), mg->GetP2()+this->gridNp2, this->gridP2);
+}
+
+/**
+ * Free the memory used by the interpolation window.
+ */
+template<typename T>
+void DREAM::TransportPrescribed<T>::DeallocateWindow() {
+    // Make sure no slice is being written in the background
+    // (any result, or exception, is discarded)
+    if (this->prefetchTask.valid()) {
+        this->prefetchTask.wait();
+        this->prefetchTask = std::future<void>();
+    }
+
+    for (len_t k = 0; k < 2; k++) {
+        if (this->window[k] != nullptr) {
+            delete [] this->window[k];
+            this->window[k] = nullptr;
+        }
+    }
+
+    if (this->prefetchBuffer != nullptr) {
+        delete [] this->prefetchBuffer;
+        this->prefetchBuffer = nullptr;
+    }
+
+    if (this->gridR != nullptr) {
+        delete [] this->gridR;
+        delete [] this->gridP1;
+        delete [] this->gridP2;
+
+        this->gridR = this->gridP1 = this->gridP2 = nullptr;
+    }
+}
+
+/**
+ * Locate the index of the prescribed time point preceding
+ * the given time (using the same convention as
+ * 'Interpolator1D', so that times outside the prescribed
+ * interval are extrapolated from the first/last two slices).
+ */
+template<typename T>
+len_t DREAM::TransportPrescribed<T>::FindTimeIndex(const real_t tv) {
+    len_t a = 0, b = (this->nt > 0 ? this->nt-1 : 0);
+
+    while (b-a > 1) {
+        len_t c = (a+b)/2;
+        if ((this->t[c] >= tv) == this->tIncreasing)
+            b = c;
+        else
+            a = c;
+    }
+
+    return a;
+}
+
+/**
+ * Returns the prescribed coefficient at time index 'i',
+ * interpolated onto the simulation grid. If the slice is not
+ * in the current window, it replaces the slice in the window
+ * which does not have index 'keep'.
+ */
+template<typename T>
+const real_t *DREAM::TransportPrescribed<T>::GetSlice(
+    const len_t i, const len_t keep
+) {
+    for (len_t k = 0; k < 2; k++)
+        if (this->windowIndex[k] == i)
+            return this->window[k];
+
+    const len_t slot = (this->windowIndex[0] == keep ? 1 : 0);
+
+    if (this->prefetch && this->prefetchIndex == i) {
+        // The slice has already been interpolated
+        // (or is being interpolated) in the background
+        WaitForPrefetch();
+        std::swap(this->window[slot], this->prefetchBuffer);
+        this->prefetchIndex = this->nt;
+    } else
+        InterpolateSlice(i, this->window[slot]);
+
+    this->windowIndex[slot] = i;
+    return this->window[slot];
+}
+
+/**
+ * Interpolate the prescribed coefficient at time index 'i'
+ * onto the (copy of the) simulation grid and store the
+ * result in 'out'.
+ *
+ * NOTE: This method may be called from a background thread
+ * and must therefore not touch 'this->grid'.
+ */
+template<typename T>
+void DREAM::TransportPrescribed<T>::InterpolateSlice(const len_t i, real_t *out) {
+    DREAM::FVM::Interpolator3D intp3(
+        nr, np2, np1, r, p2, p1, coeff[i],
+        momtype, interpmethod, false
+    );
+    intp3.Eval(
+        this->gridNr, this->gridNp2, this->gridNp1,
+        this->gridR, this->gridP2, this->gridP1,
+        this->gridtype, out
+    );
+}
+
+/**
+ * Start interpolating the time slice with index 'i' onto
+ * the simulation grid on a background thread.
+ */
+template<typename T>
+void DREAM::TransportPrescribed<T>::StartPrefetch(const len_t i) {
+    if (this->prefetchIndex == i ||
+        this->windowIndex[0] == i || this->windowIndex[1] == i)
+        return;
+
+    WaitForPrefetch();
+
+    this->prefetchIndex = i;
+    real_t *out = this->prefetchBuffer;
+    this->prefetchTask = std::async(
+        std::launch::async, [this,i,out]() { this->InterpolateSlice(i, out); }
+    );
+}
+
+/**
+ * Wait for any ongoing background interpolation to finish.
+ * Exceptions thrown on the background thread are rethrown
+ * here.
+ */
+template<typename T>
+void DREAM::TransportPrescribed<T>::WaitForPrefetch() {
+    if (this->prefetchTask.valid())
+        this->prefetchTask.get();
+}
@@ -41,6 +41,8 @@ namespace DREAM {
         }
         bool IsActive() { return this->active; }
         const std::string& GetName() { return this->name; }
+        const std::string& GetDescription() { return this->description; }
+        FVM::QuantityData *GetQuantityData() { return this->data; }
 
         FVM::Grid *GetGrid() { return this->grid; }
 
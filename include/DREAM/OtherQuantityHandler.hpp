@@ -118,6 +118,7 @@ namespace DREAM {
         void DefineQuantities();
         OtherQuantity *GetByName(const std::string&);
         len_t GetNRegistered() const { return this->registered.size(); }
+        const std::vector<OtherQuantity*>& GetRegistered() const { return this->registered; }
 
         bool RegisterGroup(const std::string&);
         void RegisterQuantity(const std::string&, bool ignorefail=false);
@@ -125,6 +126,9 @@ namespace DREAM {
         void RegisterAllQuantities();
         void StoreAll(const real_t);
 
+        void SaveCheckpoint(SFile*, const std::string&);
+        void LoadCheckpoint(SFile*, const std::string&);
+
         void SaveSFile(SFile*, const std::string& path="other");
     };
 
@@ -31,6 +31,12 @@ namespace DREAM {
 
 		virtual void Save(bool current=false);
         virtual void SaveCurrent() { this->Save(true); }
+
+        // Called after the initial state has been set, before the
+        // first time step is taken
+        virtual void Initialize() {}
+        // Called after each time step which is saved
+        virtual void SaveStep(const real_t) {}
 	};
 
     class OutputGeneratorException : public DREAM::FVM::FVMException {
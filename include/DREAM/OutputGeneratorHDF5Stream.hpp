@@ -0,0 +1,57 @@
+#ifndef _DREAM_OUTPUT_GENERATOR_HDF5_STREAM_HPP
+#define _DREAM_OUTPUT_GENERATOR_HDF5_STREAM_HPP
+
+#include <H5Cpp.h>
+#include <string>
+#include <vector>
+#include "DREAM/OutputGeneratorSFile.hpp"
+#include "FVM/QuantityData.hpp"
+
+namespace DREAM {
+    class OutputGeneratorHDF5Stream : public OutputGeneratorSFile {
+    private:
+        // Quantity which is appended to the output file in every
+        // saved time step
+        struct stream_quantity {
+            H5::DataSet dataset;
+            FVM::QuantityData *data;
+            // Number of steps to keep in memory (1 = keep initial value)
+            len_t keep;
+            // Dimensions of one time step
+            hsize_t ndims;
+            hsize_t dims[4];
+            // Number of time steps written
+            hsize_t nt;
+        };
+
+        H5::H5File *h5 = nullptr;
+        H5::DataSet timeDataset;
+        hsize_t ntimes = 0;
+        std::vector<struct stream_quantity> quantities;
+
+        // Number of saved time steps between flushes of the
+        // output file (0 = flush only at end of simulation)
+        len_t flushInterval;
+        len_t nSinceFlush = 0;
+
+        void AddQuantity(const std::string&, FVM::QuantityData*, const len_t);
+        void AppendStep(struct stream_quantity&, const real_t*);
+        void AppendTime(const real_t);
+        void CreateGroup(const std::string&);
+        void OpenQuantity(const std::string&, FVM::QuantityData*, const len_t, const hsize_t);
+        void Resume();
+        void TruncateDataset(H5::DataSet&, const std::string&, const hsize_t);
+        void WriteSavedSteps();
+        void WriteAttribute(H5::DataSet&, const std::string&, const std::string&);
+
+    public:
+        OutputGeneratorHDF5Stream(EquationSystem*, const std::string&, const len_t flushInterval=1, bool savesettings=true);
+        virtual ~OutputGeneratorHDF5Stream();
+
+        virtual void Initialize() override;
+        virtual void Save(bool current=false) override;
+        virtual void SaveStep(const real_t) override;
+    };
+}
+
+#endif/*_DREAM_OUTPUT_GENERATOR_HDF5_STREAM_HPP*/
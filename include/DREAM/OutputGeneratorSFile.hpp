@@ -10,6 +10,8 @@ namespace DREAM {
 	protected:
         std::string filename;
 		SFile *sf=nullptr;
+        // If false, the time grid is not saved by 'SaveGrids()'
+        bool saveTimeGrid = true;
 
 		virtual void SaveGrids(const std::string&, bool) override;
 		virtual void SaveIonMetaData(const std::string&) override;
@@ -123,7 +123,20 @@ enum radialgrid_numeric_format {
 /////////////////////////////////////
 enum solver_type {
     SOLVER_TYPE_LINEARLY_IMPLICIT=1,
-    SOLVER_TYPE_NONLINEAR=2
+    SOLVER_TYPE_NONLINEAR=2,
+    SOLVER_TYPE_JFNK=3
+};
+// Method used for evaluating the jacobian matrix
+// in the non-linear solver
+enum solver_jacobian {
+    SOLVER_JACOBIAN_ANALYTICAL=1,
+    SOLVER_JACOBIAN_NUMERICAL=2     // colour-grouped finite differences
+};
+// Initial guess for the non-linear solver in each time step
+enum solver_predictor {
+    SOLVER_PREDICTOR_NONE=1,        // start from previous solution
+    SOLVER_PREDICTOR_LINEAR=2,      // linear extrapolation in time
+    SOLVER_PREDICTOR_QUADRATIC=3    // quadratic extrapolation in time
 };
 // Linear solver type (used by both the linear-implicit
 // and nonlinear solvers)
@@ -133,7 +146,20 @@ enum linear_solver {
     LINEAR_SOLVER_MUMPS=2,
     LINEAR_SOLVER_MKL=3,
     LINEAR_SOLVER_SUPERLU=4,
-    LINEAR_SOLVER_GMRES=5
+    LINEAR_SOLVER_GMRES=5,
+    LINEAR_SOLVER_MIXED_PRECISION=6     // approximate MUMPS factorization + iterative refinement
+};
+// Preconditioner used with the GMRES linear solver
+enum gmres_preconditioner {
+    GMRES_PRECONDITIONER_BLOCK_JACOBI=1,    // one block per unknown quantity
+    GMRES_PRECONDITIONER_FIELDSPLIT=2,      // multiplicative field split (field/fluid/kinetic)
+    GMRES_PRECONDITIONER_SCHUR=3            // Schur complement of the field equations
+};
+// Ordering of the matrix rows/columns used by the
+// direct linear solvers in the factorization
+enum linear_solver_ordering {
+    LINEAR_SOLVER_ORDERING_DEFAULT=1,   // fill-reducing ordering of the linear solver
+    LINEAR_SOLVER_ORDERING_RADIAL=2     // radius-major (interleaved) ordering of the unknowns
 };
 
 /////////////////////////////////////
@@ -144,7 +170,8 @@ enum linear_solver {
 enum timestepper_type {
     TIMESTEPPER_TYPE_CONSTANT=1,
     TIMESTEPPER_TYPE_ADAPTIVE=2,
-	TIMESTEPPER_TYPE_IONIZATION=3
+	TIMESTEPPER_TYPE_IONIZATION=3,
+    TIMESTEPPER_TYPE_EMBEDDED=4     // adaptive, with embedded error estimate
 };
 
 /////////////////////////////////////
@@ -252,6 +279,11 @@ enum collqty_screened_diffusion_mode {              // The energy diffusion freq
     COLLQTY_SCREENED_DIFFUSION_MODE_MAXWELLIAN = 2  // such that equilibrium distribution is Maxwellian
 };
 
+enum collqty_psi_mode {                 // The Psi functions of the full collision frequencies are evaluated
+    COLLQTY_PSI_MODE_QUADRATURE = 1,    // using adaptive quadrature
+    COLLQTY_PSI_MODE_TABULATED = 2      // by interpolation in a precomputed table
+};
+
 enum collqty_Eceff_mode {
     COLLQTY_ECEFF_MODE_EC_TOT = 1,      // Gives Ectot including all bound electrons (or Ec_free if no impurities/complete screening)
     COLLQTY_ECEFF_MODE_CYLINDRICAL = 2, // Sets Eceff using the Hesslow formula ignoring trapping effects.
@@ -1,6 +1,7 @@
 #ifndef _DREAM_PROCESS_SETTINGS_HPP
 #define _DREAM_PROCESS_SETTINGS_HPP
 
+#include <memory>
 #include "DREAM/ADAS.hpp"
 #include "DREAM/AMJUEL.hpp"
 #include "DREAM/ConvergenceChecker.hpp"
@@ -17,13 +18,16 @@
 #include "DREAM/Settings/Settings.hpp"
 #include "DREAM/Simulation.hpp"
 #include "DREAM/Solver/Solver.hpp"
+#include "DREAM/Solver/SolverJFNK.hpp"
 #include "DREAM/Solver/SolverLinearlyImplicit.hpp"
 #include "DREAM/Solver/SolverNonLinear.hpp"
 #include "DREAM/TimeStepper/TimeStepper.hpp"
 #include "DREAM/TimeStepper/TimeStepperAdaptive.hpp"
+#include "DREAM/TimeStepper/TimeStepperEmbedded.hpp"
 #include "DREAM/TimeStepper/TimeStepperConstant.hpp"
 #include "DREAM/TimeStepper/TimeStepperIonization.hpp"
 #include "FVM/Grid/Grid.hpp"
+#include "FVM/Grid/GridCache.hpp"
 #include "FVM/Grid/PXiGrid/PXiMomentumGrid.hpp"
 #include "FVM/Grid/RadialGrid.hpp"
 #include "FVM/Interpolator1D.hpp"
@@ -62,6 +66,7 @@ namespace DREAM {
 
 
         static FVM::Grid *ConstructRadialGrid(Settings*);
+        static std::unique_ptr<FVM::GridCache> ConstructGridCache(Settings*);
         static FVM::RadialGrid *ConstructRadialGrid_Cylindrical(const int_t, Settings*);
         static FVM::RadialGrid *ConstructRadialGrid_ToroidalAnalytical(const int_t, Settings*);
         static FVM::RadialGrid *ConstructRadialGrid_Numerical(const int_t, Settings*);
@@ -231,6 +236,7 @@ namespace DREAM {
 
         // Routines for constructing time steppers
         static TimeStepperAdaptive *ConstructTimeStepper_adaptive(Settings*, FVM::UnknownQuantityHandler*, std::vector<len_t>*);
+        static TimeStepperEmbedded *ConstructTimeStepper_embedded(Settings*, FVM::UnknownQuantityHandler*, std::vector<len_t>*);
         static TimeStepperConstant *ConstructTimeStepper_constant(Settings*, FVM::UnknownQuantityHandler*);
         static TimeStepperIonization *ConstructTimeStepper_ionization(Settings*, FVM::UnknownQuantityHandler*);
 
@@ -267,6 +273,7 @@ namespace DREAM {
 
         // Routines for constructing solvers
         static SolverLinearlyImplicit *ConstructSolver_linearly_implicit(Settings*, FVM::UnknownQuantityHandler*, std::vector<UnknownQuantityEquation*>*, EquationSystem*);
+        static SolverJFNK *ConstructSolver_jfnk(Settings*, FVM::UnknownQuantityHandler*, std::vector<UnknownQuantityEquation*>*, EquationSystem*);
         static SolverNonLinear *ConstructSolver_nonlinear(Settings*, FVM::UnknownQuantityHandler*, std::vector<UnknownQuantityEquation*>*, EquationSystem*);
     };
 }
@@ -14,8 +14,10 @@
 #include "DREAM/UnknownQuantityEquation.hpp"
 #include "DREAM/Equations/SPIHandler.hpp"
 #include "FVM/BlockMatrix.hpp"
+#include "FVM/COOMatrix.hpp"
 #include "FVM/FVMException.hpp"
 #include "FVM/MatrixInverter.hpp"
+#include "FVM/Solvers/MIGMRES.hpp"
 #include "FVM/TimeKeeper.hpp"
 #include "FVM/UnknownQuantityHandler.hpp"
 
@@ -53,6 +55,24 @@ namespace DREAM {
         FVM::MatrixInverter *mainInverter=nullptr;
         // Robust backup inverter to use if necessary
         FVM::MatrixInverter *backupInverter=nullptr;
+        // If true, direct inverters reuse the symbolic factorization
+        // (ordering and fill) of the first matrix they factorize
+        bool reuseSymbolicFactorization = false;
+        // Ordering of the matrix rows/columns to use in the
+        // factorizations of the direct inverters
+        enum OptionConstants::linear_solver_ordering matrixOrdering =
+            OptionConstants::LINEAR_SOLVER_ORDERING_DEFAULT;
+        // Preconditioner to use with the GMRES linear solver
+        enum OptionConstants::gmres_preconditioner gmresPreconditioner =
+            OptionConstants::GMRES_PRECONDITIONER_BLOCK_JACOBI;
+        // Preconditioner reuse policy and number of Krylov
+        // recycling vectors of the GMRES linear solver
+        len_t gmresMaxPCReuse = 0, gmresMaxPCIterations = 0, gmresRecycle = 0;
+        // Accuracy of the factorization, and tolerance and maximum
+        // number of iterations of the iterative refinement, used by
+        // the mixed-precision linear solver
+        real_t mixedEpsilon = 1e-7, mixedRelTol = 1e-10;
+        len_t mixedMaxIter = 20;
 
         SPIHandler *SPI;
 
@@ -60,9 +80,59 @@ namespace DREAM {
             timerTot, timerCqh, timerREFluid, timerRebuildTerms;*/
         FVM::TimeKeeper *solver_timeKeeper;
         len_t timerTot, timerCqh, timerREFluid, timerSPIHandler, timerRebuildTerms;
+        // Timings for the rebuild of each individual equation term
+        FVM::TimeKeeper *terms_timeKeeper;
+
+        // Operator applied to unknown 'operandId' in the
+        // equation for unknown 'uqnId'
+        struct operator_task {
+            len_t uqnId;
+            len_t operandId;
+            FVM::Operator *op;
+
+            // Unknowns with respect to which the operator (or its
+            // boundary conditions) has a non-empty jacobian block
+            std::vector<len_t> jacDerivIds, jacBCDerivIds;
+        };
+
+        // List of all operators in the equation system (in the order
+        // they appear in the equations for the non-trivial unknowns)
+        std::vector<struct operator_task> operatorTasks;
+
+        // If true, independent operators are rebuilt in parallel
+        bool parallelRebuild = false;
+        // If true, the jacobian contributions of independent
+        // operators are evaluated in parallel
+        bool parallelJacobian = false;
+        // Groups of operators (indices into 'operatorTasks') which may
+        // be rebuilt/differentiated concurrently with other groups
+        // (operators within a group are processed in order)
+        std::vector<std::vector<len_t>> operatorGroups;
+        // Per-group buffers for jacobian contributions
+        std::vector<FVM::COOMatrix*> jacobianBuffers;
+
+        // Flag indicating whether the non-empty jacobian blocks
+        // ('jacDerivIds' and 'jacBCDerivIds') have been determined
+        bool jacobianPatternBuilt = false;
+        // If true, blocks outside of the jacobian pattern are
+        // evaluated in every iteration to verify that they are empty
+        bool validateJacobianPattern = false;
+        // Buffer used for detecting non-empty jacobian blocks
+        FVM::COOMatrix *jacobianProbe = nullptr;
+
+        void BuildRebuildSchedule();
+        void BuildJacobianParallel(FVM::BlockMatrix*);
+        void ProbeJacobianPattern(FVM::BlockMatrix*, bool);
+        void ApplyJacobianBC(FVM::BlockMatrix*, bool);
 
         virtual void initialize_internal(const len_t, std::vector<len_t>&) {}
 
+        std::vector<PetscInt> ConstructRadialOrdering();
+        std::vector<FVM::MIGMRES::split> ConstructFieldSplits(const bool);
+
+        void SaveCheckpointList(SFile*, const std::string&, const std::vector<len_t>&);
+        void LoadCheckpointList(SFile*, const std::string&, std::vector<len_t>&);
+
     public:
         Solver(
             FVM::UnknownQuantityHandler*, std::vector<UnknownQuantityEquation*>*,
@@ -72,6 +142,7 @@ namespace DREAM {
         virtual ~Solver();
 
         void BuildJacobian(const real_t, const real_t, FVM::BlockMatrix*);
+        void BuildJacobianDiagonalBlocks(FVM::BlockMatrix*);
         void BuildMatrix(const real_t, const real_t, FVM::BlockMatrix*, real_t*);
         void BuildVector(const real_t, const real_t, real_t*, FVM::BlockMatrix*);
         void RebuildTerms(const real_t, const real_t);
@@ -99,6 +170,23 @@ namespace DREAM {
 
         virtual void SetIonHandler(IonHandler *ih) 
             {this->ionHandler = ih;}
+        void SetParallelRebuild(bool p) { this->parallelRebuild = p; }
+        void SetParallelJacobian(bool p) { this->parallelJacobian = p; }
+        void SetValidateJacobianPattern(bool v) { this->validateJacobianPattern = v; }
+        void SetReuseSymbolicFactorization(bool);
+        void SetMatrixOrdering(enum OptionConstants::linear_solver_ordering);
+        void SetGMRESPreconditioner(enum OptionConstants::gmres_preconditioner p)
+        { this->gmresPreconditioner = p; }
+        void SetMixedPrecision(const real_t epsilon, const real_t reltol, const len_t maxiter) {
+            this->mixedEpsilon = epsilon;
+            this->mixedRelTol = reltol;
+            this->mixedMaxIter = maxiter;
+        }
+        void SetGMRESReuse(const len_t maxReuse, const len_t maxIterations, const len_t recycle) {
+            this->gmresMaxPCReuse = maxReuse;
+            this->gmresMaxPCIterations = maxIterations;
+            this->gmresRecycle = recycle;
+        }
         virtual void SetInitialGuess(const real_t*) = 0;
         virtual void Solve(const real_t t, const real_t dt) = 0;
 
@@ -119,6 +207,11 @@ namespace DREAM {
         void SwitchToMainInverter();
 
         virtual void WriteDataSFile(SFile*, const std::string&);
+
+        // Save/restore the solver statistics collected so far
+        // (used when resuming a simulation from a checkpoint)
+        virtual void SaveCheckpoint(SFile*, const std::string&) {}
+        virtual void LoadCheckpoint(SFile*, const std::string&) {}
     };
 
     class SolverException : public DREAM::FVM::FVMException {
@@ -0,0 +1,99 @@
+#ifndef _DREAM_SOLVER_JFNK_HPP
+#define _DREAM_SOLVER_JFNK_HPP
+
+#include "FVM/config.h"
+
+#include <petsc.h>
+#include <vector>
+#include "DREAM/EquationSystem.hpp"
+#include "DREAM/Solver/Solver.hpp"
+#include "DREAM/UnknownQuantityEquation.hpp"
+#include "FVM/BlockMatrix.hpp"
+#include "FVM/TimeKeeper.hpp"
+#include "FVM/UnknownQuantityHandler.hpp"
+
+namespace DREAM {
+    class SolverJFNK : public Solver {
+    private:
+        // Block-diagonal part of the jacobian matrix (used as preconditioner)
+        FVM::BlockMatrix *precMatrix = nullptr;
+        // Matrix-free jacobian operator
+        Mat jacobianShell = nullptr;
+        KSP ksp = nullptr;
+        Vec petsc_F = nullptr, petsc_dx = nullptr, petsc_scale = nullptr;
+        EquationSystem *eqsys;
+
+        len_t maxiter=100;
+        real_t reltol=1e-6;
+        bool verbose=false;
+
+        // Krylov solver settings
+        len_t kspMaxIter=200;
+        real_t kspRelTol=1e-4;
+
+        len_t iteration=0, nTimeStep=0;
+        real_t t, dt;
+        // x0:     Current solution estimate
+        // x1:     Next solution estimate
+        // dx:     Newton step
+        // xh, Fh: Perturbed solution and corresponding residual
+        // F0:     Residual in 'x0'
+        // scale:  Diagonal of the scaling matrix S
+        real_t
+            *x0=nullptr, *x1=nullptr, *dx=nullptr, *xh=nullptr,
+            *Fh=nullptr, *F0=nullptr, *scale=nullptr;
+
+        FVM::TimeKeeper *timeKeeper;
+        len_t timerTot, timerRebuild, timerResidual, timerPreconditioner, timerKrylov;
+
+        std::vector<len_t> nIterations;
+        std::vector<len_t> nKrylovIterations;
+        len_t nKrylovIterationsStep = 0;
+
+    protected:
+        virtual void initialize_internal(const len_t, std::vector<len_t>&) override;
+
+        void _EvaluateF(const real_t*, real_t*);
+        void _InternalSolve();
+        void BuildScaling();
+
+    public:
+        SolverJFNK(
+            FVM::UnknownQuantityHandler*,
+            std::vector<UnknownQuantityEquation*>*, EquationSystem*,
+            const int_t maxiter=100, const real_t reltol=1e-6,
+            bool verbose=false
+        );
+        virtual ~SolverJFNK();
+
+        void Allocate();
+        void Deallocate();
+
+        void ApplyJacobian(Vec, Vec);
+
+        len_t GetIteration() const { return this->iteration; }
+        len_t MaxIter() const { return this->maxiter; }
+        bool Verbose() const  { return this->verbose; }
+
+        void SetKrylovSettings(const len_t maxiter, const real_t reltol)
+        { this->kspMaxIter = maxiter; this->kspRelTol = reltol; }
+
+        bool IsConverged(const real_t*, const real_t*);
+
+        virtual void SetInitialGuess(const real_t*) override;
+        virtual void Solve(const real_t, const real_t) override;
+
+        const real_t *TakeNewtonStep();
+        const real_t *UpdateSolution(const real_t*);
+
+        virtual void PrintTimings() override;
+        virtual void SaveTimings(SFile*, const std::string& path="") override;
+
+        virtual void WriteDataSFile(SFile*, const std::string&) override;
+
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
+    };
+}
+
+#endif/*_DREAM_SOLVER_JFNK_HPP*/
@@ -57,6 +57,9 @@ namespace DREAM {
         void SetDebugMode(bool, bool, bool, int_t, bool);
 
         virtual void WriteDataSFile(SFile*, const std::string&) override;
+
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
     };
 }
 
@@ -29,6 +29,26 @@ namespace DREAM {
 		real_t *x0, *x1, *dx, *xinit;
 		real_t *x_2norm, *dx_2norm;
 
+        // Backtracking line search: the Newton step is shortened until
+        // the (weighted) residual norm has decreased sufficiently
+        bool lineSearch = false;
+        // Maximum number of step reductions per iteration
+        static const len_t MAX_BACKTRACKS = 8;
+        // Sufficient decrease parameter (Armijo condition)
+        static constexpr real_t ARMIJO_C = 1e-4;
+        // Step length given by 'MaximalPhysicalStepLength()'
+        real_t physicalDamping = 1;
+        // Residual in the trial point of the line search
+        real_t *Ftrial;
+        // Per-unknown 2-norms of the residual in the current point
+        // and the trial point
+        real_t *F0_2norm, *Ftrial_2norm;
+        // If true, 'Ftrial' contains the residual in the current
+        // solution estimate and the equation terms are up-to-date
+        bool residualValid = false;
+        len_t nBacktracksStep = 0;
+        real_t minStepLengthStep = 1;
+
         FVM::TimeKeeper *timeKeeper;
         len_t timerTot, timerRebuild, timerResidual, timerJacobian, timerInvert;
 
@@ -37,15 +57,53 @@ namespace DREAM {
             savevector = false, savenumjac = false, savesystem = false, debugrescaled = false;
         len_t savetimestep = 0, saveiteration = 1;
 
+        // Jacobian lagging: the factorization of the jacobian is reused
+        // in at most 'maxJacobianLag' consecutive iterations, as long as
+        // the convergence rate remains below 'maxLagRate'
+        len_t maxJacobianLag = 0;
+        real_t maxLagRate = 0.5;
+        // Number of iterations since the jacobian was last built
+        len_t jacobianAge = 0;
+        // Time step for which the jacobian was last built
+        real_t jacobianDt = 0;
+        // Inverter holding the factorization of the current jacobian
+        FVM::MatrixInverter *factorizedInverter = nullptr;
+        len_t nJacobiansStep = 0;
+
+        // Method used for evaluating the jacobian
+        enum OptionConstants::solver_jacobian jacobianMode = OptionConstants::SOLVER_JACOBIAN_ANALYTICAL;
+        // Non-zero pattern of the jacobian matrix in compressed row
+        // and column format (see '_BuildJacobianColoring()'), and groups
+        // of columns which do not share any rows, used when evaluating
+        // the jacobian numerically
+        std::vector<PetscInt> numjacRowPtr, numjacCols;
+        std::vector<PetscInt> numjacColPtr, numjacColRows, numjacColPos;
+        std::vector<std::vector<PetscInt>> numjacGroups;
+
+        // Extrapolation of the solution from previous time steps,
+        // used as initial guess for the Newton iteration
+        enum OptionConstants::solver_predictor predictor = OptionConstants::SOLVER_PREDICTOR_NONE;
+        // Order of the extrapolation actually used in each time step
+        // (lower than requested when not enough history is available)
+        std::vector<len_t> predictorOrder;
+
         std::vector<len_t> nIterations;
+        std::vector<len_t> nJacobians;
         std::vector<bool> usedBackupInverter;
+        std::vector<len_t> nBacktracks;
+        std::vector<real_t> minStepLength;
 
 	protected:
 		virtual void initialize_internal(const len_t, std::vector<len_t>&) override;
 
         void _EvaluateF(const real_t*, real_t*, FVM::BlockMatrix*);
-        void _EvaluateJacobianNumerically(FVM::BlockMatrix*);
+        void _BuildJacobianColoring();
+        void _EvaluateJacobianNumerically(FVM::BlockMatrix*, bool printProgress=false);
         void _InternalSolve();
+        len_t Predict();
+        bool UseLaggedJacobian();
+        const real_t *LineSearch(const real_t*);
+        real_t ResidualMerit(const real_t*);
 
 	public:
 		SolverNonLinear(
@@ -60,6 +118,7 @@ namespace DREAM {
 
 		void Allocate();
         void AllocateJacobianMatrix();
+        FVM::BlockMatrix *ConstructJacobianMatrix();
 		void Deallocate();
 		const std::string& GetNonTrivialName(const len_t);
 
@@ -74,6 +133,11 @@ namespace DREAM {
 
 		// Setters
 		void SetIteration(const len_t i) { this->iteration = i; }
+        void SetJacobianLag(const len_t maxlag, const real_t maxrate)
+        { this->maxJacobianLag = maxlag; this->maxLagRate = maxrate; }
+        void SetLineSearch(bool ls) { this->lineSearch = ls; }
+        void SetJacobianMode(enum OptionConstants::solver_jacobian m) { this->jacobianMode = m; }
+        void SetPredictor(enum OptionConstants::solver_predictor p) { this->predictor = p; }
 
 		bool IsConverged(const real_t*, const real_t*);
 
@@ -101,7 +165,15 @@ namespace DREAM {
         virtual void SwitchToBackupInverter() override;
 
         virtual void WriteDataSFile(SFile*, const std::string&) override;
+
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
 	};
 }
 
+const real_t MaximalPhysicalStepLength(
+    real_t*, const real_t*, len_t, std::vector<len_t>,
+    DREAM::FVM::UnknownQuantityHandler*, DREAM::IonHandler*, len_t&
+);
+
 #endif/*_DREAM_SOLVER_NON_LINEAR_HPP*/
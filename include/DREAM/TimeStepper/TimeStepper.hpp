@@ -1,6 +1,8 @@
 #ifndef _DREAM_TIME_STEPPER_HPP
 #define _DREAM_TIME_STEPPER_HPP
 
+#include <string>
+#include <softlib/SFile.h>
 #include "DREAM/Solver/Solver.hpp"
 #include "FVM/FVMException.hpp"
 #include "FVM/UnknownQuantityHandler.hpp"
@@ -27,6 +29,12 @@ namespace DREAM {
         virtual void PrintProgress() = 0;
         virtual void ValidateStep() = 0;
 
+        // Returns 'true' if the full state of the time stepper can
+        // be written to a checkpoint after the most recent step
+        virtual bool CanCheckpoint() { return true; }
+        virtual void SaveCheckpoint(SFile*, const std::string&) = 0;
+        virtual void LoadCheckpoint(SFile*, const std::string&) = 0;
+
         void SetSolver(Solver *s) { this->solver = s; }
     };
 
@@ -102,6 +102,10 @@ namespace DREAM {
         virtual real_t NextTime() override;
         virtual void ValidateStep() override;
 
+        virtual bool CanCheckpoint() override;
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
+
         virtual void PrintProgress() override;
     };
 }
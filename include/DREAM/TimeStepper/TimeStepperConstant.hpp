@@ -31,6 +31,9 @@ namespace DREAM {
         virtual real_t NextTime() override;
         virtual void PrintProgress() override;
         virtual void ValidateStep() override;
+
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
     };
 }
 
@@ -0,0 +1,91 @@
+#ifndef _DREAM_TIME_STEPPER_EMBEDDED_HPP
+#define _DREAM_TIME_STEPPER_EMBEDDED_HPP
+
+#include <vector>
+#include "DREAM/ConvergenceChecker.hpp"
+#include "DREAM/TimeStepper/TimeStepper.hpp"
+
+namespace DREAM {
+    class TimeStepperEmbedded : public TimeStepper {
+    private:
+        real_t tMax, dt;
+        // Time of the most recently accepted solution, and
+        // length of the step currently being taken
+        real_t currentTime=0, stepDt=0;
+        len_t currentStep = 1;
+
+        // List of non-trivial unknowns
+        std::vector<len_t> nontrivials;
+        // Object used to evaluate norms of solution vectors
+        ConvergenceChecker *convChecker;
+        // Number of time steps taken which have resulted in an exception (in a row)
+        len_t stepsWithException = 0;
+
+        // Maximum number of times the solver may throw an exception
+        // without us rethrowing it
+        const len_t MAX_STEPS_WITH_EXCEPTION=5;
+        // Factor by which the time step is reduced when an exception
+        // is caught.
+        const real_t STEP_REDUCTION_AT_EXCEPTION=0.2;
+        // Safety factor, and bounds on the factor by which the
+        // time step may change between two steps
+        const real_t SAFETY_FACTOR=0.9;
+        const real_t MIN_STEP_CHANGE=0.2, MAX_STEP_CHANGE=5;
+
+        // Set to true if the most recently taken time step was
+        // accepted (i.e. if its estimated error was smaller than
+        // the tolerance)
+        bool stepSucceeded = false;
+        // If true, the most recently taken step was rejected and
+        // the solution must be restored before the next step
+        bool restoreSolution = false;
+
+        // If true, generates excessive output to stdout
+        bool verbose = false;
+
+        // Total length of progress bar (including percentage)
+        const len_t PROGRESSBAR_LENGTH = 80;
+
+        len_t sol_size=0;
+        // Solution obtained in the most recent step
+        real_t *sol=nullptr;
+        // Second-order estimate of the same solution
+        real_t *sol_ref=nullptr;
+        // Solutions in the two steps before the previous one
+        real_t *sol_old=nullptr, *sol_old2=nullptr;
+
+        // PRIVATE METHODS
+        void AllocateSolutions(const len_t);
+        void DeallocateSolutions();
+        void RestorePreviousSolution();
+        bool UpdateStep();
+
+    public:
+        TimeStepperEmbedded(
+            const real_t tMax, const real_t dt0, FVM::UnknownQuantityHandler*,
+            std::vector<len_t>&, ConvergenceChecker*, bool verbose=false
+        );
+        ~TimeStepperEmbedded();
+
+        virtual real_t CurrentTime() const override { return this->currentTime; }
+        virtual void HandleException(FVM::FVMException&) override;
+        virtual bool IsFinished() override { return (this->currentTime >= this->tMax); }
+        virtual bool IsSaveStep() override { return this->stepSucceeded; }
+        virtual real_t NextTime() override;
+        virtual void ValidateStep() override;
+
+        virtual bool CanCheckpoint() override { return this->stepSucceeded; }
+        virtual void SaveCheckpoint(SFile*, const std::string&) override;
+        virtual void LoadCheckpoint(SFile*, const std::string&) override;
+
+        virtual void PrintProgress() override;
+
+        static void EstimateSolution(
+            const len_t, const real_t, const real_t[3],
+            const real_t*, const real_t*, const real_t*,
+            const real_t*, real_t*, const len_t
+        );
+    };
+}
+
+#endif/*_DREAM_TIME_STEPPER_EMBEDDED_HPP*/
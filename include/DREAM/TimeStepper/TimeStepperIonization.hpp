@@ -38,6 +38,9 @@ namespace DREAM {
 		virtual real_t NextTime() override;
 		virtual void ValidateStep() override;
 
+		virtual void SaveCheckpoint(SFile*, const std::string&) override;
+		virtual void LoadCheckpoint(SFile*, const std::string&) override;
+
 		real_t GetIonizationTimeScale();
 
 		virtual void PrintProgress() override;
@@ -39,6 +39,7 @@ namespace DREAM {
         len_t NumberOfElements() const { return this->uqty->NumberOfElements(); }
         len_t NumberOfNonZeros();
         len_t NumberOfNonZeros_jac();
+        len_t NumberOfNonZeros_jac(const len_t);
 
         bool IsEvaluable();
         FVM::PredeterminedParameter *GetPredetermined();
@@ -29,6 +29,7 @@ namespace DREAM::FVM {
 
             // Block API
             void ConstructSystem();
+            void ConstructSystem(const std::vector<PetscInt>&);
             len_t CreateSubEquation(const PetscInt, const PetscInt, const PetscInt id=-1);
             PetscInt GetOffset(const PetscInt);
             PetscInt GetOffsetById(const PetscInt);
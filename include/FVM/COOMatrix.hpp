@@ -0,0 +1,51 @@
+#ifndef _DREAM_FVM_COO_MATRIX_HPP
+#define _DREAM_FVM_COO_MATRIX_HPP
+
+#include <petscmat.h>
+#include <vector>
+#include "FVM/config.h"
+#include "FVM/Matrix.hpp"
+
+namespace DREAM::FVM {
+    /**
+     * Matrix which, instead of inserting elements into a PETSc
+     * matrix directly, accumulates them as (row, column, value)
+     * triplets. The elements can later be added to a regular
+     * 'Matrix' in one go using 'AddTo()'. This allows several
+     * threads to fill separate buffers concurrently, while the
+     * (non thread-safe) insertion into the PETSc matrix is done
+     * serially.
+     */
+    class COOMatrix : public Matrix {
+        private:
+            std::vector<PetscInt> rows, cols;
+            std::vector<PetscScalar> vals;
+            // Number of elements set since the buffer was last
+            // cleared (including zeros, which are not stored)
+            len_t nTouched = 0;
+
+        public:
+            COOMatrix(const PetscInt, const PetscInt);
+            virtual ~COOMatrix();
+
+            void AddTo(Matrix*);
+            void Clear();
+            len_t Size() const { return this->vals.size(); }
+            len_t NumberOfTouched() const { return this->nTouched; }
+
+            virtual void Destroy() override {}
+
+            virtual void SetElement(
+                const PetscInt, const PetscInt,
+                const PetscScalar, InsertMode im=ADD_VALUES
+            ) override;
+            virtual void SetRow(
+                PetscInt, const PetscInt,
+                PetscInt*, const PetscScalar*,
+                InsertMode im=ADD_VALUES
+            ) override;
+            virtual void SetDiagonalConstant(const PetscInt, const PetscInt[], const PetscReal) override;
+    };
+}
+
+#endif/*_DREAM_FVM_COO_MATRIX_HPP*/
@@ -12,6 +12,19 @@ namespace DREAM::FVM {
         std::vector<len_t> derivIdsJacobian;
         std::vector<len_t> derivNMultiplesJacobian;
 
+        // If true, this term has declared that 'Rebuild()' and
+        // 'SetJacobianBlock()' only modify data owned by the term
+        // itself, or by the objects listed in 'rebuildDependencies',
+        // so that it may be processed concurrently with other terms.
+        // Terms which have not opted in are always processed serially.
+        bool rebuildThreadSafe = false;
+
+        // Objects holding cached data which this term modifies in
+        // 'Rebuild()' or 'SetJacobianBlock()' (e.g. GSL workspaces/
+        // accelerators owned by some other object). Thread-safe terms
+        // sharing any such object are never processed concurrently.
+        std::vector<const void*> rebuildDependencies;
+
     protected:
         std::string name = "<NOT SET>";
 
@@ -29,6 +42,14 @@ namespace DREAM::FVM {
         void AddUnknownForJacobian(FVM::UnknownQuantityHandler *u, const char *UQTY){
             AddUnknownForJacobian(u, u->GetUnknownID(UQTY));
         }
+        // Declares that this term may be rebuilt/differentiated concurrently with other terms
+        void SetRebuildThreadSafe(bool s=true) {
+            rebuildThreadSafe = s;
+        }
+        // Declares that 'obj' holds cached data modified when rebuilding/differentiating this term
+        void AddRebuildDependency(const void *obj) {
+            rebuildDependencies.push_back(obj);
+        }
         // Returns total number of multiples of the jacobian contributions
         len_t GetNumberOfMultiplesJacobian() const {
             len_t nnz = 0; 
@@ -91,6 +112,8 @@ namespace DREAM::FVM {
 
         std::vector<len_t> GetDerivIdsJacobian(){return derivIdsJacobian;}
         std::vector<len_t> GetNMultiplesJacobian(){return derivNMultiplesJacobian;}
+        const std::vector<const void*>& GetRebuildDependencies() const { return this->rebuildDependencies; }
+        bool IsRebuildThreadSafe() const { return this->rebuildThreadSafe; }
     };
 
     class EquationTermException : public FVMException {
@@ -19,7 +19,9 @@ namespace DREAM::FVM {
 
     public:
         IdentityTerm(Grid* g, const real_t scaleFactor=1.0) 
-            : DiagonalLinearTerm(g), scaleFactor(scaleFactor) {}
+            : DiagonalLinearTerm(g), scaleFactor(scaleFactor) {
+            SetRebuildThreadSafe();
+        }
 
     };
 }
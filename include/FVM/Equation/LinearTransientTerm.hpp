@@ -16,6 +16,12 @@ namespace DREAM::FVM {
         len_t unknownId;
         // Differentiated quantity at the previous time step
         real_t *xn;
+        // Differentiated quantity two time steps back (only
+        // used with the second-order time discretization)
+        const real_t *xnm1 = nullptr;
+        // Coefficients of the time discretization (see
+        // UnknownQuantityHandler::GetTransientCoefficients())
+        real_t coeff[3] = {1, -1, 0};
     protected:
         virtual bool TermDependsOnUnknowns() override {return false;}
         virtual bool AddWeightsJacobian(const len_t, const len_t, Matrix*, const real_t*) override {return false;}
@@ -9,6 +9,7 @@
 #include "FVM/Equation/EvaluableEquationTerm.hpp"
 #include "FVM/Equation/PredeterminedParameter.hpp"
 #include "FVM/Grid/Grid.hpp"
+#include "FVM/TimeKeeper.hpp"
 
 namespace DREAM::FVM {
     class OperatorException : public FVMException {
@@ -35,8 +36,22 @@ namespace DREAM::FVM {
 
         real_t *vectorElementsSingleTerm=nullptr;
 
+        // Timers measuring the time spent rebuilding each term of this
+        // operator (only used if a TimeKeeper has been assigned)
+        TimeKeeper *rebuildTimeKeeper = nullptr;
+        std::vector<len_t> rebuildTimers;
+
         void MakeIdentifiable(int_t, EquationTerm*);
 
+        void StartRebuildTimer(const len_t k) {
+            if (this->rebuildTimeKeeper != nullptr)
+                this->rebuildTimeKeeper->StartTimer(this->rebuildTimers[k]);
+        }
+        void StopRebuildTimer(const len_t k) {
+            if (this->rebuildTimeKeeper != nullptr)
+                this->rebuildTimeKeeper->StopTimer(this->rebuildTimers[k]);
+        }
+
     public:
         Operator(Grid*);
 
@@ -101,6 +116,7 @@ namespace DREAM::FVM {
 
         len_t GetNumberOfNonZerosPerRow() const;
         len_t GetNumberOfNonZerosPerRow_jac() const;
+        len_t GetNumberOfNonZerosPerRow_jac(const len_t, const len_t) const;
         PredeterminedParameter *GetPredetermined() { return this->predetermined; }
         AdvectionDiffusionTerm *GetAdvectionDiffusion() const { return this->adterm; }
         /**
@@ -111,6 +127,10 @@ namespace DREAM::FVM {
         bool IsEvaluable() const;
 
         void RebuildTerms(const real_t, const real_t, UnknownQuantityHandler*);
+        void GetRebuildDependencies(std::vector<const void*>&) const;
+        bool IsRebuildThreadSafe() const;
+        bool HasJacobianContribution(const len_t, const len_t) const;
+        void SetRebuildTimeKeeper(TimeKeeper*, const std::string&, const std::string&);
 
         bool SetJacobianBlock(const len_t uqtyId, const len_t derivId, Matrix*, const real_t*, bool printTerms=false);
         bool SetJacobianBlockBC(const len_t uqtyId, const len_t derivId, Matrix*, const real_t*, bool printTerms=false);
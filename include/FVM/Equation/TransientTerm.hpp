@@ -5,6 +5,8 @@
  * -- ~ -------------
  * dt        dt
  *
+ * (or the second-order BDF2 formula, if selected; see
+ * LinearTransientTerm)
  */
 
 
@@ -24,7 +26,9 @@ namespace DREAM::FVM {
         }
     public:
         TransientTerm(Grid* g, const len_t unknownId, real_t scaleFactor = 1.0) 
-            : LinearTransientTerm(g,unknownId), scaleFactor(scaleFactor) {} 
+            : LinearTransientTerm(g,unknownId), scaleFactor(scaleFactor) {
+            SetRebuildThreadSafe();
+        }
     };
 }
 
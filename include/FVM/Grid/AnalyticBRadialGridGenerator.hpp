@@ -58,6 +58,8 @@ namespace DREAM::FVM {
 		real_t InterpolateInputTriangularityDeriv(real_t r);
 		real_t InterpolateInputShafranovShift(real_t r);
 		real_t InterpolateInputShafranovShiftDeriv(real_t r);
+
+        bool FindMinorRadiusNewton(const real_t, const real_t, const len_t, const real_t, const real_t, real_t&);
 			
         gsl_spline *spline_G=nullptr, *spline_psi=nullptr, *spline_kappa=nullptr, *spline_delta=nullptr, *spline_Delta=nullptr;
         gsl_interp_accel *gsl_acc_G, *gsl_acc_psi, *gsl_acc_kappa, *gsl_acc_delta, *gsl_acc_Delta;
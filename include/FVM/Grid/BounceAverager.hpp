@@ -35,13 +35,19 @@ namespace DREAM::FVM {
         real_t *theta_trapped_ref;
         real_t *weights_trapped_ref;
 
+        // true once Rebuild() has allocated the bounce surface data
+        bool isBuilt = false;
+
         // true if evaluate bounce integral with adaptive quadrature
         bool integrateTrappedAdaptive = false; //...for trapped orbits
         bool integratePassingAdaptive = false; //...for passing orbits
 
         gsl_integration_fixed_workspace *gsl_w = nullptr;
-        gsl_integration_workspace *gsl_adaptive = nullptr;
-        gsl_root_fsolver *gsl_fsolver = nullptr;
+        // One adaptive-quadrature workspace and root solver per
+        // OpenMP thread (see FluxSurfaceAverager::GetThreadIndex())
+        len_t nThreads;
+        gsl_integration_workspace **gsl_adaptive = nullptr;
+        gsl_root_fsolver **gsl_fsolver = nullptr;
         gsl_integration_qaws_table *qaws_table;
         int QAG_KEY = GSL_INTEG_GAUSS41;
         
@@ -95,7 +101,7 @@ namespace DREAM::FVM {
         ~BounceAverager();
 
         real_t CalculateBounceAverage(len_t ir, len_t i, len_t j, fluxGridType fluxGridType, real_t(*F)(real_t,real_t,real_t,real_t,void*), void *par, const int_t *F_list=nullptr);
-        void Rebuild();
+        void Rebuild(bool bounceDataLoaded=false);
 
         BounceSurfaceQuantity *GetBOverBmin(){return BOverBmin;}
         BounceSurfaceQuantity *GetROverR0(){return ROverR0;}
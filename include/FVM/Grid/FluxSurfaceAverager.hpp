@@ -76,9 +76,13 @@ namespace DREAM::FVM {
             *NablaR2 = nullptr;
         
         gsl_integration_fixed_workspace *gsl_w = nullptr;
-        gsl_integration_workspace *gsl_adaptive;
-        gsl_integration_workspace *gsl_adaptive_outer;
-        gsl_root_fsolver *gsl_fsolver;
+        // Workspaces for the adaptive quadratures and root finding,
+        // one per OpenMP thread (indexed with GetThreadIndex()) so
+        // that averages can be evaluated on several radii at once
+        len_t nThreads;
+        gsl_integration_workspace **gsl_adaptive;
+        gsl_integration_workspace **gsl_adaptive_outer;
+        gsl_root_fsolver **gsl_fsolver;
         gsl_integration_qaws_table *qaws_table;
         int QAG_KEY = GSL_INTEG_GAUSS41;
 
@@ -117,7 +121,7 @@ namespace DREAM::FVM {
         );
         ~FluxSurfaceAverager();
 
-        void Rebuild();
+        void Rebuild(bool evaluateVpVol=true);
 
         real_t EvaluateFluxSurfaceIntegral(len_t ir, fluxGridType, real_t(*F)(real_t,real_t,real_t,void*), void *par=nullptr, const int_t *F_list=nullptr);
         real_t CalculateFluxSurfaceAverage(len_t ir, fluxGridType, real_t(*F)(real_t,real_t,real_t,void*), void *par=nullptr, const int_t *F_list=nullptr);
@@ -191,6 +195,9 @@ namespace DREAM::FVM {
         static void FindBouncePoints(len_t ir, real_t Bmin, real_t theta_Bmin, real_t theta_Bmax, FluxSurfaceAverager*, real_t xi0, fluxGridType, real_t *thetab_1, real_t *thetab_2, gsl_root_fsolver*, bool isSymmetric=false);
         static real_t xiParticleFunction(real_t, void*);
 
+        static len_t GetMaxThreads();
+        static len_t GetThreadIndex(const len_t nThreads);
+
         static real_t AssembleBAFunc(
             real_t xiOverXi0,real_t BOverBmin, real_t ROverR0, 
             real_t NablaR2, const int_t *Flist
@@ -198,6 +205,15 @@ namespace DREAM::FVM {
         static real_t AssembleFSAFunc(
             real_t BOverBmin, real_t ROverR0, real_t NablaR2, const int_t *Flist
         );
+        static bool EvaluateFluxSurfaceIntegralKernel(
+            const int_t *Flist, const len_t ntheta, const real_t *weights, const real_t *Jacobian,
+            const real_t *BOverBmin, const real_t *ROverR0, const real_t *NablaR2, real_t &integral
+        );
+        static bool EvaluateBounceIntegralKernel(
+            const int_t *Flist, const len_t ntheta, const real_t xi0, const real_t *weights,
+            const real_t *Metric, const real_t *BOverBmin, const real_t *ROverR0,
+            const real_t *NablaR2, real_t &integral
+        );
         real_t EvaluateAvalancheDeltaHat(len_t ir, real_t p, real_t xi_l, real_t xi_u, real_t Vp, real_t VpVol, int_t RESign = 1);
     };
 }
@@ -1,8 +1,10 @@
 #ifndef _DREAM_FVM_GRID_HPP
 #define _DREAM_FVM_GRID_HPP
 
-namespace DREAM::FVM { class Grid; }
+namespace DREAM::FVM { class Grid; class GridCache; }
 
+#include <string>
+#include <softlib/SFile.h>
 #include "FVM/config.h"
 #include "FVM/Grid/MomentumGrid.hpp"
 #include "FVM/Grid/RadialGrid.hpp"
@@ -64,6 +66,7 @@ namespace DREAM::FVM {
 
         void DeallocateVprime();
         void DeallocateBounceParameters();
+        void DeallocateAvalancheDeltaHat();
 
         void RebuildBounceAveragedQuantities();
         void SetBounceAverage(real_t **&BA_quantity, fluxGridType fluxGridType, real_t(*F)(real_t,real_t,real_t,real_t,void*), void *par=nullptr, const int_t *Flist=nullptr);
@@ -81,6 +84,10 @@ namespace DREAM::FVM {
         RadialGrid *rgrid;
 		MomentumGrid **momentumGrids;
 
+        // Cache of bounce averages (not owned by this object)
+        GridCache *geometryCache = nullptr;
+        std::string geometryCacheName;
+
     public:
         Grid(RadialGrid*, MomentumGrid*, const real_t t0=0, 
             FluxSurfaceAverager::quadrature_method qm = FluxSurfaceAverager::QUAD_FIXED_CHEBYSHEV, len_t ntheta = 0);
@@ -89,6 +96,10 @@ namespace DREAM::FVM {
         bool Rebuild(const real_t);
         void RebuildJacobians();
 
+        void SetGeometryCache(GridCache*, const std::string&);
+        void SaveGeometryCache(SFile*, const std::string&);
+        void LoadGeometryCache(SFile*, const std::string&);
+
         real_t Integral(const real_t*) const;
         real_t *IntegralMomentum(const real_t*, real_t *I=nullptr) const;
         real_t IntegralMomentumAtRadius(const len_t, const real_t*) const;
@@ -0,0 +1,66 @@
+#ifndef _DREAM_FVM_GRID_CACHE_HPP
+#define _DREAM_FVM_GRID_CACHE_HPP
+
+namespace DREAM::FVM { class GridCache; }
+
+#include <set>
+#include <string>
+#include <softlib/SFile.h>
+#include "FVM/config.h"
+#include "FVM/FVMException.hpp"
+#include "FVM/Grid/Grid.hpp"
+#include "FVM/Grid/RadialGrid.hpp"
+
+namespace DREAM::FVM {
+    class GridCache {
+    public:
+        // Name of group in which the radial grid data is stored
+        static constexpr const char *RADIALGRID = "radialgrid";
+
+    private:
+        std::string filename;
+
+        // File to read from (if the cache file already exists)
+        // and temporary file to write to (if it does not)
+        SFile *sfRead = nullptr, *sfWrite = nullptr;
+        std::string tmpfilename;
+
+        // Names of groups written to the cache file so far
+        std::set<std::string> stored;
+
+        SFile *GetWriter();
+        void CheckNr(const std::string&, const len_t);
+
+    public:
+        GridCache(const std::string&);
+        ~GridCache();
+
+        void Close();
+
+        bool IsHit() const { return (this->sfRead != nullptr); }
+        bool Contains(const std::string&);
+        const std::string& GetFilename() const { return this->filename; }
+
+        void Load(RadialGrid*);
+        void Load(Grid*, const std::string&);
+        void Save(RadialGrid*);
+        void Save(Grid*, const std::string&);
+
+        static real_t *LoadList(SFile*, const std::string&, const len_t);
+        static real_t **LoadArray(SFile*, const std::string&, const len_t, const len_t);
+        static bool **LoadBoolArray(SFile*, const std::string&, const len_t, const len_t);
+        static void SaveArray(SFile*, const std::string&, const real_t *const*, const len_t, const len_t);
+        static void SaveArray(SFile*, const std::string&, const bool *const*, const len_t, const len_t);
+    };
+
+    class GridCacheException : public FVMException {
+    public:
+        template<typename ... Args>
+        GridCacheException(const std::string &msg, Args&& ... args)
+            : FVMException(msg, std::forward<Args>(args) ...) {
+            AddModule("GridCache");
+        }
+    };
+}
+
+#endif/*_DREAM_FVM_GRID_CACHE_HPP*/
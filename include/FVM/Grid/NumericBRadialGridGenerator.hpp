@@ -38,6 +38,10 @@ namespace DREAM::FVM {
         gsl_spline2d
             *spline_R, *spline_Z, *spline_BR, *spline_BZ, *spline_Bphi,
             *spline_B;
+        // Accelerators (only used in Rebuild() and the SPI helper
+        // routines; the *AtTheta() methods are called concurrently
+        // from the flux surface averager and so look up the
+        // interpolation intervals without accelerators)
         gsl_interp_accel *acc_r, *acc_theta;
 
 		real_t *addR0DataPoint(const real_t*, const real_t*, const len_t, const len_t, real_t c=std::numeric_limits<real_t>::quiet_NaN());
@@ -47,6 +51,8 @@ namespace DREAM::FVM {
 
         real_t _thetaBounded(const real_t) const;
 
+        bool FindMinorRadiusNewton(const real_t, const real_t, const real_t, real_t&);
+
     public:
         NumericBRadialGridGenerator(
             const len_t nr, const real_t r0, const real_t ra,
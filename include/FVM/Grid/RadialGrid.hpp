@@ -1,8 +1,10 @@
 #ifndef _DREAM_FVM_RADIAL_GRID_HPP
 #define _DREAM_FVM_RADIAL_GRID_HPP
 
-namespace DREAM::FVM { class RadialGrid; }
+namespace DREAM::FVM { class RadialGrid; class GridCache; }
 
+#include <string>
+#include <softlib/SFile.h>
 #include "FVM/FVMException.hpp"
 #include "FVM/Grid/RadialGridGenerator.hpp"
 #include "FVM/Grid/FluxSurfaceAverager.hpp"
@@ -142,6 +144,7 @@ namespace DREAM::FVM {
         void SetFluxSurfaceAverage(real_t *&FSA_quantity, real_t *&FSA_quantity_f, real_t(*F)(real_t,real_t,real_t,void*), void *par=nullptr, const int_t *Flist = nullptr);
 
         virtual void RebuildFluxSurfaceAveragedQuantities();
+        void RebuildToroidalFlux();
         void SetEffectivePassingFraction(real_t*&, real_t*&, real_t*, real_t*);
         static real_t effectivePassingFractionIntegrand(real_t x, void *p);
 
@@ -158,6 +161,9 @@ namespace DREAM::FVM {
         FluxSurfaceAverager *fluxSurfaceAverager;
         RadialGridGenerator *generator;
 
+        // Cache of flux surface averages (not owned by this object)
+        GridCache *geometryCache = nullptr;
+
     public:
         RadialGrid(RadialGridGenerator*, const real_t t0=0, 
             FluxSurfaceAverager::interp_method im = FluxSurfaceAverager::INTERP_STEFFEN,
@@ -201,6 +207,10 @@ namespace DREAM::FVM {
         bool Rebuild(const real_t);
 
         virtual void RebuildJacobians();
+
+        void SetGeometryCache(GridCache *gc) { this->geometryCache = gc; }
+        void SaveGeometryCache(SFile*, const std::string&);
+        void LoadGeometryCache(SFile*, const std::string&);
         
         real_t CalculateFluxSurfaceAverage(len_t ir, fluxGridType fluxGridType, real_t(*F)(real_t,real_t,real_t,void*), void *par=nullptr, const int_t *F_list=nullptr);
         real_t EvaluateFluxSurfaceIntegral(len_t ir, fluxGridType fluxGridType, real_t(*F)(real_t,real_t,real_t,void*), void *par=nullptr, const int_t *F_list=nullptr);
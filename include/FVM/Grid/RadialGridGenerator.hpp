@@ -46,6 +46,22 @@ namespace DREAM::FVM {
         // which is why we use this rather small value here. It does however not seem to slow down the
         // simulations significantly
         const real_t CartesianCoordinateTol = 1e-6;
+
+        // Lookup table for the inverse flux-surface mapping, giving the
+        // minor radius 'r' on a regular grid in the poloidal plane
+        // (X = R-R0, Y = Z, in the cartesian coordinates taken by
+        // GetRThetaPhiFromCartesian(), whose origin R0 is set by the
+        // derived class). Used to provide starting guesses
+        // for GetRThetaPhiFromCartesian(), and built in Rebuild() of the
+        // derived classes which support it.
+        const len_t INVERSE_MAPPING_NPOINTS = 65;
+        real_t *invMapR=nullptr;
+        real_t invMapXmin=0, invMapYmin=0, invMapDX=0, invMapDY=0;
+        // Value of 'r' beyond which the table may not be used
+        real_t invMapRmax=0;
+
+        void BuildInverseMapping(const real_t, const real_t, const real_t, const real_t, const real_t);
+        bool InverseMappingGuess(const real_t, const real_t, real_t&) const;
         
         // True if the flux surfaces are up-down symmetric, i.e. if B(theta) = B(-theta)
         // where (if true) theta=0 must correspond to outermost low-field side, B(0) = B_min. 
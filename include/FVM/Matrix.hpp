@@ -65,11 +65,11 @@ namespace DREAM::FVM {
             PetscInt GetRowOffset() const { return this->rowOffset; }
             PetscInt GetColOffset() const { return this->colOffset; }
 
-            void SetElement(
+            virtual void SetElement(
                 const PetscInt, const PetscInt,
                 const PetscScalar, InsertMode im=ADD_VALUES
             );
-			void SetRow(
+			virtual void SetRow(
 				PetscInt, const PetscInt,
 				PetscInt*, const PetscScalar*,
 				InsertMode im=ADD_VALUES
@@ -81,7 +81,7 @@ namespace DREAM::FVM {
             void Zero(bool nzKeep = true);
 			void ZeroRows(const PetscInt, const PetscInt[]);
 			void ZeroRowsColumns(const PetscInt, const PetscInt[]);
-			void SetDiagonalConstant(const PetscInt, const PetscInt[], const PetscReal);
+			virtual void SetDiagonalConstant(const PetscInt, const PetscInt[], const PetscReal);
 
             void PrintInfo();
 
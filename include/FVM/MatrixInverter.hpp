@@ -3,6 +3,7 @@
 
 #include <petscksp.h>
 #include <petscvec.h>
+#include <vector>
 #include "FVM/Matrix.hpp"
 
 namespace DREAM::FVM {
@@ -12,13 +13,39 @@ namespace DREAM::FVM {
         KSP ksp;
 
         PetscInt errorcode=0;
+
+        // If true, the factorization computed in a previous call to
+        // 'Invert()' is reused (i.e. the matrix is assumed unchanged)
+        bool reuseFactorization = false;
+        // Matrix most recently passed to 'SetOperator()'
+        Mat operatorMat = nullptr;
+        // Permutation of the matrix rows/columns to use in the
+        // factorization (nullptr = use the ordering of the solver)
+        IS ordering = nullptr;
+
+        void SetOperator(Matrix*);
 	public:
+        // Name of the PETSc matrix ordering which applies the
+        // permutation given to 'SetOrdering()'
+        static constexpr const char *MATORDERING_DREAM = "dream";
+
 		MatrixInverter() {}
-        virtual ~MatrixInverter() {}
+        virtual ~MatrixInverter();
 
         virtual int_t GetReturnCode() { return this->errorcode; }
 		virtual void Invert(Matrix*, Vec*, Vec*) = 0;
 
+        // Returns true if this inverter can reuse the factorization
+        // of a previously inverted matrix
+        virtual bool SupportsFactorizationReuse() const { return false; }
+        void SetReuseFactorization(const bool r) { this->reuseFactorization = r; }
+        virtual void SetReuseSymbolicFactorization(const bool) {}
+
+        // Returns true if this inverter can factorize the matrix
+        // using an externally given ordering
+        virtual bool SupportsOrdering() const { return false; }
+        void SetOrdering(const std::vector<PetscInt>&);
+
         virtual void PrintInfo();
 	};
 }
@@ -30,6 +30,7 @@ namespace DREAM::FVM {
         real_t *oldtime = nullptr;
         const len_t N_SAVE_OLD_STEPS = 4;   // Can roll back N-1 steps (TimeStepperAdaptive needs N >= 3 (so that we can also restore the "initial" time derivative))
         len_t nOldSaved = 0;      // Number of old steps currently stored
+        len_t nOldValid = 0;      // Number of consecutive old steps in 'olddata' (not reset by true saves)
 
         // Data from time step before the previous (even in step was not saved to 'store')
         // (this variable is one time step older than 'olddata' and is used when
@@ -65,8 +66,20 @@ namespace DREAM::FVM {
         bool HasChanged() const { return this->hasChanged; }
         bool HasInitialValue() const { return (this->store.size()>=1); }
 
+        // Access to the steps saved to the 'store' array
+        len_t GetNSavedSteps() const { return this->store.size(); }
+        const real_t *GetSavedStep(const len_t i) const { return this->store[i]; }
+        void ClearSavedSteps(const len_t keep=0);
+        len_t GetStepDimensions(sfilesize_t*) const;
+
         len_t GetNOldSaved() const { return this->nOldSaved; }
 
+        // Access to the history of previous time steps ('i = 0' is
+        // the most recent step), e.g. for extrapolating the solution
+        len_t GetNOldSteps() const { return this->nOldValid; }
+        const real_t *GetOldData(const len_t i) const { return this->olddata[i]; }
+        real_t GetOldTime(const len_t i) const { return this->oldtime[i]; }
+
         bool CanRollbackSaveStep() const;
         void RollbackSaveStep();
         void SaveStep(const real_t, bool);
@@ -80,6 +93,9 @@ namespace DREAM::FVM {
 		void SaveSFileCurrent(SFile*, const std::string& name, const std::string& path="", const std::string& desc="", bool saveMeta=false);
 
         void SetInitialValue(const real_t*, const real_t t0=0);
+
+        void SaveCheckpoint(SFile*, const std::string&);
+        void LoadCheckpoint(SFile*, const std::string&);
     };
 }
 
@@ -2,6 +2,7 @@
 #define _DREAM_FVM_MATRIX_INVERTER_GMRES_HPP
 
 #include <petscksp.h>
+#include <string>
 #include <vector>
 #include "FVM/config.h"
 #include "FVM/MatrixInverter.hpp"
@@ -17,7 +18,39 @@ namespace DREAM::FVM {
 
         PetscInt *blocks;
         len_t nBlocks;
+
+        std::vector<len_t> nontrivial_unknowns;
+        UnknownQuantityHandler *unknowns;
+
+        // Maximum number of consecutive solves in which the
+        // preconditioner may be reused (0 = rebuild in every solve)
+        len_t maxPCReuse = 0;
+        // Rebuild the preconditioner if the previous solve needed
+        // more than this number of iterations (0 = no limit)
+        len_t maxPCIterations = 0;
+        // Number of solves since the preconditioner was built
+        len_t pcAge = 0;
+        // Number of GMRES iterations needed in the previous solve
+        PetscInt lastIterations = 0;
+
+        // For each split of the field-split preconditioner (if used),
+        // true if the split is inverted exactly
+        std::vector<bool> splitDirect;
+
+        bool ReusePreconditioner() const;
+        void SetFieldSplitSolvers();
 	public:
+        // Group of unknowns forming one block ("split") of
+        // a field-split preconditioner
+        struct split {
+            std::string name;
+            // IDs of the unknowns in the split
+            std::vector<len_t> unknowns;
+            // If true, the split is inverted exactly using LU
+            // (otherwise, an incomplete LU factorization is used)
+            bool direct;
+        };
+
 		MIGMRES(const len_t, std::vector<len_t>&, UnknownQuantityHandler*,
             PetscErrorCode (*)(KSP, PetscInt, PetscReal, KSPConvergedReason*, void*),
             void*
@@ -25,6 +58,9 @@ namespace DREAM::FVM {
         ~MIGMRES();
 
 		virtual void Invert(Matrix*, Vec*, Vec*) override;
+        void SetPreconditionerReuse(const len_t, const len_t);
+        void SetKrylovRecycling(const len_t);
+        void SetFieldSplit(const std::vector<struct split>&, const bool schur=false);
         void SetConvergenceTest(
             PetscErrorCode (*)(KSP, PetscInt, PetscReal, KSPConvergedReason*, void*),
             void*
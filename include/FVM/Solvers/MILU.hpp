@@ -14,6 +14,10 @@ namespace DREAM::FVM {
         ~MILU();
 
 		virtual void Invert(Matrix*, Vec*, Vec*) override;
+
+        virtual bool SupportsFactorizationReuse() const override { return true; }
+        virtual void SetReuseSymbolicFactorization(const bool) override;
+        virtual bool SupportsOrdering() const override { return true; }
 	};
 }
 
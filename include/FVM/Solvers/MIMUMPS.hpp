@@ -17,6 +17,12 @@ namespace DREAM::FVM {
         ~MIMUMPS();
 
 		virtual void Invert(Matrix*, Vec*, Vec*) override;
+
+        virtual bool SupportsFactorizationReuse() const override { return true; }
+        virtual void SetReuseSymbolicFactorization(const bool) override;
+#ifdef PETSC_HAVE_MUMPS
+        virtual bool SupportsOrdering() const override { return true; }
+#endif
 	};
 }
 
@@ -0,0 +1,29 @@
+#ifndef _DREAM_FVM_MATRIX_INVERTER_MIXED_PRECISION_HPP
+#define _DREAM_FVM_MATRIX_INVERTER_MIXED_PRECISION_HPP
+
+#include <petscksp.h>
+#include "FVM/config.h"
+#include "FVM/MatrixInverter.hpp"
+
+namespace DREAM::FVM {
+	class MIMixedPrecision : public MatrixInverter {
+    private:
+        len_t xn;
+
+        // Precision of the factorization (MUMPS BLR dropping parameter)
+        real_t epsilon;
+	public:
+		MIMixedPrecision(const len_t, const real_t epsilon=1e-7, const real_t reltol=1e-10, const len_t maxiter=20);
+        ~MIMixedPrecision();
+
+		virtual void Invert(Matrix*, Vec*, Vec*) override;
+
+        virtual bool SupportsFactorizationReuse() const override { return true; }
+        virtual void SetReuseSymbolicFactorization(const bool) override;
+#ifdef PETSC_HAVE_MUMPS
+        virtual bool SupportsOrdering() const override { return true; }
+#endif
+	};
+}
+
+#endif/*_DREAM_FVM_MATRIX_INVERTER_MIXED_PRECISION_HPP*/
@@ -42,7 +42,11 @@ namespace DREAM::FVM {
         real_t GetPreviousTime() { return this->data->GetPreviousTime(); }
         real_t *GetData() { return this->data->Get(); }
         real_t *GetDataPrevious() { return this->data->GetPrevious(); }
+        const real_t *GetDataOld(const len_t i) const { return this->data->GetOldData(i); }
+        real_t GetOldTime(const len_t i) const { return this->data->GetOldTime(i); }
+        len_t GetNOldSteps() const { return this->data->GetNOldSteps(); }
         real_t *GetInitialData() { return this->data->GetInitialData(); }
+        QuantityData *GetQuantityData() { return this->data; }
         Grid *GetGrid() { return this->grid; }
         const std::string& GetDescription() const { return this->description; }
         const std::string& GetEquationDescription() const { return this->description_eqn; }
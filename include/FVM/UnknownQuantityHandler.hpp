@@ -14,6 +14,10 @@ namespace DREAM::FVM {
     private:
         std::vector<UnknownQuantity*> unknowns;
 
+        // Order of the backward differentiation formula (BDF) used
+        // by transient terms to discretize time derivatives
+        len_t timeIntegrationOrder = 1;
+
     public:
         UnknownQuantityHandler();
         ~UnknownQuantityHandler();
@@ -27,6 +31,8 @@ namespace DREAM::FVM {
         const real_t *GetLongVector(const len_t, const len_t*, real_t *vec=nullptr);
         const real_t *GetLongVectorPrevious(const std::vector<len_t>& nontrivials, real_t *vec=nullptr);
         const real_t *GetLongVectorPrevious(const len_t, const len_t*, real_t *vec=nullptr);
+        const real_t *GetLongVectorOld(const std::vector<len_t>& nontrivials, const len_t, real_t *vec=nullptr);
+        len_t GetNOldSteps(const std::vector<len_t>& nontrivials);
         const len_t GetLongVectorSize(const std::vector<len_t>& nontrivials);
         const len_t GetLongVectorSize(const len_t, const len_t*);
 
@@ -39,6 +45,11 @@ namespace DREAM::FVM {
         real_t *GetUnknownDataPrevious(const len_t);
         real_t *GetUnknownDataPrevious(const std::string&);
         real_t *GetUnknownInitialData(const len_t);
+        const real_t *GetUnknownDataOld(const len_t id, const len_t i) { return unknowns[id]->GetDataOld(i); }
+
+        len_t GetTimeIntegrationOrder() const { return this->timeIntegrationOrder; }
+        void SetTimeIntegrationOrder(const len_t order) { this->timeIntegrationOrder = order; }
+        len_t GetTransientCoefficients(const len_t, const real_t, real_t*);
         const std::vector<UnknownQuantity*>& GetUnknowns() const { return this->unknowns; }
 
         bool HasChanged(const len_t id) const { return unknowns[id]->HasChanged(); }
@@ -60,6 +71,9 @@ namespace DREAM::FVM {
         void SaveSFileCurrent(const std::string& filename, bool saveMeta=false);
         void SaveSFileCurrent(SFile*, const std::string& path="", bool saveMeta=false);
 
+        void SaveCheckpoint(SFile*, const std::string&);
+        void LoadCheckpoint(SFile*, const std::string&);
+
         void SetInitialValue(const std::string&, const real_t*, const real_t t0=0);
         void SetInitialValue(const len_t, const real_t*, const real_t t0=0);
 
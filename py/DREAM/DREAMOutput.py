@@ -82,6 +82,8 @@ class DREAMOutput:
                 return SolverLinear(solverdata, output)
             elif solverdata['type'] == SettingsSolver.NONLINEAR:
                 return SolverNonLinear(solverdata, output)
+            elif solverdata['type'] == SettingsSolver.JFNK:
+                return SolverNonLinear(solverdata, output)
         else:
             print('WARNING: Invalid solver data given.')
             return None
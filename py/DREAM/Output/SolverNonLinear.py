@@ -16,7 +16,27 @@ class SolverNonLinear(Solver):
         super().__init__(solverdata, output)
 
         self.iterations = [int(x) for x in solverdata['iterations'][:]]
-        self.backupinverter = [x==1 for x in solverdata['backupinverter'][:]]
+        if 'backupinverter' in solverdata:
+            self.backupinverter = [x==1 for x in solverdata['backupinverter'][:]]
+        else:
+            self.backupinverter = [False]*len(self.iterations)
+
+        if 'jacobians' in solverdata:
+            self.jacobians = [int(x) for x in solverdata['jacobians'][:]]
+        else:
+            self.jacobians = None
+
+        if 'backtracks' in solverdata:
+            self.backtracks = [int(x) for x in solverdata['backtracks'][:]]
+            self.minsteplength = [float(x) for x in solverdata['minsteplength'][:]]
+        else:
+            self.backtracks = None
+            self.minsteplength = None
+
+        if 'kspiterations' in solverdata:
+            self.kspiterations = [int(x) for x in solverdata['kspiterations'][:]]
+        else:
+            self.kspiterations = None
 
 
     def __str__(self):
@@ -28,6 +48,16 @@ class SolverNonLinear(Solver):
         s += "Max. iterations: {}\n".format(max(self.iterations))
         s += "Avg. iterations: {}\n".format(sum(self.iterations)/len(self.iterations))
         s += "Min. iterations: {}\n\n".format(min(self.iterations))
+
+        if self.jacobians is not None:
+            s += "Jacobian evaluations: {} (in {} iterations)\n\n".format(sum(self.jacobians), sum(self.iterations))
+
+        if self.backtracks is not None:
+            s += "Line search backtracks: {}\n".format(sum(self.backtracks))
+            s += "Min. step length: {}\n\n".format(min(self.minsteplength))
+
+        if self.kspiterations is not None:
+            s += "GMRES iterations: {} (in {} iterations)\n\n".format(sum(self.kspiterations), sum(self.iterations))
         
         bi = sum(self.backupinverter)
         if bi == 0:
@@ -30,6 +30,9 @@ PSTAR_MODE_COLLISIONLESS = 2
 SCREENED_DIFFUSION_MODE_ZERO = 1
 SCREENED_DIFFUSION_MODE_MAXWELLIAN = 2
 
+PSI_MODE_QUADRATURE = 1
+PSI_MODE_TABULATED = 2
+
 
 class CollisionHandler:
     
@@ -37,7 +40,8 @@ class CollisionHandler:
     def __init__(self,
             bremsstrahlung_mode=BREMSSTRAHLUNG_MODE_NEGLECT,
             collfreq_mode=COLLFREQ_MODE_FULL, collfreq_type=COLLFREQ_TYPE_PARTIALLY_SCREENED,
-            lnlambda=LNLAMBDA_THERMAL, pstar_mode=PSTAR_MODE_COLLISIONLESS, screened_diffusion=SCREENED_DIFFUSION_MODE_MAXWELLIAN):
+            lnlambda=LNLAMBDA_THERMAL, pstar_mode=PSTAR_MODE_COLLISIONLESS, screened_diffusion=SCREENED_DIFFUSION_MODE_MAXWELLIAN,
+            psi_mode=PSI_MODE_QUADRATURE):
         """
         Constructor.
         """
@@ -47,6 +51,7 @@ class CollisionHandler:
         self.lnlambda = lnlambda
         self.pstar_mode = pstar_mode
         self.screened_diffusion = screened_diffusion
+        self.psi_mode = psi_mode
 
     
     def fromdict(self, data):
@@ -65,6 +70,8 @@ class CollisionHandler:
             self.pstar_mode = data['pstar_mode']
         if 'screened_diffusion_mode' in data:
             self.screened_diffusion = data['screened_diffusion_mode']
+        if 'psi_mode' in data:
+            self.psi_mode = data['psi_mode']
 
 
     def todict(self, verify=True):
@@ -80,7 +87,8 @@ class CollisionHandler:
             'collfreq_type': self.collfreq_type,
             'lnlambda': self.lnlambda,
             'pstar_mode': self.pstar_mode,
-            'screened_diffusion_mode': self.screened_diffusion
+            'screened_diffusion_mode': self.screened_diffusion,
+            'psi_mode': self.psi_mode
         }
 
     
@@ -18,11 +18,32 @@ class Output:
         self.savesettings = True
         self.timingstdout = False
         self.timingfile = True
+        self.stream = False
+        self.flushinterval = 1
+        self.checkpoint_filename = 'checkpoint.h5'
+        self.checkpoint_steps = 0
+        self.checkpoint_walltime = 0
 
 
     ############################
     # SETTERS
     ############################
+    def setCheckpoint(self, steps=0, walltime=0, filename='checkpoint.h5'):
+        """
+        Enable periodic writing of checkpoints during the simulation. A
+        simulation can be resumed from a checkpoint by running
+        ``dreami --restart CHECKPOINT INPUT``. A checkpoint is written
+        whenever either of the two criteria is met.
+
+        :param int steps:     Number of time steps between checkpoints (0 = disabled).
+        :param float walltime: Wall-clock time (in seconds) between checkpoints (0 = disabled).
+        :param str filename:  Name of the checkpoint file.
+        """
+        self.checkpoint_steps = int(steps)
+        self.checkpoint_walltime = float(walltime)
+        self.checkpoint_filename = filename
+
+
     def setFilename(self, filename):
         """
         Set the name of the output file.
@@ -42,6 +63,19 @@ class Output:
         self.savesettings = save
 
 
+    def setStreaming(self, stream=True, flushinterval=1):
+        """
+        Specify whether to write each saved time step to the output file as
+        the simulation proceeds, rather than keeping all time steps in memory
+        and writing them at the end of the simulation.
+
+        :param bool stream:       If ``True``, streams saved time steps to the output file.
+        :param int flushinterval: Number of saved time steps between flushes of the output file to disk (0 = only flush at the end of the simulation).
+        """
+        self.stream = stream
+        self.flushinterval = int(flushinterval)
+
+
     def setTiming(self, stdout=None, file=None):
         """
         Specifies whether to print timing information and/or include
@@ -68,6 +102,14 @@ class Output:
 
         if 'savesettings' in data:
             self.savesettings = bool(data['savesettings'])
+        if 'stream' in data:
+            self.stream = bool(data['stream'])
+        if 'flushinterval' in data:
+            self.flushinterval = int(data['flushinterval'])
+        if 'checkpoint' in data:
+            self.checkpoint_filename = data['checkpoint']['filename']
+            self.checkpoint_steps = int(data['checkpoint']['steps'])
+            self.checkpoint_walltime = float(data['checkpoint']['walltime'])
 
         self.verifySettings()
 
@@ -86,7 +128,14 @@ class Output:
             'filename': self.filename,
             'savesettings': self.savesettings,
             'timingfile': self.timingfile,
-            'timingstdout': self.timingstdout
+            'timingstdout': self.timingstdout,
+            'stream': self.stream,
+            'flushinterval': self.flushinterval,
+            'checkpoint': {
+                'filename': self.checkpoint_filename,
+                'steps': self.checkpoint_steps,
+                'walltime': self.checkpoint_walltime
+            }
         }
 
         return data
@@ -104,5 +153,15 @@ class Output:
             raise DREAMException("The option 'timingfile' must be a bool.")
         elif type(self.timingstdout) != bool:
             raise DREAMException("The option 'timingstdout' must be a bool.")
+        elif type(self.stream) != bool:
+            raise DREAMException("The option 'stream' must be a bool.")
+        elif type(self.flushinterval) != int or self.flushinterval < 0:
+            raise DREAMException("The option 'flushinterval' must be a non-negative integer.")
+        elif type(self.checkpoint_filename) != str:
+            raise DREAMException("The checkpoint file name must be a string.")
+        elif type(self.checkpoint_steps) != int or self.checkpoint_steps < 0:
+            raise DREAMException("The number of time steps between checkpoints must be a non-negative integer.")
+        elif self.checkpoint_walltime < 0:
+            raise DREAMException("The wall-clock time between checkpoints must be non-negative.")
 
 
@@ -69,10 +69,22 @@ class RadialGrid(PrescribedScalarParameter):
         # prescribed arbitrary grid
         self.r_f = None 
 
+        # Directory in which to cache grid geometry
+        self.cachedir = None
+
 
     #######################
     # SETTERS
     #######################
+    def setCacheDirectory(self, cachedir):
+        """
+        Set the directory in which flux surface and bounce averages of the
+        grids are cached between simulations. If ``None``, caching is
+        disabled.
+        """
+        self.cachedir = cachedir
+
+
     def setCustomGridPoints(self, r_f):
         """
         (Cylindrical, Analytic toroidal)
@@ -479,6 +491,9 @@ class RadialGrid(PrescribedScalarParameter):
             self.dlnB0dt_x = data['dlnB0dt']['x']
             self.dlnB0dt_t = data['dlnB0dt']['t']
 
+        if 'cachedir' in data:
+            self.cachedir = data['cachedir']
+
 
     def todict(self, verify=True):
         """
@@ -536,6 +551,9 @@ class RadialGrid(PrescribedScalarParameter):
                 't': self.dlnB0dt_t
             }
 
+        if self.cachedir is not None:
+            data['cachedir'] = self.cachedir
+
         return data
         
             
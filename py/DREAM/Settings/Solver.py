@@ -10,6 +10,14 @@ from . Preconditioner import Preconditioner
 
 LINEAR_IMPLICIT = 1
 NONLINEAR       = 2
+JFNK            = 3
+
+JACOBIAN_ANALYTICAL = 1
+JACOBIAN_NUMERICAL  = 2
+
+PREDICTOR_NONE      = 1
+PREDICTOR_LINEAR    = 2
+PREDICTOR_QUADRATIC = 3
 
 BACKUP_SOLVER_NONE    = 0
 LINEAR_SOLVER_LU      = 1
@@ -17,6 +25,14 @@ LINEAR_SOLVER_MUMPS   = 2
 LINEAR_SOLVER_MKL     = 3
 LINEAR_SOLVER_SUPERLU = 4
 LINEAR_SOLVER_GMRES   = 5
+LINEAR_SOLVER_MIXED_PRECISION = 6
+
+ORDERING_DEFAULT = 1
+ORDERING_RADIAL  = 2
+
+GMRES_PRECONDITIONER_BLOCK_JACOBI = 1
+GMRES_PRECONDITIONER_FIELDSPLIT   = 2
+GMRES_PRECONDITIONER_SCHUR        = 3
 
 
 class Solver:
@@ -40,8 +56,27 @@ class Solver:
         self.debug_timestep = 0
         self.debug_iteration = 1
         self.debug_rescaled = False
+        self.debug_validatejacobian = False
 
         self.backupsolver = None
+        self.parallelrebuild = False
+        self.paralleljacobian = False
+        self.reusesymbolic = False
+        self.ordering = ORDERING_DEFAULT
+        self.gmres_preconditioner = GMRES_PRECONDITIONER_BLOCK_JACOBI
+        self.gmres_maxpcreuse = 0
+        self.gmres_maxpciterations = 0
+        self.gmres_recycle = 0
+        self.mixed_epsilon = 1e-7
+        self.mixed_reltol = 1e-10
+        self.mixed_maxiter = 20
+        self.maxjacobianlag = 0
+        self.maxlagrate = 0.5
+        self.linesearch = False
+        self.jacobian = JACOBIAN_ANALYTICAL
+        self.predictor = PREDICTOR_NONE
+        self.jfnk_maxiter = 200
+        self.jfnk_reltol = 1e-4
         self.tolerance = ToleranceSettings()
         self.preconditioner = Preconditioner()
         self.setOption(linsolv=linsolv, maxiter=maxiter, verbose=verbose)
@@ -49,7 +84,8 @@ class Solver:
 
     def setDebug(self, printmatrixinfo=False, printjacobianinfo=False, savejacobian=False,
                  savesolution=False, savematrix=False, savenumericaljacobian=False, saverhs=False,
-                 saveresidual=False, savesystem=False, rescaled=False, timestep=0, iteration=1):
+                 saveresidual=False, savesystem=False, rescaled=False, timestep=0, iteration=1,
+                 validatejacobian=False):
         """
         Enable output of debug information.
 
@@ -68,6 +104,7 @@ class Solver:
         :param bool savenumericaljacobian: If ``True``, evaluates the jacobian matrix numerically and saves it using a PETSc viewer.
         :param bool saveresidual:          If ``True``, saves the residual vector to a ``.mat`` file.
         :param bool rescaled:              If ``True``, saves the rescaled versions of the jacobian/solution/residual.
+        :param bool validatejacobian:      If ``True``, verifies in every iteration that the jacobian blocks which were found to be empty in the first iteration remain empty (applies to all time steps and iterations).
         :param int iteration:              Index of iteration to save debug info for. If ``0``, saves in all iterations. If ``timestep`` is ``0``, this parameter is always ignored.
         """
         self.debug_printmatrixinfo = printmatrixinfo
@@ -80,6 +117,7 @@ class Solver:
         self.debug_saveresidual = saveresidual
         self.debug_savesystem = savesystem
         self.debug_rescaled = rescaled
+        self.debug_validatejacobian = validatejacobian
         self.debug_timestep = timestep
         self.debug_iteration = iteration
 
@@ -92,6 +130,144 @@ class Solver:
         self.backupsolver = backup
 
 
+    def setParallelRebuild(self, parallel=True):
+        """
+        If ``True``, equation terms which are marked as thread-safe
+        are rebuilt in parallel (using OpenMP) in every iteration, while
+        all other terms are rebuilt in sequence. The number of threads
+        is controlled via ``OMP_NUM_THREADS``.
+        """
+        self.parallelrebuild = parallel
+
+
+    def setParallelJacobian(self, parallel=True):
+        """
+        If ``True``, the jacobian contributions of equation terms which
+        are marked as thread-safe are evaluated in parallel (using
+        OpenMP) when building the jacobian matrix of the non-linear
+        solver. The number of threads is controlled via ``OMP_NUM_THREADS``.
+        """
+        self.paralleljacobian = parallel
+
+
+    def setFactorizationReuse(self, symbolic=True, maxlag=0, maxrate=0.5):
+        """
+        Configure reuse of matrix factorizations in the direct linear
+        solvers (LU and MUMPS).
+
+        :param bool symbolic:  If ``True``, the ordering and fill computed in the first factorization of a matrix are reused in all subsequent factorizations.
+        :param int maxlag:     Maximum number of consecutive Newton iterations in which the factorization of a previously built jacobian may be reused (modified Newton). If ``0``, the jacobian is built and factorized in every iteration. Only used by the non-linear solver.
+        :param float maxrate:  Maximum convergence rate (ratio of the norms of two consecutive Newton steps) for which a previous jacobian may be reused. If convergence is slower, the jacobian is rebuilt.
+        """
+        self.reusesymbolic = symbolic
+        self.maxjacobianlag = int(maxlag)
+        self.maxlagrate = float(maxrate)
+
+
+    def setOrdering(self, ordering):
+        """
+        Specifies the ordering of the matrix rows/columns to use when
+        factorizing matrices with the direct linear solvers (LU or MUMPS).
+        With ``ORDERING_DEFAULT``, the fill-reducing ordering of the
+        linear solver is used. With ``ORDERING_RADIAL``, all unknowns at
+        the same radius are placed next to each other, which reduces the
+        fill-in of the factorization when many fluid quantities are
+        coupled locally in radius.
+
+        :param int ordering: Matrix ordering to use.
+        """
+        self.ordering = int(ordering)
+
+
+    def setGMRESPreconditioner(self, preconditioner):
+        """
+        Specifies the preconditioner to use with the GMRES linear solver.
+        With ``GMRES_PRECONDITIONER_BLOCK_JACOBI``, each unknown quantity is
+        preconditioned separately. With ``GMRES_PRECONDITIONER_FIELDSPLIT``,
+        the unknowns are grouped into field/circuit quantities, fluid
+        quantities and kinetic quantities, and the groups are inverted one
+        after another. With ``GMRES_PRECONDITIONER_SCHUR``, the field/circuit
+        quantities are instead eliminated via their Schur complement.
+
+        :param int preconditioner: GMRES preconditioner to use.
+        """
+        self.gmres_preconditioner = int(preconditioner)
+
+
+    def setGMRESReuse(self, maxreuse=0, maxiterations=0, recycle=0):
+        """
+        Set options for reusing information between consecutive solves
+        with the GMRES linear solver.
+
+        :param int maxreuse:      Maximum number of consecutive solves in which the preconditioner may be reused (``0`` = rebuild the preconditioner in every solve).
+        :param int maxiterations: Rebuild the preconditioner if the previous solve needed more than this number of GMRES iterations (``0`` = no limit).
+        :param int recycle:       Number of deflation vectors to carry between GMRES restarts and solves (``0`` = no Krylov subspace recycling).
+        """
+        self.gmres_maxpcreuse = int(maxreuse)
+        self.gmres_maxpciterations = int(maxiterations)
+        self.gmres_recycle = int(recycle)
+
+
+    def setMixedPrecisionOptions(self, epsilon=1e-7, reltol=1e-10, maxiter=20):
+        """
+        Set options for the mixed-precision linear solver
+        (``LINEAR_SOLVER_MIXED_PRECISION``).
+
+        :param float epsilon: Relative accuracy of the approximate factorization.
+        :param float reltol:  Relative tolerance of the iterative refinement.
+        :param int maxiter:   Maximum number of iterative refinement steps.
+        """
+        self.mixed_epsilon = float(epsilon)
+        self.mixed_reltol = float(reltol)
+        self.mixed_maxiter = int(maxiter)
+
+
+    def setJacobianMode(self, mode):
+        """
+        Specifies how the jacobian matrix is evaluated in the non-linear
+        solver (either ``JACOBIAN_ANALYTICAL`` or ``JACOBIAN_NUMERICAL``).
+        With ``JACOBIAN_NUMERICAL``, the elements in the non-zero pattern
+        of the analytical jacobian are evaluated using finite differences
+        of the residual.
+        """
+        self.jacobian = int(mode)
+
+
+    def setLineSearch(self, linesearch=True):
+        """
+        Enable/disable the backtracking line search of the non-linear
+        solver. When enabled, each Newton step is shortened until it
+        reduces the residual of the equation system sufficiently.
+
+        :param bool linesearch: If ``True``, enables the line search.
+        """
+        self.linesearch = linesearch
+
+
+    def setPredictor(self, predictor=PREDICTOR_LINEAR):
+        """
+        Specifies how the initial guess of the non-linear solver is formed
+        in each time step. With ``PREDICTOR_NONE``, the solver starts from
+        the solution of the previous time step, while ``PREDICTOR_LINEAR``
+        and ``PREDICTOR_QUADRATIC`` extrapolate the solutions of the two
+        or three most recent time steps to the new time.
+
+        :param int predictor: Type of predictor to use.
+        """
+        self.predictor = int(predictor)
+
+
+    def setJFNKOptions(self, maxiter=200, reltol=1e-4):
+        """
+        Set options for the Jacobian-free Newton-Krylov solver.
+
+        :param int maxiter:   Maximum number of GMRES iterations per Newton iteration.
+        :param float reltol:  Relative tolerance for GMRES in each Newton iteration.
+        """
+        self.jfnk_maxiter = int(maxiter)
+        self.jfnk_reltol = float(reltol)
+
+
     def setLinearSolver(self, linsolv):
         """
         Set the linear solver to use.
@@ -137,13 +313,15 @@ class Solver:
 
     def setType(self, ttype):
         """
-        Specifies which type of solver to use (either ``LINEAR_IMPLICIT``
-        or ``NONLINEAR``).
+        Specifies which type of solver to use (either ``LINEAR_IMPLICIT``,
+        ``NONLINEAR`` or ``JFNK``).
         """
         if ttype == LINEAR_IMPLICIT:
             self.type = ttype
         elif ttype == NONLINEAR:
             self.type = ttype
+        elif ttype == JFNK:
+            self.type = ttype
         else:
             raise DREAMException("Solver: Unrecognized solver type: {}.".format(ttype))
 
@@ -174,8 +352,59 @@ class Solver:
         if 'backupsolver' in data:
             self.backupsolver = int(data['backupsolver'])
 
+        if 'parallelrebuild' in data:
+            self.parallelrebuild = bool(data['parallelrebuild'])
+
+        if 'paralleljacobian' in data:
+            self.paralleljacobian = bool(data['paralleljacobian'])
+
+        if 'reusesymbolic' in data:
+            self.reusesymbolic = bool(data['reusesymbolic'])
+
+        if 'ordering' in data:
+            self.ordering = int(scal(data['ordering']))
+
+        if 'gmres' in data:
+            if 'preconditioner' in data['gmres']:
+                self.gmres_preconditioner = int(scal(data['gmres']['preconditioner']))
+            if 'maxpcreuse' in data['gmres']:
+                self.gmres_maxpcreuse = int(scal(data['gmres']['maxpcreuse']))
+            if 'maxpciterations' in data['gmres']:
+                self.gmres_maxpciterations = int(scal(data['gmres']['maxpciterations']))
+            if 'recycle' in data['gmres']:
+                self.gmres_recycle = int(scal(data['gmres']['recycle']))
+
+        if 'mixed' in data:
+            if 'epsilon' in data['mixed']:
+                self.mixed_epsilon = float(scal(data['mixed']['epsilon']))
+            if 'reltol' in data['mixed']:
+                self.mixed_reltol = float(scal(data['mixed']['reltol']))
+            if 'maxiter' in data['mixed']:
+                self.mixed_maxiter = int(scal(data['mixed']['maxiter']))
+
+        if 'maxjacobianlag' in data:
+            self.maxjacobianlag = int(data['maxjacobianlag'])
+
+        if 'maxlagrate' in data:
+            self.maxlagrate = float(data['maxlagrate'])
+
+        if 'jacobian' in data:
+            self.jacobian = int(scal(data['jacobian']))
+
+        if 'linesearch' in data:
+            self.linesearch = bool(data['linesearch'])
+
+        if 'predictor' in data:
+            self.predictor = int(scal(data['predictor']))
+
+        if 'jfnk' in data:
+            if 'maxiter' in data['jfnk']:
+                self.jfnk_maxiter = int(scal(data['jfnk']['maxiter']))
+            if 'reltol' in data['jfnk']:
+                self.jfnk_reltol = float(scal(data['jfnk']['reltol']))
+
         if 'debug' in data:
-            flags = ['printmatrixinfo', 'printjacobianinfo', 'savejacobian', 'savesolution', 'savematrix', 'savenumericaljacobian', 'saverhs', 'saveresidual', 'savesystem', 'rescaled']
+            flags = ['printmatrixinfo', 'printjacobianinfo', 'savejacobian', 'savesolution', 'savematrix', 'savenumericaljacobian', 'saverhs', 'saveresidual', 'savesystem', 'rescaled', 'validatejacobian']
 
             for f in flags:
                 if f in data['debug']:
@@ -201,7 +430,22 @@ class Solver:
             'type': self.type,
             'linsolv': self.linsolv,
             'maxiter': self.maxiter,
-            'verbose': self.verbose
+            'verbose': self.verbose,
+            'parallelrebuild': self.parallelrebuild,
+            'paralleljacobian': self.paralleljacobian,
+            'reusesymbolic': self.reusesymbolic,
+            'ordering': self.ordering,
+            'gmres': {
+                'preconditioner': self.gmres_preconditioner,
+                'maxpcreuse': self.gmres_maxpcreuse,
+                'maxpciterations': self.gmres_maxpciterations,
+                'recycle': self.gmres_recycle
+            },
+            'mixed': {
+                'epsilon': self.mixed_epsilon,
+                'reltol': self.mixed_reltol,
+                'maxiter': self.mixed_maxiter
+            }
         }
 
         data['preconditioner'] = self.preconditioner.todict()
@@ -216,6 +460,11 @@ class Solver:
             }
         elif self.type == NONLINEAR:
             data['tolerance'] = self.tolerance.todict()
+            data['maxjacobianlag'] = self.maxjacobianlag
+            data['maxlagrate'] = self.maxlagrate
+            data['linesearch'] = self.linesearch
+            data['jacobian'] = self.jacobian
+            data['predictor'] = self.predictor
             data['debug'] = {
                 'printjacobianinfo': self.debug_printjacobianinfo,
                 'savejacobian': self.debug_savejacobian,
@@ -224,12 +473,19 @@ class Solver:
                 'saveresidual': self.debug_saveresidual,
                 'savesystem': self.debug_savesystem,
                 'rescaled': self.debug_rescaled,
+                'validatejacobian': self.debug_validatejacobian,
                 'timestep': self.debug_timestep,
                 'iteration': self.debug_iteration
             }
 
             if self.backupsolver is not None:
                 data['backupsolver'] = self.backupsolver
+        elif self.type == JFNK:
+            data['tolerance'] = self.tolerance.todict()
+            data['jfnk'] = {
+                'maxiter': self.jfnk_maxiter,
+                'reltol': self.jfnk_reltol
+            }
 
         return data
 
@@ -255,6 +511,18 @@ class Solver:
                 raise DREAMException("Solver: Invalid type of parameter 'maxiter': {}. Expected integer.".format(type(self.maxiter)))
             elif type(self.verbose) != bool:
                 raise DREAMException("Solver: Invalid type of parameter 'verbose': {}. Expected boolean.".format(type(self.verbose)))
+            elif type(self.maxjacobianlag) != int:
+                raise DREAMException("Solver: Invalid type of parameter 'maxjacobianlag': {}. Expected integer.".format(type(self.maxjacobianlag)))
+            elif self.maxjacobianlag < 0:
+                raise DREAMException("Solver: Invalid value of parameter 'maxjacobianlag': {}. Must be non-negative.".format(self.maxjacobianlag))
+            elif type(self.maxlagrate) != float:
+                raise DREAMException("Solver: Invalid type of parameter 'maxlagrate': {}. Expected float.".format(type(self.maxlagrate)))
+            elif type(self.linesearch) != bool:
+                raise DREAMException("Solver: Invalid type of parameter 'linesearch': {}. Expected boolean.".format(type(self.linesearch)))
+            elif self.jacobian not in [JACOBIAN_ANALYTICAL, JACOBIAN_NUMERICAL]:
+                raise DREAMException("Solver: Unrecognized jacobian mode: {}.".format(self.jacobian))
+            elif self.predictor not in [PREDICTOR_NONE, PREDICTOR_LINEAR, PREDICTOR_QUADRATIC]:
+                raise DREAMException("Solver: Unrecognized predictor: {}.".format(self.predictor))
 
             if type(self.debug_printjacobianinfo) != bool:
                 raise DREAMException("Solver: Invalid type of parameter 'debug_printjacobianinfo': {}. Expected boolean.".format(type(self.debug_printjacobianinfo)))
@@ -268,6 +536,8 @@ class Solver:
                 raise DREAMException("Solver: Invalid type of parameter 'debug_saveresidual': {}. Expected boolean.".format(type(self.debug_saveresidual)))
             elif type(self.debug_rescaled) != bool:
                 raise DREAMException("Solver: Invalid type of parameter 'debug_rescaled': {}. Expected boolean.".format(type(self.debug_rescaled)))
+            elif type(self.debug_validatejacobian) != bool:
+                raise DREAMException("Solver: Invalid type of parameter 'debug_validatejacobian': {}. Expected boolean.".format(type(self.debug_validatejacobian)))
             elif type(self.debug_timestep) != int:
                 raise DREAMException("Solver: Invalid type of parameter 'debug_timestep': {}. Expected integer.".format(type(self.debug_timestep)))
             elif type(self.debug_iteration) != int:
@@ -275,9 +545,46 @@ class Solver:
 
             self.tolerance.verifySettings()
             self.verifyLinearSolverSettings()
+        elif self.type == JFNK:
+            if type(self.maxiter) != int:
+                raise DREAMException("Solver: Invalid type of parameter 'maxiter': {}. Expected integer.".format(type(self.maxiter)))
+            elif type(self.verbose) != bool:
+                raise DREAMException("Solver: Invalid type of parameter 'verbose': {}. Expected boolean.".format(type(self.verbose)))
+            elif type(self.jfnk_maxiter) != int:
+                raise DREAMException("Solver: Invalid type of parameter 'jfnk_maxiter': {}. Expected integer.".format(type(self.jfnk_maxiter)))
+            elif self.jfnk_maxiter <= 0:
+                raise DREAMException("Solver: Invalid value of parameter 'jfnk_maxiter': {}. Must be positive.".format(self.jfnk_maxiter))
+            elif type(self.jfnk_reltol) != float:
+                raise DREAMException("Solver: Invalid type of parameter 'jfnk_reltol': {}. Expected float.".format(type(self.jfnk_reltol)))
+
+            self.tolerance.verifySettings()
         else:
             raise DREAMException("Solver: Unrecognized solver type: {}.".format(self.type))
 
+        if type(self.parallelrebuild) != bool:
+            raise DREAMException("Solver: Invalid type of parameter 'parallelrebuild': {}. Expected boolean.".format(type(self.parallelrebuild)))
+        if type(self.paralleljacobian) != bool:
+            raise DREAMException("Solver: Invalid type of parameter 'paralleljacobian': {}. Expected boolean.".format(type(self.paralleljacobian)))
+        if type(self.reusesymbolic) != bool:
+            raise DREAMException("Solver: Invalid type of parameter 'reusesymbolic': {}. Expected boolean.".format(type(self.reusesymbolic)))
+        if self.ordering not in [ORDERING_DEFAULT, ORDERING_RADIAL]:
+            raise DREAMException("Solver: Unrecognized matrix ordering: {}.".format(self.ordering))
+        if self.gmres_preconditioner not in [GMRES_PRECONDITIONER_BLOCK_JACOBI, GMRES_PRECONDITIONER_FIELDSPLIT, GMRES_PRECONDITIONER_SCHUR]:
+            raise DREAMException("Solver: Unrecognized GMRES preconditioner: {}.".format(self.gmres_preconditioner))
+        for f in ['maxpcreuse', 'maxpciterations', 'recycle']:
+            v = getattr(self, 'gmres_{}'.format(f))
+            if type(v) != int:
+                raise DREAMException("Solver: Invalid type of parameter 'gmres_{}': {}. Expected integer.".format(f, type(v)))
+            elif v < 0:
+                raise DREAMException("Solver: Invalid value of parameter 'gmres_{}': {}. Must be non-negative.".format(f, v))
+
+        if type(self.mixed_epsilon) != float or self.mixed_epsilon <= 0:
+            raise DREAMException("Solver: Invalid value of parameter 'mixed_epsilon': {}. Expected positive float.".format(self.mixed_epsilon))
+        elif type(self.mixed_reltol) != float or self.mixed_reltol <= 0:
+            raise DREAMException("Solver: Invalid value of parameter 'mixed_reltol': {}. Expected positive float.".format(self.mixed_reltol))
+        elif type(self.mixed_maxiter) != int or self.mixed_maxiter <= 0:
+            raise DREAMException("Solver: Invalid value of parameter 'mixed_maxiter': {}. Expected positive integer.".format(self.mixed_maxiter))
+
         self.preconditioner.verifySettings()
 
 
@@ -286,7 +593,7 @@ class Solver:
         Verifies the settings for the linear solver (which is used
         by both the 'LINEAR_IMPLICIT' and 'NONLINEAR' solvers).
         """
-        solv = [LINEAR_SOLVER_LU, LINEAR_SOLVER_MUMPS, LINEAR_SOLVER_MKL, LINEAR_SOLVER_SUPERLU, LINEAR_SOLVER_GMRES]
+        solv = [LINEAR_SOLVER_LU, LINEAR_SOLVER_MUMPS, LINEAR_SOLVER_MKL, LINEAR_SOLVER_SUPERLU, LINEAR_SOLVER_GMRES, LINEAR_SOLVER_MIXED_PRECISION]
         if self.linsolv not in solv:
             raise DREAMException("Solver: Unrecognized linear solver type: {}.".format(self.linsolv))
         elif self.backupsolver is not None and (self.backupsolver not in solv and self.backupsolver != BACKUP_SOLVER_NONE):
@@ -11,6 +11,7 @@ from . ToleranceSettings import ToleranceSettings
 TYPE_CONSTANT = 1
 TYPE_ADAPTIVE = 2
 TYPE_IONIZATION = 3
+TYPE_EMBEDDED = 4
 
 
 class TimeStepper:
@@ -42,6 +43,7 @@ class TimeStepper:
         self.dtmax = None
         self.automaticstep = None
         self.safetyfactor = None
+        self.order = 1
 
 
     def __contains__(self, item):
@@ -108,6 +110,19 @@ class TimeStepper:
         self.nSaveSteps = nSaveSteps
 
 
+    def setOrder(self, order):
+        """
+        Sets the order of the backward differentiation formula used to
+        discretize time derivatives. With ``order=1`` (default), the
+        backward Euler method is used, and with ``order=2``, the
+        (variable-step) second-order BDF2 method is used.
+        """
+        if order not in [1, 2]:
+            raise DREAMException("TimeStepper: Invalid order of time discretization: {}. Must be 1 or 2.".format(order))
+
+        self.order = int(order)
+
+
     def setRelTol(self, reltol): self.setRelativeTolerance(reltol=reltol)
 
 
@@ -130,10 +145,10 @@ class TimeStepper:
 
 
     def setType(self, ttype, *args, **kwargs):
-        if ttype not in [TYPE_CONSTANT, TYPE_ADAPTIVE, TYPE_IONIZATION]:
+        if ttype not in [TYPE_CONSTANT, TYPE_ADAPTIVE, TYPE_IONIZATION, TYPE_EMBEDDED]:
             raise DREAMException("TimeStepper: Unrecognized time stepper type specified: {}".format(ttype))
 
-        if ttype in [TYPE_ADAPTIVE, TYPE_IONIZATION]:
+        if ttype in [TYPE_ADAPTIVE, TYPE_IONIZATION, TYPE_EMBEDDED]:
             self.nt = None
 
         self.type = int(ttype)
@@ -182,6 +197,7 @@ class TimeStepper:
         if 'minsavedt' in data: self.minsavedt = float(scal(data['minsavedt']))
         if 'nt' in data: self.nt = int(scal(data['nt']))
         if 'nsavesteps' in data: self.nSaveSteps = int(scal(data['nsavesteps']))
+        if 'order' in data: self.order = int(scal(data['order']))
         if 'verbose' in data: self.verbose = bool(scal(data['verbose']))
         if 'safetyfactor' in data: self.safetyfactor = float(scal(data['safetyfactor']))
         if 'tolerance' in data: self.tolerance.fromdict(data['tolerance'])
@@ -199,7 +215,8 @@ class TimeStepper:
 
         data = {
             'type': self.type,
-            'tmax': self.tmax
+            'tmax': self.tmax,
+            'order': self.order
         }
 
         if self.dt is not None: data['dt'] = self.dt
@@ -212,6 +229,9 @@ class TimeStepper:
             data['constantstep'] = self.constantstep
             data['tolerance'] = self.tolerance.todict()
             data['verbose'] = self.verbose
+        elif self.type == TYPE_EMBEDDED:
+            data['tolerance'] = self.tolerance.todict()
+            data['verbose'] = self.verbose
         elif self.type == TYPE_IONIZATION:
             if self.dtmax is not None: data['dtmax'] = self.dtmax
             data['automaticstep'] = self.automaticstep
@@ -225,6 +245,11 @@ class TimeStepper:
         """
         Verify that the TimeStepper settings are consistent.
         """
+        if self.order not in [1, 2]:
+            raise DREAMException("TimeStepper: Invalid order of time discretization: {}. Must be 1 or 2.".format(self.order))
+        elif self.order == 2 and self.type == TYPE_ADAPTIVE:
+            raise DREAMException("TimeStepper adaptive: The second-order time discretization is not supported by this time stepper.")
+
         if self.type == TYPE_CONSTANT:
             if self.tmax is None or self.tmax <= 0:
                 raise DREAMException("TimeStepper constant: 'tmax' must be set to a value > 0.")
@@ -252,6 +277,16 @@ class TimeStepper:
             elif type(self.constantstep) != bool:
                 raise DREAMException("TimeStepper adaptive: 'constantstep' must be a boolean.")
             self.tolerance.verifySettings()
+        elif self.type == TYPE_EMBEDDED:
+            if self.tmax is None or self.tmax <= 0:
+                raise DREAMException("TimeStepper embedded: 'tmax' must be set to a value > 0.")
+            elif self.nt is not None:
+                raise DREAMException("TimeStepper embedded: 'nt' cannot be used with the embedded time stepper.")
+            elif self.dt is not None and self.dt < 0:
+                raise DREAMException("TimeStepper embedded: 'dt' must be non-negative.")
+            elif type(self.verbose) != bool:
+                raise DREAMException("TimeStepper embedded: 'verbose' must be a boolean.")
+            self.tolerance.verifySettings()
         elif self.type == TYPE_IONIZATION:
             if self.tmax is None or self.tmax <= 0:
                 raise DREAMException("TimeStepper ionization: 'tmax' must be set to a value > 0.")
@@ -57,6 +57,10 @@ class TransportSettings:
         self.drr_pperp    = None
         self.drr_interp3d = None
 
+        # Time interpolation of prescribed coefficients
+        self.interp_windowed = False
+        self.interp_prefetch = False
+
         # Svensson pstar
         self.pstar          = None
         self.interp1d_param = SVENSSON_INTERP1D_PARAM_TIME 
@@ -108,6 +112,21 @@ class TransportSettings:
         self._prescribeCoefficient('drr', coeff=drr, t=t, r=r, p=p, xi=xi, ppar=ppar, pperp=pperp)
 
 
+    def setInterpolationWindow(self, windowed=True, prefetch=False):
+        """
+        Only keep the two prescribed time slices bracketing the current
+        simulation time interpolated onto the simulation grid, instead of
+        interpolating all time slices when the simulation starts. This
+        greatly reduces the memory used by kinetic coefficients given at
+        many time points.
+
+        :param bool windowed: If ``True``, interpolate time slices lazily as the simulation advances.
+        :param bool prefetch: If ``True``, interpolate the next time slice on a background thread.
+        """
+        self.interp_windowed = bool(windowed)
+        self.interp_prefetch = bool(prefetch)
+
+
     def setSvenssonPstar(self,pstar):
         """
         Set the lower momentum bound for the runaway, radial transport, region.
@@ -363,6 +382,12 @@ class TransportSettings:
                 if 'ppar' in data['drr']: self.drr_ppar = data['drr']['ppar']
                 if 'pperp' in data['drr']: self.drr_pperp = data['drr']['pperp']
 
+        if 'interp_windowed' in data:
+            self.interp_windowed = bool(data['interp_windowed'])
+
+        if 'interp_prefetch' in data:
+            self.interp_prefetch = bool(data['interp_prefetch'])
+
         if 'pstar' in data:
             self.pstar = data['pstar']
             
@@ -442,6 +467,9 @@ class TransportSettings:
                     data['drr']['ppar'] = self.drr_ppar
                     data['drr']['pperp'] = self.drr_pperp
 
+        if self.type == TRANSPORT_PRESCRIBED:
+            data['interp_windowed'] = self.interp_windowed
+            data['interp_prefetch'] = self.interp_prefetch
         
         # Svensson pstar
         if self.type == TRANSPORT_SVENSSON and self.pstar is not None:
@@ -25,31 +25,17 @@ const len_t
 
 /**
  * Constructor.
+ *
+ * Interpolation objects are not constructed here, but the first time
+ * data for an element is requested (see 'get_element()'), so that only
+ * the elements actually used in a simulation are prepared.
+ *
+ * interp: 2D interpolation method to use.
  */
-ADAS::ADAS(const gsl_interp2d_type *interp) {
-    // Generate interpolator objects
+ADAS::ADAS(const gsl_interp2d_type *interp) : interp(interp) {
     for (len_t i = 0; i < adas_rate_n; i++) {
         struct adas_rate *ar = (adas_rate_table+i);
-
-        ADASRateInterpolator **ari = new ADASRateInterpolator*[N_ADAS_RATES];
-
-        #define INITADAS(type,shiftZ0) \
-            new ADASRateInterpolator( \
-                ar->Z, ar-> type ## _nn, ar-> type ## _nT, \
-                ar-> type ## _n, ar-> type ## _T, \
-                ar-> type , shiftZ0, interp \
-            )
-
-        ari[IDX_ACD] = INITADAS(acd, true);
-        ari[IDX_CCD] = INITADAS(ccd, false);
-        ari[IDX_SCD] = INITADAS(scd, false);
-        ari[IDX_PLT] = INITADAS(plt, false);
-        ari[IDX_PRB] = INITADAS(prb, true);
-
-        len_t idx = get_isotope_index(ar->Z, ar->A);
-        intp[idx] = ari;
-
-        #undef INITADAS
+        rates[get_isotope_index(ar->Z, ar->A)] = ar;
     }
 }
 
@@ -84,22 +70,24 @@ len_t ADAS::get_isotope_index(const len_t Z, const len_t A) const {
  */
 bool ADAS::HasElement(const len_t Z, const len_t A) const {
     len_t idx = get_isotope_index(Z, A);
-    return (intp.find(idx) != intp.end());
+    return (rates.find(idx) != rates.end());
 }
 
 
 /**
  * (private)
- * Returns an iterator to the entry in the interpolator list
- * for the element with the specified charge.
+ * Returns the list of interpolation objects for the element with
+ * the specified charge, constructing them if this is the first time
+ * the element is requested.
  *
- * Z: Charge of element to get iterator to.
+ * Z: Charge of element to get interpolators for.
+ * A: Mass number of isotope (0 = default isotope).
  */
-unordered_map<len_t, ADASRateInterpolator**>::const_iterator ADAS::get_element(const len_t Z, const len_t A) const {
+ADASRateInterpolator **ADAS::get_element(const len_t Z, const len_t A) const {
     len_t idx = get_isotope_index(Z, A);
 
-    unordered_map<len_t, ADASRateInterpolator**>::const_iterator it = intp.find(idx);
-    if (it == intp.end()) {
+    auto rit = rates.find(idx);
+    if (rit == rates.end()) {
         if (A == 0)
             throw ADASException(
                 "Element with charge Z=" LEN_T_PRINTF_FMT " not in DREAM ADAS database.",
@@ -112,26 +100,68 @@ unordered_map<len_t, ADASRateInterpolator**>::const_iterator ADAS::get_element(c
             );
     }
 
-    return it;
+    ADASRateInterpolator **ari;
+    // Equation terms may be rebuilt in parallel
+#ifdef _OPENMP
+    #pragma omp critical (DREAM_ADAS_get_element)
+#endif
+    {
+        auto it = intp.find(idx);
+        if (it == intp.end()) {
+            ari = construct_element(rit->second);
+            intp[idx] = ari;
+        } else
+            ari = it->second;
+    }
+
+    return ari;
+}
+
+/**
+ * (private)
+ * Construct the interpolation objects for all rate
+ * coefficients of the given element.
+ *
+ * ar: ADAS data for element.
+ */
+ADASRateInterpolator **ADAS::construct_element(const struct adas_rate *ar) const {
+    ADASRateInterpolator **ari = new ADASRateInterpolator*[N_ADAS_RATES];
+
+    #define INITADAS(type,shiftZ0) \
+        new ADASRateInterpolator( \
+            ar->Z, ar-> type ## _nn, ar-> type ## _nT, \
+            ar-> type ## _n, ar-> type ## _T, \
+            ar-> type , shiftZ0, this->interp \
+        )
+
+    ari[IDX_ACD] = INITADAS(acd, true);
+    ari[IDX_CCD] = INITADAS(ccd, false);
+    ari[IDX_SCD] = INITADAS(scd, false);
+    ari[IDX_PLT] = INITADAS(plt, false);
+    ari[IDX_PRB] = INITADAS(prb, true);
+
+    #undef INITADAS
+
+    return ari;
 }
 
 /**
  * Getters for ADAS data.
  */
 ADASRateInterpolator *ADAS::GetACD(const len_t Z, const len_t A) const {
-    return get_element(Z, A)->second[IDX_ACD];
+    return get_element(Z, A)[IDX_ACD];
 }
 ADASRateInterpolator *ADAS::GetCCD(const len_t Z, const len_t A) const {
-    return get_element(Z, A)->second[IDX_CCD];
+    return get_element(Z, A)[IDX_CCD];
 }
 ADASRateInterpolator *ADAS::GetSCD(const len_t Z, const len_t A) const {
-    return get_element(Z, A)->second[IDX_SCD];
+    return get_element(Z, A)[IDX_SCD];
 }
 ADASRateInterpolator *ADAS::GetPLT(const len_t Z, const len_t A) const {
-    return get_element(Z, A)->second[IDX_PLT];
+    return get_element(Z, A)[IDX_PLT];
 }
 ADASRateInterpolator *ADAS::GetPRB(const len_t Z, const len_t A) const {
-    return get_element(Z, A)->second[IDX_PRB];
+    return get_element(Z, A)[IDX_PRB];
 }
 
 /**
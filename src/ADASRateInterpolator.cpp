@@ -6,6 +6,7 @@
 #include <cmath>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_interp2d.h>
+#include <gsl/gsl_spline.h>
 #include "DREAM/ADASRateInterpolator.hpp"
 
 
@@ -20,7 +21,7 @@ using namespace DREAM;
  * logn:   Logarithm of plasma density (size nn).
  * logT:   Logarithm of plasma temperature (size nT).
  * coeff:  ADAS rate coefficient to interpolate (size Z*nn*nT).
- * interp: 2D interpolation method to use.
+ * interp: 2D interpolation method to use (bicubic or bilinear).
  */
 ADASRateInterpolator::ADASRateInterpolator(
     const len_t Z, const len_t nn, const len_t nT,
@@ -28,45 +29,174 @@ ADASRateInterpolator::ADASRateInterpolator(
     bool shiftZ0, const gsl_interp2d_type *interp
 ) : Z(Z), nn(nn), nT(nT), logn(logn), logT(logT), data(coeff), shiftZ0(shiftZ0) {
 
-    this->interp_c = new gsl_interp2d*[Z];
-    this->interp_l = new gsl_interp2d*[Z];
-    this->nacc = new gsl_interp_accel*[Z];
-    this->Tacc = new gsl_interp_accel*[Z];
+    this->bicubic = (interp != gsl_interp2d_bilinear);
+    if (this->bicubic)
+        ComputeSplineDerivatives();
+}
+
+/**
+ * Destructor.
+ */
+ADASRateInterpolator::~ADASRateInterpolator() {
+    if (this->zn != nullptr) {
+        delete [] this->znT;
+        delete [] this->zT;
+        delete [] this->zn;
+    }
+}
+
+/**
+ * Evaluate the derivatives of the tabulated data which are
+ * needed for bicubic interpolation. As in the GSL 'bicubic'
+ * interpolation method, the derivatives in the nodes are taken
+ * from natural cubic splines through the rows and columns of
+ * the table (and through the columns of the log(n) derivative
+ * for the mixed derivative).
+ */
+void ADASRateInterpolator::ComputeSplineDerivatives() {
     const len_t stride = nn*nT;
+    this->zn  = new real_t[Z*stride];
+    this->zT  = new real_t[Z*stride];
+    this->znT = new real_t[Z*stride];
+
+    gsl_interp_accel *acc = gsl_interp_accel_alloc();
+    gsl_spline *spline_n = gsl_spline_alloc(gsl_interp_cspline, nn);
+    gsl_spline *spline_T = gsl_spline_alloc(gsl_interp_cspline, nT);
+    real_t *col = new real_t[nT];
 
-    for (len_t i = 0; i < Z; i++) {
-        this->interp_c[i] = gsl_interp2d_alloc(interp, nn, nT);
-        gsl_interp2d_init(this->interp_c[i], this->logn, this->logT, this->data + i*stride, nn, nT);
+    for (len_t idx = 0; idx < Z; idx++) {
+        const real_t *z = this->data + idx*stride;
+        real_t *zx  = this->zn + idx*stride;
+        real_t *zy  = this->zT + idx*stride;
+        real_t *zxy = this->znT + idx*stride;
 
-        if (interp == gsl_interp2d_bilinear)
-            this->interp_l[i] = this->interp_c[i];
-        else {
-            this->interp_l[i] = gsl_interp2d_alloc(gsl_interp2d_bilinear, nn, nT);
-            gsl_interp2d_init(this->interp_l[i], this->logn, this->logT, this->data + i*stride, nn, nT);
+        // d/dlog(n)
+        for (len_t j = 0; j < nT; j++) {
+            gsl_spline_init(spline_n, logn, z+j*nn, nn);
+            gsl_interp_accel_reset(acc);
+            for (len_t i = 0; i < nn; i++)
+                zx[j*nn+i] = gsl_spline_eval_deriv(spline_n, logn[i], acc);
         }
 
-        this->nacc[i] = gsl_interp_accel_alloc();
-        this->Tacc[i] = gsl_interp_accel_alloc();
+        // d/dlog(T) and d^2/dlog(n)dlog(T)
+        for (len_t i = 0; i < nn; i++) {
+            for (len_t j = 0; j < nT; j++)
+                col[j] = z[j*nn+i];
+
+            gsl_spline_init(spline_T, logT, col, nT);
+            gsl_interp_accel_reset(acc);
+            for (len_t j = 0; j < nT; j++)
+                zy[j*nn+i] = gsl_spline_eval_deriv(spline_T, logT[j], acc);
+
+            for (len_t j = 0; j < nT; j++)
+                col[j] = zx[j*nn+i];
+
+            gsl_spline_init(spline_T, logT, col, nT);
+            gsl_interp_accel_reset(acc);
+            for (len_t j = 0; j < nT; j++)
+                zxy[j*nn+i] = gsl_spline_eval_deriv(spline_T, logT[j], acc);
+        }
     }
+
+    delete [] col;
+    gsl_spline_free(spline_T);
+    gsl_spline_free(spline_n);
+    gsl_interp_accel_free(acc);
 }
 
 /**
- * Destructor.
+ * Locate the given point in the table and evaluate the
+ * interpolation basis functions in it.
+ *
+ * ln: Logarithm (base 10) of density.
+ * lT: Logarithm (base 10) of temperature.
+ * pt: Contains the location of the point on return.
  */
-ADASRateInterpolator::~ADASRateInterpolator() {
-    for (len_t i = 0; i < Z; i++) {
-        if (this->interp_c[i] != this->interp_l[i])
-            gsl_interp2d_free(this->interp_l[i]);
+void ADASRateInterpolator::Locate(const real_t ln, const real_t lT, struct point &pt) const {
+    // Bilinear extrapolation is used outside of the table
+    pt.linear = (!bicubic || ln < this->logn[0] || lT < this->logT[0] ||
+        ln > this->logn[this->nn-1] || lT > this->logT[this->nT-1]);
+
+    pt.in = gsl_interp_bsearch(this->logn, ln, 0, this->nn-1);
+    pt.iT = gsl_interp_bsearch(this->logT, lT, 0, this->nT-1);
+    pt.dn = this->logn[pt.in+1] - this->logn[pt.in];
+    pt.dT = this->logT[pt.iT+1] - this->logT[pt.iT];
+
+    const real_t t = (ln - this->logn[pt.in]) / pt.dn;
+    const real_t u = (lT - this->logT[pt.iT]) / pt.dT;
+
+    if (pt.linear) {
+        pt.a0 = 1-t;  pt.a1 = t;  pt.da0 = -1; pt.da1 = 1;
+        pt.c0 = 1-u;  pt.c1 = u;  pt.dc0 = -1; pt.dc1 = 1;
+        pt.b0 = pt.b1 = pt.db0 = pt.db1 = 0;
+        pt.d0 = pt.d1 = pt.dd0 = pt.dd1 = 0;
+    } else {
+        const real_t t2 = t*t, t3 = t2*t;
+        pt.a0 = 2*t3 - 3*t2 + 1;  pt.da0 = 6*t2 - 6*t;
+        pt.a1 = 3*t2 - 2*t3;      pt.da1 = 6*t - 6*t2;
+        pt.b0 = t3 - 2*t2 + t;    pt.db0 = 3*t2 - 4*t + 1;
+        pt.b1 = t3 - t2;          pt.db1 = 3*t2 - 2*t;
 
-        gsl_interp2d_free(this->interp_c[i]);
-        gsl_interp_accel_free(this->nacc[i]);
-        gsl_interp_accel_free(this->Tacc[i]);
+        const real_t u2 = u*u, u3 = u2*u;
+        pt.c0 = 2*u3 - 3*u2 + 1;  pt.dc0 = 6*u2 - 6*u;
+        pt.c1 = 3*u2 - 2*u3;      pt.dc1 = 6*u - 6*u2;
+        pt.d0 = u3 - 2*u2 + u;    pt.dd0 = 3*u2 - 4*u + 1;
+        pt.d1 = u3 - u2;          pt.dd1 = 3*u2 - 2*u;
     }
+}
+
+/**
+ * Evaluate the interpolated (base 10) logarithm of the rate
+ * coefficient, and optionally its derivatives with respect
+ * to log10(n) and log10(T), in a point located using 'Locate()'.
+ *
+ * idx:  Index of the tabulated charge state.
+ * pt:   Point to evaluate the interpolant in.
+ * dfdn: If not 'nullptr', contains the derivative with
+ *       respect to log10(n) on return.
+ * dfdT: If not 'nullptr', contains the derivative with
+ *       respect to log10(T) on return.
+ */
+real_t ADASRateInterpolator::EvalPoint(
+    const len_t idx, const struct point &pt, real_t *dfdn, real_t *dfdT
+) const {
+    const len_t stride = this->nn*this->nT;
+    const len_t k00 = pt.iT*this->nn + pt.in, k10 = k00+1;
+    const len_t k01 = k00 + this->nn, k11 = k01+1;
+    const real_t *z = this->data + idx*stride;
+
+    // Interpolate along log(n) on the two log(T) rows of the cell...
+    real_t f0  = pt.a0*z[k00]  + pt.a1*z[k10];
+    real_t f1  = pt.a0*z[k01]  + pt.a1*z[k11];
+    real_t fn0 = pt.da0*z[k00] + pt.da1*z[k10];
+    real_t fn1 = pt.da0*z[k01] + pt.da1*z[k11];
+
+    // ...together with the log(T) derivative (bicubic only)
+    real_t g0 = 0, g1 = 0, gn0 = 0, gn1 = 0;
+    if (!pt.linear) {
+        const real_t *zx  = this->zn + idx*stride;
+        const real_t *zy  = this->zT + idx*stride;
+        const real_t *zxy = this->znT + idx*stride;
+        const real_t dn = pt.dn;
+
+        f0  += dn*(pt.b0*zx[k00]  + pt.b1*zx[k10]);
+        f1  += dn*(pt.b0*zx[k01]  + pt.b1*zx[k11]);
+        fn0 += dn*(pt.db0*zx[k00] + pt.db1*zx[k10]);
+        fn1 += dn*(pt.db0*zx[k01] + pt.db1*zx[k11]);
+
+        g0  = pt.a0*zy[k00]  + pt.a1*zy[k10]  + dn*(pt.b0*zxy[k00]  + pt.b1*zxy[k10]);
+        g1  = pt.a0*zy[k01]  + pt.a1*zy[k11]  + dn*(pt.b0*zxy[k01]  + pt.b1*zxy[k11]);
+        gn0 = pt.da0*zy[k00] + pt.da1*zy[k10] + dn*(pt.db0*zxy[k00] + pt.db1*zxy[k10]);
+        gn1 = pt.da0*zy[k01] + pt.da1*zy[k11] + dn*(pt.db0*zxy[k01] + pt.db1*zxy[k11]);
+    }
+
+    // ...and combine in the log(T) direction
+    if (dfdn != nullptr)
+        *dfdn = (pt.c0*fn0 + pt.c1*fn1 + pt.dT*(pt.d0*gn0 + pt.d1*gn1)) / pt.dn;
+    if (dfdT != nullptr)
+        *dfdT = (pt.dc0*f0 + pt.dc1*f1 + pt.dT*(pt.dd0*g0 + pt.dd1*g1)) / pt.dT;
 
-    delete [] this->Tacc;
-    delete [] this->nacc;
-    delete [] this->interp_l;
-    delete [] this->interp_c;
+    return pt.c0*f0 + pt.c1*f1 + pt.dT*(pt.d0*g0 + pt.d1*g1);
 }
 
 /**
@@ -84,42 +214,106 @@ real_t ADASRateInterpolator::Eval(const len_t Z0, const real_t n, const real_t T
     if((n<=0) || (T<=0))
         return 0;
 
-    const len_t idx = (shiftZ0 ? Z0-1 : Z0);
-    const len_t stride = this->nn*this->nT;
-    const real_t lT = log10(T);
-    const real_t ln = log10(n);
+    struct point pt;
+    Locate(log10(n), log10(T), pt);
 
     // coeff = 10^ADASDATA
-    gsl_interp2d *spln;
-    if (ln < this->logn[0] || lT < this->logT[0] || ln > this->logn[this->nn-1] || lT > this->logT[this->nT-1])
-        spln = this->interp_l[idx];
-    else
-        spln = this->interp_c[idx];
-
-    return exp(LN10 * gsl_interp2d_eval_extrap(
-        // GSL interpolation 2D object
-        spln,
-        // Input data
-        this->logn, this->logT, this->data+idx*stride,
-        // Point to evaluate data in
-        ln, lT,
-        // Accelerator objects (for quicker table lookup)
-        this->nacc[idx], this->Tacc[idx]
-    ));
+    const len_t idx = (shiftZ0 ? Z0-1 : Z0);
+    return exp(LN10 * EvalPoint(idx, pt));
 }
 
-real_t ADASRateInterpolator::Eval_deriv_n(const len_t Z0, const real_t n, const real_t T) {
-    real_t eps = std::numeric_limits<real_t>::epsilon();
-    real_t dn = sqrt(eps)*n + eps;
-    return ( Eval(Z0,n+dn,T) - Eval(Z0,n,T) ) / dn;
+/**
+ * Evaluate the rate coefficient for all charge states and all
+ * given plasma parameters in one call. The table lookup is shared
+ * between all charge states, and the derivatives with respect to
+ * density and temperature are evaluated analytically from the
+ * interpolating spline. Output arrays are indexed as
+ * [Z0*nr + ir], with Z0 = 0, 1, ..., Z.
+ *
+ * nr:       Number of density/temperature points.
+ * n:        Densities (size nr).
+ * T:        Temperatures (size nr).
+ * rate:     On return, contains the rate coefficient (size (Z+1)*nr,
+ *           or 'nullptr' if not needed).
+ * drate_dn: On return, contains the derivative of the rate coefficient
+ *           with respect to density (or 'nullptr' if not needed).
+ * drate_dT: On return, contains the derivative of the rate coefficient
+ *           with respect to temperature (or 'nullptr' if not needed).
+ */
+void ADASRateInterpolator::Eval(
+    const len_t nr, const real_t *n, const real_t *T, real_t *rate,
+    real_t *drate_dn, real_t *drate_dT
+) {
+    const len_t Z0null = (shiftZ0 ? 0 : Z);
+    const len_t Z0offs = (shiftZ0 ? 1 : 0);
+    const bool derivs = (drate_dn != nullptr || drate_dT != nullptr);
+
+    for (len_t ir = 0; ir < nr; ir++) {
+        if (n[ir] <= 0 || T[ir] <= 0) {
+            for (len_t Z0 = 0; Z0 <= Z; Z0++) {
+                if (rate != nullptr) rate[Z0*nr + ir] = 0;
+                if (drate_dn != nullptr) drate_dn[Z0*nr + ir] = 0;
+                if (drate_dT != nullptr) drate_dT[Z0*nr + ir] = 0;
+            }
+            continue;
+        }
+
+        struct point pt;
+        Locate(log10(n[ir]), log10(T[ir]), pt);
+
+        for (len_t idx = 0; idx < Z; idx++) {
+            const len_t k = (idx+Z0offs)*nr + ir;
+            real_t dfdn, dfdT;
+            real_t R = exp(LN10 * EvalPoint(idx, pt, derivs ? &dfdn : nullptr, derivs ? &dfdT : nullptr));
+
+            if (rate != nullptr) rate[k] = R;
+            // d(10^f)/dn = 10^f * (df/dlog10(n)) / n
+            if (drate_dn != nullptr) drate_dn[k] = R * dfdn / n[ir];
+            if (drate_dT != nullptr) drate_dT[k] = R * dfdT / T[ir];
+        }
+
+        if (rate != nullptr) rate[Z0null*nr + ir] = 0;
+        if (drate_dn != nullptr) drate_dn[Z0null*nr + ir] = 0;
+        if (drate_dT != nullptr) drate_dT[Z0null*nr + ir] = 0;
+    }
 }
 
+/**
+ * Evaluate the derivative of the rate coefficient with
+ * respect to density.
+ *
+ * Z0: Ion charge state to evaluate derivative for.
+ * n:  Density.
+ * T   Temperature.
+ */
+real_t ADASRateInterpolator::Eval_deriv_n(const len_t Z0, const real_t n, const real_t T) {
+    if ((shiftZ0 && Z0 == 0) || (!shiftZ0 && Z0 == Z) || n <= 0 || T <= 0)
+        return 0;
+
+    struct point pt;
+    Locate(log10(n), log10(T), pt);
 
-real_t ADASRateInterpolator::Eval_deriv_T(const len_t Z0, const real_t n, const real_t T) {
-    real_t eps = std::numeric_limits<real_t>::epsilon();
-    real_t dT = sqrt(eps)*T + eps;
-    return ( Eval(Z0,n,T+dT) - Eval(Z0,n,T) ) / dT;
+    real_t dfdn;
+    const len_t idx = (shiftZ0 ? Z0-1 : Z0);
+    return exp(LN10 * EvalPoint(idx, pt, &dfdn)) * dfdn / n;
 }
 
+/**
+ * Evaluate the derivative of the rate coefficient with
+ * respect to temperature.
+ *
+ * Z0: Ion charge state to evaluate derivative for.
+ * n:  Density.
+ * T   Temperature.
+ */
+real_t ADASRateInterpolator::Eval_deriv_T(const len_t Z0, const real_t n, const real_t T) {
+    if ((shiftZ0 && Z0 == 0) || (!shiftZ0 && Z0 == Z) || n <= 0 || T <= 0)
+        return 0;
 
+    struct point pt;
+    Locate(log10(n), log10(T), pt);
 
+    real_t dfdT;
+    const len_t idx = (shiftZ0 ? Z0-1 : Z0);
+    return exp(LN10 * EvalPoint(idx, pt, nullptr, &dfdT)) * dfdT / T;
+}
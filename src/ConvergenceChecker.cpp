@@ -3,6 +3,8 @@
  * relative).
  */
 
+#include <cmath>
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -147,6 +149,7 @@ bool ConvergenceChecker::IsConverged(const real_t *x, const real_t *dx, bool ver
     // Iterate over norms and ensure that all are small
     const len_t N = this->nontrivials.size();
     bool converged = true;
+    real_t measure = 0;
 
     for (len_t i = 0; i < N; i++) {
 		bool conv = true;
@@ -159,7 +162,11 @@ bool ConvergenceChecker::IsConverged(const real_t *x, const real_t *dx, bool ver
             continue;
 
 		//if(x_2norm[i]>0)
-        conv = (dx_2norm[i] <= (epsa + epsr*x_2norm[i])); 
+        const real_t scale = epsa + epsr*x_2norm[i];
+        conv = (dx_2norm[i] <= scale); 
+
+        if (scale > 0 && dx_2norm[i]/scale > measure)
+            measure = dx_2norm[i]/scale;
 
         // Guard against infinity...
         if (std::isinf(dx_2norm[i]) || std::isinf(x_2norm[i]))
@@ -191,9 +198,29 @@ bool ConvergenceChecker::IsConverged(const real_t *x, const real_t *dx, bool ver
         converged = converged && conv;
     }
 
+    this->prevStepMeasure = this->stepMeasure;
+    this->stepMeasure = measure;
+
 	return converged;
 }
 
+/**
+ * Returns the rate at which the solution converges, measured as the
+ * ratio of the (largest, relative to its tolerance) step norm in the
+ * most recent call to 'IsConverged()' to that in the call before. A
+ * rate well below one indicates rapid convergence. If fewer than two
+ * steps have been checked since the last call to
+ * 'ResetConvergenceRate()', zero is returned.
+ */
+real_t ConvergenceChecker::GetConvergenceRate() const {
+    if (this->prevStepMeasure <= 0)
+        return 0;
+    else if (!std::isfinite(this->stepMeasure))
+        return std::numeric_limits<real_t>::infinity();
+    else
+        return this->stepMeasure / this->prevStepMeasure;
+}
+
 /**
  * Set the absolute tolerance for the specified unknown.
  *
@@ -0,0 +1,132 @@
+/**
+ * Routines for writing and loading checkpoints of the state of the
+ * EquationSystem object. A checkpoint contains everything which is
+ * needed to resume the simulation from where the checkpoint was
+ * written, namely
+ *
+ *   - the current and previous values of all unknown quantities,
+ *     together with all time steps saved so far,
+ *   - the data saved for "other" quantities,
+ *   - the state of the time stepper,
+ *   - solver statistics, and
+ *   - the state of the SPI shards (if SPI is used).
+ *
+ * Together with the settings used to start the simulation, the
+ * checkpoint allows the simulation to be resumed and give the same
+ * result as an uninterrupted simulation.
+ */
+
+#include <cstdio>
+#include <string>
+#include <softlib/SFile.h>
+#include "DREAM/EquationSystem.hpp"
+#include "DREAM/IO.hpp"
+
+
+using namespace DREAM;
+using namespace std;
+
+
+/**
+ * Enable writing of checkpoints during the simulation.
+ *
+ * filename: Name of checkpoint file to write.
+ * steps:    Number of time steps between checkpoints (0 = never
+ *           write checkpoints based on the number of steps).
+ * walltime: Wall-clock time (in seconds) between checkpoints
+ *           (0 = never write checkpoints based on wall-clock time).
+ */
+void EquationSystem::SetCheckpointing(
+    const string& filename, const len_t steps, const real_t walltime
+) {
+    this->checkpointFilename = filename;
+    this->checkpointSteps = steps;
+    this->checkpointWalltime = walltime;
+}
+
+/**
+ * Write a checkpoint of the current state of the equation system
+ * to the named file. The checkpoint is first written to a
+ * temporary file which is then moved to the final location, so
+ * that the previous checkpoint remains intact if the simulation
+ * is aborted while the checkpoint is being written.
+ *
+ * filename: Name of checkpoint file.
+ */
+void EquationSystem::SaveCheckpoint(const string& filename) {
+    const string tmpname = filename + ".tmp";
+    SFile *sf = SFile::Create(tmpname, SFILE_MODE_WRITE);
+
+    sf->WriteList("times", this->times.data(), this->times.size());
+
+    sf->CreateStruct("unknowns");
+    this->unknowns.SaveCheckpoint(sf, "unknowns");
+
+    sf->CreateStruct("other");
+    this->otherQuantityHandler->SaveCheckpoint(sf, "other");
+
+    sf->CreateStruct("timestepper");
+    this->timestepper->SaveCheckpoint(sf, "timestepper");
+
+    sf->CreateStruct("solver");
+    this->solver->SaveCheckpoint(sf, "solver");
+
+    if (this->SPI != nullptr) {
+        sf->CreateStruct("spi");
+        this->SPI->SaveCheckpoint(sf, "spi");
+    }
+
+    sf->Close();
+    delete sf;
+
+    if (std::rename(tmpname.c_str(), filename.c_str()) != 0)
+        throw EquationSystemException(
+            "Unable to move checkpoint file '%s' to '%s'.",
+            tmpname.c_str(), filename.c_str()
+        );
+}
+
+/**
+ * Restore the state of the equation system from the named
+ * checkpoint file. This should be called after the equation
+ * system has been fully constructed (with the same settings as
+ * were used for the simulation which wrote the checkpoint) and
+ * before 'Solve()' is called.
+ *
+ * filename: Name of checkpoint file.
+ */
+void EquationSystem::LoadCheckpoint(const string& filename) {
+    SFile *sf = SFile::Create(filename, SFILE_MODE_READ);
+
+    sfilesize_t nt;
+    real_t *t = sf->GetList("times", &nt);
+    this->times.assign(t, t+nt);
+    delete [] t;
+
+    this->currentTime = this->times.back();
+
+    this->unknowns.LoadCheckpoint(sf, "unknowns");
+    this->otherQuantityHandler->LoadCheckpoint(sf, "other");
+    this->timestepper->LoadCheckpoint(sf, "timestepper");
+    this->solver->LoadCheckpoint(sf, "solver");
+
+    if (this->SPI != nullptr) {
+        if (!sf->HasVariable("spi/rCoordPPrevious"))
+            throw EquationSystemException(
+                "The checkpoint file '%s' does not contain any SPI data.",
+                filename.c_str()
+            );
+
+        this->SPI->LoadCheckpoint(sf, "spi");
+    }
+
+    sf->Close();
+    delete sf;
+
+    this->restarted = true;
+
+    DREAM::IO::PrintInfo(
+        "Resuming simulation from checkpoint '%s' at t = %.6e s.",
+        filename.c_str(), this->currentTime
+    );
+}
@@ -7,6 +7,7 @@
 #include <softlib/Timer.h>
 #include "DREAM/EquationSystem.hpp"
 #include "DREAM/IO.hpp"
+#include "DREAM/OutputGenerator.hpp"
 #include "DREAM/QuitException.hpp"
 #include "DREAM/Settings/OptionConstants.hpp"
 #include "DREAM/Solver/SolverLinearlyImplicit.hpp"
@@ -175,10 +176,18 @@ void EquationSystem::SetSolver(Solver *solver) {
  * Solve this equation system.
  */
 void EquationSystem::Solve() {
-    this->currentTime = 0;
-    this->times.push_back(this->currentTime);
+    // When restarting from a checkpoint, the time and all
+    // previous time steps have already been restored
+    if (!this->restarted) {
+        this->currentTime = 0;
+        this->times.push_back(this->currentTime);
+    }
     this->timestepper->SetSolver(solver);
 
+    // Prepare output (which may be written while solving)
+    if (this->outputGenerator != nullptr)
+        this->outputGenerator->Initialize();
+
     this->PrintNonTrivialUnknowns();
     this->PrintTrivialUnknowns();
 
@@ -193,6 +202,8 @@ void EquationSystem::Solve() {
 
     Timer tim;
     len_t istep = 0;    // Number of times 'solver->Solve()' has been called...
+    len_t lastCheckpointStep = 0;
+    real_t lastCheckpointWalltime = 0;
     while (!timestepper->IsFinished()) {
         // Take step
         real_t tNext = timestepper->NextTime();
@@ -220,10 +231,25 @@ void EquationSystem::Solve() {
                 this->times.push_back(tNext);
 
                 otherQuantityHandler->StoreAll(tNext);
+
+                if (this->outputGenerator != nullptr)
+                    this->outputGenerator->SaveStep(tNext);
             } else
                 unknowns.SaveStep(tNext, false);
             
             timestepper->PrintProgress();
+
+            // Write checkpoint?
+            if (!this->checkpointFilename.empty() && timestepper->CanCheckpoint()) {
+                real_t walltime = tim.GetMicroseconds() * 1e-6;
+                if ((this->checkpointSteps > 0 && istep-lastCheckpointStep >= this->checkpointSteps) ||
+                    (this->checkpointWalltime > 0 && walltime-lastCheckpointWalltime >= this->checkpointWalltime)) {
+                    this->SaveCheckpoint(this->checkpointFilename);
+
+                    lastCheckpointStep = istep;
+                    lastCheckpointWalltime = walltime;
+                }
+            }
         } catch (DREAM::QuitException& ex) {
             // Rethrow quit exception
             throw ex;
@@ -26,6 +26,10 @@ CollisionFrequency::CollisionFrequency(FVM::Grid *g, FVM::UnknownQuantityHandler
                 : CollisionQuantity(g,u,ih,mgtype,cqset) {
     lnLambdaEE = lnLee;
     lnLambdaEI = lnLei;
+
+    if (cqset->psi_mode == OptionConstants::COLLQTY_PSI_MODE_TABULATED &&
+        cqset->collfreq_mode == OptionConstants::COLLQTY_COLLISION_FREQUENCY_MODE_FULL)
+        psiTable = PsiFunctionTable::Get();
 }
 
 
@@ -582,10 +586,14 @@ real_t CollisionFrequency::evaluatePsi0(len_t ir, real_t p) {
     } else if (lowenergyLimit){
         return evaluatePsiLowenergyLimit(0,p,Theta);
     } else {
+        real_t psi0int;
+        if (psiTable != nullptr && psiTable->Evaluate(0, p, Theta, &psi0int))
+            return psi0int;
+
         gsl_function F;
         F.function = &(CollisionFrequency::psi0Integrand); 
         F.params = &Theta;
-        real_t psi0int, error; 
+        real_t error; 
 
         real_t epsabs = 0, epsrel = 1e-8, lim = gsl_ad_w->limit; 
         gsl_integration_qag(&F,0,p,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&psi0int,&error);
@@ -613,11 +621,15 @@ real_t CollisionFrequency::evaluatePsi1(len_t ir, real_t p) {
         return Term0 + Theta*Term1 + Theta*Theta*Term2; 
     } else if (lowenergyLimit){
         return evaluatePsiLowenergyLimit(1,p,Theta);
-    }  else {
+    } else {
+        real_t psi1int;
+        if (psiTable != nullptr && psiTable->Evaluate(1, p, Theta, &psi1int))
+            return psi1int;
+
         gsl_function F;
         F.function = &(CollisionFrequency::psi1Integrand); 
         F.params = &Theta;
-        real_t psi1int, error; 
+        real_t error; 
 
         real_t epsabs = 0, epsrel = 1e-8, lim = gsl_ad_w->limit; 
         gsl_integration_qag(&F,0,p,epsabs,epsrel,lim,QAG_KEY,gsl_ad_w,&psi1int,&error);
@@ -642,11 +654,15 @@ real_t CollisionFrequency::evaluatePsi2(len_t ir, real_t p) {
         return Term0 + Theta*Term1 + Theta*Theta*Term2; 
     } else if (lowenergyLimit){
         return evaluatePsiLowenergyLimit(2,p,Theta);
-    }  else {
+    } else {
+        real_t psi2int;
+        if (psiTable != nullptr && psiTable->Evaluate(2, p, Theta, &psi2int))
+            return psi2int;
+
         gsl_function F;
         F.function = &(CollisionFrequency::psi2Integrand); 
         F.params = &Theta;
-        real_t psi2int, error; 
+        real_t error; 
 
         real_t epsabs = 0, epsrel = 1e-8, lim = gsl_ad_w->limit; 
         gsl_integration_qags(&F,0,p,epsabs,epsrel,lim,gsl_ad_w,&psi2int,&error);
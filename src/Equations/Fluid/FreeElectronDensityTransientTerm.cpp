@@ -26,6 +26,12 @@ FreeElectronDensityTransientTerm::FreeElectronDensityTransientTerm(FVM::Grid *g,
 void FreeElectronDensityTransientTerm::Rebuild(const real_t t, const real_t dt, FVM::UnknownQuantityHandler *uqty) {
     this->dt = dt;
     this->nions_prev = uqty->GetUnknownDataPrevious(this->id_ions);
+
+    if (uqty->GetTransientCoefficients(this->id_ions, dt, this->coeff) >= 2)
+        this->nions_prev2 = uqty->GetUnknownDataOld(this->id_ions, 1);
+    else
+        this->nions_prev2 = nullptr;
+
     this->DiagonalLinearTerm::Rebuild(t,dt,uqty);
 }
 
@@ -44,11 +50,17 @@ void FreeElectronDensityTransientTerm::SetMatrixElements(FVM::Matrix *mat, real_
     len_t nMultiples = ionHandler->GetNzs();
     for (len_t i = 0; i < N; i++)
         for(len_t n=0; n<nMultiples; n++)
-            mat->SetElement(i,n*N+i, weights[n*N+i]);
-    if (rhs != nullptr)
+            mat->SetElement(i,n*N+i, coeff[0]*weights[n*N+i]);
+    if (rhs != nullptr) {
         for (len_t i = 0; i < N; i++)
             for(len_t n=0; n<nMultiples; n++)
-                rhs[i] -= weights[n*N+i]*nions_prev[n*N+i];
+                rhs[i] += coeff[1]*weights[n*N+i]*nions_prev[n*N+i];
+
+        if (nions_prev2 != nullptr)
+            for (len_t i = 0; i < N; i++)
+                for(len_t n=0; n<nMultiples; n++)
+                    rhs[i] += coeff[2]*weights[n*N+i]*nions_prev2[n*N+i];
+    }
 }
 
 
@@ -66,7 +78,12 @@ void FreeElectronDensityTransientTerm::SetVectorElements(real_t *vec, const real
     len_t nMultiples = ionHandler->GetNzs();
     for (len_t i = 0; i < N; i++)
         for(len_t n=0; n<nMultiples; n++)
-            vec[i] += weights[n*N+i] * (nions[n*N+i]-nions_prev[n*N+i]);
+            vec[i] += weights[n*N+i] * (coeff[0]*nions[n*N+i] + coeff[1]*nions_prev[n*N+i]);
+
+    if (nions_prev2 != nullptr)
+        for (len_t i = 0; i < N; i++)
+            for(len_t n=0; n<nMultiples; n++)
+                vec[i] += coeff[2]*weights[n*N+i]*nions_prev2[n*N+i];
 }
 
 
@@ -52,6 +52,9 @@ IonRateEquation::IonRateEquation(
 		this->id_T_cold = unknowns->GetUnknownID(OptionConstants::UQTY_T_COLD);
     }
 
+    // The ADAS interpolators hold no mutable state
+    SetRebuildThreadSafe();
+
     AllocateRateCoefficients();
 }
 
@@ -166,36 +169,28 @@ void IonRateEquation::Rebuild(
     ADASRateInterpolator *acd = adas->GetACD(Zion);
     ADASRateInterpolator *scd = adas->GetSCD(Zion);
 
-    real_t eps = sqrt(std::numeric_limits<real_t>::epsilon());
-    // Iterate over charge state (0 ... Z)
-    for (len_t i = 0; i < Nr; i++){
-        real_t hn = eps*(1 + n[i]);
-        real_t hT = eps*(1 + T[i]);
-        for (len_t Z0 = 0; Z0 <= Zion; Z0++){
-            Rec[Z0][i]         = acd->Eval(Z0, n[i], T[i]);
-            PartialNRec[Z0][i] = (acd->Eval(Z0, n[i]+hn, T[i]) - Rec[Z0][i])/hn;
-            PartialTRec[Z0][i] = (acd->Eval(Z0, n[i], T[i]+hT) - Rec[Z0][i])/hT;
-            Ion[Z0][i]         = 0;
-            PartialNIon[Z0][i] = 0;
-            PartialTIon[Z0][i] = 0;
-            
+    // Evaluate rate coefficients (and their derivatives with
+    // respect to n_cold and T_cold) for all charge states
+    acd->Eval(Nr, n, T, Rec[0], PartialNRec[0], PartialTRec[0]);
+
+    for (len_t Z0 = 0; Z0 <= Zion; Z0++)
+        for (len_t i = 0; i < Nr; i++){
             posIonizTerm[Z0][i] = 0;
             negIonizTerm[Z0][i] = 0;
             posRecTerm[Z0][i] = 0;
             negRecTerm[Z0][i] = 0;
         }
-    }
+
     // if not covered by the kinetic ionization model, set fluid ionization rates
     if(addFluidIonization || addFluidJacobian)
-        for (len_t i = 0; i < Nr; i++){
-            real_t hn = eps*(1 + n[i]);
-            real_t hT = eps*(1 + T[i]);
-            for (len_t Z0 = 0; Z0 <= Zion; Z0++){
-                Ion[Z0][i]         = scd->Eval(Z0, n[i], T[i]);
-                PartialNIon[Z0][i] = (scd->Eval(Z0, n[i]+hn, T[i]) - Ion[Z0][i])/hn;
-                PartialTIon[Z0][i] = (scd->Eval(Z0, n[i], T[i]+hT) - Ion[Z0][i])/hT;
+        scd->Eval(Nr, n, T, Ion[0], PartialNIon[0], PartialTIon[0]);
+    else
+        for (len_t Z0 = 0; Z0 <= Zion; Z0++)
+            for (len_t i = 0; i < Nr; i++){
+                Ion[Z0][i]         = 0;
+                PartialNIon[Z0][i] = 0;
+                PartialTIon[Z0][i] = 0;
             }
-        }
 }
 
 
@@ -30,6 +30,11 @@ void IonTransientTerm::Rebuild(
 ) {
     this->dt = dt;
     this->xn = uqty->GetUnknownDataPrevious(this->unknownId);
+
+    if (uqty->GetTransientCoefficients(this->unknownId, dt, this->coeff) >= 2)
+        this->xnm1 = uqty->GetUnknownDataOld(this->unknownId, 1);
+    else
+        this->xnm1 = nullptr;
 }
 
 /**
@@ -75,11 +80,16 @@ void IonTransientTerm::SetCSMatrixElements(
 
     const len_t N = grid->GetNCells();
     for (len_t i = 0; i < N; i++)
-        mat->SetElement(rOffset+i, rOffset+i, -1/this->dt);
+        mat->SetElement(rOffset+i, rOffset+i, -coeff[0]/this->dt);
 
-    if (rhs != nullptr)
+    if (rhs != nullptr) {
         for (len_t i = 0; i < N; i++)
-            rhs[rOffset+i] += this->xn[rOffset+i] / this->dt;
+            rhs[rOffset+i] -= coeff[1]*this->xn[rOffset+i] / this->dt;
+
+        if (this->xnm1 != nullptr)
+            for (len_t i = 0; i < N; i++)
+                rhs[rOffset+i] -= coeff[2]*this->xnm1[rOffset+i] / this->dt;
+    }
 }
 
 /**
@@ -104,6 +114,10 @@ void IonTransientTerm::SetCSVectorElements(
     const len_t N = grid->GetNCells();
 
     for (len_t i = 0; i < N; i++)
-        vec[rOffset+i] += -(nions[rOffset+i] - xn[rOffset+i]) / this->dt;
+        vec[rOffset+i] -= (coeff[0]*nions[rOffset+i] + coeff[1]*xn[rOffset+i]) / this->dt;
+
+    if (this->xnm1 != nullptr)
+        for (len_t i = 0; i < N; i++)
+            vec[rOffset+i] -= coeff[2]*xnm1[rOffset+i] / this->dt;
 }
 
@@ -50,6 +50,74 @@ RadiatedPowerTerm::RadiatedPowerTerm(
     this->bremsRel2 = 5.0/(8.0*M_SQRT2)*(44.0-3.0*M_PI*M_PI); // e-e brems correction
 }
 
+/**
+ * Destructor.
+ */
+RadiatedPowerTerm::~RadiatedPowerTerm() {
+    DeallocateRateBuffers();
+}
+
+
+/**
+ * Deallocate the work arrays used for storing ADAS rate coefficients.
+ */
+void RadiatedPowerTerm::DeallocateRateBuffers() {
+    if (this->PLT != nullptr) {
+        delete [] this->PLT;
+        delete [] this->PRB;
+        delete [] this->ACD;
+        delete [] this->SCD;
+    }
+    this->PLT = this->PRB = this->ACD = this->SCD = nullptr;
+    this->nRateElements = 0;
+}
+
+/**
+ * Evaluate the ADAS rate coefficients PLT, PRB, ACD and SCD (or their
+ * derivatives with respect to n_cold or T_cold) for all charge states
+ * of the given ion species and all radii, storing them in the work
+ * arrays 'PLT', 'PRB', 'ACD' and 'SCD' (indexed as [Z0*NCells + i]).
+ * PRB and ACD are only evaluated if 'includePRB' is true.
+ *
+ * iz:     Index of ion species to evaluate rate coefficients for.
+ * n_cold: Cold electron density.
+ * T_cold: Cold electron temperature.
+ * mode:   Indicates whether to evaluate the rate coefficients or
+ *         their derivatives.
+ */
+void RadiatedPowerTerm::EvaluateADASRates(
+    const len_t iz, const real_t *n_cold, const real_t *T_cold,
+    enum adas_rate_mode mode
+) {
+    const len_t NCells = grid->GetNCells();
+    const len_t Z = ionHandler->GetZ(iz);
+    const len_t N = (Z+1)*NCells;
+
+    if (N > this->nRateElements) {
+        DeallocateRateBuffers();
+        this->PLT = new real_t[N];
+        this->PRB = new real_t[N];
+        this->ACD = new real_t[N];
+        this->SCD = new real_t[N];
+        this->nRateElements = N;
+    }
+
+    auto eval = [&](ADASRateInterpolator *intp, real_t *out) {
+        switch (mode) {
+            case ADAS_RATE_VALUE:   intp->Eval(NCells, n_cold, T_cold, out); break;
+            case ADAS_RATE_DERIV_N: intp->Eval(NCells, n_cold, T_cold, nullptr, out); break;
+            case ADAS_RATE_DERIV_T: intp->Eval(NCells, n_cold, T_cold, nullptr, nullptr, out); break;
+        }
+    };
+
+    eval(adas->GetPLT(Z), this->PLT);
+    eval(adas->GetSCD(Z), this->SCD);
+    if (includePRB) {
+        eval(adas->GetPRB(Z), this->PRB);
+        eval(adas->GetACD(Z), this->ACD);
+    }
+}
+
 
 /**
  * Set the weights of this term.
@@ -83,10 +151,9 @@ void RadiatedPowerTerm::SetWeights(const real_t *ionScaleFactor, real_t *w) {
             weights[i] = 0;
 
     for(len_t iz = 0; iz<nZ; iz++){
-        ADASRateInterpolator *PLT_interper = adas->GetPLT(Zs[iz]);
-        ADASRateInterpolator *PRB_interper = adas->GetPRB(Zs[iz]);
-        ADASRateInterpolator *ACD_interper = adas->GetACD(Zs[iz]);
-        ADASRateInterpolator *SCD_interper = adas->GetSCD(Zs[iz]);
+        bool opaqueDeuterium = (Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE);
+        if (!opaqueDeuterium)
+            EvaluateADASRates(iz, n_cold, T_cold, ADAS_RATE_VALUE);
         real_t dWi = 0;
         real_t Li = 0;
         real_t Bi = 0;
@@ -94,7 +161,7 @@ void RadiatedPowerTerm::SetWeights(const real_t *ionScaleFactor, real_t *w) {
             len_t indZ = ionHandler->GetIndex(iz,Z0);
             for (len_t i = 0; i < NCells; i++){
 
-            	if(Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE){//Ly-opaque deuterium radiation from AMJUEL
+            	if(opaqueDeuterium){//Ly-opaque deuterium radiation from AMJUEL
 		            // Radiated power term
 		            Li = amjuel->getIonizLossLyOpaque(Z0, n_cold[i], T_cold[i]);// includes both line radiation and ionization potential energy difference
 		            
@@ -118,20 +185,20 @@ void RadiatedPowerTerm::SetWeights(const real_t *ionScaleFactor, real_t *w) {
 	                }
             	}else{
 		            // Radiated power term
-		            Li =  PLT_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		            Li =  PLT[Z0*NCells + i];
 		            if (includePRB) 
-		                Li += PRB_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                Li += PRB[Z0*NCells + i];
 		            Bi = 0;
 		            // Binding energy rate term
 		            if(Z0>0 && includePRB) {     // Recombination gain
                         // Not needed as dWi was evaluated at the correct Z0 in the
                         // previous iteration (when the if's are put in this order...)
 		                //dWi = Constants::ec * nist->GetIonizationEnergy(Zs[iz],Z0-1);
-		                Bi -= dWi * ACD_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                Bi -= dWi * ACD[Z0*NCells + i];
                     }
 		            if(Z0<Zs[iz]){ // Ionization loss
 		                dWi = Constants::ec * nist->GetIonizationEnergy(Zs[iz],Z0);
-		                Bi += dWi * SCD_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                Bi += dWi * SCD[Z0*NCells + i];
 		            }
 
                 }
@@ -176,10 +243,9 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
 
     if(derivId == id_ni){
         for(len_t iz = 0; iz<nZ; iz++){
-            ADASRateInterpolator *PLT_interper = adas->GetPLT(Zs[iz]);
-            ADASRateInterpolator *PRB_interper = adas->GetPRB(Zs[iz]);
-            ADASRateInterpolator *ACD_interper = adas->GetACD(Zs[iz]);
-            ADASRateInterpolator *SCD_interper = adas->GetSCD(Zs[iz]);
+            bool opaqueDeuterium = (Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE);
+            if (!opaqueDeuterium)
+                EvaluateADASRates(iz, n_cold, T_cold, ADAS_RATE_VALUE);
             
             real_t dWi = 0;
             real_t Li = 0;
@@ -187,7 +253,7 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
             
             for(len_t Z0 = 0; Z0<=Zs[iz]; Z0++){
                 len_t indZ = ionHandler->GetIndex(iz,Z0);
-                if(Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE){
+                if(opaqueDeuterium){
 		            for (len_t i = 0; i < NCells; i++){
 		                Li =  amjuel->getIonizLossLyOpaque(Z0, n_cold[i], T_cold[i]);
 	                    Li += amjuel->getRecRadLyOpaque(Z0, n_cold[i], T_cold[i]);
@@ -209,15 +275,15 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
 	                }
 	            }else{
 		            for (len_t i = 0; i < NCells; i++){
-		                Li =  PLT_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                Li =  PLT[Z0*NCells + i];
 		                if (includePRB)
-		                    Li += PRB_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                    Li += PRB[Z0*NCells + i];
 		                Bi = 0;
 		                if(Z0>0 && includePRB)
-		                    Bi -= dWi * ACD_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                    Bi -= dWi * ACD[Z0*NCells + i];
 		                if(Z0<Zs[iz]){
 		                    dWi = Constants::ec * nist->GetIonizationEnergy(Zs[iz],Z0);
-		                    Bi += dWi * SCD_interper->Eval(Z0, n_cold[i], T_cold[i]);
+		                    Bi += dWi * SCD[Z0*NCells + i];
 		                }
 
                         real_t cont = Li+Bi;
@@ -247,10 +313,9 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
         }
     } else if(derivId == id_ncold){
         for(len_t iz = 0; iz<nZ; iz++){
-            ADASRateInterpolator *PLT_interper = adas->GetPLT(Zs[iz]);
-            ADASRateInterpolator *PRB_interper = adas->GetPRB(Zs[iz]);
-            ADASRateInterpolator *ACD_interper = adas->GetACD(Zs[iz]);
-            ADASRateInterpolator *SCD_interper = adas->GetSCD(Zs[iz]);
+            bool opaqueDeuterium = (Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE);
+            if (!opaqueDeuterium)
+                EvaluateADASRates(iz, n_cold, T_cold, ADAS_RATE_DERIV_N);
             
             real_t dWi = 0;
             real_t dLi = 0;
@@ -258,7 +323,7 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
             
             for(len_t Z0 = 0; Z0<=Zs[iz]; Z0++){
                 len_t indZ = ionHandler->GetIndex(iz,Z0);
-                if(Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE){
+                if(opaqueDeuterium){
 		            for (len_t i = 0; i < NCells; i++){
 		                dLi =  amjuel->getIonizLossLyOpaque_deriv_n(Z0, n_cold[i], T_cold[i]);
 	                    dLi += amjuel->getRecRadLyOpaque_deriv_n(Z0, n_cold[i], T_cold[i]);
@@ -280,15 +345,15 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
 	                }
                 }else{                
 		            for (len_t i = 0; i < NCells; i++){
-		                real_t dLi = PLT_interper->Eval_deriv_n(Z0, n_cold[i], T_cold[i]);
+		                real_t dLi = PLT[Z0*NCells + i];
 		                if (includePRB)
-		                    dLi += PRB_interper->Eval_deriv_n(Z0, n_cold[i], T_cold[i]);
+		                    dLi += PRB[Z0*NCells + i];
 		                real_t dBi = 0;
 		                if(Z0>0 && includePRB)
-		                    dBi -= dWi * ACD_interper->Eval_deriv_n(Z0, n_cold[i], T_cold[i]);
+		                    dBi -= dWi * ACD[Z0*NCells + i];
 		                if(Z0<Zs[iz]){
 		                    dWi = Constants::ec * nist->GetIonizationEnergy(Zs[iz],Z0);
-		                    dBi += dWi * SCD_interper->Eval_deriv_n(Z0, n_cold[i], T_cold[i]);
+		                    dBi += dWi * SCD[Z0*NCells + i];
 		                }
 
                         real_t cont = n_i[indZ*NCells + i]*(dLi+dBi);
@@ -305,10 +370,9 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
                 diffWeights[i] += bremsPrefactor*sqrt(T_cold[i])*bremsRel2*T_cold[i]/Constants::mc2inEV;
     } else if (derivId == id_Tcold){
         for(len_t iz = 0; iz<nZ; iz++){
-            ADASRateInterpolator *PLT_interper = adas->GetPLT(Zs[iz]);
-            ADASRateInterpolator *PRB_interper = adas->GetPRB(Zs[iz]);
-            ADASRateInterpolator *ACD_interper = adas->GetACD(Zs[iz]);
-            ADASRateInterpolator *SCD_interper = adas->GetSCD(Zs[iz]);
+            bool opaqueDeuterium = (Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE);
+            if (!opaqueDeuterium)
+                EvaluateADASRates(iz, n_cold, T_cold, ADAS_RATE_DERIV_T);
             
             real_t dWi = 0;
             real_t dLi = 0;
@@ -316,7 +380,7 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
             
             for(len_t Z0 = 0; Z0<=Zs[iz]; Z0++){
                 len_t indZ = ionHandler->GetIndex(iz,Z0);
-                if(Zs[iz]==1 && opacity_modes[iz]==OptionConstants::OPACITY_MODE_GROUND_STATE_OPAQUE){
+                if(opaqueDeuterium){
 		            for (len_t i = 0; i < NCells; i++){
 		                dLi =  amjuel->getIonizLossLyOpaque_deriv_T(Z0, n_cold[i], T_cold[i]);
 		                dLi += amjuel->getRecRadLyOpaque_deriv_T(Z0, n_cold[i], T_cold[i]);
@@ -336,15 +400,15 @@ void RadiatedPowerTerm::SetDiffWeights(len_t derivId, len_t, const real_t *ionSc
 	                }
                 }else{ 
 		            for (len_t i = 0; i < NCells; i++){
-		                real_t dLi = PLT_interper->Eval_deriv_T(Z0, n_cold[i], T_cold[i]);
+		                real_t dLi = PLT[Z0*NCells + i];
 		                if (includePRB)
-		                    dLi += PRB_interper->Eval_deriv_T(Z0, n_cold[i], T_cold[i]);
+		                    dLi += PRB[Z0*NCells + i];
 		                real_t dBi = 0;
 		                if(Z0>0 && includePRB)
-		                    dBi -= dWi * ACD_interper->Eval_deriv_T(Z0, n_cold[i], T_cold[i]);
+		                    dBi -= dWi * ACD[Z0*NCells + i];
 		                if(Z0<Zs[iz]){
 		                    dWi = Constants::ec * nist->GetIonizationEnergy(Zs[iz],Z0);
-		                    dBi += dWi * SCD_interper->Eval_deriv_T(Z0, n_cold[i], T_cold[i]);
+		                    dBi += dWi * SCD[Z0*NCells + i];
 		                }
                         
                         real_t cont = n_i[indZ*NCells + i]*(dLi+dBi);
@@ -26,6 +26,11 @@ SPITransientTerm::SPITransientTerm(FVM::Grid *grid, const len_t unknownId, len_t
 void SPITransientTerm::Rebuild(const real_t, const real_t dt, FVM::UnknownQuantityHandler *uqty) {
     this->dt = dt;
     this->xn = uqty->GetUnknownDataPrevious(this->unknownId);
+
+    if (uqty->GetTransientCoefficients(this->unknownId, dt, this->coeff) >= 2)
+        this->xnm1 = uqty->GetUnknownDataOld(this->unknownId, 1);
+    else
+        this->xnm1 = nullptr;
 }
 
 bool SPITransientTerm::SetJacobianBlock(const len_t, const len_t derivId, FVM::Matrix *jac, const real_t*){
@@ -37,7 +42,7 @@ bool SPITransientTerm::SetJacobianBlock(const len_t, const len_t derivId, FVM::M
 
     if(derivId==this->unknownId){
         for (len_t i = 0; i < nShard; i++){
-            jac->SetElement(i,i, scaleFactor/this->dt);
+            jac->SetElement(i,i, coeff[0]*scaleFactor/this->dt);
         }
         return true;
     }
@@ -63,6 +68,10 @@ void SPITransientTerm::SetVectorElements(real_t *vec, const real_t *xnp1) {
 		return;
 
     for (len_t i = 0; i < nShard; i++)
-        vec[i] += scaleFactor*(xnp1[i] - xn[i]) / this->dt;
+        vec[i] += scaleFactor*(coeff[0]*xnp1[i] + coeff[1]*xn[i]) / this->dt;
+
+    if (this->xnm1 != nullptr)
+        for (len_t i = 0; i < nShard; i++)
+            vec[i] += coeff[2]*scaleFactor*xnm1[i] / this->dt;
 }
 
@@ -0,0 +1,365 @@
+/**
+ * Tabulation of the relativistic Chandrasekhar functions Psi0, Psi1 and
+ * Psi2 appearing in the "full" collision frequencies. Outside of the
+ * low-energy and superthermal limits, the Psi functions must be evaluated
+ * by adaptive quadrature, which dominates the cost of rebuilding the
+ * collision frequencies in fully kinetic simulations. This class instead
+ * tabulates the functions once, on a uniform grid in
+ *
+ *   u = sqrt((gamma-1)/Theta),    l = log(Theta),
+ *
+ * which maps the intermediate regime to a rectangle, and evaluates them
+ * using bicubic Hermite interpolation. To retain accuracy in the partial
+ * derivatives with respect to T_cold, which are formed from the
+ * differences Psi1-Psi0 and Psi2-Psi1, we tabulate Psi0 together with
+ * these two differences (instead of Psi1 and Psi2 directly), each
+ * normalized by its low-energy asymptote so that the tabulated functions
+ * are of order unity and slowly varying.
+ *
+ * The derivatives of the tabulated data are evaluated with fourth-order
+ * finite differences and passed through the Hyman monotonicity filter, so
+ * that the interpolant preserves monotonicity of the data while remaining
+ * fourth-order accurate. After building the table, the interpolation
+ * error is measured in all cell mid-points (where it is largest) against
+ * adaptive quadrature and the table is refined until the maximum relative
+ * error is below the requested tolerance.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <gsl/gsl_math.h>
+#include "DREAM/Equations/PsiFunctionTable.hpp"
+#include "DREAM/IO.hpp"
+
+
+using namespace DREAM;
+
+
+/**
+ * Constructor.
+ *
+ * reltol: Maximum relative interpolation error allowed in Psi0,
+ *         Psi1-Psi0 and Psi2-Psi1.
+ */
+PsiFunctionTable::PsiFunctionTable(const real_t reltol) : reltol(reltol) {
+    this->u0 = U_MIN;
+    this->u1 = sqrt(10.0);
+    this->l0 = log(THETA_MIN);
+    this->l1 = log(THETA_MAX);
+
+    this->gsl_ad_w = gsl_integration_workspace_alloc(1000);
+
+    Build();
+}
+
+/**
+ * Destructor.
+ */
+PsiFunctionTable::~PsiFunctionTable() {
+    Deallocate();
+    gsl_integration_workspace_free(this->gsl_ad_w);
+}
+
+
+/**
+ * Returns the table shared by all collision frequencies.
+ * The table is built the first time this method is called.
+ */
+const PsiFunctionTable *PsiFunctionTable::Get() {
+    static PsiFunctionTable table;
+    return &table;
+}
+
+
+/**
+ * Allocate memory for the table.
+ *
+ * nu: Number of points in the u direction.
+ * nl: Number of points in the log(Theta) direction.
+ */
+void PsiFunctionTable::Allocate(const len_t nu, const len_t nl) {
+    Deallocate();
+
+    this->nu = nu;
+    this->nl = nl;
+    this->hu = (u1-u0) / (nu-1);
+    this->hl = (l1-l0) / (nl-1);
+
+    const len_t N = NQUANTITIES*nu*nl;
+    this->F   = new real_t[N];
+    this->Fu  = new real_t[N];
+    this->Fl  = new real_t[N];
+    this->Ful = new real_t[N];
+}
+
+/**
+ * Free memory used by the table.
+ */
+void PsiFunctionTable::Deallocate() {
+    if (this->F != nullptr) {
+        delete [] this->F;
+        delete [] this->Fu;
+        delete [] this->Fl;
+        delete [] this->Ful;
+    }
+}
+
+
+/**
+ * Fourth-order accurate derivative of the equidistant
+ * data f[k*stride], k = 0, ..., n-1, in the point i.
+ */
+static real_t psitable_derivative(
+    const real_t *f, const len_t stride, const len_t n,
+    const len_t i, const real_t h
+) {
+    auto F = [&f,&stride](const len_t k) { return f[k*stride]; };
+
+    if (i >= 2 && i+2 < n)
+        return (F(i-2) - 8*F(i-1) + 8*F(i+1) - F(i+2)) / (12*h);
+    else if (i == 0)
+        return (-25*F(0) + 48*F(1) - 36*F(2) + 16*F(3) - 3*F(4)) / (12*h);
+    else if (i == 1)
+        return (-3*F(0) - 10*F(1) + 18*F(2) - 6*F(3) + F(4)) / (12*h);
+    else if (i == n-1)
+        return (25*F(n-1) - 48*F(n-2) + 36*F(n-3) - 16*F(n-4) + 3*F(n-5)) / (12*h);
+    else
+        return (3*F(n-1) + 10*F(n-2) - 18*F(n-3) + 6*F(n-4) - F(n-5)) / (12*h);
+}
+
+/**
+ * Apply the Hyman monotonicity filter to the derivative 'd'
+ * of the data f[k*stride] in the point i (see J M Hyman,
+ * SIAM J. Sci. Stat. Comput. 4, 645 (1983)).
+ */
+static real_t psitable_hyman(
+    real_t d, const real_t *f, const len_t stride, const len_t n,
+    const len_t i, const real_t h
+) {
+    real_t s, smin;
+    if (i == 0) {
+        s = smin = (f[stride]-f[0]) / h;
+    } else if (i == n-1) {
+        s = smin = (f[(n-1)*stride]-f[(n-2)*stride]) / h;
+    } else {
+        real_t sm = (f[i*stride]-f[(i-1)*stride]) / h;
+        real_t sp = (f[(i+1)*stride]-f[i*stride]) / h;
+
+        // Local extremum: leave derivative unchanged
+        if (sm*sp <= 0)
+            return d;
+
+        s = sm;
+        smin = std::min(fabs(sm), fabs(sp));
+    }
+
+    smin = fabs(smin);
+    if (d*s < 0)
+        return 0;
+    else if (fabs(d) > 3*smin)
+        return copysign(3*smin, s);
+    else
+        return d;
+}
+
+/**
+ * Build the table, refining it until the interpolation error
+ * is below the requested tolerance.
+ */
+void PsiFunctionTable::Build() {
+    const len_t NU_MAX = 1025;
+    len_t nu = 65, nl = 33;
+
+    for (;;) {
+        Allocate(nu, nl);
+
+        // Tabulate function values
+        for (len_t q = 0; q < NQUANTITIES; q++)
+            for (len_t j = 0; j < nl; j++) {
+                real_t Theta = exp(l0 + j*hl);
+                for (len_t i = 0; i < nu; i++) {
+                    real_t u = u0 + i*hu;
+                    F[(q*nl + j)*nu + i] = EvaluateExact(q, u, Theta) / Normalization(q, u, Theta);
+                }
+            }
+
+        // Evaluate derivatives
+        for (len_t q = 0; q < NQUANTITIES; q++) {
+            const len_t offs = q*nl*nu;
+            for (len_t j = 0; j < nl; j++)
+                for (len_t i = 0; i < nu; i++) {
+                    const real_t *fu = F+offs + j*nu;
+                    const real_t *fl = F+offs + i;
+                    Fu[offs + j*nu + i] = psitable_hyman(
+                        psitable_derivative(fu, 1, nu, i, hu), fu, 1, nu, i, hu
+                    );
+                    Fl[offs + j*nu + i] = psitable_hyman(
+                        psitable_derivative(fl, nu, nl, j, hl), fl, nu, nl, j, hl
+                    );
+                }
+
+            for (len_t j = 0; j < nl; j++)
+                for (len_t i = 0; i < nu; i++)
+                    Ful[offs + j*nu + i] = psitable_derivative(Fu+offs + i, nu, nl, j, hl);
+        }
+
+        this->maxError = MeasureError();
+        if (this->maxError <= this->reltol) {
+            this->valid = true;
+            break;
+        } else if (nu >= NU_MAX)
+            break;
+
+        nu = 2*nu-1;
+        nl = 2*nl-1;
+    }
+
+    if (this->valid)
+        DREAM::IO::PrintInfo(
+            "Tabulated Psi functions on " LEN_T_PRINTF_FMT "x" LEN_T_PRINTF_FMT
+            " grid (max. relative error %.2e).",
+            this->nu, this->nl, this->maxError
+        );
+    else
+        DREAM::IO::PrintWarning(
+            "Unable to tabulate Psi functions to a relative tolerance of %.2e "
+            "(achieved %.2e). The Psi functions will be evaluated using quadrature.",
+            this->reltol, this->maxError
+        );
+}
+
+
+/**
+ * Integrands of the tabulated quantities.
+ */
+struct psitable_params { len_t q; real_t Theta; };
+static real_t psitable_integrand(real_t s, void *par) {
+    struct psitable_params *params = (struct psitable_params*)par;
+    real_t gs = sqrt(1+s*s);
+    real_t gsMinusOne = s*s/(1+gs);     // = gs - 1
+    real_t e = exp(-gsMinusOne/params->Theta);
+
+    switch (params->q) {
+        case 0: return e/gs;                // Psi0
+        case 1: return gsMinusOne/gs * e;   // Psi1 - Psi0
+        default: return gsMinusOne * e;     // Psi2 - Psi1
+    }
+}
+
+/**
+ * Evaluate the tabulated quantity 'q' using adaptive quadrature.
+ *
+ * q:     Index of quantity (0 = Psi0, 1 = Psi1-Psi0, 2 = Psi2-Psi1).
+ * u:     Table coordinate u = sqrt((gamma-1)/Theta).
+ * Theta: Normalized temperature.
+ */
+real_t PsiFunctionTable::EvaluateExact(const len_t q, const real_t u, const real_t Theta) {
+    real_t gammaMinusOne = u*u*Theta;
+    real_t p = sqrt(gammaMinusOne*(gammaMinusOne+2));
+
+    struct psitable_params params = {q, Theta};
+    gsl_function Fn;
+    Fn.function = &psitable_integrand;
+    Fn.params = &params;
+
+    real_t val, error;
+    real_t epsabs = 0, epsrel = 1e-3*this->reltol;
+    gsl_integration_qag(&Fn, 0, p, epsabs, epsrel, gsl_ad_w->limit, GSL_INTEG_GAUSS31, gsl_ad_w, &val, &error);
+
+    return val;
+}
+
+/**
+ * Low-energy asymptote of the tabulated quantity 'q', by which
+ * the tabulated data is normalized.
+ */
+real_t PsiFunctionTable::Normalization(const len_t q, const real_t u, const real_t Theta) {
+    if (q == 0)
+        return sqrt(2*Theta) * 0.5*M_SQRTPI * erf(u);
+    else
+        return sqrt(2*Theta)*Theta * (0.25*M_SQRTPI*erf(u) - 0.5*u*exp(-u*u));
+}
+
+
+/**
+ * Interpolate the normalized quantity 'q' in the
+ * point (u, l), with l = log(Theta).
+ */
+real_t PsiFunctionTable::Interpolate(const len_t q, const real_t u, const real_t l) const {
+    len_t i = std::min((len_t)((u-u0)/hu), nu-2);
+    len_t j = std::min((len_t)((l-l0)/hl), nl-2);
+    real_t t = (u-u0)/hu - i;
+    real_t s = (l-l0)/hl - j;
+
+    // Cubic Hermite basis functions
+    real_t t2 = t*t, t3 = t2*t;
+    real_t a0 = 2*t3 - 3*t2 + 1, a1 = 3*t2 - 2*t3;
+    real_t b0 = hu*(t3 - 2*t2 + t), b1 = hu*(t3 - t2);
+
+    real_t s2 = s*s, s3 = s2*s;
+    real_t c0 = 2*s3 - 3*s2 + 1, c1 = 3*s2 - 2*s3;
+    real_t d0 = hl*(s3 - 2*s2 + s), d1 = hl*(s3 - s2);
+
+    const len_t k00 = (q*nl + j)*nu + i, k10 = k00+1;
+    const len_t k01 = k00 + nu, k11 = k01+1;
+
+    return
+        c0*(a0*F[k00]  + a1*F[k10]  + b0*Fu[k00]  + b1*Fu[k10]) +
+        c1*(a0*F[k01]  + a1*F[k11]  + b0*Fu[k01]  + b1*Fu[k11]) +
+        d0*(a0*Fl[k00] + a1*Fl[k10] + b0*Ful[k00] + b1*Ful[k10]) +
+        d1*(a0*Fl[k01] + a1*Fl[k11] + b0*Ful[k01] + b1*Ful[k11]);
+}
+
+/**
+ * Returns the maximum relative interpolation error of the table,
+ * measured in the mid-points of all cells.
+ */
+real_t PsiFunctionTable::MeasureError() {
+    real_t err = 0;
+    for (len_t q = 0; q < NQUANTITIES; q++)
+        for (len_t j = 0; j+1 < nl; j++) {
+            real_t l = l0 + (j+0.5)*hl;
+            real_t Theta = exp(l);
+            for (len_t i = 0; i+1 < nu; i++) {
+                real_t u = u0 + (i+0.5)*hu;
+                real_t exact = EvaluateExact(q, u, Theta);
+                real_t approx = Interpolate(q, u, l) * Normalization(q, u, Theta);
+
+                err = std::max(err, fabs(approx/exact - 1));
+            }
+        }
+
+    return err;
+}
+
+
+/**
+ * Evaluate the function Psi_n in the given point. Returns
+ * 'false' if the point lies outside of the table, in which
+ * case 'psi' is not modified.
+ *
+ * n:     Index of Psi function to evaluate (0, 1 or 2).
+ * p:     Momentum.
+ * Theta: Normalized temperature, T/mc^2.
+ * psi:   On return, contains the value of Psi_n.
+ */
+bool PsiFunctionTable::Evaluate(
+    const len_t n, const real_t p, const real_t Theta, real_t *psi
+) const {
+    if (!this->valid || Theta < THETA_MIN || Theta > THETA_MAX)
+        return false;
+
+    real_t gamma = sqrt(1+p*p);
+    real_t gammaMinusOne = p*p/(gamma+1);   // = gamma-1
+    real_t u = sqrt(gammaMinusOne/Theta);
+    if (u < u0 || u > u1)
+        return false;
+
+    real_t l = log(Theta);
+    real_t v = 0;
+    for (len_t q = 0; q <= n; q++)
+        v += Interpolate(q, u, l) * Normalization(q, u, Theta);
+
+    *psi = v;
+    return true;
+}
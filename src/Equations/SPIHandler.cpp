@@ -1,6 +1,7 @@
 /**
  * Implementation of a class that calculates and stores quantities related to the SPI shards
  */
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -168,9 +169,9 @@ void SPIHandler::AllocateQuantities(){
     Ypdot = new real_t[nShard];
     rCld = new real_t[nShard];
     depositionRate = new real_t[nr];
-    depositionProfilesAllShards = new real_t[nr*nShard];
+    depositionProfilesAllShards.Resize(nShard);
     heatAbsorbtionRate = new real_t[nr];
-    heatAbsorbtionProfilesAllShards = new real_t[nr*nShard];
+    heatAbsorbtionProfilesAllShards.Resize(nShard);
     rCoordPPrevious = new real_t[nShard];
     thetaCoordPPrevious = new real_t[nShard];
     phiCoordPPrevious = new real_t[nShard];
@@ -196,9 +197,7 @@ void SPIHandler::DeallocateQuantities(){
     delete [] Ypdot;
     delete [] rCld;
     delete [] depositionRate;
-    delete [] depositionProfilesAllShards;
     delete [] heatAbsorbtionRate;
-    delete [] heatAbsorbtionProfilesAllShards;
     delete [] rCoordPPrevious;
     delete [] thetaCoordPPrevious;
     delete [] phiCoordPPrevious;
@@ -322,17 +321,7 @@ void SPIHandler::Rebuild(real_t dt){
         CalculateTimeAveragedDeltaSourceLocal(depositionProfilesAllShards);
 
         // Shift the deposition profile to the last grid cell (before the current one) to avoid "self-dilution"
-        for(len_t ip=0;ip<nShard;ip++){
-            if(rCoordPNext[ip]>rCoordPPrevious[ip]){
-                for(len_t ir=0;ir<nr-1;ir++){
-                    depositionProfilesAllShards[ir*nShard+ip]=rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*depositionProfilesAllShards[(ir+1)*nShard+ip];
-                }
-            }else if(rCoordPNext[ip]<rCoordPPrevious[ip]){
-                for(len_t ir=nr-1;ir>0;ir--){
-                    depositionProfilesAllShards[ir*nShard+ip]=rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*depositionProfilesAllShards[(ir-1)*nShard+ip];
-                }
-            }
-        }
+        ShiftDepositionProfilesLastFluxTube(depositionProfilesAllShards);
     }else if(spi_deposition_mode==OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_GAUSSIAN){
         CalculateGaussianSourceLocal(depositionProfilesAllShards);
 
@@ -399,12 +388,16 @@ real_t SPIHandler::CalculateBFieldDampingJOREK(len_t ir){
  * Calculate deposition corresponding to the ablation, with a density conserving discretisation
  */
 real_t *SPIHandler::CalculateDepositionRate(real_t *SPIMolarFraction){
-    for(len_t ir=0;ir<nr;ir++){
+    for(len_t ir=0;ir<nr;ir++)
         depositionRate[ir]=0;
-        for(len_t ip=0;ip<nShard;ip++){
-            if(YpPrevious[ip]>0 && irp[ip]<nr){
-                depositionRate[ir]+=-SPIMolarFraction[ip]*4.0*M_PI*(Yp[ip]/abs(Yp[ip])*pow(abs(Yp[ip]),9.0/5.0)-pow(YpPrevious[ip],9.0/5.0))/3.0/pelletMolarVolume[ip]*Constants::N_Avogadro/dt*depositionProfilesAllShards[ir*nShard+ip];
-            }
+
+    // Each shard only contributes in the cells it has deposited material in
+    const shard_profiles &dp = depositionProfilesAllShards;
+    for(len_t ip=0;ip<nShard;ip++){
+        if(YpPrevious[ip]>0 && irp[ip]<nr){
+            real_t depositionPrefactor = -SPIMolarFraction[ip]*4.0*M_PI*(Yp[ip]/abs(Yp[ip])*pow(abs(Yp[ip]),9.0/5.0)-pow(YpPrevious[ip],9.0/5.0))/3.0/pelletMolarVolume[ip]*Constants::N_Avogadro/dt;
+            for(len_t ir=dp.irStart[ip];ir<dp.irEnd[ip];ir++)
+                depositionRate[ir]+=depositionPrefactor*dp.At(ip,ir);
         }
     }
     return depositionRate;
@@ -414,20 +407,27 @@ real_t *SPIHandler::CalculateDepositionRate(real_t *SPIMolarFraction){
  * Calculate the total heat flux going into the pellet cloud assuming Maxwellian distribution for the insident electrons
  */
 void SPIHandler::CalculateAdiabaticHeatAbsorbtionRateMaxwellian(){
-    for(len_t ir=0;ir<nr;ir++){
+    for(len_t ir=0;ir<nr;ir++)
         heatAbsorbtionRate[ir]=0;
-        for(len_t ip=0;ip<nShard;ip++){
-            if(YpPrevious[ip]>0 && irp[ip]<nr){
-                real_t heatAbsorbtionPrefactor = M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
-                
-                heatAbsorbtionRate[ir]+=-heatAbsorbtionPrefactor*heatAbsorbtionProfilesAllShards[ir*nShard+ip];
+
+    // Each shard only contributes in the cells where it absorbed heat
+    // (and, due to the shifted re-deposition, in their neighbours)
+    const shard_profiles &hp = heatAbsorbtionProfilesAllShards;
+    for(len_t ip=0;ip<nShard;ip++){
+        if(YpPrevious[ip]>0 && irp[ip]<nr && hp.irStart[ip]<hp.irEnd[ip]){
+            real_t heatAbsorbtionPrefactor = M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
+
+            len_t irMin = (hp.irStart[ip]>0 ? hp.irStart[ip]-1 : 0);
+            len_t irMax = min(hp.irEnd[ip]+1, nr);
+            for(len_t ir=irMin;ir<irMax;ir++){
+                heatAbsorbtionRate[ir]+=-heatAbsorbtionPrefactor*hp.At(ip,ir);
                 
                 // Account for shifted re-deposition 
                 // NOTE: only strictly valid for delta function kernel (assumes deposition only on one side of r=0)
                 if(rCoordPNext[ip]>rCoordPPrevious[ip] && ir<nr-1)
-                    heatAbsorbtionRate[ir]+=rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*heatAbsorbtionPrefactor*heatAbsorbtionProfilesAllShards[(ir+1)*nShard+ip];
+                    heatAbsorbtionRate[ir]+=rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*heatAbsorbtionPrefactor*hp.At(ip,ir+1);
                 else if(rCoordPNext[ip]<rCoordPPrevious[ip] && ir>0)
-                    heatAbsorbtionRate[ir]+=rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*heatAbsorbtionPrefactor*heatAbsorbtionProfilesAllShards[(ir-1)*nShard+ip];
+                    heatAbsorbtionRate[ir]+=rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*heatAbsorbtionPrefactor*hp.At(ip,ir-1);
             }
         }
     }
@@ -437,13 +437,18 @@ void SPIHandler::CalculateAdiabaticHeatAbsorbtionRateMaxwellian(){
  * Calculate a delta function averaged over the current time step (which gives a "box"-function) 
  * and grid cell volume (splits the "box" between the cells passed during the time step
  * Derivation available on github in SPIDeltaSoure.pdf
+ *
+ * Only the cells passed by each shard are stored (see 'shard_profiles').
  */
-void SPIHandler::CalculateTimeAveragedDeltaSourceLocal(real_t *timeAveragedDeltaSource){
+void SPIHandler::CalculateTimeAveragedDeltaSourceLocal(shard_profiles &timeAveragedDeltaSource){
+    timeAveragedDeltaSource.values.clear();
+
     for(len_t ip=0;ip<nShard;ip++){
 
-        // Reset the deposition profile
-        for(len_t ir=0;ir<nr;ir++)
-            timeAveragedDeltaSource[ir*nShard+ip]=0.0;
+        // Radial intervals passed by the shard during the time step
+        // (two, if the averaging is split at the turning point)
+        real_t rSourceMinSplit[2], rSourceMaxSplit[2];
+        len_t nIntervals=0;
 
         if(irp[ip] < nr){
             // Find out if the shard has passed its turning point (where the radial coordinate goes from decreasing to increasing)
@@ -462,7 +467,7 @@ void SPIHandler::CalculateTimeAveragedDeltaSourceLocal(real_t *timeAveragedDelta
                 gradRCartesianPrevious[1]*(xp[3*ip+1]-xpPrevious[3*ip+1])+
                 gradRCartesianPrevious[2]*(xp[3*ip+2]-xpPrevious[3*ip+2])))<0;
 
-            while(iSplit<nSplit){
+            while(iSplit<nSplit && nIntervals<2){
                 if(turningPointPassed){
                     if(iSplit==1){
                         nSplit=2;
@@ -477,16 +482,37 @@ void SPIHandler::CalculateTimeAveragedDeltaSourceLocal(real_t *timeAveragedDelta
                     rSourceMax=max(rCoordPPrevious[ip],rCoordPNext[ip]); 
                     rSourceMin=min(rCoordPPrevious[ip],rCoordPNext[ip]);
                 }
-        
-                for(len_t ir=0;ir<nr;ir++){
-                    if(!(rGrid->GetR_f(ir)>rSourceMax || rGrid->GetR_f(ir+1)<rSourceMin)){
-                        timeAveragedDeltaSource[ir*nShard+ip]+=1.0/(rGrid->GetVpVol(ir)*VpVolNormFactor*(rSourceMax-rSourceMin))*
-                                                             (min(rGrid->GetR_f(ir+1),rSourceMax)-max(rGrid->GetR_f(ir),rSourceMin))/rGrid->GetDr(ir);
-                    }
-                }
+
+                rSourceMinSplit[nIntervals]=rSourceMin;
+                rSourceMaxSplit[nIntervals]=rSourceMax;
+                nIntervals++;
                 iSplit++;
             }
         }
+
+        // Determine the range of cells passed by the shard...
+        len_t irStart=nr, irEnd=0;
+        for(len_t i=0;i<nIntervals;i++){
+            len_t is, ie;
+            FindCellRange(rSourceMinSplit[i], rSourceMaxSplit[i], is, ie);
+            if(is<ie){
+                irStart=min(irStart,is);
+                irEnd=max(irEnd,ie);
+            }
+        }
+        if(irStart>=irEnd)
+            irStart=irEnd=0;
+
+        // ...and set the source in those cells
+        real_t *source=timeAveragedDeltaSource.SetRange(ip, irStart, irEnd);
+        for(len_t i=0;i<nIntervals;i++){
+            len_t is, ie;
+            FindCellRange(rSourceMinSplit[i], rSourceMaxSplit[i], is, ie);
+            for(len_t ir=is;ir<ie;ir++){
+                source[ir-irStart]+=1.0/(rGrid->GetVpVol(ir)*VpVolNormFactor*(rSourceMaxSplit[i]-rSourceMinSplit[i]))*
+                                     (min(rGrid->GetR_f(ir+1),rSourceMaxSplit[i])-max(rGrid->GetR_f(ir),rSourceMinSplit[i]))/rGrid->GetDr(ir);
+            }
+        }
     }
 }
 
@@ -495,30 +521,105 @@ void SPIHandler::CalculateTimeAveragedDeltaSourceLocal(real_t *timeAveragedDelta
  * NOTE: not time averaged, so be careful with using time steps long enough to allow the shards 
  * to travel lengths comparable to the cloud radius! Also, this profile is gaussian in the radial coordinate,
  * not a 2D-gaussian in the poloidal plane!
+ *
+ * The profile is only stored in cells within GAUSSIAN_SOURCE_CUTOFF cloud radii of the
+ * shard, outside of which the erf() differences below vanish to machine precision.
  */
-void SPIHandler::CalculateGaussianSourceLocal(real_t *gaussianSource){
+void SPIHandler::CalculateGaussianSourceLocal(shard_profiles &gaussianSource){
+    // erf(x) == 1 in double precision for x > 5.93
+    const real_t GAUSSIAN_SOURCE_CUTOFF = 6.0;
+
+    gaussianSource.values.clear();
+
     for(len_t ip=0;ip<nShard;ip++){
-        for(len_t ir=0;ir<nr;ir++){
-            gaussianSource[ir*nShard+ip]=((erf((rGrid->GetR_f(ir+1)-rCoordPNext[ip])/rCld[ip])-erf((rGrid->GetR_f(ir)-rCoordPNext[ip])/rCld[ip]))/2+
-                                          (erf((-rGrid->GetR_f(ir+1)-rCoordPNext[ip])/rCld[ip])-erf((-rGrid->GetR_f(ir)-rCoordPNext[ip])/rCld[ip]))/2)/  //contribution on the "other" side of the magnetic axis
-                                         (2*M_PI*M_PI*VpVolNormFactor*(rGrid->GetR_f(ir+1)*rGrid->GetR_f(ir+1)-rGrid->GetR_f(ir)*rGrid->GetR_f(ir)));
+        len_t irStart, irEnd;
+        FindCellRange(
+            max(0.0, rCoordPNext[ip]-GAUSSIAN_SOURCE_CUTOFF*rCld[ip]),
+            rCoordPNext[ip]+GAUSSIAN_SOURCE_CUTOFF*rCld[ip], irStart, irEnd
+        );
+
+        real_t *source=gaussianSource.SetRange(ip, irStart, irEnd);
+        for(len_t ir=irStart;ir<irEnd;ir++){
+            source[ir-irStart]=((erf((rGrid->GetR_f(ir+1)-rCoordPNext[ip])/rCld[ip])-erf((rGrid->GetR_f(ir)-rCoordPNext[ip])/rCld[ip]))/2+
+                                (erf((-rGrid->GetR_f(ir+1)-rCoordPNext[ip])/rCld[ip])-erf((-rGrid->GetR_f(ir)-rCoordPNext[ip])/rCld[ip]))/2)/  //contribution on the "other" side of the magnetic axis
+                               (2*M_PI*M_PI*VpVolNormFactor*(rGrid->GetR_f(ir+1)*rGrid->GetR_f(ir+1)-rGrid->GetR_f(ir)*rGrid->GetR_f(ir)));
+        }
+    }
+}
+
+/**
+ * Shift the deposition profile of each shard to the last grid cell passed
+ * (before the current one) to avoid "self-dilution". The profile in cell 'ir'
+ * is replaced by the (volume-rescaled) profile in the neighbouring cell
+ * the shard came from.
+ */
+void SPIHandler::ShiftDepositionProfilesLastFluxTube(shard_profiles &profiles){
+    vector<real_t> oldValues;
+    oldValues.swap(profiles.values);
+
+    for(len_t ip=0;ip<nShard;ip++){
+        const len_t is=profiles.irStart[ip], ie=profiles.irEnd[ip], offset=profiles.offset[ip];
+        auto oldAt = [&](len_t ir) -> real_t {
+            return (ir>=is && ir<ie) ? oldValues[offset+ir-is] : 0;
+        };
+
+        if(is>=ie){
+            profiles.SetRange(ip, 0, 0);
+        }else if(rCoordPNext[ip]>rCoordPPrevious[ip]){
+            // The outermost cell keeps its value
+            len_t irStart=(is>0 ? is-1 : 0), irEnd=(ie==nr ? nr : ie-1);
+            real_t *dp=profiles.SetRange(ip, irStart, irEnd);
+            for(len_t ir=irStart;ir<irEnd;ir++){
+                if(ir<nr-1)
+                    dp[ir-irStart]=rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*oldAt(ir+1);
+                else
+                    dp[ir-irStart]=oldAt(ir);
+            }
+        }else if(rCoordPNext[ip]<rCoordPPrevious[ip]){
+            // The innermost cell keeps its value
+            len_t irStart=(is==0 ? 0 : is+1), irEnd=min(ie+1,nr);
+            real_t *dp=profiles.SetRange(ip, irStart, irEnd);
+            for(len_t ir=irStart;ir<irEnd;ir++){
+                if(ir>0)
+                    dp[ir-irStart]=rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*oldAt(ir-1);
+                else
+                    dp[ir-irStart]=oldAt(ir);
+            }
+        }else{
+            real_t *dp=profiles.SetRange(ip, is, ie);
+            for(len_t ir=is;ir<ie;ir++)
+                dp[ir-is]=oldAt(ir);
         }
     }
 }
 
+/**
+ * Find the range of grid cells irStart <= ir < irEnd which overlap
+ * with the radial interval [rMin, rMax]. If no cell overlaps with
+ * the interval, irStart >= irEnd.
+ */
+void SPIHandler::FindCellRange(real_t rMin, real_t rMax, len_t &irStart, len_t &irEnd){
+    const real_t *r_f=rGrid->GetR_f();
+
+    // First cell with r_f(ir+1) >= rMin...
+    irStart=lower_bound(r_f+1, r_f+nr+1, rMin)-(r_f+1);
+    // ...and one past the last cell with r_f(ir) <= rMax
+    irEnd=upper_bound(r_f, r_f+nr, rMax)-r_f;
+}
+
 /**
  * General function to find the grid cell indexes corresponding to the shard positions
  * This functionality could be moved to the radial grid generator-classes, and be optimised for every specific grid
  */
 void SPIHandler::CalculateIrp(){
+    const real_t *r_f=rGrid->GetR_f();
     for(len_t ip=0;ip<nShard;ip++){
-        for(len_t ir=0; ir<nr;ir++){
-            if(rCoordPNext[ip]<rGrid->GetR_f(ir+1) && rCoordPNext[ip]>rGrid->GetR_f(ir)){
-                irp[ip]=ir;
-                break;
-            }
+        // Last flux grid point with r_f(ir) <= r
+        len_t ir=upper_bound(r_f, r_f+nr+1, rCoordPNext[ip])-r_f;
+        if(ir>0 && ir<nr+1 && rCoordPNext[ip]>r_f[ir-1])
+            irp[ip]=ir-1;
+        else
             irp[ip]=nr;
-        }
     }
 }
 
@@ -697,12 +798,13 @@ bool SPIHandler::setJacobianYpdotNGSKinetic(FVM::Matrix *jac,len_t derivId, real
 bool SPIHandler::setJacobianDepositionRateDensCons(FVM::Matrix *jac,len_t derivId, real_t *scaleFactor, real_t *SPIMolarFraction, len_t rOffset){
     bool jacIsSet=false;
     if(derivId==id_Yp){
-        for(len_t ir=0;ir<nr;ir++){
-            for(len_t ip=0;ip<nShard;ip++){
-                if(YpPrevious[ip]>0){
-                    jac->SetElement(ir+rOffset,ip,-scaleFactor[ir]*SPIMolarFraction[ip]*12.0/5.0*M_PI*pow(abs(Yp[ip]),4.0/5.0)/pelletMolarVolume[ip]*Constants::N_Avogadro/dt*depositionProfilesAllShards[ir*nShard+ip]);
-                    jacIsSet=true;
-                }
+        // Only set the (non-zero) elements in the cells each shard deposits material in
+        const shard_profiles &dp = depositionProfilesAllShards;
+        for(len_t ip=0;ip<nShard;ip++){
+            if(YpPrevious[ip]>0){
+                for(len_t ir=dp.irStart[ip];ir<dp.irEnd[ip];ir++)
+                    jac->SetElement(ir+rOffset,ip,-scaleFactor[ir]*SPIMolarFraction[ip]*12.0/5.0*M_PI*pow(abs(Yp[ip]),4.0/5.0)/pelletMolarVolume[ip]*Constants::N_Avogadro/dt*dp.At(ip,ir));
+                jacIsSet=true;
             }
         }
     }
@@ -719,62 +821,88 @@ bool SPIHandler::setJacobianDepositionRateDensCons(FVM::Matrix *jac,len_t derivI
  */
 bool SPIHandler::setJacobianAdiabaticHeatAbsorbtionRateMaxwellian(FVM::Matrix *jac,len_t derivId, real_t scaleFactor){
     bool jacIsSet=false;
+    const shard_profiles &hp = heatAbsorbtionProfilesAllShards;
+
+    // Only the cells where the shard absorbs heat (and their neighbours,
+    // due to the shifted re-deposition) give non-zero contributions
+    auto setShardElements = [&](len_t ip, len_t col, real_t prefactor){
+        len_t irMin = (hp.irStart[ip]>0 ? hp.irStart[ip]-1 : 0);
+        len_t irMax = min(hp.irEnd[ip]+1, nr);
+        if(hp.irStart[ip]>=hp.irEnd[ip])
+            irMax = irMin;
+
+        for(len_t ir=irMin;ir<irMax;ir++){
+            real_t jacEl = prefactor*hp.At(ip,ir);
+
+            // Account for shifted re-deposition
+            if(rCoordPNext[ip]>rCoordPPrevious[ip] && ir<nr-1)
+                jacEl+=-rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*hp.At(ip,ir+1);
+            else if(rCoordPNext[ip]<rCoordPPrevious[ip] && ir>0)
+                jacEl+=-rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*hp.At(ip,ir-1);
+
+            jac->SetElement(ir,col,jacEl);
+        }
+    };
+
     if(derivId==id_Yp){
         if(spi_cloud_radius_mode==OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_SELFCONSISTENT){
-            for(len_t ir=0;ir<nr;ir++){
-                for(len_t ip=0;ip<nShard;ip++){
-                    if(YpPrevious[ip]>0 && irp[ip]<nr){
-                        real_t prefactor = -scaleFactor*6.0/5.0/Yp[ip]*M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
-                        real_t jacEl = prefactor*heatAbsorbtionProfilesAllShards[ir*nShard+ip];
-                        
-                        // Account for shifted re-deposition
-                        if(rCoordPNext[ip]>rCoordPPrevious[ip] && ir<nr-1)
-                            jacEl+=-rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir+1)*nShard+ip];
-                        else if(rCoordPNext[ip]<rCoordPPrevious[ip] && ir>0)
-                            jacEl+=-rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir-1)*nShard+ip];
-                    
-                        jac->SetElement(ir,ip,jacEl);
-                        jacIsSet=true;
-                    }
+            for(len_t ip=0;ip<nShard;ip++){
+                if(YpPrevious[ip]>0 && irp[ip]<nr){
+                    real_t prefactor = -scaleFactor*6.0/5.0/Yp[ip]*M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
+                    setShardElements(ip, ip, prefactor);
+                    jacIsSet=true;
                 }
             }
         }
     }else if(derivId==id_Tcold){
-        for(len_t ir=0;ir<nr;ir++){
-            for(len_t ip=0;ip<nShard;ip++){
-                if(irp[ip]<nr){
-                    real_t prefactor = -scaleFactor*3.0/2.0*M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec;
-                    real_t jacEl = prefactor*heatAbsorbtionProfilesAllShards[ir*nShard+ip];
-                        
-                    // Account for shifted re-deposition
-                    if(rCoordPNext[ip]>rCoordPPrevious[ip] && ir<nr-1)
-                        jacEl+=-rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir+1)*nShard+ip];
-                    else if(rCoordPNext[ip]<rCoordPPrevious[ip] && ir>0)
-                        jacEl+=-rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir-1)*nShard+ip];
-                
-                    jac->SetElement(ir,irp[ip],jacEl);
-                    jacIsSet=true;
-                }
+        for(len_t ip=0;ip<nShard;ip++){
+            if(irp[ip]<nr){
+                real_t prefactor = -scaleFactor*3.0/2.0*M_PI*rCld[ip]*rCld[ip]*ncold[irp[ip]]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec;
+                setShardElements(ip, irp[ip], prefactor);
+                jacIsSet=true;
             }
         }
     }else if(derivId==id_ncold){
-        for(len_t ir=0;ir<nr;ir++){
-            for(len_t ip=0;ip<nShard;ip++){
-                if(irp[ip]<nr){
-                    real_t prefactor = -scaleFactor*M_PI*rCld[ip]*rCld[ip]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
-                    real_t jacEl = prefactor*heatAbsorbtionProfilesAllShards[ir*nShard+ip];
-                        
-                    // Account for shifted re-deposition
-                    if(rCoordPNext[ip]>rCoordPPrevious[ip] && ir<nr-1)
-                        jacEl+=-rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir+1)*nShard+ip];
-                    else if(rCoordPNext[ip]<rCoordPPrevious[ip] && ir>0)
-                        jacEl+=-rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*heatAbsorbtionProfilesAllShards[(ir-1)*nShard+ip];
-                
-                    jac->SetElement(ir,irp[ip],jacEl);
-                    jacIsSet=true;
-                }
+        for(len_t ip=0;ip<nShard;ip++){
+            if(irp[ip]<nr){
+                real_t prefactor = -scaleFactor*M_PI*rCld[ip]*rCld[ip]*sqrt(8.0*Constants::ec*Tcold[irp[ip]]/(M_PI*Constants::me))*Constants::ec*Tcold[irp[ip]];
+                setShardElements(ip, irp[ip], prefactor);
+                jacIsSet=true;
             }
         }
     }
     return jacIsSet;
 }
+
+/**
+ * Write the state of the SPI handler which is not contained in
+ * the unknown quantities to the given checkpoint file. This is
+ * the previous radial coordinate of each shard, which is used
+ * as the starting guess when transforming the shard positions
+ * to flux coordinates.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void SPIHandler::SaveCheckpoint(SFile *sf, const string& path){
+    sf->WriteList(path+"/rCoordPPrevious", rCoordPPrevious, nShard);
+}
+
+/**
+ * Restore the state of the SPI handler from the given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void SPIHandler::LoadCheckpoint(SFile *sf, const string& path){
+    sfilesize_t n;
+    real_t *r=sf->GetList(path+"/rCoordPPrevious", &n);
+    if(n!=nShard){
+        delete [] r;
+        throw DREAMException("SPIHandler: The number of shards in the checkpoint file '%s' does not match the number of shards in the simulation.", sf->filename.c_str());
+    }
+
+    for(len_t ip=0;ip<nShard;ip++)
+        rCoordPPrevious[ip]=r[ip];
+    delete [] r;
+}
@@ -195,6 +195,57 @@ void OtherQuantityHandler::SaveSFile(SFile *sf, const std::string& path) {
     }
 }
 
+/**
+ * Write the data stored for all registered quantities to
+ * the given checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void OtherQuantityHandler::SaveCheckpoint(SFile *sf, const std::string& path) {
+    vector<string> groups;
+    for (auto it = this->registered.begin(); it != this->registered.end(); it++) {
+        OtherQuantity *oq = *it;
+
+        // Should we create a new group first?
+        auto slash = oq->GetName().find('/');
+        if (slash != string::npos) {
+            string groupname = oq->GetName().substr(0, slash);
+
+            if (std::find(groups.begin(), groups.end(), groupname) == std::end(groups)) {
+                sf->CreateStruct(path+"/"+groupname);
+                groups.push_back(groupname);
+            }
+        }
+
+        const string name = path + "/" + oq->GetName();
+        sf->CreateStruct(name);
+        oq->GetQuantityData()->SaveCheckpoint(sf, name);
+    }
+}
+
+/**
+ * Restore the data stored for all registered quantities
+ * from the given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void OtherQuantityHandler::LoadCheckpoint(SFile *sf, const std::string& path) {
+    for (auto it = this->registered.begin(); it != this->registered.end(); it++) {
+        OtherQuantity *oq = *it;
+        const string name = path + "/" + oq->GetName();
+
+        if (!sf->HasVariable(name + "/data"))
+            throw OtherQuantityException(
+                "Quantity '%s' is missing from the checkpoint file '%s'.",
+                oq->GetName().c_str(), sf->filename.c_str()
+            );
+
+        oq->GetQuantityData()->LoadCheckpoint(sf, name);
+    }
+}
+
 /********************************
  * IMPLEMENTATION OF QUANTITIES *
  ********************************/
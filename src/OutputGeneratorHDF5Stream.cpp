@@ -0,0 +1,422 @@
+/**
+ * OutputGenerator implementation which writes every saved time
+ * step directly to an HDF5 file, instead of keeping the full time
+ * evolution of all quantities in memory until the end of the
+ * simulation.
+ *
+ * Data which does not depend on time (grids, ion meta data and
+ * settings) is written when the output generator is initialized,
+ * using the regular 'OutputGeneratorSFile' routines. The time
+ * evolution of the unknown and other quantities is then appended
+ * to extendable (chunked) HDF5 datasets as the simulation proceeds.
+ * Solver statistics and timing information is written at the end.
+ * Since the file is flushed regularly, the time steps written
+ * before a simulation is aborted can still be read from the file.
+ *
+ * The layout of the file is identical to that of the file
+ * produced by 'OutputGeneratorSFile'.
+ */
+
+#include <string>
+#include <vector>
+#include "DREAM/OutputGeneratorHDF5Stream.hpp"
+
+
+using namespace DREAM;
+using namespace std;
+
+
+/**
+ * Constructor.
+ *
+ * eqsys:         Equation system to save output for.
+ * filename:      Name of the output file.
+ * flushInterval: Number of saved time steps between flushes of the file
+ *                to disk. If 0, the file is only flushed at the end.
+ * savesettings:  If 'true', saves the simulation settings to the file.
+ */
+OutputGeneratorHDF5Stream::OutputGeneratorHDF5Stream(
+    EquationSystem *eqsys, const std::string& filename,
+    const len_t flushInterval, bool savesettings
+) : OutputGeneratorSFile(eqsys, filename, savesettings),
+    flushInterval(flushInterval) {
+
+    // The time grid is streamed to the file separately
+    this->saveTimeGrid = false;
+}
+
+/**
+ * Destructor.
+ */
+OutputGeneratorHDF5Stream::~OutputGeneratorHDF5Stream() {
+    if (this->h5 != nullptr) {
+        this->h5->close();
+        delete this->h5;
+    }
+}
+
+
+/**
+ * Create the output file and write all data which does not
+ * change with time, as well as the initial values of all
+ * unknown quantities.
+ */
+void OutputGeneratorHDF5Stream::Initialize() {
+    // If the simulation was restarted from a checkpoint written
+    // while streaming, the earlier time steps are only available
+    // in the existing output file, which we continue writing to
+    const len_t nSaved = this->unknowns->GetUnknown(0)->GetQuantityData()->GetNSavedSteps();
+    if (this->eqsys->IsRestarted() && nSaved < this->eqsys->GetTimes().size()) {
+        this->Resume();
+        return;
+    }
+
+    // Write time-independent data
+    this->sf = SFile::Create(this->filename, SFILE_MODE_WRITE);
+
+    this->SaveGrids("grid", false);
+    this->SaveIonMetaData("ionmeta");
+
+    if (this->savesettings)
+        this->SaveSettings("settings");
+
+    this->sf->Close();
+    delete this->sf;
+    this->sf = nullptr;
+
+    try {
+        this->h5 = new H5::H5File(this->filename, H5F_ACC_RDWR);
+
+        // Time grid
+        hsize_t dims[1] = {0}, maxdims[1] = {H5S_UNLIMITED}, chunk[1] = {1};
+        H5::DataSpace space(1, dims, maxdims);
+        H5::DSetCreatPropList plist;
+        plist.setChunk(1, chunk);
+        this->timeDataset = this->h5->createDataSet(
+            "grid/t", H5::PredType::NATIVE_DOUBLE, space, plist
+        );
+
+        // Unknown quantities
+        this->CreateGroup("eqsys");
+        const len_t nUnknowns = this->unknowns->GetNUnknowns();
+        for (len_t i = 0; i < nUnknowns; i++) {
+            FVM::UnknownQuantity *uqty = this->unknowns->GetUnknown(i);
+            this->AddQuantity("eqsys/" + uqty->GetName(), uqty->GetQuantityData(), 1);
+
+            H5::DataSet &ds = this->quantities.back().dataset;
+            this->WriteAttribute(ds, "description", uqty->GetDescription());
+            this->WriteAttribute(ds, "equation", uqty->GetEquationDescription());
+        }
+
+        // Other quantities (groups are only created if they
+        // contain at least one quantity)
+        for (OtherQuantity *oq : this->oqty->GetRegistered()) {
+            const string name = "other/" + oq->GetName();
+            this->CreateGroup(name.substr(0, name.rfind('/')));
+
+            this->AddQuantity(name, oq->GetQuantityData(), 0);
+
+            this->WriteAttribute(this->quantities.back().dataset, "description", oq->GetDescription());
+        }
+
+        // Write initial state (and, if the simulation was restarted
+        // from a checkpoint, all time steps saved before the restart)
+        for (const real_t t : this->eqsys->GetTimes())
+            this->AppendTime(t);
+
+        this->WriteSavedSteps();
+    } catch (H5::Exception &ex) {
+        throw OutputGeneratorException(
+            "Failed to initialize output file '%s': %s",
+            this->filename.c_str(), ex.getCDetailMsg()
+        );
+    }
+}
+
+/**
+ * Create a new (extendable) dataset for the given quantity.
+ *
+ * name: Full path to the dataset in the output file.
+ * data: Quantity to stream to the dataset.
+ * keep: Number of steps to keep in the 'store' array of the
+ *       quantity after they have been written to the file.
+ */
+void OutputGeneratorHDF5Stream::AddQuantity(
+    const string& name, FVM::QuantityData *data, const len_t keep
+) {
+    struct stream_quantity q;
+    q.data = data;
+    q.keep = keep;
+    q.nt   = 0;
+
+    sfilesize_t sdims[4];
+    q.ndims = data->GetStepDimensions(sdims);
+    for (len_t i = 0; i < q.ndims; i++)
+        q.dims[i] = sdims[i];
+
+    hsize_t dims[5], maxdims[5], chunk[5];
+    dims[0] = 0;
+    maxdims[0] = H5S_UNLIMITED;
+    chunk[0] = 1;
+    for (len_t i = 0; i < q.ndims; i++)
+        dims[i+1] = maxdims[i+1] = chunk[i+1] = q.dims[i];
+
+    H5::DataSpace space(q.ndims+1, dims, maxdims);
+    H5::DSetCreatPropList plist;
+    plist.setChunk(q.ndims+1, chunk);
+
+    q.dataset = this->h5->createDataSet(
+        name, H5::PredType::NATIVE_DOUBLE, space, plist
+    );
+
+    this->quantities.push_back(q);
+}
+
+/**
+ * Append a single time step to the dataset of the given quantity.
+ *
+ * q:    Quantity to append data to.
+ * data: Data of the time step.
+ */
+void OutputGeneratorHDF5Stream::AppendStep(struct stream_quantity &q, const real_t *data) {
+    hsize_t size[5], offset[5] = {0,0,0,0,0}, count[5];
+    size[0] = q.nt+1;
+    offset[0] = q.nt;
+    count[0] = 1;
+    for (len_t i = 0; i < q.ndims; i++)
+        size[i+1] = count[i+1] = q.dims[i];
+
+    q.dataset.extend(size);
+
+    H5::DataSpace fspace = q.dataset.getSpace();
+    fspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+    H5::DataSpace mspace(q.ndims+1, count);
+
+    q.dataset.write(data, H5::PredType::NATIVE_DOUBLE, mspace, fspace);
+    q.nt++;
+}
+
+/**
+ * Append a time point to the time grid in the output file.
+ *
+ * t: Time to append.
+ */
+void OutputGeneratorHDF5Stream::AppendTime(const real_t t) {
+    hsize_t size[1] = {this->ntimes+1}, offset[1] = {this->ntimes}, count[1] = {1};
+    this->timeDataset.extend(size);
+
+    H5::DataSpace fspace = this->timeDataset.getSpace();
+    fspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+    H5::DataSpace mspace(1, count);
+
+    this->timeDataset.write(&t, H5::PredType::NATIVE_DOUBLE, mspace, fspace);
+    this->ntimes++;
+}
+
+/**
+ * Create the named group in the output file, as well as
+ * every intermediate group in its path, unless they
+ * already exist.
+ *
+ * name: Full path to the group (e.g. "other/fluid/...").
+ */
+void OutputGeneratorHDF5Stream::CreateGroup(const string& name) {
+    string::size_type slash = 0;
+    do {
+        slash = name.find('/', slash+1);
+        const string path = name.substr(0, slash);
+
+        if (!path.empty() && !H5Lexists(this->h5->getId(), path.c_str(), H5P_DEFAULT))
+            this->h5->createGroup(path);
+    } while (slash != string::npos);
+}
+
+/**
+ * Write a string attribute to the given dataset. Empty
+ * strings are not written.
+ *
+ * ds:    Dataset to attach attribute to.
+ * name:  Name of attribute.
+ * value: Attribute value.
+ */
+void OutputGeneratorHDF5Stream::WriteAttribute(
+    H5::DataSet &ds, const string& name, const string& value
+) {
+    if (value.empty())
+        return;
+
+    H5::StrType st(H5::PredType::C_S1, value.size());
+    H5::Attribute attr = ds.createAttribute(name, st, H5::DataSpace(H5S_SCALAR));
+    attr.write(st, value);
+}
+
+/**
+ * Write all data saved since the previous call to this
+ * method to the output file, and release the memory used
+ * by the written time steps.
+ *
+ * t: Time of the most recently saved step.
+ */
+void OutputGeneratorHDF5Stream::SaveStep(const real_t t) {
+    if (this->h5 == nullptr)
+        return;
+
+    try {
+        this->AppendTime(t);
+        this->WriteSavedSteps();
+    } catch (H5::Exception &ex) {
+        throw OutputGeneratorException(
+            "Failed to write time step to output file '%s': %s",
+            this->filename.c_str(), ex.getCDetailMsg()
+        );
+    }
+}
+
+/**
+ * Append all time steps which have not yet been written to the
+ * output file and release the memory they occupy. The file is
+ * flushed every 'flushInterval' calls.
+ */
+void OutputGeneratorHDF5Stream::WriteSavedSteps() {
+    for (auto &q : this->quantities) {
+        // Steps [0, keep) are kept in memory after being written
+        len_t start = (q.nt < q.keep ? q.nt : q.keep);
+        const len_t n = q.data->GetNSavedSteps();
+        for (len_t i = start; i < n; i++)
+            this->AppendStep(q, q.data->GetSavedStep(i));
+
+        q.data->ClearSavedSteps(q.keep);
+    }
+
+    if (this->flushInterval > 0 && ++this->nSinceFlush >= this->flushInterval) {
+        this->h5->flush(H5F_SCOPE_GLOBAL);
+        this->nSinceFlush = 0;
+    }
+}
+
+/**
+ * Re-open the output file of a simulation which is resumed from
+ * a checkpoint. Any time steps written to the file after the
+ * checkpoint was written are discarded.
+ */
+void OutputGeneratorHDF5Stream::Resume() {
+    try {
+        this->h5 = new H5::H5File(this->filename, H5F_ACC_RDWR);
+
+        // Remove data written at the end of a previous run
+        if (H5Lexists(this->h5->getId(), "solver", H5P_DEFAULT))
+            this->h5->unlink("solver");
+        if (H5Lexists(this->h5->getId(), "timings", H5P_DEFAULT))
+            this->h5->unlink("timings");
+
+        this->ntimes = this->eqsys->GetTimes().size();
+        this->timeDataset = this->h5->openDataSet("grid/t");
+        this->TruncateDataset(this->timeDataset, "grid/t", this->ntimes);
+
+        const len_t nUnknowns = this->unknowns->GetNUnknowns();
+        for (len_t i = 0; i < nUnknowns; i++) {
+            FVM::UnknownQuantity *uqty = this->unknowns->GetUnknown(i);
+            this->OpenQuantity("eqsys/" + uqty->GetName(), uqty->GetQuantityData(), 1, this->ntimes);
+        }
+
+        // Other quantities are not stored in the initial time point
+        for (OtherQuantity *oq : this->oqty->GetRegistered())
+            this->OpenQuantity("other/" + oq->GetName(), oq->GetQuantityData(), 0, this->ntimes-1);
+
+        this->WriteSavedSteps();
+    } catch (H5::Exception &ex) {
+        throw OutputGeneratorException(
+            "Failed to resume writing to output file '%s': %s",
+            this->filename.c_str(), ex.getCDetailMsg()
+        );
+    }
+}
+
+/**
+ * Open an existing dataset of a quantity which is streamed to
+ * the output file.
+ *
+ * name: Full path to the dataset in the output file.
+ * data: Quantity to stream to the dataset.
+ * keep: Number of steps to keep in the 'store' array of the
+ *       quantity after they have been written to the file.
+ * nt:   Number of time steps to keep in the dataset.
+ */
+void OutputGeneratorHDF5Stream::OpenQuantity(
+    const string& name, FVM::QuantityData *data, const len_t keep, const hsize_t nt
+) {
+    struct stream_quantity q;
+    q.data = data;
+    q.keep = keep;
+    q.nt   = nt;
+
+    sfilesize_t sdims[4];
+    q.ndims = data->GetStepDimensions(sdims);
+    for (len_t i = 0; i < q.ndims; i++)
+        q.dims[i] = sdims[i];
+
+    q.dataset = this->h5->openDataSet(name);
+    this->TruncateDataset(q.dataset, name, nt);
+
+    this->quantities.push_back(q);
+}
+
+/**
+ * Shrink the given dataset so that it contains the specified
+ * number of time steps.
+ *
+ * ds:   Dataset to truncate.
+ * name: Name of the dataset (for error messages).
+ * nt:   Number of time steps to keep.
+ */
+void OutputGeneratorHDF5Stream::TruncateDataset(
+    H5::DataSet &ds, const string& name, const hsize_t nt
+) {
+    hsize_t dims[5];
+    H5::DataSpace space = ds.getSpace();
+    space.getSimpleExtentDims(dims);
+
+    if (dims[0] < nt)
+        throw OutputGeneratorException(
+            "Unable to resume writing to output file '%s': dataset '%s' "
+            "contains fewer time steps than the checkpoint. Was the "
+            "checkpoint written by a different simulation?",
+            this->filename.c_str(), name.c_str()
+        );
+
+    dims[0] = nt;
+    H5Dset_extent(ds.getId(), dims);
+}
+
+/**
+ * Finalize the output file by writing solver statistics
+ * and timing information.
+ *
+ * current: If 'true' and the output generator has not been
+ *          initialized, only saves the most recent time step.
+ */
+void OutputGeneratorHDF5Stream::Save(bool current) {
+    // Simulation was never started; write regular output
+    if (this->h5 == nullptr && this->ntimes == 0) {
+        this->saveTimeGrid = true;
+        this->OutputGeneratorSFile::Save(current);
+        this->saveTimeGrid = false;
+        return;
+    }
+    // Output has already been finalized
+    else if (this->h5 == nullptr)
+        return;
+
+    this->h5->close();
+    delete this->h5;
+    this->h5 = nullptr;
+
+    this->sf = SFile::Create(this->filename, SFILE_MODE_UPDATE);
+
+    this->SaveSolverData("solver");
+    this->SaveTimings("timings");
+
+    this->sf->Close();
+    delete this->sf;
+    this->sf = nullptr;
+}
@@ -66,11 +66,13 @@ void OutputGeneratorSFile::SaveGrids(const std::string& name, bool current) {
         group = name + "/";
 
     // Time grid
-    const real_t *t = this->eqsys->GetTimes().data();
-    if (current)
-        this->sf->WriteList(group + "t", t+(this->eqsys->GetTimes().size()-1), 1);
-    else
-        this->sf->WriteList(group + "t", t, this->eqsys->GetTimes().size());
+    if (this->saveTimeGrid) {
+        const real_t *t = this->eqsys->GetTimes().data();
+        if (current)
+            this->sf->WriteList(group + "t", t+(this->eqsys->GetTimes().size()-1), 1);
+        else
+            this->sf->WriteList(group + "t", t, this->eqsys->GetTimes().size());
+    }
 
     FVM::RadialGrid *rgrid = this->fluidGrid->GetRadialGrid();
 
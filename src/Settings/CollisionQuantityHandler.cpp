@@ -32,6 +32,7 @@ void SimulationGenerator::DefineOptions_CollisionQuantityHandler(
     s->DefineSetting(MODNAME "/bremsstrahlung_mode", "Model to use for bremsstrahlung", (int_t)OptionConstants::EQTERM_BREMSSTRAHLUNG_MODE_NEGLECT);
     s->DefineSetting(MODNAME "/pstar_mode", "Model to use for p_\\star", (int_t)OptionConstants::COLLQTY_PSTAR_MODE_COLLISIONLESS);
     s->DefineSetting(MODNAME "/screened_diffusion_mode", "Model to use for the energy diffusion frequency caused by bound electrons", (int_t)OptionConstants::COLLQTY_SCREENED_DIFFUSION_MODE_MAXWELLIAN);
+    s->DefineSetting(MODNAME "/psi_mode", "Method to use for evaluating the Psi functions of the full collision frequencies", (int_t)OptionConstants::COLLQTY_PSI_MODE_QUADRATURE);
 }
 
 /**
@@ -56,6 +57,7 @@ CollisionQuantityHandler *SimulationGenerator::ConstructCollisionQuantityHandler
     cq->bremsstrahlung_mode = (enum OptionConstants::eqterm_bremsstrahlung_mode)      s->GetInteger(MODNAME "/bremsstrahlung_mode");
     cq->pstar_mode          = (enum OptionConstants::collqty_pstar_mode)              s->GetInteger(MODNAME "/pstar_mode");
     cq->screened_diffusion  = (enum OptionConstants::collqty_screened_diffusion_mode) s->GetInteger(MODNAME "/screened_diffusion_mode");
+    cq->psi_mode            = (enum OptionConstants::collqty_psi_mode)                s->GetInteger(MODNAME "/psi_mode");
 
     CollisionQuantityHandler *cqh = new CollisionQuantityHandler(grid, unknowns, ionHandler,gridtype,cq);
 
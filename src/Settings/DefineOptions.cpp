@@ -50,4 +50,9 @@ void SimulationGenerator::DefineOptions_Output(Settings *s) {
     s->DefineSetting("/output/filename", "File name of simulation output", (std::string)"output.h5");
     s->DefineSetting("/output/timingstdout", "Print timing info to stdout after the simulation.", (bool)false);
     s->DefineSetting("/output/timingfile", "Save timing info to the output file.", (bool)false);
+    s->DefineSetting("/output/stream", "Write each saved time step to the output file as the simulation proceeds.", (bool)false);
+    s->DefineSetting("/output/flushinterval", "Number of saved time steps between flushes of the streamed output file (0 = flush only at end).", (int_t)1);
+    s->DefineSetting("/output/checkpoint/filename", "Name of checkpoint file to write during the simulation", (std::string)"checkpoint.h5");
+    s->DefineSetting("/output/checkpoint/steps", "Number of time steps between checkpoints (0 = disabled).", (int_t)0);
+    s->DefineSetting("/output/checkpoint/walltime", "Wall-clock time (in seconds) between checkpoints (0 = disabled).", (real_t)0);
 }
@@ -74,6 +74,26 @@ EquationSystem *SimulationGenerator::ConstructEquationSystem(
     // Timing information
     eqsys->SetTiming(s->GetBool("/output/timingstdout"), s->GetBool("/output/timingfile"));
 
+    // Checkpointing
+    int_t checkpointSteps = s->GetInteger("/output/checkpoint/steps");
+    real_t checkpointWalltime = s->GetReal("/output/checkpoint/walltime");
+    if (checkpointSteps < 0)
+        throw SettingsException(
+            "output: The number of time steps between checkpoints must be non-negative: " INT_T_PRINTF_FMT ".",
+            checkpointSteps
+        );
+    else if (checkpointWalltime < 0)
+        throw SettingsException(
+            "output: The wall-clock time between checkpoints must be non-negative: %e.",
+            checkpointWalltime
+        );
+
+    if (checkpointSteps > 0 || checkpointWalltime > 0)
+        eqsys->SetCheckpointing(
+            s->GetString("/output/checkpoint/filename"),
+            (len_t)checkpointSteps, checkpointWalltime
+        );
+
     // Initialize from previous simulation output?
     const real_t t0 = ConstructInitializer(eqsys, s);
 
@@ -3,10 +3,12 @@
  */
 
 #include <iostream>
+#include <memory>
 #include "DREAM/ADAS.hpp"
 #include "DREAM/AMJUEL.hpp"
 #include "DREAM/EquationSystem.hpp"
 #include "DREAM/NIST.hpp"
+#include "DREAM/OutputGeneratorHDF5Stream.hpp"
 #include "DREAM/OutputGeneratorSFile.hpp"
 #include "DREAM/Settings/Settings.hpp"
 #include "DREAM/Settings/SimulationGenerator.hpp"
@@ -30,6 +32,17 @@ Simulation *SimulationGenerator::ProcessSettings(Settings *s) {
     FVM::Grid *scalarGrid  = ConstructScalarGrid();
     FVM::Grid *fluidGrid   = ConstructRadialGrid(s);
     FVM::Grid *hottailGrid = ConstructHotTailGrid(s, fluidGrid->GetRadialGrid(), &ht_type);
+
+    // Flux surface and bounce averages may be loaded from
+    // (or saved to) an on-disk cache. If building the grids
+    // fails, the (incomplete) cache is discarded when the
+    // pointer goes out of scope.
+    std::unique_ptr<FVM::GridCache> gridCache = ConstructGridCache(s);
+    if (gridCache != nullptr) {
+        fluidGrid->SetGeometryCache(gridCache.get(), "fluidgrid");
+        if (hottailGrid)
+            hottailGrid->SetGeometryCache(gridCache.get(), "hottailgrid");
+    }
     
     scalarGrid->Rebuild(t0);
     fluidGrid->Rebuild(t0);
@@ -38,8 +51,23 @@ Simulation *SimulationGenerator::ProcessSettings(Settings *s) {
 
 	// The runaway grid depends on the hot-tail grid (if it exists)
     FVM::Grid *runawayGrid = ConstructRunawayGrid(s, fluidGrid->GetRadialGrid(), hottailGrid, &re_type);
-    if (runawayGrid)
+    if (runawayGrid) {
+        if (gridCache != nullptr)
+            runawayGrid->SetGeometryCache(gridCache.get(), "runawaygrid");
         runawayGrid->Rebuild(t0);
+    }
+
+    // The cache is only used while the grids are first built
+    if (gridCache != nullptr) {
+        fluidGrid->SetGeometryCache(nullptr, "");
+        if (hottailGrid)
+            hottailGrid->SetGeometryCache(nullptr, "");
+        if (runawayGrid)
+            runawayGrid->SetGeometryCache(nullptr, "");
+
+        gridCache->Close();
+        gridCache.reset();
+    }
 
     // Load ADAS database
     ADAS *adas = LoadADAS(s);
@@ -127,8 +155,20 @@ AMJUEL *SimulationGenerator::LoadAMJUEL(Settings*){
 void SimulationGenerator::LoadOutput(Settings *s, Simulation *sim) {
     std::string filename = s->GetString("/output/filename");
 
-    sim->SetOutputGenerator(new OutputGeneratorSFile(
-        sim->GetEquationSystem(), filename
-    ));
+    if (s->GetBool("/output/stream")) {
+        int_t flushInterval = s->GetInteger("/output/flushinterval");
+        if (flushInterval < 0)
+            throw SettingsException(
+                "output: Invalid flush interval: " INT_T_PRINTF_FMT ". The flush interval must be non-negative.",
+                flushInterval
+            );
+
+        sim->SetOutputGenerator(new OutputGeneratorHDF5Stream(
+            sim->GetEquationSystem(), filename, (len_t)flushInterval
+        ));
+    } else
+        sim->SetOutputGenerator(new OutputGeneratorSFile(
+            sim->GetEquationSystem(), filename
+        ));
 }
 
@@ -2,7 +2,12 @@
  * Construction of the radial grid.
  */
 
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
 #include <string>
+#include "DREAM/IO.hpp"
 #include "DREAM/Settings/Settings.hpp"
 #include "DREAM/Settings/SimulationGenerator.hpp"
 #include "FVM/Grid/AnalyticBRadialGridGenerator.hpp"
@@ -57,6 +62,9 @@ void SimulationGenerator::DefineOptions_RadialGrid(Settings *s) {
     // NumericBRadialGridGenerator
     s->DefineSetting(RADIALGRID "/filename", "Name of file containing the magnetic field data", (string)"");
     s->DefineSetting(RADIALGRID "/fileformat", "Format used for storing the magnetic field data", (int_t)OptionConstants::RADIALGRID_NUMERIC_FORMAT_LUKE);
+
+    // Geometry cache
+    s->DefineSetting(RADIALGRID "/cachedir", "Directory in which to cache flux surface and bounce averages (empty = disabled)", (string)"");
 }
 
 /**
@@ -119,6 +127,94 @@ FVM::Grid *SimulationGenerator::ConstructRadialGrid(Settings *s) {
 
 
 
+/**
+ * Add the given bytes to the 64-bit FNV-1a hash 'h'.
+ */
+static void gridcache_hash(uint64_t &h, const void *data, const size_t n) {
+    const unsigned char *p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+}
+
+/**
+ * Construct the cache of flux surface and bounce averages
+ * used when building the grids. The cache file is named after
+ * a hash of all radial and kinetic grid settings, together with
+ * the contents of the numerical magnetic field file (if any), so
+ * that simulations with identical grids share the same cache
+ * file. Returns an empty pointer if caching is disabled.
+ *
+ * s: Settings object specifying how to construct the grids.
+ */
+unique_ptr<FVM::GridCache> SimulationGenerator::ConstructGridCache(Settings *s) {
+    const string cachedir = s->GetString(RADIALGRID "/cachedir");
+    if (cachedir.empty())
+        return nullptr;
+
+    // Bump version whenever the cache file layout, or the
+    // way the cached quantities are evaluated, changes
+    uint64_t h = 14695981039346656037ull;
+    const string version = "DREAM-gridcache-1";
+    gridcache_hash(h, version.c_str(), version.size());
+
+    for (auto const& [name, setting] : s->GetSettings()) {
+        if (name.rfind(RADIALGRID "/", 0) != 0 &&
+            name.rfind("hottailgrid/", 0) != 0 &&
+            name.rfind("runawaygrid/", 0) != 0)
+            continue;
+        else if (name == RADIALGRID "/cachedir")
+            continue;
+
+        gridcache_hash(h, name.c_str(), name.size()+1);
+
+        len_t n = 1;
+        for (len_t i = 0; i < setting->ndims; i++)
+            n *= setting->dims[i];
+
+        switch (setting->type) {
+            case Settings::SETTING_TYPE_BOOL: gridcache_hash(h, setting->value, sizeof(bool)); break;
+            case Settings::SETTING_TYPE_INT: gridcache_hash(h, setting->value, sizeof(int_t)); break;
+            case Settings::SETTING_TYPE_REAL: gridcache_hash(h, setting->value, sizeof(real_t)); break;
+            case Settings::SETTING_TYPE_INT_ARRAY: gridcache_hash(h, setting->value, n*sizeof(int_t)); break;
+            case Settings::SETTING_TYPE_REAL_ARRAY: gridcache_hash(h, setting->value, n*sizeof(real_t)); break;
+            case Settings::SETTING_TYPE_STRING: {
+                const string *str = (const string*)setting->value;
+                gridcache_hash(h, str->c_str(), str->size());
+            } break;
+
+            default: break;
+        }
+    }
+
+    // Numerical magnetic field data
+    enum OptionConstants::radialgrid_type type = (enum OptionConstants::radialgrid_type)s->GetInteger(RADIALGRID "/type", false);
+    if (type == OptionConstants::RADIALGRID_TYPE_NUMERICAL) {
+        const string filename = s->GetString(RADIALGRID "/filename", false);
+        ifstream f(filename, ios::binary);
+        if (!f)
+            throw SettingsException(
+                "Unable to open magnetic field data file '%s'.", filename.c_str()
+            );
+
+        char buf[65536];
+        while (f.read(buf, sizeof(buf)) || f.gcount() > 0)
+            gridcache_hash(h, buf, f.gcount());
+    }
+
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", (unsigned long long)h);
+    const string filename = cachedir + "/grid-" + key + ".h5";
+
+    unique_ptr<FVM::GridCache> gc = make_unique<FVM::GridCache>(filename);
+    if (gc->IsHit())
+        DREAM::IO::PrintInfo("Loading grid geometry from cache '%s'.", filename.c_str());
+
+    return gc;
+}
+
+
 /**
  * Construct a radial grid according to the
  * given specification.
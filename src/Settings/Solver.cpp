@@ -32,6 +32,24 @@ void SimulationGenerator::DefineOptions_Solver(Settings *s) {
     s->DefineSetting(MODULENAME "/maxiter", "Maximum number of nonlinear iterations allowed", (int_t)100);
     s->DefineSetting(MODULENAME "/reltol", "Relative tolerance for nonlinear solver", (real_t)1e-6);
     s->DefineSetting(MODULENAME "/verbose", "If true, generates extra output during nonlinear solve", (bool)false);
+    s->DefineSetting(MODULENAME "/parallelrebuild", "If true, rebuilds independent equation terms in parallel (using OpenMP)", (bool)false);
+    s->DefineSetting(MODULENAME "/reusesymbolic", "If true, direct linear solvers reuse the ordering and fill of the first factorization of a matrix", (bool)false);
+    s->DefineSetting(MODULENAME "/ordering", "Ordering of the matrix rows/columns to use in the factorizations of the direct linear solvers", (int_t)OptionConstants::LINEAR_SOLVER_ORDERING_DEFAULT);
+    s->DefineSetting(MODULENAME "/maxjacobianlag", "Maximum number of consecutive iterations in which the factorization of a jacobian may be reused (0 = build jacobian in every iteration)", (int_t)0);
+    s->DefineSetting(MODULENAME "/maxlagrate", "Maximum convergence rate (ratio of consecutive step norms) for which a lagged jacobian may be used", (real_t)0.5);
+    s->DefineSetting(MODULENAME "/jacobian", "Method to use for evaluating the jacobian matrix in the non-linear solver", (int_t)OptionConstants::SOLVER_JACOBIAN_ANALYTICAL);
+    s->DefineSetting(MODULENAME "/linesearch", "If true, the non-linear solver uses a backtracking line search to ensure that each Newton step reduces the residual", (bool)false);
+    s->DefineSetting(MODULENAME "/predictor", "Extrapolation from previous time steps used as initial guess for the non-linear solver", (int_t)OptionConstants::SOLVER_PREDICTOR_NONE);
+    s->DefineSetting(MODULENAME "/paralleljacobian", "If true, evaluates the jacobian contributions of independent equation terms in parallel (using OpenMP)", (bool)false);
+    s->DefineSetting(MODULENAME "/gmres/preconditioner", "Preconditioner to use with the GMRES linear solver", (int_t)OptionConstants::GMRES_PRECONDITIONER_BLOCK_JACOBI);
+    s->DefineSetting(MODULENAME "/gmres/maxpcreuse", "Maximum number of consecutive GMRES solves in which the preconditioner may be reused (0 = rebuild preconditioner in every solve)", (int_t)0);
+    s->DefineSetting(MODULENAME "/gmres/maxpciterations", "Rebuild the GMRES preconditioner if the previous solve needed more than this number of iterations (0 = no limit)", (int_t)0);
+    s->DefineSetting(MODULENAME "/gmres/recycle", "Number of deflation vectors carried between GMRES restarts and solves (0 = no Krylov subspace recycling)", (int_t)0);
+    s->DefineSetting(MODULENAME "/mixed/epsilon", "Relative accuracy of the approximate factorization used by the mixed-precision linear solver", (real_t)1e-7);
+    s->DefineSetting(MODULENAME "/mixed/reltol", "Relative tolerance of the iterative refinement in the mixed-precision linear solver", (real_t)1e-10);
+    s->DefineSetting(MODULENAME "/mixed/maxiter", "Maximum number of iterative refinement steps in the mixed-precision linear solver", (int_t)20);
+    s->DefineSetting(MODULENAME "/jfnk/maxiter", "Maximum number of GMRES iterations per Newton iteration in the Jacobian-free Newton-Krylov solver", (int_t)200);
+    s->DefineSetting(MODULENAME "/jfnk/reltol", "Relative tolerance for GMRES in the Jacobian-free Newton-Krylov solver", (real_t)1e-4);
 
     DefineToleranceSettings(MODULENAME, s);
     DefinePreconditionerSettings(s);
@@ -47,6 +65,7 @@ void SimulationGenerator::DefineOptions_Solver(Settings *s) {
     s->DefineSetting(MODULENAME "/debug/saveresidual", "If true, saves the residual vector in the specified iteration(s)", (bool)false);
     s->DefineSetting(MODULENAME "/debug/savesystem", "If true, saves the full equation system in the most recent iteration/time step", (bool)false);
     s->DefineSetting(MODULENAME "/debug/rescaled", "If true, saves the rescaled version of the jacobian/solution/residual.", (bool)false);
+    s->DefineSetting(MODULENAME "/debug/validatejacobian", "If true, verifies in every iteration that the jacobian blocks skipped as empty remain empty", (bool)false);
     s->DefineSetting(MODULENAME "/debug/timestep", "Index of time step to save debug info for. If '0', saves debug info for all time steps and iterations", (int_t)0);
     s->DefineSetting(MODULENAME "/debug/iteration", "Index of iteration to save debug info for.", (int_t)1);
 }
@@ -73,6 +92,10 @@ void SimulationGenerator::ConstructSolver(EquationSystem *eqsys, Settings *s) {
 			solver = ConstructSolver_nonlinear(s, u, eqns, eqsys);
 			break;
 
+        case OptionConstants::SOLVER_TYPE_JFNK:
+            solver = ConstructSolver_jfnk(s, u, eqns, eqsys);
+            break;
+
         default:
             throw SettingsException(
                 "Unrecognized solver type: %d.", type
@@ -90,6 +113,47 @@ void SimulationGenerator::ConstructSolver(EquationSystem *eqsys, Settings *s) {
 
     solver->SetIonHandler(eqsys->GetIonHandler());
 
+    solver->SetParallelRebuild(s->GetBool(MODULENAME "/parallelrebuild"));
+    solver->SetParallelJacobian(s->GetBool(MODULENAME "/paralleljacobian"));
+    solver->SetReuseSymbolicFactorization(s->GetBool(MODULENAME "/reusesymbolic"));
+
+    enum OptionConstants::linear_solver_ordering ordering =
+        (enum OptionConstants::linear_solver_ordering)s->GetInteger(MODULENAME "/ordering");
+    if (ordering != OptionConstants::LINEAR_SOLVER_ORDERING_DEFAULT &&
+        ordering != OptionConstants::LINEAR_SOLVER_ORDERING_RADIAL)
+        throw SettingsException(
+            "Solver: Unrecognized matrix ordering: %d.", ordering
+        );
+    solver->SetMatrixOrdering(ordering);
+
+    enum OptionConstants::gmres_preconditioner gmrespc =
+        (enum OptionConstants::gmres_preconditioner)s->GetInteger(MODULENAME "/gmres/preconditioner");
+    if (gmrespc != OptionConstants::GMRES_PRECONDITIONER_BLOCK_JACOBI &&
+        gmrespc != OptionConstants::GMRES_PRECONDITIONER_FIELDSPLIT &&
+        gmrespc != OptionConstants::GMRES_PRECONDITIONER_SCHUR)
+        throw SettingsException(
+            "Solver: Unrecognized GMRES preconditioner: %d.", gmrespc
+        );
+    solver->SetGMRESPreconditioner(gmrespc);
+
+    int_t maxpcreuse = s->GetInteger(MODULENAME "/gmres/maxpcreuse");
+    int_t maxpciter  = s->GetInteger(MODULENAME "/gmres/maxpciterations");
+    int_t recycle    = s->GetInteger(MODULENAME "/gmres/recycle");
+    if (maxpcreuse < 0 || maxpciter < 0 || recycle < 0)
+        throw SettingsException(
+            "Solver: The GMRES preconditioner reuse and recycling settings must be non-negative."
+        );
+    solver->SetGMRESReuse((len_t)maxpcreuse, (len_t)maxpciter, (len_t)recycle);
+
+    real_t mixedeps   = s->GetReal(MODULENAME "/mixed/epsilon");
+    real_t mixedtol   = s->GetReal(MODULENAME "/mixed/reltol");
+    int_t mixedmaxit  = s->GetInteger(MODULENAME "/mixed/maxiter");
+    if (mixedeps <= 0 || mixedtol <= 0 || mixedmaxit <= 0)
+        throw SettingsException(
+            "Solver: The mixed-precision linear solver settings must be positive."
+        );
+    solver->SetMixedPrecision(mixedeps, mixedtol, (len_t)mixedmaxit);
+
     solver->SetConvergenceChecker(LoadToleranceSettings(
         MODULENAME, s, u, solver->GetNonTrivials()
     ));
@@ -145,6 +209,13 @@ SolverNonLinear *SimulationGenerator::ConstructSolver_nonlinear(
     int_t maxiter     = s->GetInteger(MODULENAME "/maxiter");
     real_t reltol     = s->GetReal(MODULENAME "/reltol");
     bool verbose      = s->GetBool(MODULENAME "/verbose");
+    int_t maxjaclag   = s->GetInteger(MODULENAME "/maxjacobianlag");
+    real_t maxlagrate = s->GetReal(MODULENAME "/maxlagrate");
+    bool linesearch   = s->GetBool(MODULENAME "/linesearch");
+    enum OptionConstants::solver_jacobian jacmode =
+        (enum OptionConstants::solver_jacobian)s->GetInteger(MODULENAME "/jacobian");
+    enum OptionConstants::solver_predictor predictor =
+        (enum OptionConstants::solver_predictor)s->GetInteger(MODULENAME "/predictor");
     bool savejacobian = s->GetBool(MODULENAME "/debug/savejacobian");
     bool savesolution = s->GetBool(MODULENAME "/debug/savesolution");
     bool savenumjac   = s->GetBool(MODULENAME "/debug/savenumericaljacobian");
@@ -154,10 +225,61 @@ SolverNonLinear *SimulationGenerator::ConstructSolver_nonlinear(
     int_t timestep    = s->GetInteger(MODULENAME "/debug/timestep");
     int_t iteration   = s->GetInteger(MODULENAME "/debug/iteration");
     bool savesystem   = s->GetBool(MODULENAME "/debug/savesystem");
+    bool validatejac  = s->GetBool(MODULENAME "/debug/validatejacobian");
 
     auto snl = new SolverNonLinear(u, eqns, eqsys, linsolv, backups, maxiter, reltol, verbose);
     snl->SetDebugMode(printdebug, savesolution, savejacobian, saveresidual, savenumjac, timestep, iteration, savesystem, rescaled);
+    snl->SetValidateJacobianPattern(validatejac);
+
+    if (maxjaclag < 0)
+        throw SettingsException(
+            "Solver: The maximum jacobian lag must be non-negative: " INT_T_PRINTF_FMT ".",
+            maxjaclag
+        );
+    snl->SetJacobianLag((len_t)maxjaclag, maxlagrate);
+    snl->SetLineSearch(linesearch);
+
+    if (jacmode != OptionConstants::SOLVER_JACOBIAN_ANALYTICAL &&
+        jacmode != OptionConstants::SOLVER_JACOBIAN_NUMERICAL)
+        throw SettingsException(
+            "Solver: Unrecognized jacobian mode: %d.", jacmode
+        );
+    snl->SetJacobianMode(jacmode);
+
+    if (predictor != OptionConstants::SOLVER_PREDICTOR_NONE &&
+        predictor != OptionConstants::SOLVER_PREDICTOR_LINEAR &&
+        predictor != OptionConstants::SOLVER_PREDICTOR_QUADRATIC)
+        throw SettingsException(
+            "Solver: Unrecognized predictor: %d.", predictor
+        );
+    snl->SetPredictor(predictor);
 
     return snl;
 }
 
+/**
+ * Construct a SolverJFNK object according to the provided
+ * settings.
+ */
+SolverJFNK *SimulationGenerator::ConstructSolver_jfnk(
+    Settings *s, FVM::UnknownQuantityHandler *u,
+    vector<UnknownQuantityEquation*> *eqns,
+    EquationSystem *eqsys
+) {
+    int_t maxiter     = s->GetInteger(MODULENAME "/maxiter");
+    real_t reltol     = s->GetReal(MODULENAME "/reltol");
+    bool verbose      = s->GetBool(MODULENAME "/verbose");
+    int_t kspmaxiter  = s->GetInteger(MODULENAME "/jfnk/maxiter");
+    real_t kspreltol  = s->GetReal(MODULENAME "/jfnk/reltol");
+
+    if (kspmaxiter <= 0)
+        throw SettingsException(
+            "Solver: The maximum number of GMRES iterations must be positive: " INT_T_PRINTF_FMT ".",
+            kspmaxiter
+        );
+
+    auto sj = new SolverJFNK(u, eqns, eqsys, maxiter, reltol, verbose);
+    sj->SetKrylovSettings((len_t)kspmaxiter, kspreltol);
+
+    return sj;
+}
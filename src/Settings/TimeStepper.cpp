@@ -30,6 +30,7 @@ void SimulationGenerator::DefineOptions_TimeStepper(Settings *s) {
 	s->DefineSetting(MODULENAME "/minsavedt", "Minimum time required to elapse between time steps to save in adaptive ioniz time stepper.", (real_t)0);
     s->DefineSetting(MODULENAME "/nsavesteps", "Number of time steps to save to output (downsampling)", (int_t)0);
     s->DefineSetting(MODULENAME "/nt", "Number of time steps to take", (int_t)0);
+    s->DefineSetting(MODULENAME "/order", "Order of the backward differentiation formula used for time derivatives (1 = backward Euler, 2 = BDF2)", (int_t)1);
 	s->DefineSetting(MODULENAME "/safetyfactor", "Safety factor to use when automatically determining the baseline timestep for the adaptive ionization time stepper.", (real_t)50);
     s->DefineSetting(MODULENAME "/tmax", "Maximum simulation time", (real_t)0.0);
     s->DefineSetting(MODULENAME "/type", "Time step generator type", (int_t)OptionConstants::TIMESTEPPER_TYPE_CONSTANT);
@@ -48,8 +49,25 @@ void SimulationGenerator::DefineOptions_TimeStepper(Settings *s) {
 void SimulationGenerator::ConstructTimeStepper(EquationSystem *eqsys, Settings *s) {
     enum OptionConstants::timestepper_type type = (enum OptionConstants::timestepper_type)s->GetInteger(MODULENAME "/type");
 
+    int_t order = s->GetInteger(MODULENAME "/order");
+
     FVM::UnknownQuantityHandler *u = eqsys->GetUnknownHandler();
     vector<len_t> *nontrivials = eqsys->GetNonTrivialUnknowns();
+
+    if (order != 1 && order != 2)
+        throw SettingsException(
+            "TimeStepper: Invalid order of time discretization: " INT_T_PRINTF_FMT ". Must be 1 or 2.",
+            order
+        );
+    // The step-doubling stepper pushes intermediate states to the
+    // history of the unknowns, which would corrupt the BDF2 formula
+    else if (order == 2 && type == OptionConstants::TIMESTEPPER_TYPE_ADAPTIVE)
+        throw SettingsException(
+            "TimeStepper adaptive: The second-order time discretization is not "
+            "supported by this time stepper. Use the embedded adaptive time stepper instead."
+        );
+
+    u->SetTimeIntegrationOrder((len_t)order);
     TimeStepper *ts;
     switch (type) {
         case OptionConstants::TIMESTEPPER_TYPE_CONSTANT:
@@ -64,6 +82,10 @@ void SimulationGenerator::ConstructTimeStepper(EquationSystem *eqsys, Settings *
 			ts = ConstructTimeStepper_ionization(s, u);
 			break;
 
+        case OptionConstants::TIMESTEPPER_TYPE_EMBEDDED:
+            ts = ConstructTimeStepper_embedded(s, u, nontrivials);
+            break;
+
         default:
             throw SettingsException(
                 "Unrecognized time stepper type: %d.", type
@@ -140,6 +162,33 @@ TimeStepperAdaptive *SimulationGenerator::ConstructTimeStepper_adaptive(
     return new TimeStepperAdaptive(tmax, dt, u, *nontrivials, cc, checkevery, verbose, conststep);
 }
 
+/**
+ * Construct a TimeStepperEmbedded object according to the
+ * provided settings.
+ *
+ * s: Settings object specifying how to construct the
+ *    TimeStepperEmbedded object.
+ */
+TimeStepperEmbedded *SimulationGenerator::ConstructTimeStepper_embedded(
+    Settings *s, FVM::UnknownQuantityHandler *u,
+    vector<len_t> *nontrivials
+) {
+    real_t tmax = s->GetReal(MODULENAME "/tmax");
+    real_t dt = s->GetReal(MODULENAME "/dt");
+    bool verbose = s->GetBool(MODULENAME "/verbose");
+
+    if (dt < 0)
+        throw SettingsException("TimeStepper embedded: Initial time step 'dt' must be non-negative.");
+    else if (dt == 0)
+        dt = tmax * 1e-3;
+
+    ConvergenceChecker *cc = LoadToleranceSettings(
+        MODULENAME, s, u, *nontrivials
+    );
+
+    return new TimeStepperEmbedded(tmax, dt, u, *nontrivials, cc, verbose);
+}
+
 /**
  * Construct a TimeStepperIonization object according to the
  * provided settings.
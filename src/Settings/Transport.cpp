@@ -45,6 +45,14 @@ void SimulationGenerator::DefineOptions_Transport(
                      (int_t) OptionConstants::svensson_interp1d_param::SVENSSON_INTERP1D_TIME);
     
 
+    // Time interpolation of prescribed coefficients
+    s->DefineSetting(mod + "/" + subname + "/interp_windowed",
+        "If true, only keep the two prescribed time slices bracketing the current time interpolated onto the simulation grid.",
+        (bool)false);
+    s->DefineSetting(mod + "/" + subname + "/interp_prefetch",
+        "If true, interpolate the next prescribed time slice on a background thread (only used with 'interp_windowed').",
+        (bool)false);
+
     // Boundary condition
     s->DefineSetting(mod + "/" + subname + "/boundarycondition", "Boundary condition to use for radial transport.", (int_t)OptionConstants::EQTERM_TRANSPORT_BC_F_0);
 
@@ -125,9 +133,12 @@ T *SimulationGenerator::ConstructTransportTerm_internal(
             default: break;
         }
     }
+    bool windowed = s->GetBool(mod + "/interp_windowed");
+    bool prefetch = s->GetBool(mod + "/interp_prefetch");
+
     return new T(
         grid, nt, nr, np1, np2, x, t, r, p1, p2,
-        mtype, gridtype, interp3d
+        mtype, gridtype, interp3d, windowed, prefetch
     );
 }
 
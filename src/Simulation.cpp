@@ -28,6 +28,10 @@ Simulation::~Simulation() {
  * Run this simulation.
  */
 void Simulation::Run() {
+    // Output may be written while solving
+    if (outgen != nullptr)
+        eqsys->SetOutputGenerator(outgen);
+
     eqsys->Solve();
 }
 
@@ -3,7 +3,10 @@
  * in the non-linear solver.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <vector>
 #include "DREAM/Solver/SolverNonLinear.hpp"
 #include "FVM/BlockMatrix.hpp"
 #include "FVM/UnknownQuantity.hpp"
@@ -12,81 +15,273 @@
 using namespace DREAM;
 
 
+/**
+ * Group the columns of the jacobian matrix such that no two columns
+ * in the same group have a non-zero element in the same row
+ * (Curtis-Powell-Reid). All columns of a group can then be
+ * differentiated with a single evaluation of the residual, so that
+ * the number of residual evaluations is roughly equal to the largest
+ * number of non-zero elements in any row.
+ *
+ * The non-zero pattern is taken from the analytical jacobian in the
+ * current point. Terms which declare a dependence on an unknown (see
+ * 'Operator::HasJacobianContribution()') but provide no analytical
+ * jacobian elements at all with respect to it are not represented in
+ * this pattern, and so the corresponding blocks are added to the
+ * pattern as dense blocks. The resulting pattern is stored in both
+ * compressed row ('numjacRowPtr', 'numjacCols') and compressed column
+ * ('numjacColPtr', 'numjacColRows') format, where 'numjacColPos' gives
+ * the index in 'numjacCols' of each element in the column format.
+ */
+void SolverNonLinear::_BuildJacobianColoring() {
+    const len_t nu = this->nontrivial_unknowns.size();
+
+    // Index of each non-trivial unknown in 'nontrivial_unknowns',
+    // and offset of its block in the matrix
+    std::map<len_t, len_t> index;
+    std::vector<PetscInt> blockOffset(nu+1, 0);
+    for (len_t k = 0; k < nu; k++) {
+        index[this->nontrivial_unknowns[k]] = k;
+        blockOffset[k+1] = blockOffset[k] +
+            this->unknowns->GetUnknown(this->nontrivial_unknowns[k])->NumberOfElements();
+    }
+
+    // Index of the block containing row/column 'i'
+    auto blockOf = [&blockOffset](const PetscInt i) {
+        return (len_t)((std::upper_bound(blockOffset.begin(), blockOffset.end(), i) - blockOffset.begin()) - 1);
+    };
+
+    const PetscInt N = blockOffset[nu];
+
+    // Non-zero pattern of the analytical jacobian
+    FVM::BlockMatrix *ajac = this->ConstructJacobianMatrix();
+    this->BuildJacobian(this->CurrentTime(), this->CurrentTimeStep(), ajac);
+
+    std::vector<std::vector<PetscInt>> rows(N);
+    std::vector<bool> nonEmpty(nu*nu, false);
+    for (PetscInt i = 0; i < N; i++) {
+        PetscInt ncols;
+        const PetscInt *cols;
+        MatGetRow(ajac->mat(), i, &ncols, &cols, nullptr);
+        rows[i].assign(cols, cols+ncols);
+        MatRestoreRow(ajac->mat(), i, &ncols, &cols, nullptr);
+
+        const len_t X = blockOf(i);
+        for (PetscInt j : rows[i])
+            nonEmpty[X*nu + blockOf(j)] = true;
+    }
+
+    delete ajac;
+
+    // Blocks without any analytical jacobian elements, although
+    // a term declares a dependence on the unknown, are dense
+    std::vector<bool> dense(nu*nu, false);
+    for (const struct operator_task& task : this->operatorTasks) {
+        const len_t X = index.at(task.uqnId);
+
+        for (len_t derivId : this->nontrivial_unknowns) {
+            const len_t Y = index.at(derivId);
+            if (!nonEmpty[X*nu + Y] && task.op->HasJacobianContribution(task.operandId, derivId))
+                dense[X*nu + Y] = true;
+        }
+    }
+
+    for (len_t X = 0; X < nu; X++) {
+        bool hasDense = false;
+        for (len_t Y = 0; Y < nu; Y++) {
+            if (!dense[X*nu + Y])
+                continue;
+
+            hasDense = true;
+            for (PetscInt i = blockOffset[X]; i < blockOffset[X+1]; i++)
+                for (PetscInt j = blockOffset[Y]; j < blockOffset[Y+1]; j++)
+                    rows[i].push_back(j);
+        }
+
+        if (hasDense) {
+            for (PetscInt i = blockOffset[X]; i < blockOffset[X+1]; i++) {
+                std::sort(rows[i].begin(), rows[i].end());
+                rows[i].erase(std::unique(rows[i].begin(), rows[i].end()), rows[i].end());
+            }
+        }
+    }
+
+    // Compressed row format
+    this->numjacRowPtr.assign(N+1, 0);
+    for (PetscInt i = 0; i < N; i++)
+        this->numjacRowPtr[i+1] = this->numjacRowPtr[i] + rows[i].size();
+
+    const PetscInt nnz = this->numjacRowPtr[N];
+    this->numjacCols.resize(nnz);
+    for (PetscInt i = 0; i < N; i++)
+        std::copy(rows[i].begin(), rows[i].end(), this->numjacCols.begin() + this->numjacRowPtr[i]);
+
+    // Compressed column format
+    this->numjacColPtr.assign(N+1, 0);
+    for (PetscInt q = 0; q < nnz; q++)
+        this->numjacColPtr[this->numjacCols[q]+1]++;
+    for (PetscInt j = 0; j < N; j++)
+        this->numjacColPtr[j+1] += this->numjacColPtr[j];
+
+    this->numjacColRows.resize(nnz);
+    this->numjacColPos.resize(nnz);
+    std::vector<PetscInt> next(this->numjacColPtr.begin(), this->numjacColPtr.end()-1);
+    for (PetscInt i = 0; i < N; i++) {
+        for (PetscInt q = this->numjacRowPtr[i]; q < this->numjacRowPtr[i+1]; q++) {
+            const PetscInt p = next[this->numjacCols[q]]++;
+            this->numjacColRows[p] = i;
+            this->numjacColPos[p]  = q;
+        }
+    }
+
+    // Greedy colouring of the column intersection graph: each
+    // column is given the lowest colour not used by any column
+    // sharing a row with it
+    std::vector<PetscInt> colour(N, -1);
+    // forbidden[c] == j if colour 'c' is taken by a neighbour of column 'j'
+    std::vector<PetscInt> forbidden(N, -1);
+    PetscInt nColours = 0;
+    for (PetscInt j = 0; j < N; j++) {
+        for (PetscInt p = this->numjacColPtr[j]; p < this->numjacColPtr[j+1]; p++) {
+            const PetscInt i = this->numjacColRows[p];
+            for (PetscInt q = this->numjacRowPtr[i]; q < this->numjacRowPtr[i+1]; q++) {
+                const PetscInt k = this->numjacCols[q];
+                if (colour[k] >= 0)
+                    forbidden[colour[k]] = j;
+            }
+        }
+
+        PetscInt c = 0;
+        while (c < nColours && forbidden[c] == j)
+            c++;
+
+        colour[j] = c;
+        if (c == nColours)
+            nColours++;
+    }
+
+    this->numjacGroups.assign(nColours, std::vector<PetscInt>());
+    for (PetscInt j = 0; j < N; j++)
+        this->numjacGroups[colour[j]].push_back(j);
+}
+
 /**
  * Evaluate jacobian numerically using finite difference
- * of the residual function.
+ * of the residual function. Columns which do not share any
+ * non-zero rows are perturbed simultaneously (see
+ * '_BuildJacobianColoring()'), so that the number of residual
+ * evaluations is roughly equal to the largest number of non-zero
+ * elements in any row of the jacobian.
  *
- * jac: Jacobian matrix.
+ * When the non-zero pattern is (re)built, the jacobian matrix is
+ * reallocated with exactly that pattern, and all elements of the
+ * pattern (including zeros) are inserted in every evaluation. Every
+ * element written therefore lies within the preallocation, and the
+ * non-zero structure of the matrix does not change between
+ * evaluations.
+ *
+ * jac:           Jacobian matrix.
+ * printProgress: If true, prints the progress of the evaluation.
  */
 void SolverNonLinear::_EvaluateJacobianNumerically(
-    FVM::BlockMatrix *jac
+    FVM::BlockMatrix *jac, bool printProgress
 ) {
-    printf("Evaluating Jacobian numerically...   0.00%%");
+    if (printProgress)
+        printf("Evaluating Jacobian numerically...   0.00%%");
 
     len_t nSize = this->unknowns->GetLongVectorSize(this->nontrivial_unknowns);
-    const real_t *iniVec = this->unknowns->GetLongVector(this->nontrivial_unknowns);
 
-    real_t *dFVec   = new real_t[nSize];
+    real_t *iniVec  = new real_t[nSize];
     real_t *FVec    = new real_t[nSize];
     real_t *iniFVec = new real_t[nSize];
     real_t *xhVec   = new real_t[nSize];
+    real_t *hStep   = new real_t[nSize];
+
+    this->unknowns->GetLongVector(this->nontrivial_unknowns, iniVec);
     
     // Copy initial vector to shifted solution vector
     for (len_t i = 0; i < nSize; i++)
         xhVec[i] = iniVec[i];
 
+    // Evaluate F(x) (which also rebuilds the equation
+    // terms in the unperturbed point)
+    this->_EvaluateF(iniVec, iniFVec, jac);
+
+    if (this->numjacGroups.empty()) {
+        this->_BuildJacobianColoring();
+
+        std::vector<PetscInt> nnz(nSize);
+        for (len_t i = 0; i < nSize; i++)
+            nnz[i] = this->numjacRowPtr[i+1] - this->numjacRowPtr[i];
+
+        jac->ConstructSystem(nnz);
+    }
+
     jac->SetOffset(0, 0);
     jac->Zero();
 
-    this->_EvaluateF(iniVec, iniFVec, jac);
-
+    // Determine derivative step lengths
     const real_t h = 1e-6, hDefault = 10;
-    len_t index = 0;
-    for (auto uid : this->nontrivial_unknowns) {
-        FVM::UnknownQuantity *uqn = this->unknowns->GetUnknown(uid);
-        const len_t N = uqn->NumberOfElements();
-
-        // Differentiate w.r.t. index...
-        for (len_t _i = 0; _i < N; _i++, index++) {
-            // Restore previous element
-            if (index > 0)
-                xhVec[index-1] = iniVec[index-1];
-
-            // Determine derivative step length
-            real_t hStep;
-            if (iniVec[index] == 0)
-                hStep = hDefault;
-            else
-                hStep = h*iniVec[index];
-
-            xhVec[index] += hStep;
-
-            // Evaluate F(x+h)
-            this->_EvaluateF(xhVec, FVec, jac);
-
-            // Evaluate dF/dx_index
-            for (len_t j = 0; j < nSize; j++)
-                dFVec[j] = (FVec[j]-iniFVec[j]) / hStep;
-
-            // Set Jacobian column
-            for (len_t j = 0; j < nSize; j++) {
-                if (dFVec[j] != 0)
-                    jac->SetElement(j, index, dFVec[j], INSERT_VALUES);
+    for (len_t i = 0; i < nSize; i++) {
+        if (iniVec[i] == 0)
+            hStep[i] = hDefault;
+        else
+            hStep[i] = h*iniVec[i];
+    }
+
+    // Values of the elements in the non-zero pattern (row format)
+    std::vector<PetscScalar> vals(this->numjacCols.size(), 0);
+
+    const len_t nGroups = this->numjacGroups.size();
+    for (len_t ig = 0; ig < nGroups; ig++) {
+        const std::vector<PetscInt>& group = this->numjacGroups[ig];
+
+        for (PetscInt j : group)
+            xhVec[j] += hStep[j];
+
+        // Evaluate F(x+h)
+        this->_EvaluateF(xhVec, FVec, jac);
+
+        // Evaluate dF/dx_j for all columns in group
+        for (PetscInt j : group) {
+            for (PetscInt p = this->numjacColPtr[j]; p < this->numjacColPtr[j+1]; p++) {
+                const PetscInt i = this->numjacColRows[p];
+                vals[this->numjacColPos[p]] = (FVec[i]-iniFVec[i]) / hStep[j];
             }
 
-            printf("\b\b\b\b\b\b\b%6.2f%%", double(index)/double(nSize-1)*100);
+            // Restore element
+            xhVec[j] = iniVec[j];
+        }
+
+        if (printProgress) {
+            printf("\b\b\b\b\b\b\b%6.2f%%", double(ig+1)/double(nGroups)*100);
             std::cout << std::flush;
         }
     }
 
-    printf("\n");
+    if (printProgress)
+        printf("\n");
+
+    // Set jacobian elements (row by row)
+    for (len_t i = 0; i < nSize; i++) {
+        const PetscInt q = this->numjacRowPtr[i];
+        const PetscInt n = this->numjacRowPtr[i+1] - q;
+        if (n > 0)
+            jac->SetRow(i, n, this->numjacCols.data()+q, vals.data()+q, INSERT_VALUES);
+    }
 
     jac->Assemble();
 
+    // Restore solution, and rebuild the equation terms in
+    // the unperturbed point
+    this->unknowns->Store(this->nontrivial_unknowns, iniVec);
+    this->RebuildTerms(this->CurrentTime(), this->CurrentTimeStep());
+
+    delete [] hStep;
     delete [] xhVec;
     delete [] iniFVec;
     delete [] FVec;
-    delete [] dFVec;
+    delete [] iniVec;
 }
 
 /**
@@ -2,8 +2,12 @@
  * Implementation of common routines for the 'Solver' routines.
  */
 
+#include <algorithm>
+#include <exception>
 #include <iostream>
 
+#include <map>
+#include <string>
 #include <vector>
 #include "DREAM/IO.hpp"
 #include "DREAM/Solver/Solver.hpp"
@@ -18,6 +22,7 @@
 #ifdef PETSC_HAVE_MKL_PARDISO
 #   include "FVM/Solvers/MIMKL.hpp"
 #endif
+#include "FVM/Solvers/MIMixedPrecision.hpp"
 #include "FVM/Solvers/MIMUMPS.hpp"
 #include "FVM/Solvers/MISuperLU.hpp"
 
@@ -43,6 +48,8 @@ Solver::Solver(
     this->timerREFluid = this->solver_timeKeeper->AddTimer("refluid", "Rebuild RunawayFluid");
     this->timerSPIHandler = this->solver_timeKeeper->AddTimer("spihandler", "Rebuild SPIHandler");
     this->timerRebuildTerms = this->solver_timeKeeper->AddTimer("equations", "Rebuild terms");
+
+    this->terms_timeKeeper = new FVM::TimeKeeper("Solver rebuild terms");
 }
 
 /**
@@ -50,8 +57,12 @@ Solver::Solver(
  */
 Solver::~Solver() {
     delete this->solver_timeKeeper;
+    delete this->terms_timeKeeper;
     delete this->convChecker;
 
+    for (FVM::COOMatrix *buf : this->jacobianBuffers)
+        delete buf;
+
     if (this->diag_prec != nullptr)
         delete this->diag_prec;
 }
@@ -59,6 +70,11 @@ Solver::~Solver() {
 /**
  * Build a jacobian matrix for the equation system.
  *
+ * In the first call, every operator is differentiated with respect
+ * to every non-trivial unknown, and the blocks which turn out to be
+ * non-empty are recorded (see 'ProbeJacobianPattern()'). In all
+ * subsequent calls, only the non-empty blocks are evaluated.
+ *
  * t:    Time to build the jacobian matrix for.
  * dt:   Length of time step to take.
  * mat:  Matrix to use for storing the jacobian.
@@ -67,59 +83,261 @@ void Solver::BuildJacobian(const real_t, const real_t, FVM::BlockMatrix *jac) {
     // Reset jacobian matrix
     jac->Zero();
 
-    // Iterate over (non-trivial) unknowns (i.e. those which appear
-    // in the matrix system), corresponding to blocks in F and
-    // rows in the Jacobian matrix.
-    for (len_t uqnId : nontrivial_unknowns) {
-        UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
-        map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
-        len_t matUqnId = utmm[uqnId];
-        // Iterate over each equation term
-        len_t operatorId = 0;
-        for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++) {
-            const real_t *x = unknowns->GetUnknownData(it->first);
-        
-            // "Differentiate with respect to the unknowns which
-            // appear in the matrix"
-            //   d (F_uqnId) / d x_derivId
-            for (len_t derivId : nontrivial_unknowns) {
-                len_t matDerivId = utmm[derivId];
-                jac->SelectSubEquation(matUqnId, matDerivId);
-
-                // - in the equation for                           x_uqnId
-                // - differentiate the operator that is applied to x_it
-                // - with respect to                               x_derivId
-                it->second->SetJacobianBlock(it->first, derivId, jac, x);
+    if (!this->jacobianPatternBuilt)
+        this->ProbeJacobianPattern(jac, false);
+    else {
+        if (this->parallelJacobian)
+            this->BuildJacobianParallel(jac);
+        else {
+            map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
+
+            // Iterate over all operators in the equations for the
+            // (non-trivial) unknowns, i.e. those which appear in the
+            // matrix system, corresponding to blocks in F and rows
+            // in the Jacobian matrix.
+            for (struct operator_task& task : this->operatorTasks) {
+                const real_t *x = unknowns->GetUnknownData(task.operandId);
+                len_t matUqnId = utmm[task.uqnId];
+
+                // "Differentiate with respect to the unknowns which
+                // appear in the matrix"
+                //   d (F_uqnId) / d x_derivId
+                for (len_t derivId : task.jacDerivIds) {
+                    jac->SelectSubEquation(matUqnId, utmm[derivId]);
+
+                    // - in the equation for                           x_uqnId
+                    // - differentiate the operator that is applied to x_operandId
+                    // - with respect to                               x_derivId
+                    task.op->SetJacobianBlock(task.operandId, derivId, jac, x);
+                }
             }
-
-            operatorId++;
         }
 
-        //printf("operatorId = " LEN_T_PRINTF_FMT "\n", operatorId);
+        if (this->validateJacobianPattern)
+            this->ProbeJacobianPattern(jac, true);
     }
     jac->PartialAssemble();
 
     // Apply boundary conditions which overwrite elements
-    for (len_t uqnId : nontrivial_unknowns) {
-        UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
-        map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
-        len_t matUqnId = utmm[uqnId];
+    this->ApplyJacobianBC(jac, !this->jacobianPatternBuilt || this->validateJacobianPattern);
 
-        // Iterate over each equation
-        for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++) {
-            const real_t *x = unknowns->GetUnknownData(it->first);
-
-            // "Differentiate with respect to the unknowns which
-            // appear in the matrix"
-            //   d (eqn_uqnId) / d x_derivId
-            for (len_t derivId : nontrivial_unknowns) {
-                len_t matDerivId = utmm[derivId];
-                jac->SelectSubEquation(matUqnId, matDerivId);
-                // For logic, see comment in the for-loop above
-                it->second->SetJacobianBlockBC(it->first, derivId, jac, x);
+    this->jacobianPatternBuilt = true;
+    jac->Assemble();
+}
+
+/**
+ * Differentiate operators with respect to all non-trivial unknowns
+ * and record which jacobian blocks are non-empty. Since many jacobian
+ * elements are exactly zero in the first iteration, the structural
+ * pattern is used: a block is considered non-empty if any term of the
+ * operator has declared a jacobian contribution with respect to the
+ * unknown (see 'Operator::HasJacobianContribution()'), if
+ * 'Operator::SetJacobianBlock()' reports a contribution, or if any
+ * element is set in it (even if it is zero, in which case it is not
+ * stored). The non-zero elements are added to the given jacobian
+ * matrix.
+ *
+ * jac:      Jacobian matrix to add contributions to.
+ * validate: If 'false', the pattern is built from scratch. If 'true',
+ *           only the blocks which are not already part of the pattern
+ *           are evaluated, and a warning is printed for any such block
+ *           that turns out to be non-empty (the block is then added to
+ *           the pattern).
+ */
+void Solver::ProbeJacobianPattern(FVM::BlockMatrix *jac, bool validate) {
+    if (this->jacobianProbe == nullptr)
+        this->jacobianProbe = new FVM::COOMatrix(jac->GetNRows(), jac->GetNCols());
+
+    map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
+    for (struct operator_task& task : this->operatorTasks) {
+        const real_t *x = unknowns->GetUnknownData(task.operandId);
+        const PetscInt rowOffset = jac->GetOffset(utmm[task.uqnId]);
+
+        if (!validate)
+            task.jacDerivIds.clear();
+
+        for (len_t derivId : nontrivial_unknowns) {
+            if (validate && find(task.jacDerivIds.begin(), task.jacDerivIds.end(), derivId) != task.jacDerivIds.end())
+                continue;
+
+            this->jacobianProbe->SetOffset(rowOffset, jac->GetOffset(utmm[derivId]));
+            bool c = task.op->SetJacobianBlock(task.operandId, derivId, this->jacobianProbe, x);
+            c = c || (this->jacobianProbe->NumberOfTouched() > 0) ||
+                task.op->HasJacobianContribution(task.operandId, derivId);
+
+            if (c) {
+                if (validate)
+                    DREAM::IO::PrintWarning(
+                        "Jacobian block d(%s)/d(%s) of the operator applied to '%s' "
+                        "was not part of the jacobian pattern.",
+                        unknowns->GetUnknown(task.uqnId)->GetName().c_str(),
+                        unknowns->GetUnknown(derivId)->GetName().c_str(),
+                        unknowns->GetUnknown(task.operandId)->GetName().c_str()
+                    );
+
+                task.jacDerivIds.push_back(derivId);
+            }
+
+            this->jacobianProbe->AddTo(jac);
+        }
+    }
+}
+
+/**
+ * Apply the boundary conditions which overwrite elements of the
+ * jacobian matrix.
+ *
+ * jac:   Jacobian matrix to apply boundary conditions to.
+ * probe: If 'true', boundary conditions are applied for all
+ *        non-trivial unknowns and the blocks to which they contribute
+ *        are recorded. Otherwise, only the previously recorded blocks
+ *        are visited.
+ */
+void Solver::ApplyJacobianBC(FVM::BlockMatrix *jac, bool probe) {
+    map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
+
+    for (struct operator_task& task : this->operatorTasks) {
+        const real_t *x = unknowns->GetUnknownData(task.operandId);
+        len_t matUqnId = utmm[task.uqnId];
+
+        if (!probe) {
+            for (len_t derivId : task.jacBCDerivIds) {
+                jac->SelectSubEquation(matUqnId, utmm[derivId]);
+                task.op->SetJacobianBlockBC(task.operandId, derivId, jac, x);
+            }
+
+            continue;
+        }
+
+        if (!this->jacobianPatternBuilt)
+            task.jacBCDerivIds.clear();
+
+        // "Differentiate with respect to the unknowns which
+        // appear in the matrix"
+        //   d (eqn_uqnId) / d x_derivId
+        for (len_t derivId : nontrivial_unknowns) {
+            jac->SelectSubEquation(matUqnId, utmm[derivId]);
+            if (!task.op->SetJacobianBlockBC(task.operandId, derivId, jac, x))
+                continue;
+
+            if (find(task.jacBCDerivIds.begin(), task.jacBCDerivIds.end(), derivId) != task.jacBCDerivIds.end())
+                continue;
+
+            if (this->jacobianPatternBuilt)
+                DREAM::IO::PrintWarning(
+                    "Jacobian block d(%s)/d(%s) of the boundary conditions applied to '%s' "
+                    "was not part of the jacobian pattern.",
+                    unknowns->GetUnknown(task.uqnId)->GetName().c_str(),
+                    unknowns->GetUnknown(derivId)->GetName().c_str(),
+                    unknowns->GetUnknown(task.operandId)->GetName().c_str()
+                );
+
+            task.jacBCDerivIds.push_back(derivId);
+        }
+    }
+}
+
+/**
+ * Evaluate the (non-boundary condition) contributions to the
+ * jacobian matrix in parallel. Each group of operators returned
+ * by 'BuildRebuildSchedule()' is differentiated by a separate
+ * thread, which writes its elements to a private COO buffer. Since
+ * operators sharing any cached data are placed in the same group,
+ * no equation term is differentiated by more than one thread at a
+ * time. Only the blocks in the jacobian pattern are evaluated.
+ * When all groups are done, the buffers are added to the jacobian
+ * matrix serially (in group order).
+ *
+ * jac: Jacobian matrix to add contributions to.
+ */
+void Solver::BuildJacobianParallel(FVM::BlockMatrix *jac) {
+    const len_t nGroups = this->operatorGroups.size();
+
+    if (this->jacobianBuffers.size() != nGroups) {
+        for (FVM::COOMatrix *buf : this->jacobianBuffers)
+            delete buf;
+
+        this->jacobianBuffers.resize(nGroups);
+        for (len_t ig = 0; ig < nGroups; ig++)
+            this->jacobianBuffers[ig] = new FVM::COOMatrix(jac->GetNRows(), jac->GetNCols());
+    }
+
+    // Block offsets (looked up outside of the parallel region)
+    map<len_t, PetscInt> offsets;
+    for (len_t uqnId : nontrivial_unknowns)
+        offsets[uqnId] = jac->GetOffset(this->unknownToMatrixMapping[uqnId]);
+
+    exception_ptr eptr = nullptr;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (len_t ig = 0; ig < nGroups; ig++) {
+        FVM::COOMatrix *buf = this->jacobianBuffers[ig];
+        buf->Clear();
+
+        try {
+            for (len_t it : this->operatorGroups[ig]) {
+                const struct operator_task& task = this->operatorTasks[it];
+                const real_t *x = unknowns->GetUnknownData(task.operandId);
+                const PetscInt rowOffset = offsets.at(task.uqnId);
+
+                for (len_t derivId : task.jacDerivIds) {
+                    buf->SetOffset(rowOffset, offsets.at(derivId));
+                    task.op->SetJacobianBlock(task.operandId, derivId, buf, x);
+                }
+            }
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                if (eptr == nullptr)
+                    eptr = current_exception();
             }
         }
     }
+
+    if (eptr != nullptr)
+        rethrow_exception(eptr);
+
+    for (FVM::COOMatrix *buf : this->jacobianBuffers)
+        buf->AddTo(jac);
+}
+
+/**
+ * Build the block-diagonal part of the jacobian matrix, i.e. only
+ * the derivatives of the equation for each non-trivial unknown with
+ * respect to that same unknown. All couplings between different
+ * unknowns are neglected. This matrix is used to precondition the
+ * matrix-free (Jacobian-free Newton-Krylov) solver.
+ *
+ * jac: Matrix to use for storing the block-diagonal jacobian.
+ */
+void Solver::BuildJacobianDiagonalBlocks(FVM::BlockMatrix *jac) {
+    map<len_t, len_t>& utmm = this->unknownToMatrixMapping;
+
+    jac->Zero();
+
+    for (struct operator_task& task : this->operatorTasks) {
+        const real_t *x = unknowns->GetUnknownData(task.operandId);
+        len_t matUqnId = utmm[task.uqnId];
+
+        jac->SelectSubEquation(matUqnId, matUqnId);
+        task.op->SetJacobianBlock(task.operandId, task.uqnId, jac, x);
+    }
+
+    jac->PartialAssemble();
+
+    // Apply boundary conditions which overwrite elements
+    for (struct operator_task& task : this->operatorTasks) {
+        const real_t *x = unknowns->GetUnknownData(task.operandId);
+        len_t matUqnId = utmm[task.uqnId];
+
+        jac->SelectSubEquation(matUqnId, matUqnId);
+        task.op->SetJacobianBlockBC(task.operandId, task.uqnId, jac, x);
+    }
+
     jac->Assemble();
 }
 
@@ -228,9 +446,113 @@ void Solver::Initialize(const len_t size, vector<len_t>& unknowns) {
     // appear in the matrices that are built later on)
     nontrivial_unknowns = unknowns;
 
+    // Set up per-term rebuild timings
+    for (len_t uqnId : nontrivial_unknowns) {
+        UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
+        const string& eqnName = this->unknowns->GetUnknown(uqnId)->GetName();
+
+        for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++) {
+            const string& opName = this->unknowns->GetUnknown(it->first)->GetName();
+            it->second->SetRebuildTimeKeeper(
+                this->terms_timeKeeper, eqnName + "__" + opName,
+                eqnName + " (" + opName + ")"
+            );
+        }
+    }
+
+    this->BuildRebuildSchedule();
+
     this->initialize_internal(size, unknowns);
 }
 
+/**
+ * Partition the operators of the equation system into groups
+ * which can be rebuilt (and differentiated) independently of each
+ * other. Only operators whose terms have all explicitly declared
+ * themselves thread-safe (see 'Operator::IsRebuildThreadSafe()')
+ * may be processed in parallel; all other operators are placed in
+ * one common group, which is processed serially. Two thread-safe
+ * operators are placed in the same group if they share any rebuild
+ * dependency (i.e. a term, or an object holding cached data which
+ * is modified when rebuilding or differentiating their terms; see
+ * 'Operator::GetRebuildDependencies()'). Within a group, operators
+ * are processed in the same order as in the serial rebuild.
+ * This also sets up the list of operators ('operatorTasks') and resets
+ * the jacobian pattern.
+ */
+void Solver::BuildRebuildSchedule() {
+    vector<struct operator_task>& ops = this->operatorTasks;
+    ops.clear();
+    for (len_t uqnId : nontrivial_unknowns) {
+        UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
+        for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++)
+            ops.push_back({uqnId, it->first, it->second, {}, {}});
+    }
+
+    // The jacobian pattern must be determined anew
+    this->jacobianPatternBuilt = false;
+
+    // Union-find over operators
+    const len_t nOps = ops.size();
+    vector<len_t> parent(nOps);
+    for (len_t i = 0; i < nOps; i++)
+        parent[i] = i;
+
+    auto root = [&parent](len_t i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+
+    auto join = [&root,&parent](len_t i, len_t j) {
+        len_t a = root(i), b = root(j);
+        if (a != b)
+            parent[std::max(a,b)] = std::min(a,b);
+    };
+
+    // Operators which are not known to be thread-safe may share
+    // arbitrary (undeclared) data, and are all processed together
+    const len_t NO_OPERATOR = nOps;
+    len_t firstUnsafe = NO_OPERATOR;
+    for (len_t i = 0; i < nOps; i++) {
+        if (ops[i].op->IsRebuildThreadSafe())
+            continue;
+
+        if (firstUnsafe == NO_OPERATOR)
+            firstUnsafe = i;
+        else
+            join(firstUnsafe, i);
+    }
+
+    map<const void*, len_t> owner;
+    vector<const void*> deps;
+    for (len_t i = 0; i < nOps; i++) {
+        deps.clear();
+        ops[i].op->GetRebuildDependencies(deps);
+
+        for (const void *d : deps) {
+            auto it = owner.find(d);
+            if (it == owner.end())
+                owner[d] = i;
+            else
+                join(i, it->second);
+        }
+    }
+
+    // Collect groups (in order of first operator)
+    map<len_t, len_t> groupIndex;
+    this->operatorGroups.clear();
+    for (len_t i = 0; i < nOps; i++) {
+        len_t r = root(i);
+        auto it = groupIndex.find(r);
+        if (it == groupIndex.end()) {
+            groupIndex[r] = this->operatorGroups.size();
+            this->operatorGroups.push_back({i});
+        } else
+            this->operatorGroups[it->second].push_back(i);
+    }
+}
+
 /**
  * Rebuild all equation terms in the equation system for
  * the specified time.
@@ -275,12 +597,40 @@ void Solver::RebuildTerms(const real_t t, const real_t dt) {
     }
     solver_timeKeeper->StopTimer(timerSPIHandler);
 
-    for (len_t i = 0; i < nontrivial_unknowns.size(); i++) {
-        len_t uqnId = nontrivial_unknowns[i];
-        UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
+    if (this->parallelRebuild) {
+        // Exceptions may not propagate out of an OpenMP region, so
+        // we catch the first one thrown and rethrow it afterwards
+        exception_ptr eptr = nullptr;
+        const len_t nGroups = this->operatorGroups.size();
 
-        for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++) {
-            it->second->RebuildTerms(t, dt, unknowns);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (len_t ig = 0; ig < nGroups; ig++) {
+            try {
+                for (len_t it : this->operatorGroups[ig])
+                    this->operatorTasks[it].op->RebuildTerms(t, dt, unknowns);
+            } catch (...) {
+#ifdef _OPENMP
+                #pragma omp critical
+#endif
+                {
+                    if (eptr == nullptr)
+                        eptr = current_exception();
+                }
+            }
+        }
+
+        if (eptr != nullptr)
+            rethrow_exception(eptr);
+    } else {
+        for (len_t i = 0; i < nontrivial_unknowns.size(); i++) {
+            len_t uqnId = nontrivial_unknowns[i];
+            UnknownQuantityEquation *eqn = unknown_equations->at(uqnId);
+
+            for (auto it = eqn->GetOperators().begin(); it != eqn->GetOperators().end(); it++) {
+                it->second->RebuildTerms(t, dt, unknowns);
+            }
         }
     }
 
@@ -297,7 +647,10 @@ void Solver::Precondition(FVM::Matrix *mat, Vec rhs) {
     if (this->diag_prec == nullptr)
         return;
 
-    this->diag_prec->RescaleMatrix(mat);
+    // (the matrix may already be preconditioned if it
+    // is reused from a previous iteration)
+    if (mat != nullptr)
+        this->diag_prec->RescaleMatrix(mat);
     this->diag_prec->RescaleRHSVector(rhs);
 }
 
@@ -320,6 +673,7 @@ void Solver::UnPrecondition(Vec x) {
  */
 void Solver::PrintTimings_rebuild() {
     this->solver_timeKeeper->PrintTimings(true, 0);
+    this->terms_timeKeeper->PrintTimings(true, -1);
 }
 
 /**
@@ -328,6 +682,9 @@ void Solver::PrintTimings_rebuild() {
  */
 void Solver::SaveTimings_rebuild(SFile *sf, const std::string& path) {
     this->solver_timeKeeper->SaveTimings(sf, path);
+
+    sf->CreateStruct(path+"/terms");
+    this->terms_timeKeeper->SaveTimings(sf, path+"/terms");
 }
 
 /**
@@ -346,6 +703,174 @@ void Solver::SelectLinearSolver(const len_t N) {
 
     if (this->backupSolver != OptionConstants::LINEAR_SOLVER_NONE)
         this->backupInverter = this->ConstructLinearSolver(N, this->backupSolver);
+
+    this->SetReuseSymbolicFactorization(this->reuseSymbolicFactorization);
+    this->SetMatrixOrdering(this->matrixOrdering);
+}
+
+/**
+ * Enable/disable reuse of the symbolic factorization in the
+ * linear solvers (for those which support it).
+ */
+void Solver::SetReuseSymbolicFactorization(bool reuse) {
+    this->reuseSymbolicFactorization = reuse;
+
+    if (this->mainInverter != nullptr)
+        this->mainInverter->SetReuseSymbolicFactorization(reuse);
+    if (this->backupInverter != nullptr)
+        this->backupInverter->SetReuseSymbolicFactorization(reuse);
+}
+
+/**
+ * Set the ordering of the matrix rows/columns to use in the
+ * factorizations of the direct linear solvers (for those which
+ * support it).
+ */
+void Solver::SetMatrixOrdering(enum OptionConstants::linear_solver_ordering ordering) {
+    this->matrixOrdering = ordering;
+
+    if (this->mainInverter == nullptr && this->backupInverter == nullptr)
+        return;
+
+    vector<PetscInt> perm;
+    if (ordering == OptionConstants::LINEAR_SOLVER_ORDERING_RADIAL)
+        perm = this->ConstructRadialOrdering();
+
+    if (this->mainInverter != nullptr)
+        this->mainInverter->SetOrdering(perm);
+    if (this->backupInverter != nullptr)
+        this->backupInverter->SetOrdering(perm);
+}
+
+/**
+ * Construct a radius-major ordering of the rows/columns of the
+ * matrices built by this solver. In the matrices, the unknowns
+ * are laid out one after another (all of 'n_cold', then all of
+ * 'T_cold', ...), so that couplings between different unknowns
+ * at the same radius appear far from the diagonal and cause
+ * heavy fill-in in the LU factorization. In the radius-major
+ * ordering, all elements of all unknowns (including all
+ * multiples, e.g. ion charge states, and all momentum cells of
+ * kinetic quantities) at radius 'ir' are instead placed next to
+ * each other, followed by the elements at radius 'ir+1'.
+ * Unknowns living on a grid with a different number of radial
+ * points (i.e. scalar quantities) are placed last, since they
+ * typically couple to all radii.
+ *
+ * Element 'i' of the returned vector is the index in the matrix
+ * of the row/column placed in position 'i'.
+ */
+vector<PetscInt> Solver::ConstructRadialOrdering() {
+    // Number of radial points of the fluid quantities
+    len_t nr = 0;
+    for (len_t id : this->nontrivial_unknowns)
+        nr = max(nr, this->unknowns->GetUnknown(id)->GetGrid()->GetNr());
+
+    const len_t nuqn = this->nontrivial_unknowns.size();
+    vector<PetscInt> perm;
+    perm.reserve(this->matrix_size);
+
+    // Offset of each unknown in the matrix, and offset of
+    // the current radius within each (multiple of the) unknown
+    vector<len_t> offsets(nuqn), roffsets(nuqn, 0);
+    for (len_t i = 0, offs = 0; i < nuqn; i++) {
+        offsets[i] = offs;
+        offs += this->unknowns->GetUnknown(this->nontrivial_unknowns[i])->NumberOfElements();
+    }
+
+    for (len_t ir = 0; ir < nr; ir++) {
+        for (len_t i = 0; i < nuqn; i++) {
+            FVM::UnknownQuantity *uqn = this->unknowns->GetUnknown(this->nontrivial_unknowns[i]);
+            FVM::Grid *grid = uqn->GetGrid();
+            if (grid->GetNr() != nr)
+                continue;
+
+            const len_t ncells = grid->GetNCells();
+            const len_t nc = grid->GetMomentumGrid(ir)->GetNCells();
+            for (len_t m = 0; m < uqn->NumberOfMultiples(); m++)
+                for (len_t k = 0; k < nc; k++)
+                    perm.push_back(offsets[i] + m*ncells + roffsets[i] + k);
+
+            roffsets[i] += nc;
+        }
+    }
+
+    // Unknowns with a different number of radial points
+    for (len_t i = 0; i < nuqn; i++) {
+        FVM::UnknownQuantity *uqn = this->unknowns->GetUnknown(this->nontrivial_unknowns[i]);
+        if (uqn->GetGrid()->GetNr() == nr)
+            continue;
+
+        for (len_t k = 0; k < uqn->NumberOfElements(); k++)
+            perm.push_back(offsets[i] + k);
+    }
+
+    if (perm.size() != this->matrix_size)
+        throw SolverException(
+            "Radial ordering contains " LEN_T_PRINTF_FMT " elements. Expected " LEN_T_PRINTF_FMT ".",
+            (len_t)perm.size(), this->matrix_size
+        );
+
+    return perm;
+}
+
+/**
+ * Divide the non-trivial unknowns into the groups used by the
+ * field-split preconditioner of the GMRES linear solver:
+ *
+ *   field:   the electric field, currents, poloidal flux and
+ *            circuit equations, which are strongly coupled to
+ *            each other via Ohm's law and Ampère's law,
+ *   fluid:   the ion densities, temperatures and other fluid
+ *            quantities,
+ *   kinetic: the hot-tail and runaway electron distribution
+ *            functions.
+ *
+ * The field and fluid splits are small and inverted exactly,
+ * while the (large) kinetic split is inverted approximately.
+ *
+ * If 'schur' is true, the fluid and kinetic splits are merged
+ * into a single 'plasma' split. The field split is placed first,
+ * so that the field equations are eliminated and the plasma
+ * equations are solved via their Schur complement.
+ */
+vector<FVM::MIGMRES::split> Solver::ConstructFieldSplits(const bool schur) {
+    const vector<string> fieldNames = {
+        OptionConstants::UQTY_E_FIELD, OptionConstants::UQTY_I_P,
+        OptionConstants::UQTY_I_WALL, OptionConstants::UQTY_J_HOT,
+        OptionConstants::UQTY_J_OHM, OptionConstants::UQTY_J_RE,
+        OptionConstants::UQTY_J_TOT, OptionConstants::UQTY_POL_FLUX,
+        OptionConstants::UQTY_PSI_EDGE, OptionConstants::UQTY_PSI_TRANS,
+        OptionConstants::UQTY_PSI_WALL, OptionConstants::UQTY_V_LOOP_TRANS,
+        OptionConstants::UQTY_V_LOOP_WALL
+    };
+    const vector<string> kineticNames = {
+        OptionConstants::UQTY_F_HOT, OptionConstants::UQTY_F_RE
+    };
+
+    FVM::MIGMRES::split
+        field   = {"field", {}, true},
+        fluid   = {"fluid", {}, true},
+        kinetic = {"kinetic", {}, false};
+
+    for (len_t id : this->nontrivial_unknowns) {
+        const string& name = this->unknowns->GetUnknown(id)->GetName();
+
+        if (find(fieldNames.begin(), fieldNames.end(), name) != fieldNames.end())
+            field.unknowns.push_back(id);
+        else if (find(kineticNames.begin(), kineticNames.end(), name) != kineticNames.end())
+            kinetic.unknowns.push_back(id);
+        else
+            fluid.unknowns.push_back(id);
+    }
+
+    if (schur) {
+        FVM::MIGMRES::split plasma = {"plasma", fluid.unknowns, kinetic.unknowns.empty()};
+        plasma.unknowns.insert(plasma.unknowns.end(), kinetic.unknowns.begin(), kinetic.unknowns.end());
+
+        return {field, plasma};
+    } else
+        return {field, fluid, kinetic};
 }
 
 /**
@@ -395,7 +920,17 @@ void Solver::SelectLinearSolver(const len_t N) {
 FVM::MatrixInverter *Solver::ConstructLinearSolver(const len_t N, enum OptionConstants::linear_solver ls) {
     if (ls == OptionConstants::LINEAR_SOLVER_GMRES) {
        //return new FVM::MIGMRES(N, nontrivial_unknowns, unknowns, &CheckGMRESConverged, this);
-       return new FVM::MIGMRES(N, nontrivial_unknowns, unknowns, nullptr, nullptr);
+       auto gmres = new FVM::MIGMRES(N, nontrivial_unknowns, unknowns, nullptr, nullptr);
+
+       if (this->gmresPreconditioner != OptionConstants::GMRES_PRECONDITIONER_BLOCK_JACOBI) {
+           bool schur = (this->gmresPreconditioner == OptionConstants::GMRES_PRECONDITIONER_SCHUR);
+           gmres->SetFieldSplit(this->ConstructFieldSplits(schur), schur);
+       }
+
+       gmres->SetPreconditionerReuse(this->gmresMaxPCReuse, this->gmresMaxPCIterations);
+       gmres->SetKrylovRecycling(this->gmresRecycle);
+
+       return gmres;
     } else if (ls == OptionConstants::LINEAR_SOLVER_LU)
         return new FVM::MILU(N);
     else if (ls == OptionConstants::LINEAR_SOLVER_MKL) {
@@ -415,6 +950,16 @@ FVM::MatrixInverter *Solver::ConstructLinearSolver(const len_t N, enum OptionCon
             "Your version of PETSc does not include support for MUMPS. "
             "To use this linear solver you must recompile PETSc."
         );
+#endif
+    } else if (ls == OptionConstants::LINEAR_SOLVER_MIXED_PRECISION) {
+#ifdef PETSC_HAVE_MUMPS
+        return new FVM::MIMixedPrecision(N, this->mixedEpsilon, this->mixedRelTol, this->mixedMaxIter);
+#else
+        throw SolverException(
+            "Your version of PETSc does not include support for MUMPS, which is "
+            "required by the mixed-precision linear solver. To use this linear "
+            "solver you must recompile PETSc."
+        );
 #endif
     } else if (ls == OptionConstants::LINEAR_SOLVER_SUPERLU) {
 #ifdef PETSC_HAVE_SUPERLU
@@ -475,3 +1020,44 @@ void Solver::SwitchToMainInverter() {
  */
 void Solver::WriteDataSFile(SFile*, const std::string&) {}
 
+
+/**
+ * Write a list of solver statistics to a checkpoint file.
+ * Empty lists are not written.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * name: Name of variable in file.
+ * v:    List to write.
+ */
+void Solver::SaveCheckpointList(
+    SFile *sf, const std::string& name, const std::vector<len_t>& v
+) {
+    if (v.empty())
+        return;
+
+    std::vector<int64_t> w(v.begin(), v.end());
+    sf->WriteInt64List(name, w.data(), w.size());
+}
+
+/**
+ * Read a list of solver statistics written by
+ * 'SaveCheckpointList()' from a checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * name: Name of variable in file.
+ * v:    List to store data in.
+ */
+void Solver::LoadCheckpointList(
+    SFile *sf, const std::string& name, std::vector<len_t>& v
+) {
+    v.clear();
+    if (!sf->HasVariable(name))
+        return;
+
+    sfilesize_t n;
+    int64_t *w = sf->GetIntList(name, &n);
+    for (sfilesize_t i = 0; i < n; i++)
+        v.push_back((len_t)w[i]);
+
+    delete [] w;
+}
@@ -0,0 +1,523 @@
+/**
+ * Implementation of a Jacobian-free Newton-Krylov (JFNK) solver.
+ *
+ * Rather than assembling the full jacobian matrix, this solver only
+ * evaluates the action of the jacobian on a vector, J*v, using
+ * directional finite differences of the residual vector F (as built
+ * by 'Solver::BuildVector()'). The linear system J*dx = F arising in
+ * each Newton iteration is solved using GMRES, preconditioned by the
+ * LU factorization of the block-diagonal part of the jacobian (the
+ * derivative of the equation for each unknown with respect to that
+ * same unknown, as given by 'Operator::SetJacobianBlock()').
+ *
+ * Since different unknowns can differ in magnitude by many orders of
+ * magnitude, the linear system is solved for the scaled variable
+ *
+ *   y = S^-1 * dx,
+ *
+ * where S is a diagonal matrix containing a characteristic magnitude
+ * of each unknown quantity. The finite-difference step is thereby
+ * distributed evenly among all unknowns.
+ *
+ * NOTE: The diagonal preconditioner (see 'DiagonalPreconditioner')
+ * is not used by this solver; the scaling matrix S serves the same
+ * purpose.
+ */
+
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <string>
+#include <vector>
+#include "DREAM/IO.hpp"
+#include "DREAM/Solver/SolverJFNK.hpp"
+#include "DREAM/Solver/SolverNonLinear.hpp"
+
+
+using namespace DREAM;
+using namespace std;
+
+
+/**
+ * Callback used by PETSc for evaluating the action of the
+ * (scaled) jacobian on the vector 'v'.
+ */
+PetscErrorCode SolverJFNK_ApplyJacobian(Mat J, Vec v, Vec Jv) {
+    void *ctx;
+    MatShellGetContext(J, &ctx);
+    SolverJFNK *solver = (SolverJFNK*)ctx;
+
+    try {
+        solver->ApplyJacobian(v, Jv);
+    } catch (FVM::FVMException &ex) {
+        DREAM::IO::PrintError(ex.what());
+        return 1;
+    } catch (std::exception &ex) {
+        DREAM::IO::PrintError(ex.what());
+        return 1;
+    } catch (...) {
+        // Exceptions must never propagate through PETSc
+        DREAM::IO::PrintError("JFNK: Unknown exception thrown while applying the jacobian.");
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * Constructor.
+ */
+SolverJFNK::SolverJFNK(
+    FVM::UnknownQuantityHandler *unknowns,
+    vector<UnknownQuantityEquation*> *unknown_equations,
+    EquationSystem *eqsys,
+    const int_t maxiter, const real_t reltol,
+    bool verbose
+) : Solver(unknowns, unknown_equations, OptionConstants::LINEAR_SOLVER_NONE),
+    eqsys(eqsys), maxiter(maxiter), reltol(reltol), verbose(verbose) {
+
+    this->timeKeeper = new FVM::TimeKeeper("Solver JFNK");
+    this->timerTot = this->timeKeeper->AddTimer("total", "Total time");
+    this->timerRebuild = this->timeKeeper->AddTimer("rebuildtot", "Rebuild coefficients");
+    this->timerResidual = this->timeKeeper->AddTimer("residual", "Construct residual");
+    this->timerPreconditioner = this->timeKeeper->AddTimer("preconditioner", "Construct preconditioner");
+    this->timerKrylov = this->timeKeeper->AddTimer("krylov", "Krylov solve");
+}
+
+/**
+ * Destructor.
+ */
+SolverJFNK::~SolverJFNK() {
+    Deallocate();
+
+    delete this->timeKeeper;
+}
+
+/**
+ * Allocate memory for all objects used by this solver.
+ */
+void SolverJFNK::Allocate() {
+    // Block-diagonal preconditioner matrix (only the diagonal
+    // blocks are ever assembled, so we only preallocate those)
+    this->precMatrix = new FVM::BlockMatrix();
+
+    for (len_t i = 0; i < nontrivial_unknowns.size(); i++) {
+        len_t id = nontrivial_unknowns[i];
+        UnknownQuantityEquation *eqn = this->unknown_equations->at(id);
+
+        unknownToMatrixMapping[id] =
+            this->precMatrix->CreateSubEquation(eqn->NumberOfElements(), eqn->NumberOfNonZeros_jac(id), id);
+    }
+
+    this->precMatrix->ConstructSystem();
+
+    const len_t N = precMatrix->GetNRows();
+
+    // Matrix-free jacobian
+    MatCreateShell(
+        PETSC_COMM_WORLD, N, N, N, N, (void*)this, &this->jacobianShell
+    );
+    MatShellSetOperation(
+        this->jacobianShell, MATOP_MULT, (void(*)(void))SolverJFNK_ApplyJacobian
+    );
+
+    // Krylov solver
+    KSPCreate(PETSC_COMM_WORLD, &this->ksp);
+    KSPSetType(this->ksp, KSPGMRES);
+
+    PC pc;
+    KSPGetPC(this->ksp, &pc);
+    PCSetType(pc, PCLU);
+
+    VecCreateSeq(PETSC_COMM_WORLD, N, &this->petsc_F);
+    VecCreateSeq(PETSC_COMM_WORLD, N, &this->petsc_dx);
+    VecCreateSeq(PETSC_COMM_WORLD, N, &this->petsc_scale);
+
+    this->x0 = new real_t[N];
+    this->x1 = new real_t[N];
+    this->dx = new real_t[N];
+    this->xh = new real_t[N];
+    this->Fh = new real_t[N];
+    this->F0 = new real_t[N];
+    this->scale = new real_t[N];
+}
+
+/**
+ * Deallocate memory used by this solver. The PETSc destroy
+ * functions set the given objects to 'nullptr', and so may be
+ * called again (or before 'Allocate()').
+ */
+void SolverJFNK::Deallocate() {
+    KSPDestroy(&this->ksp);
+    MatDestroy(&this->jacobianShell);
+
+    if (this->precMatrix != nullptr)
+        delete this->precMatrix;
+
+    if (this->x0 != nullptr) {
+        delete [] this->x0;
+        delete [] this->x1;
+        delete [] this->dx;
+        delete [] this->xh;
+        delete [] this->Fh;
+        delete [] this->F0;
+        delete [] this->scale;
+    }
+
+    this->precMatrix = nullptr;
+    this->x0 = this->x1 = this->dx = this->xh = nullptr;
+    this->Fh = this->F0 = this->scale = nullptr;
+
+    VecDestroy(&this->petsc_F);
+    VecDestroy(&this->petsc_dx);
+    VecDestroy(&this->petsc_scale);
+}
+
+/**
+ * Initialize the solver.
+ */
+void SolverJFNK::initialize_internal(
+    const len_t, vector<len_t>&
+) {
+    this->Allocate();
+
+    if (this->convChecker == nullptr)
+        this->SetConvergenceChecker(
+            new ConvergenceChecker(unknowns, this->nontrivial_unknowns, this->reltol)
+        );
+}
+
+/**
+ * Evaluate the action of the scaled jacobian matrix on the
+ * vector 'v' using a forward finite difference:
+ *
+ *   J*S*v ~ (F(x0 + h*S*v) - F(x0)) / h
+ *
+ * The step length 'h' is chosen such that the relative
+ * perturbation of the (scaled) solution is of the order of
+ * the square root of the machine epsilon.
+ *
+ * v:  Vector to apply jacobian to.
+ * Jv: On return, contains the product J*S*v.
+ */
+void SolverJFNK::ApplyJacobian(Vec v, Vec Jv) {
+    const len_t N = this->matrix_size;
+    const real_t *vv;
+    VecGetArrayRead(v, &vv);
+
+    real_t vnorm = 0, xnorm = 0;
+    for (len_t i = 0; i < N; i++) {
+        vnorm += vv[i]*vv[i];
+        xnorm += (x0[i]/scale[i])*(x0[i]/scale[i]);
+    }
+    vnorm = sqrt(vnorm);
+    xnorm = sqrt(xnorm);
+
+    real_t *jv;
+    VecGetArray(Jv, &jv);
+
+    if (vnorm == 0) {
+        for (len_t i = 0; i < N; i++)
+            jv[i] = 0;
+
+        VecRestoreArray(Jv, &jv);
+        VecRestoreArrayRead(v, &vv);
+        return;
+    }
+
+    const real_t h = sqrt(numeric_limits<real_t>::epsilon()) * (1 + xnorm) / vnorm;
+    for (len_t i = 0; i < N; i++)
+        xh[i] = x0[i] + h*scale[i]*vv[i];
+
+    VecRestoreArrayRead(v, &vv);
+
+    this->_EvaluateF(xh, Fh);
+
+    for (len_t i = 0; i < N; i++)
+        jv[i] = (Fh[i] - F0[i]) / h;
+
+    VecRestoreArray(Jv, &jv);
+}
+
+/**
+ * Build the scaling matrix S. The scale factor of each unknown
+ * is taken as the root-mean-square of the unknown in the current
+ * solution estimate (or 1 if the unknown is identically zero).
+ */
+void SolverJFNK::BuildScaling() {
+    len_t offset = 0;
+    for (len_t id : this->nontrivial_unknowns) {
+        const len_t n = this->unknowns->GetUnknown(id)->NumberOfElements();
+
+        real_t s = 0;
+        for (len_t i = 0; i < n; i++)
+            s += x0[offset+i]*x0[offset+i];
+        s = sqrt(s/n);
+
+        if (s == 0 || !isfinite(s))
+            s = 1;
+
+        for (len_t i = 0; i < n; i++)
+            scale[offset+i] = s;
+
+        offset += n;
+    }
+
+    real_t *sv;
+    VecGetArray(this->petsc_scale, &sv);
+    for (len_t i = 0; i < this->matrix_size; i++)
+        sv[i] = scale[i];
+    VecRestoreArray(this->petsc_scale, &sv);
+}
+
+/**
+ * Evaluate the residual vector F(x).
+ *
+ * x: Solution vector to evaluate residual for.
+ * F: On return, contains the residual vector.
+ */
+void SolverJFNK::_EvaluateF(const real_t *x, real_t *F) {
+    this->unknowns->Store(this->nontrivial_unknowns, x);
+
+    this->timeKeeper->StartTimer(timerRebuild);
+    this->RebuildTerms(this->t, this->dt);
+    this->timeKeeper->StopTimer(timerRebuild);
+
+    this->timeKeeper->StartTimer(timerResidual);
+    this->BuildVector(this->t, this->dt, F, this->precMatrix);
+    this->timeKeeper->StopTimer(timerResidual);
+}
+
+/**
+ * Check if the solver has converged.
+ */
+bool SolverJFNK::IsConverged(const real_t *x, const real_t *dx) {
+    if (this->GetIteration() >= this->MaxIter()) {
+        throw SolverException(
+            "JFNK solver reached the maximum number of allowed "
+            "iterations: " LEN_T_PRINTF_FMT ".",
+            this->MaxIter()
+        );
+    }
+
+    if (this->Verbose())
+        DREAM::IO::PrintInfo("ITERATION %d", this->GetIteration());
+
+    return convChecker->IsConverged(x, dx, this->Verbose());
+}
+
+/**
+ * Set the initial guess for the solver.
+ *
+ * guess: Vector containing values of initial guess.
+ */
+void SolverJFNK::SetInitialGuess(const real_t *guess) {
+    if (guess != nullptr) {
+        for (len_t i = 0; i < this->matrix_size; i++)
+            this->x0[i] = guess[i];
+    } else {
+        for (len_t i = 0; i < this->matrix_size; i++)
+            this->x0[i] = 0;
+    }
+}
+
+/**
+ * Solve the equation system (advance the system in time
+ * by one step).
+ *
+ * t:  Time at which the current solution is given.
+ * dt: Time step to take.
+ *
+ * (the obtained solution will correspond to time t'=t+dt)
+ */
+void SolverJFNK::Solve(const real_t t, const real_t dt) {
+    this->nTimeStep++;
+    this->nKrylovIterationsStep = 0;
+
+    this->t  = t;
+    this->dt = dt;
+
+    this->timeKeeper->StartTimer(timerTot);
+
+    this->_InternalSolve();
+
+    // Save basic statistics for step
+    this->nIterations.push_back(this->iteration);
+    this->nKrylovIterations.push_back(this->nKrylovIterationsStep);
+
+    this->timeKeeper->StopTimer(timerTot);
+}
+
+void SolverJFNK::_InternalSolve() {
+    // Take Newton steps
+    this->iteration = 0;
+    const real_t *x, *dx;
+    do {
+        this->iteration++;
+
+        dx = this->TakeNewtonStep();
+        x  = this->UpdateSolution(dx);
+
+        // Accept solution
+        real_t *tmp = this->x1;
+        this->x1 = this->x0;
+        this->x0 = tmp;
+
+        this->unknowns->Store(this->nontrivial_unknowns, x);
+    } while (!IsConverged(x, dx));
+}
+
+/**
+ * Calculate the next Newton step to take.
+ */
+const real_t *SolverJFNK::TakeNewtonStep() {
+    // Residual in the current point
+    this->_EvaluateF(this->x0, this->F0);
+
+    real_t *fvec;
+    VecGetArray(this->petsc_F, &fvec);
+    for (len_t i = 0; i < this->matrix_size; i++)
+        fvec[i] = this->F0[i];
+    VecRestoreArray(this->petsc_F, &fvec);
+
+    // Build (scaled) block-diagonal preconditioner
+    this->timeKeeper->StartTimer(timerPreconditioner);
+    this->BuildScaling();
+    this->BuildJacobianDiagonalBlocks(this->precMatrix);
+    MatDiagonalScale(this->precMatrix->mat(), nullptr, this->petsc_scale);
+    this->timeKeeper->StopTimer(timerPreconditioner);
+
+    // Solve (J*S)*y = F
+    this->timeKeeper->StartTimer(timerKrylov);
+    KSPSetTolerances(this->ksp, this->kspRelTol, PETSC_DEFAULT, PETSC_DEFAULT, this->kspMaxIter);
+    KSPSetOperators(this->ksp, this->jacobianShell, this->precMatrix->mat());
+    PetscErrorCode ierr = KSPSolve(this->ksp, this->petsc_F, this->petsc_dx);
+    this->timeKeeper->StopTimer(timerKrylov);
+
+    // The jacobian-vector products leave the unknowns (and equation
+    // terms) at the last perturbed point x0 + h*S*v, so we restore
+    // the state of the current iterate before proceeding
+    this->unknowns->Store(this->nontrivial_unknowns, this->x0);
+    this->timeKeeper->StartTimer(timerRebuild);
+    this->RebuildTerms(this->t, this->dt);
+    this->timeKeeper->StopTimer(timerRebuild);
+
+    if (ierr)
+        throw SolverException("JFNK: Failed to solve linear system in Newton iteration.");
+
+    KSPConvergedReason reason;
+    KSPGetConvergedReason(this->ksp, &reason);
+    PetscInt its;
+    KSPGetIterationNumber(this->ksp, &its);
+    this->nKrylovIterationsStep += its;
+
+    // An inexact Newton step is acceptable if GMRES only ran
+    // out of iterations; any other failure is fatal
+    if (reason == KSP_DIVERGED_ITS) {
+        if (this->Verbose())
+            DREAM::IO::PrintInfo("GMRES did not converge in " LEN_T_PRINTF_FMT " iterations.", this->kspMaxIter);
+    } else if (reason < 0)
+        throw SolverException(
+            "JFNK: GMRES failed to converge. Reason: %d.", (int)reason
+        );
+
+    // Undo scaling: dx = S*y
+    VecGetArray(this->petsc_dx, &fvec);
+    for (len_t i = 0; i < this->matrix_size; i++)
+        this->dx[i] = this->scale[i] * fvec[i];
+    VecRestoreArray(this->petsc_dx, &fvec);
+
+    return this->dx;
+}
+
+/**
+ * Update the current solution with the Newton step 'dx'.
+ *
+ * dx: Newton step to take.
+ */
+const real_t *SolverJFNK::UpdateSolution(const real_t *dx) {
+    len_t id_uqn;
+    real_t dampingFactor = MaximalPhysicalStepLength(x0,dx,iteration,nontrivial_unknowns,unknowns,ionHandler,id_uqn);
+
+    if (dampingFactor < 1 && this->Verbose()) {
+        DREAM::IO::PrintInfo();
+        DREAM::IO::PrintInfo("Newton iteration dynamically damped for unknown quantity: %s",unknowns->GetUnknown(id_uqn)->GetName().c_str());
+        DREAM::IO::PrintInfo("to conserve positivity, by a factor: %e", dampingFactor);
+        DREAM::IO::PrintInfo();
+    }
+
+    for (len_t i = 0; i < this->matrix_size; i++)
+        this->x1[i] = this->x0[i] - dampingFactor*dx[i];
+
+    return this->x1;
+}
+
+/**
+ * Print timing information after the solve.
+ */
+void SolverJFNK::PrintTimings() {
+    this->timeKeeper->PrintTimings(true, 0);
+    this->Solver::PrintTimings_rebuild();
+}
+
+/**
+ * Save timing information to the given SFile object.
+ *
+ * sf:   SFile object to save timing information to.
+ * path: Path in file to save timing information to.
+ */
+void SolverJFNK::SaveTimings(SFile *sf, const string& path) {
+    this->timeKeeper->SaveTimings(sf, path);
+
+    sf->CreateStruct(path+"/rebuild");
+    this->Solver::SaveTimings_rebuild(sf, path+"/rebuild");
+}
+
+/**
+ * Write basic data from the solver to the output file.
+ * This data is mainly statistics about the solution.
+ *
+ * sf:   SFile object to use for writing.
+ * name: Name of group within file to store data in.
+ */
+void SolverJFNK::WriteDataSFile(SFile *sf, const std::string& name) {
+    sf->CreateStruct(name);
+
+    int32_t type = (int32_t)OptionConstants::SOLVER_TYPE_JFNK;
+    sf->WriteList(name+"/type", &type, 1);
+
+    // Number of Newton iterations per time step
+    sf->WriteList(name+"/iterations", this->nIterations.data(), this->nIterations.size());
+
+    // Total number of Krylov iterations per time step
+    sf->WriteList(name+"/kspiterations", this->nKrylovIterations.data(), this->nKrylovIterations.size());
+}
+
+/**
+ * Write the solver statistics collected so far to the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void SolverJFNK::SaveCheckpoint(SFile *sf, const std::string& path) {
+    this->SaveCheckpointList(sf, path+"/iterations", this->nIterations);
+    this->SaveCheckpointList(sf, path+"/kspiterations", this->nKrylovIterations);
+    this->SaveCheckpointList(sf, path+"/ntimestep", {this->nTimeStep});
+}
+
+/**
+ * Restore the solver statistics from the given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void SolverJFNK::LoadCheckpoint(SFile *sf, const std::string& path) {
+    this->LoadCheckpointList(sf, path+"/iterations", this->nIterations);
+    this->LoadCheckpointList(sf, path+"/kspiterations", this->nKrylovIterations);
+
+    std::vector<len_t> nts;
+    this->LoadCheckpointList(sf, path+"/ntimestep", nts);
+    this->nTimeStep = (nts.empty() ? 0 : nts[0]);
+}
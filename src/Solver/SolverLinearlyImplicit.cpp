@@ -273,3 +273,25 @@ void SolverLinearlyImplicit::WriteDataSFile(SFile *sf, const std::string &name)
     sf->WriteList(name+"/type", &type, 1);
 }
 
+/**
+ * Write the solver statistics collected so far to the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void SolverLinearlyImplicit::SaveCheckpoint(SFile *sf, const std::string& path) {
+    this->SaveCheckpointList(sf, path+"/ntimestep", {this->nTimeStep});
+}
+
+/**
+ * Restore the solver statistics from the given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void SolverLinearlyImplicit::LoadCheckpoint(SFile *sf, const std::string& path) {
+    std::vector<len_t> nts;
+    this->LoadCheckpointList(sf, path+"/ntimestep", nts);
+    this->nTimeStep = (nts.empty() ? 0 : nts[0]);
+}
@@ -2,6 +2,8 @@
  * Implementation of a custom Newton solver which only utilizes
  * the linear solvers of PETSc.
  */
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <string>
@@ -80,6 +82,10 @@ void SolverNonLinear::Allocate() {
 
 	this->x_2norm  = new real_t[this->unknown_equations->size()];
 	this->dx_2norm = new real_t[this->unknown_equations->size()];
+
+    this->Ftrial = new real_t[N];
+    this->F0_2norm = new real_t[this->unknown_equations->size()];
+    this->Ftrial_2norm = new real_t[this->unknown_equations->size()];
 }
 
 /**
@@ -106,17 +112,32 @@ void SolverNonLinear::Allocate() {
 void SolverNonLinear::AllocateJacobianMatrix() {
     if (this->jacobian != nullptr)
         delete this->jacobian;
-	this->jacobian = new FVM::BlockMatrix();
+	this->jacobian = ConstructJacobianMatrix();
+
+    // The non-zero pattern used for evaluating the jacobian
+    // numerically must be rebuilt for the new matrix
+    this->numjacGroups.clear();
+}
+
+/**
+ * Construct a new block matrix with the structure of the
+ * jacobian matrix, preallocated for the number of non-zero
+ * elements given by the equations of the system.
+ */
+FVM::BlockMatrix *SolverNonLinear::ConstructJacobianMatrix() {
+	FVM::BlockMatrix *jac = new FVM::BlockMatrix();
 
 	for (len_t i = 0; i < nontrivial_unknowns.size(); i++) {
 		len_t id = nontrivial_unknowns[i];
 		UnknownQuantityEquation *eqn = this->unknown_equations->at(id);
 
 		unknownToMatrixMapping[id] =
-			this->jacobian->CreateSubEquation(eqn->NumberOfElements(), eqn->NumberOfNonZeros_jac(), id);
+			jac->CreateSubEquation(eqn->NumberOfElements(), eqn->NumberOfNonZeros_jac(), id);
 	}
 
-	this->jacobian->ConstructSystem();
+	jac->ConstructSystem();
+
+    return jac;
 }
 
 /**
@@ -132,6 +153,10 @@ void SolverNonLinear::Deallocate() {
 	delete [] this->x_2norm;
 	delete [] this->dx_2norm;
 
+    delete [] this->Ftrial;
+    delete [] this->F0_2norm;
+    delete [] this->Ftrial_2norm;
+
 	delete [] this->x0;
 	delete [] this->x1;
 	delete [] this->dx;
@@ -205,6 +230,7 @@ void SolverNonLinear::SetInitialGuess(const real_t *guess) {
  * Revert the solution to the initial guess.
  */
 void SolverNonLinear::ResetSolution() {
+    this->residualValid = false;
     this->unknowns->GetLongVectorPrevious(this->nontrivial_unknowns, this->x0);
 	this->StoreSolution(this->x0);
 }
@@ -224,12 +250,20 @@ void SolverNonLinear::Solve(const real_t t, const real_t dt) {
     this->SwitchToMainInverter();
 
     this->nTimeStep++;
+    this->nJacobiansStep = 0;
+    this->nBacktracksStep = 0;
+    this->minStepLengthStep = 1;
+    this->residualValid = false;
+    this->convChecker->ResetConvergenceRate();
 
 	this->t  = t;
 	this->dt = dt;
 
     this->timeKeeper->StartTimer(timerTot);
 
+    if (this->predictor != OptionConstants::SOLVER_PREDICTOR_NONE)
+        this->predictorOrder.push_back(this->Predict());
+
 	try {
         this->_InternalSolve();
     } catch (FVM::FVMException &ex) {
@@ -251,11 +285,106 @@ void SolverNonLinear::Solve(const real_t t, const real_t dt) {
 
     // Save basic statistics for step
     this->nIterations.push_back(this->iteration);
+    this->nJacobians.push_back(this->nJacobiansStep);
     this->usedBackupInverter.push_back(this->inverter == this->backupInverter);
+    this->nBacktracks.push_back(this->nBacktracksStep);
+    this->minStepLength.push_back(this->minStepLengthStep);
 
     this->timeKeeper->StopTimer(timerTot);
 }
 
+/**
+ * Form the initial guess for the Newton iteration by extrapolating
+ * the solutions of the previous time steps to the time 't+dt'. The
+ * extrapolating polynomial is linear or quadratic in time (depending
+ * on the selected predictor), and its order is reduced if the history
+ * does not contain enough time steps. The extrapolated change of the
+ * solution is limited in the same way as a Newton step (see
+ * 'MaximalPhysicalStepLength()') so that positive quantities remain
+ * positive.
+ *
+ * Returns the order of the extrapolation which was used (0 if the
+ * solver starts from the solution of the previous time step).
+ */
+len_t SolverNonLinear::Predict() {
+    const len_t nOld = this->unknowns->GetNOldSteps(this->nontrivial_unknowns);
+    len_t order = min(
+        (len_t)(this->predictor - OptionConstants::SOLVER_PREDICTOR_NONE),
+        (nOld > 0 ? nOld-1 : 0)
+    );
+
+    if (order == 0)
+        return 0;
+
+    // Time of each solution in the history (all unknowns are saved
+    // at the same times)
+    FVM::UnknownQuantity *uqn = this->unknowns->GetUnknown(this->nontrivial_unknowns[0]);
+    real_t tk[3];
+    for (len_t k = 0; k <= order; k++)
+        tk[k] = uqn->GetOldTime(k);
+
+    // Reduce order if time steps coincide (e.g. after a restart)
+    for (len_t k = 1; k <= order; k++) {
+        if (tk[k] >= tk[k-1]) {
+            order = k-1;
+            break;
+        }
+    }
+
+    if (order == 0)
+        return 0;
+
+    // Lagrange weights of the previous solutions at t+dt
+    const real_t tn = this->t + this->dt;
+    real_t l[3];
+    for (len_t j = 0; j <= order; j++) {
+        l[j] = 1;
+        for (len_t m = 0; m <= order; m++)
+            if (m != j)
+                l[j] *= (tn - tk[m]) / (tk[j] - tk[m]);
+    }
+
+    // Since the weights sum to one, the change relative to the most
+    // recent solution is
+    //   x0 - x_pred = sum_{j>0} l_j (x0 - x_j)
+    // (which is computed with the sign convention of a Newton step)
+    this->unknowns->GetLongVectorOld(this->nontrivial_unknowns, 0, this->x0);
+    for (len_t i = 0; i < this->matrix_size; i++)
+        this->dx[i] = 0;
+
+    for (len_t j = 1; j <= order; j++) {
+        this->unknowns->GetLongVectorOld(this->nontrivial_unknowns, j, this->x1);
+        for (len_t i = 0; i < this->matrix_size; i++)
+            this->dx[i] += l[j] * (this->x0[i] - this->x1[i]);
+    }
+
+    for (len_t i = 0; i < this->matrix_size; i++) {
+        if (!isfinite(this->dx[i])) {
+            this->StoreSolution(this->x0);
+            return 0;
+        }
+    }
+
+    len_t id_uqn;
+    real_t damping = MaximalPhysicalStepLength(
+        this->x0, this->dx, 0, this->nontrivial_unknowns,
+        this->unknowns, this->ionHandler, id_uqn
+    );
+
+    if (damping < 1 && this->Verbose())
+        DREAM::IO::PrintInfo(
+            "Predictor limited by a factor %e to conserve positivity of unknown quantity: %s",
+            damping, this->unknowns->GetUnknown(id_uqn)->GetName().c_str()
+        );
+
+    for (len_t i = 0; i < this->matrix_size; i++)
+        this->x0[i] -= damping*this->dx[i];
+
+    this->StoreSolution(this->x0);
+
+    return order;
+}
+
 void SolverNonLinear::_InternalSolve() {
 	// Take Newton steps
 	len_t iter = 0;
@@ -276,7 +405,8 @@ REDO_ITER:
 
 		x  = UpdateSolution(dx);
 
-		// TODO backtracking...
+        if (this->lineSearch)
+            x = LineSearch(dx);
 		
 		AcceptSolution();
 	} while (!IsConverged(x, dx));
@@ -294,7 +424,7 @@ REDO_ITER:
  * name: Base name to use for files.
  */
 void SolverNonLinear::SaveNumericalJacobian(const std::string& name) {
-    this->_EvaluateJacobianNumerically(this->jacobian);
+    this->_EvaluateJacobianNumerically(this->jacobian, true);
     this->jacobian->View(FVM::Matrix::BINARY_MATLAB, name + "_num");
     abort();
 }
@@ -317,17 +447,35 @@ void SolverNonLinear::StoreSolution(const real_t *x) {
  * Calculate the next Newton step to take.
  */
 const real_t *SolverNonLinear::TakeNewtonStep() {
-    this->timeKeeper->StartTimer(timerRebuild);
-	this->RebuildTerms(this->t, this->dt);
-    this->timeKeeper->StopTimer(timerRebuild);
-
-	// Evaluate function vector
-    this->timeKeeper->StartTimer(timerResidual);
 	real_t *fvec;
-	VecGetArray(this->petsc_F, &fvec);
-	this->BuildVector(this->t, this->dt, fvec, this->jacobian);
-	VecRestoreArray(this->petsc_F, &fvec);
-    this->timeKeeper->StopTimer(timerResidual);
+    if (this->residualValid) {
+        // Terms and residual were already evaluated in
+        // this point by the line search
+        VecGetArray(this->petsc_F, &fvec);
+        for (len_t i = 0; i < this->matrix_size; i++)
+            fvec[i] = this->Ftrial[i];
+        VecRestoreArray(this->petsc_F, &fvec);
+
+        this->residualValid = false;
+    } else {
+        this->timeKeeper->StartTimer(timerRebuild);
+        this->RebuildTerms(this->t, this->dt);
+        this->timeKeeper->StopTimer(timerRebuild);
+
+        // Evaluate function vector
+        this->timeKeeper->StartTimer(timerResidual);
+        VecGetArray(this->petsc_F, &fvec);
+        this->BuildVector(this->t, this->dt, fvec, this->jacobian);
+        VecRestoreArray(this->petsc_F, &fvec);
+        this->timeKeeper->StopTimer(timerResidual);
+    }
+
+    // Residual norms (before preconditioning) used by the line search
+    if (this->lineSearch) {
+        VecGetArray(this->petsc_F, &fvec);
+        this->CalculateNonTrivial2Norm(fvec, this->F0_2norm);
+        VecRestoreArray(this->petsc_F, &fvec);
+    }
     
     // Reconstruct the jacobian matrix after taking the first
     // iteration.
@@ -336,28 +484,49 @@ const real_t *SolverNonLinear::TakeNewtonStep() {
     if (this->nTimeStep == 1 && this->iteration == 2)
         this->AllocateJacobianMatrix();
 
-	// Evaluate jacobian
-    this->timeKeeper->StartTimer(timerJacobian);
-	this->BuildJacobian(this->t, this->dt, this->jacobian);
-    this->timeKeeper->StopTimer(timerJacobian);
+	// Evaluate jacobian (unless the factorization of
+    // a previous jacobian can be reused)
+    bool lagJacobian = this->UseLaggedJacobian();
+    if (lagJacobian) {
+        this->jacobianAge++;
+
+        if (this->Verbose())
+            DREAM::IO::PrintInfo("Reusing jacobian factorization (age " LEN_T_PRINTF_FMT ")", this->jacobianAge);
+    } else {
+        this->timeKeeper->StartTimer(timerJacobian);
+        if (this->jacobianMode == OptionConstants::SOLVER_JACOBIAN_NUMERICAL)
+            this->_EvaluateJacobianNumerically(this->jacobian);
+        else
+            this->BuildJacobian(this->t, this->dt, this->jacobian);
+        this->timeKeeper->StopTimer(timerJacobian);
+
+        this->jacobianAge = 0;
+        this->jacobianDt = this->dt;
+        this->factorizedInverter = this->inverter;
+        this->nJacobiansStep++;
+    }
 
     // Print/save debug info and apply preconditioner (if enabled)
+    // (a reused jacobian has already been preconditioned)
+    FVM::Matrix *precMat = (lagJacobian ? nullptr : this->jacobian);
     if (this->debugrescaled) {
-        this->Precondition(this->jacobian, this->petsc_F);
+        this->Precondition(precMat, this->petsc_F);
         this->SaveDebugInfoBefore(this->nTimeStep, this->iteration);
     } else {
         this->SaveDebugInfoBefore(this->nTimeStep, this->iteration);
-        this->Precondition(this->jacobian, this->petsc_F);
+        this->Precondition(precMat, this->petsc_F);
     }
 
 	// Solve J*dx = F
     this->timeKeeper->StartTimer(timerInvert);
+    inverter->SetReuseFactorization(lagJacobian);
     inverter->Invert(this->jacobian, &this->petsc_F, &this->petsc_dx);
 
     if (inverter->GetReturnCode() != 0) {
         if (this->Verbose())
             DREAM::IO::PrintInfo("Switching to backup inverter... " INT_T_PRINTF_FMT, inverter->GetReturnCode());
 
+        this->factorizedInverter = nullptr;
         this->SwitchToBackupInverter();
 
         return nullptr;
@@ -384,6 +553,145 @@ const real_t *SolverNonLinear::TakeNewtonStep() {
 }
 
 
+/**
+ * Returns true if the factorization of the most recently built
+ * jacobian matrix should be reused in this iteration (modified
+ * Newton), instead of building and factorizing a new jacobian.
+ * The jacobian is rebuilt if
+ *
+ *   - jacobian lagging is disabled, or not supported by the inverter,
+ *   - the jacobian matrix has just been (re)allocated,
+ *   - the inverter or the time step has changed since the jacobian
+ *     was last built,
+ *   - the jacobian has already been reused 'maxJacobianLag' times, or
+ *   - the convergence rate (as measured by the ConvergenceChecker)
+ *     has degraded beyond 'maxLagRate'.
+ */
+bool SolverNonLinear::UseLaggedJacobian() {
+    if (this->maxJacobianLag == 0 || !this->inverter->SupportsFactorizationReuse())
+        return false;
+
+    // Jacobian matrix is (re)allocated in the first two iterations
+    // (see 'AllocateJacobianMatrix()')
+    if (this->nTimeStep == 1 && this->iteration <= 2)
+        return false;
+
+    if (this->inverter != this->factorizedInverter || this->dt != this->jacobianDt)
+        return false;
+
+    if (this->jacobianAge >= this->maxJacobianLag)
+        return false;
+
+    return (this->convChecker->GetConvergenceRate() <= this->maxLagRate);
+}
+
+/**
+ * Backtracking line search along the Newton step 'dx'. Starting
+ * from the step length given by 'MaximalPhysicalStepLength()', the
+ * step is shortened until the residual merit function
+ *
+ *   phi(lambda) = sum_n ( |F_n(x0 - lambda*dx)| / |F_n(x0)| )^2
+ *
+ * (where the sum runs over the non-trivial unknowns 'n') satisfies
+ * the Armijo condition phi(lambda) <= (1 - 2*c*lambda) phi(0). The
+ * weights make the merit function insensitive to the very different
+ * scales of the equations, while keeping the Newton step a descent
+ * direction. New step lengths are obtained by minimizing a quadratic
+ * model of phi, safeguarded to [0.1, 0.5] times the previous step.
+ *
+ * If no acceptable step is found within 'MAX_BACKTRACKS' reductions,
+ * the shortest step is taken and the jacobian is rebuilt in the
+ * next iteration (in case a lagged jacobian was used).
+ *
+ * The equation terms are left rebuilt in the accepted point, so
+ * that the residual can be reused in the next Newton iteration.
+ *
+ * dx: Newton step.
+ */
+const real_t *SolverNonLinear::LineSearch(const real_t *dx) {
+    real_t lambda = this->physicalDamping;
+    const real_t phi0 = this->ResidualMerit(nullptr);
+
+    // Residual already satisfied (nothing to improve upon)
+    if (phi0 == 0)
+        return this->x1;
+
+    for (len_t k = 0;; k++) {
+        // Evaluate residual in the trial point
+        this->StoreSolution(this->x1);
+
+        this->timeKeeper->StartTimer(timerRebuild);
+        this->RebuildTerms(this->t, this->dt);
+        this->timeKeeper->StopTimer(timerRebuild);
+
+        this->timeKeeper->StartTimer(timerResidual);
+        this->BuildVector(this->t, this->dt, this->Ftrial, this->jacobian);
+        this->timeKeeper->StopTimer(timerResidual);
+
+        const real_t phi = this->ResidualMerit(this->Ftrial);
+        if (phi <= (1 - 2*ARMIJO_C*lambda)*phi0)
+            break;
+
+        if (k == MAX_BACKTRACKS) {
+            if (this->Verbose())
+                DREAM::IO::PrintInfo("Line search failed to reduce the residual. Taking step of length %e.", lambda);
+
+            // Force rebuild of the jacobian
+            this->jacobianAge = this->maxJacobianLag;
+            break;
+        }
+
+        // Minimize quadratic model of phi (with phi'(0) = -2*phi0)
+        real_t lnew;
+        if (isfinite(phi))
+            lnew = phi0*lambda*lambda / (phi - phi0 + 2*phi0*lambda);
+        else
+            lnew = 0.5*lambda;
+
+        lambda = max(0.1*lambda, min(0.5*lambda, lnew));
+
+        for (len_t i = 0; i < this->matrix_size; i++)
+            this->x1[i] = this->x0[i] - lambda*dx[i];
+
+        this->nBacktracksStep++;
+    }
+
+    if (lambda < 1 && this->Verbose())
+        DREAM::IO::PrintInfo("Line search step length: %e", lambda);
+
+    this->minStepLengthStep = min(this->minStepLengthStep, lambda);
+    this->residualValid = true;
+
+    return this->x1;
+}
+
+/**
+ * Evaluate the merit function used by the line search for the
+ * given residual vector (see 'LineSearch()'). Unknowns for which
+ * the residual vanishes in the current point do not contribute.
+ *
+ * F: Residual vector to evaluate merit function for. If 'nullptr',
+ *    the merit function is evaluated for the residual in the
+ *    current point (which is always equal to the number of unknowns
+ *    with a non-zero residual).
+ */
+real_t SolverNonLinear::ResidualMerit(const real_t *F) {
+    const len_t N = this->nontrivial_unknowns.size();
+
+    if (F != nullptr)
+        this->CalculateNonTrivial2Norm(F, this->Ftrial_2norm);
+
+    real_t phi = 0;
+    for (len_t i = 0; i < N; i++) {
+        if (this->F0_2norm[i] == 0)
+            continue;
+
+        real_t r = (F == nullptr ? 1 : this->Ftrial_2norm[i] / this->F0_2norm[i]);
+        phi += r*r;
+    }
+
+    return phi;
+}
 
 /**
  * Helper function to damping factor calculation; given a quantity
@@ -497,6 +805,7 @@ const real_t MaximalPhysicalStepLength(real_t *x0, const real_t *dx, len_t itera
 const real_t *SolverNonLinear::UpdateSolution(const real_t *dx) {
     len_t id_uqn;
 	real_t dampingFactor = MaximalPhysicalStepLength(x0,dx,iteration,nontrivial_unknowns,unknowns,ionHandler,id_uqn);
+    this->physicalDamping = dampingFactor;
 	
 	if(dampingFactor < 1 && this->Verbose()) {
         DREAM::IO::PrintInfo();
@@ -699,6 +1008,9 @@ void SolverNonLinear::WriteDataSFile(SFile *sf, const std::string& name) {
     // Number of iterations per time step
     sf->WriteList(name+"/iterations", this->nIterations.data(), this->nIterations.size());
 
+    // Number of jacobian evaluations per time step
+    sf->WriteList(name+"/jacobians", this->nJacobians.data(), this->nJacobians.size());
+
     // Whether or not backup inverter was used for a given time step
     len_t nubi = this->usedBackupInverter.size();
     int32_t *ubi = new int32_t[nubi];
@@ -707,5 +1019,70 @@ void SolverNonLinear::WriteDataSFile(SFile *sf, const std::string& name) {
 
     sf->WriteList(name+"/backupinverter", ubi, nubi);
     delete [] ubi;
+
+    if (this->lineSearch) {
+        // Number of step reductions made by the line search per time step
+        sf->WriteList(name+"/backtracks", this->nBacktracks.data(), this->nBacktracks.size());
+        // Shortest step length accepted in each time step
+        sf->WriteList(name+"/minsteplength", this->minStepLength.data(), this->minStepLength.size());
+    }
+
+    // Order of the extrapolation used for the initial guess in each
+    // time step (the number of iterations saved by the predictor can
+    // be assessed by comparing 'iterations' with a run without it)
+    if (this->predictor != OptionConstants::SOLVER_PREDICTOR_NONE)
+        sf->WriteList(name+"/predictororder", this->predictorOrder.data(), this->predictorOrder.size());
+}
+
+
+/**
+ * Write the solver statistics collected so far to the given
+ * checkpoint file. The factorization of the jacobian matrix is
+ * not saved, so after a restart the jacobian is always rebuilt
+ * in the first iteration.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void SolverNonLinear::SaveCheckpoint(SFile *sf, const std::string& path) {
+    this->SaveCheckpointList(sf, path+"/iterations", this->nIterations);
+    this->SaveCheckpointList(sf, path+"/jacobians", this->nJacobians);
+    this->SaveCheckpointList(sf, path+"/backtracks", this->nBacktracks);
+    this->SaveCheckpointList(sf, path+"/predictororder", this->predictorOrder);
+    this->SaveCheckpointList(sf, path+"/ntimestep", {this->nTimeStep});
+
+    std::vector<len_t> ubi(this->usedBackupInverter.begin(), this->usedBackupInverter.end());
+    this->SaveCheckpointList(sf, path+"/backupinverter", ubi);
+
+    if (!this->minStepLength.empty())
+        sf->WriteList(path+"/minsteplength", this->minStepLength.data(), this->minStepLength.size());
 }
 
+/**
+ * Restore the solver statistics from the given checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void SolverNonLinear::LoadCheckpoint(SFile *sf, const std::string& path) {
+    this->LoadCheckpointList(sf, path+"/iterations", this->nIterations);
+    this->LoadCheckpointList(sf, path+"/jacobians", this->nJacobians);
+    this->LoadCheckpointList(sf, path+"/backtracks", this->nBacktracks);
+    this->LoadCheckpointList(sf, path+"/predictororder", this->predictorOrder);
+
+    std::vector<len_t> nts;
+    this->LoadCheckpointList(sf, path+"/ntimestep", nts);
+    this->nTimeStep = (nts.empty() ? 0 : nts[0]);
+
+    std::vector<len_t> ubi;
+    this->LoadCheckpointList(sf, path+"/backupinverter", ubi);
+    this->usedBackupInverter.assign(ubi.begin(), ubi.end());
+
+    this->minStepLength.clear();
+    if (sf->HasVariable(path+"/minsteplength")) {
+        sfilesize_t n;
+        real_t *v = sf->GetList(path+"/minsteplength", &n);
+        this->minStepLength.assign(v, v+n);
+        delete [] v;
+    }
+}
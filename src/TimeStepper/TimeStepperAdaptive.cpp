@@ -498,3 +498,71 @@ bool TimeStepperAdaptive::UpdateStep() {
     return converged;
 }
 
+
+/**
+ * Returns 'true' if the stepper is in a state which can be
+ * written to a checkpoint, i.e. if the most recent step
+ * completed a time step (rather than a half step or a step
+ * which must be redone).
+ */
+bool TimeStepperAdaptive::CanCheckpoint() {
+    return this->IsSaveStep();
+}
+
+/**
+ * Write the state of this time stepper to the given
+ * checkpoint file. This should only be called when
+ * 'CanCheckpoint()' returns 'true', in which case the
+ * temporary solution vectors need not be saved.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void TimeStepperAdaptive::SaveCheckpoint(SFile *sf, const std::string& path) {
+    sf->WriteScalar(path + "/currentTime", this->currentTime);
+    sf->WriteScalar(path + "/initTime", this->initTime);
+    sf->WriteScalar(path + "/dt", this->dt);
+    sf->WriteScalar(path + "/oldDt", this->oldDt);
+    sf->WriteScalar(path + "/oldMaxErr", this->oldMaxErr);
+
+    int64_t state[3] = {
+        (int64_t)this->currentStep,
+        (int64_t)this->stepsSinceCheck,
+        (int64_t)this->currentStage
+    };
+    sf->WriteInt64List(path + "/state", state, 3);
+}
+
+/**
+ * Restore the state of this time stepper from the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void TimeStepperAdaptive::LoadCheckpoint(SFile *sf, const std::string& path) {
+    sfilesize_t n;
+    int64_t *state = sf->GetIntList(path + "/state", &n);
+    if (n != 3) {
+        delete [] state;
+        throw TimeStepperException(
+            "TimeStepperAdaptive: Invalid time stepper state in checkpoint file '%s'.",
+            sf->filename.c_str()
+        );
+    }
+
+    this->currentStep     = (len_t)state[0];
+    this->stepsSinceCheck = (len_t)state[1];
+    this->currentStage    = (ts_stage)state[2];
+    delete [] state;
+
+    this->currentTime = sf->GetScalar(path + "/currentTime");
+    this->initTime    = sf->GetScalar(path + "/initTime");
+    this->dt          = sf->GetScalar(path + "/dt");
+    this->oldDt       = sf->GetScalar(path + "/oldDt");
+    this->oldMaxErr   = sf->GetScalar(path + "/oldMaxErr");
+
+    // The checkpoint was written after a successful step
+    this->stepSucceeded = true;
+    this->stepsWithException = 0;
+}
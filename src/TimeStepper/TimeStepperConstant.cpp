@@ -108,3 +108,41 @@ void TimeStepperConstant::PrintProgress() {
  */
 void TimeStepperConstant::ValidateStep() {
 }
+
+/**
+ * Write the state of this time stepper to the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void TimeStepperConstant::SaveCheckpoint(SFile *sf, const std::string& path) {
+    int64_t idx[2] = {(int64_t)this->tIndex, (int64_t)this->nextSaveStep_l};
+    sf->WriteInt64List(path + "/tIndex", idx, 2);
+    sf->WriteScalar(path + "/nextSaveStep", this->nextSaveStep);
+}
+
+/**
+ * Restore the state of this time stepper from the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void TimeStepperConstant::LoadCheckpoint(SFile *sf, const std::string& path) {
+    sfilesize_t n;
+    int64_t *idx = sf->GetIntList(path + "/tIndex", &n);
+    if (n != 2) {
+        delete [] idx;
+        throw TimeStepperException(
+            "TimeStepperConstant: Invalid time stepper state in checkpoint file '%s'.",
+            sf->filename.c_str()
+        );
+    }
+
+    this->tIndex = (len_t)idx[0];
+    this->nextSaveStep_l = (len_t)idx[1];
+    this->nextSaveStep = sf->GetScalar(path + "/nextSaveStep");
+
+    delete [] idx;
+}
@@ -0,0 +1,419 @@
+/**
+ * Implementation of an adaptive time stepper for DREAM which estimates
+ * the local error of each time step using an embedded estimate.
+ *
+ * DREAM advances the system using the backward Euler (BDF1) method. After
+ * each step, the solution x_{n+1} is compared to the linear extrapolation
+ *
+ *   x^P = x_n + (dt/dt_old) * (x_n - x_{n-1})
+ *
+ * of the two previously accepted solutions (which are kept in the history of
+ * each 'QuantityData' object). To leading order, the error of the backward
+ * Euler step is (dt^2/2) x'' while that of the extrapolation is
+ * -dt*(dt+dt_old)/2 x'', and so the local truncation error of the backward
+ * Euler step is
+ *
+ *   err = dt/(2*dt+dt_old) * (x_{n+1} - x^P).
+ *
+ * This corresponds to comparing the BDF1 solution to a second-order accurate
+ * solution, but requires no additional solve. Each step therefore costs a
+ * single non-linear solve, whereas the step doubling of 'TimeStepperAdaptive'
+ * requires three. The error is compared to the tolerance using a
+ * 'ConvergenceChecker', in the same way as in 'TimeStepperAdaptive'. If the
+ * error is too large, the step is rejected and retaken with a shorter time
+ * step.
+ *
+ * If the second-order BDF2 method is used for the transient terms (see
+ * 'UnknownQuantityHandler::GetTransientCoefficients()'), the solution is
+ * instead compared to the quadratic extrapolation x^P of the three previously
+ * accepted solutions (at times t_n, t_{n-1} and t_{n-2}). To leading order,
+ * the error of the variable-step BDF2 step is
+ *
+ *   dt^2 * (t_{n+1}-t_{n-1})^2 / (6*(2*dt+dt_old)) * x''',
+ *
+ * while that of the extrapolation is
+ *
+ *   -dt * (t_{n+1}-t_{n-1}) * (t_{n+1}-t_{n-2}) / 6 * x''',
+ *
+ * and so the error is estimated as
+ *
+ *   err = C * (x_{n+1} - x^P),
+ *   C   = dt*(t_{n+1}-t_{n-1}) / [dt*(t_{n+1}-t_{n-1}) + (2*dt+dt_old)*(t_{n+1}-t_{n-2})],
+ *
+ * which reduces to C = 2/11 for a constant time step.
+ *
+ * Since no error estimate is available until two solutions are known, the
+ * first time step is always accepted.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "DREAM/IO.hpp"
+#include "DREAM/TimeStepper/TimeStepperEmbedded.hpp"
+
+
+using namespace DREAM;
+using namespace std;
+
+
+/**
+ * Constructor.
+ *
+ * tMax:        Final simulation time.
+ * dt0:         Initial time step.
+ * uqh:         UnknownQuantityHandler of solver.
+ * nontrivials: List of non-trivial unknowns.
+ * cc:          Object to use for checking the error of each step.
+ * verbose:     If true, prints information about each step.
+ */
+TimeStepperEmbedded::TimeStepperEmbedded(
+    const real_t tMax, const real_t dt0, FVM::UnknownQuantityHandler *uqh,
+    vector<len_t>& nontrivials, ConvergenceChecker *cc, bool verbose
+) : TimeStepper(uqh), tMax(tMax), dt(dt0), nontrivials(nontrivials),
+  verbose(verbose) {
+
+    if (cc == nullptr) {
+        const real_t RELTOL = 1e-6;
+        this->convChecker = new ConvergenceChecker(uqh, nontrivials, RELTOL);
+    } else
+        this->convChecker = cc;
+
+    if (dt > tMax)
+        this->dt = this->tMax;
+
+    if (verbose)
+        DREAM::IO::PrintInfo(
+            "[TimeStepper] initial dt = %.6e", this->dt
+        );
+}
+
+/**
+ * Destructor.
+ */
+TimeStepperEmbedded::~TimeStepperEmbedded() {
+    DeallocateSolutions();
+
+    delete this->convChecker;
+}
+
+
+/**
+ * Allocate memory for the temporary solution vectors.
+ *
+ * size: Number of elements in each vector.
+ */
+void TimeStepperEmbedded::AllocateSolutions(const len_t size) {
+    if (this->sol != nullptr)
+        DeallocateSolutions();
+
+    this->sol_size = size;
+    this->sol     = new real_t[size];
+    this->sol_ref = new real_t[size];
+    this->sol_old = new real_t[size];
+    this->sol_old2 = new real_t[size];
+}
+
+/**
+ * Deallocate memory for the solution vectors.
+ */
+void TimeStepperEmbedded::DeallocateSolutions() {
+    if (this->sol != nullptr)
+        delete [] this->sol;
+    if (this->sol_ref != nullptr)
+        delete [] this->sol_ref;
+    if (this->sol_old != nullptr)
+        delete [] this->sol_old;
+    if (this->sol_old2 != nullptr)
+        delete [] this->sol_old2;
+
+    this->sol = this->sol_ref = this->sol_old = this->sol_old2 = nullptr;
+}
+
+/**
+ * This method is called when an exception was thrown while
+ * the next time step was being taken. The solution is restored
+ * to the most recently accepted one, and the step is retried
+ * with a shorter time step (unless the exception has been
+ * caught too many times).
+ *
+ * ex: The exception that was caught.
+ */
+void TimeStepperEmbedded::HandleException(FVM::FVMException &ex) {
+    if (this->stepsWithException >= MAX_STEPS_WITH_EXCEPTION) {
+        DREAM::IO::PrintError("TimeStepper: Caught exception for the last time. Rethrowing...");
+        throw ex;
+    }
+
+    this->stepsWithException++;
+
+    // The failed step has not been saved, so the previous
+    // solution is still the most recently accepted one
+    RestorePreviousSolution();
+
+    this->dt *= STEP_REDUCTION_AT_EXCEPTION;
+    this->stepSucceeded = false;
+
+    if (this->verbose)
+        DREAM::IO::PrintInfo("Caught exception. Reducing time step to %e", this->dt);
+}
+
+/**
+ * Calculate and return the time of the next step to take.
+ */
+real_t TimeStepperEmbedded::NextTime() {
+    // Undo the rejected step (which has been pushed
+    // to the history of the unknowns)
+    if (this->restoreSolution) {
+        this->unknowns->RollbackSaveStep();
+        RestorePreviousSolution();
+
+        this->restoreSolution = false;
+    }
+
+    this->stepDt = this->dt;
+    if (this->currentTime + this->stepDt > this->tMax)
+        this->stepDt = this->tMax - this->currentTime;
+
+    return this->currentTime + this->stepDt;
+}
+
+/**
+ * Print current time stepping progress.
+ */
+void TimeStepperEmbedded::PrintProgress() {
+    if (!this->stepSucceeded)
+        return;
+
+    const len_t PERC_FMT_PREC = 2;      // Precision (after decimal point) in percentage
+    //                          100 . XX            %
+    const len_t PERC_FMT_LENGTH = 3+1+PERC_FMT_PREC+1;
+    const len_t EDGE_LENGTH = 1;
+    const len_t PROG_LENGTH = PROGRESSBAR_LENGTH-2*EDGE_LENGTH - PERC_FMT_LENGTH - 1;
+
+    cout << "\r[";
+    real_t perc     = CurrentTime()/this->tMax;
+    len_t threshold = static_cast<len_t>(perc * PROG_LENGTH);
+
+    for (len_t i = 0; i < PROG_LENGTH; i++) {
+        if (i < threshold)
+            cout << '#';
+        else
+            cout << '-';
+    }
+
+    cout << "] ";
+    printf(
+        "%*.*f%% (step " LEN_T_PRINTF_FMT ", dt = %.5e)",
+        int(4+PERC_FMT_PREC), int(PERC_FMT_PREC),
+        perc*100.0, this->currentStep, this->dt
+    );
+
+    cout << flush;
+}
+
+/**
+ * Restore the solution of all unknowns (and the initial guess
+ * of the solver) to the most recently accepted solution.
+ */
+void TimeStepperEmbedded::RestorePreviousSolution() {
+    for (FVM::UnknownQuantity *uqn : this->unknowns->GetUnknowns())
+        uqn->Store(uqn->GetDataPrevious());
+
+    const real_t *x = this->unknowns->GetLongVectorPrevious(this->nontrivials);
+    this->solver->SetInitialGuess(x);
+    delete [] x;
+}
+
+/**
+ * Check whether the last step taken reached the desired
+ * tolerance, and update the time step.
+ */
+void TimeStepperEmbedded::ValidateStep() {
+    // Reset exception counter (because this method is only called
+    // if the solver succeeded)
+    this->stepsWithException = 0;
+
+    this->stepSucceeded = UpdateStep();
+
+    if (this->stepSucceeded) {
+        if (this->currentTime + this->stepDt >= this->tMax)
+            this->currentTime = this->tMax;
+        else
+            this->currentTime += this->stepDt;
+
+        this->currentStep++;
+    } else
+        this->restoreSolution = true;
+}
+
+/**
+ * Construct the higher-order estimate x_{n+1} - err of the solution
+ * used to estimate the error of a time step (see top of file).
+ *
+ * order: Order of the time discretization used for the step (1 or 2).
+ * h:     Length of the time step.
+ * t:     Times of the three most recent accepted solutions, t_n,
+ *        t_{n-1} and t_{n-2} (t[2] is only used if order = 2).
+ * x:     Solution obtained in the step.
+ * x0:    Solution at time t_n.
+ * x1:    Solution at time t_{n-1}.
+ * x2:    Solution at time t_{n-2} (only used if order = 2).
+ * xRef:  On return, contains the higher-order estimate of the
+ *        solution. May be the same array as 'x0', 'x1' or 'x2'.
+ * n:     Number of elements in the solution vectors.
+ */
+void TimeStepperEmbedded::EstimateSolution(
+    const len_t order, const real_t h, const real_t t[3],
+    const real_t *x, const real_t *x0, const real_t *x1,
+    const real_t *x2, real_t *xRef, const len_t n
+) {
+    const real_t dtOld = t[0] - t[1];
+
+    if (order == 1) {
+        const real_t r = h / (2*h + dtOld);
+        for (len_t i = 0; i < n; i++) {
+            const real_t xP = x0[i] + h/dtOld * (x0[i] - x1[i]);
+            xRef[i] = x[i] - r*(x[i] - xP);
+        }
+    } else {
+        const real_t t0 = t[0], t1 = t[1], t2 = t[2];
+
+        // Lagrange weights of the quadratic extrapolation to t_{n+1}
+        const real_t tn = t0 + h;
+        const real_t l0 = (tn-t1)*(tn-t2) / ((t0-t1)*(t0-t2));
+        const real_t l1 = (tn-t0)*(tn-t2) / ((t1-t0)*(t1-t2));
+        const real_t l2 = (tn-t0)*(tn-t1) / ((t2-t0)*(t2-t1));
+
+        // Ratio of the BDF2 error to the difference between the
+        // BDF2 solution and the extrapolation (see top of file)
+        const real_t C = h*(tn-t1) / (h*(tn-t1) + (2*h+dtOld)*(tn-t2));
+
+        for (len_t i = 0; i < n; i++) {
+            const real_t xP = l0*x0[i] + l1*x1[i] + l2*x2[i];
+            xRef[i] = x[i] - C*(x[i] - xP);
+        }
+    }
+}
+
+/**
+ * Estimate the error of the most recently taken step and
+ * update the size of the time step 'dt' accordingly. Returns
+ * 'true' if the error is within the tolerance.
+ */
+bool TimeStepperEmbedded::UpdateStep() {
+    // Two previous solutions are needed for the estimate
+    const len_t nOld = this->unknowns->GetNOldSteps(this->nontrivials);
+    if (nOld < 2)
+        return true;
+
+    FVM::UnknownQuantity *uqn = this->unknowns->GetUnknown(this->nontrivials[0]);
+    const real_t t0 = uqn->GetOldTime(0), t1 = uqn->GetOldTime(1);
+    const real_t dtOld = t0 - t1;
+    if (dtOld <= 0)
+        return true;
+
+    // Order of the time discretization (the first BDF2 step is
+    // checked with the first-order estimate, which overestimates
+    // its error)
+    len_t order = 1;
+    real_t t2 = 0;
+    if (this->unknowns->GetTimeIntegrationOrder() >= 2 && nOld >= 3) {
+        t2 = uqn->GetOldTime(2);
+        if (t2 < t1)
+            order = 2;
+    }
+
+    const len_t SSIZE = this->unknowns->GetLongVectorSize(this->nontrivials);
+    if (this->sol_size != SSIZE)
+        AllocateSolutions(SSIZE);
+
+    this->unknowns->GetLongVector(this->nontrivials, this->sol);
+    this->unknowns->GetLongVectorOld(this->nontrivials, 0, this->sol_ref);
+    this->unknowns->GetLongVectorOld(this->nontrivials, 1, this->sol_old);
+
+    if (order == 2)
+        this->unknowns->GetLongVectorOld(this->nontrivials, 2, this->sol_old2);
+
+    // Higher-order estimate of the solution, x_{n+1} - err
+    const real_t h = this->stepDt;
+    const real_t t[3] = {t0, t1, t2};
+    EstimateSolution(
+        order, h, t, this->sol, this->sol_ref, this->sol_old,
+        this->sol_old2, this->sol_ref, SSIZE
+    );
+
+    bool converged = this->convChecker->IsConverged(this->sol, this->sol, this->sol_ref);
+    const real_t *err = this->convChecker->GetErrorNorms();
+
+    // Calculate maximum error
+    real_t maxErr = 0;
+    len_t maxErri = 0;
+    for (len_t i = 0; i < this->nontrivials.size(); i++) {
+        const real_t scale = this->convChecker->GetErrorScale(this->nontrivials[i]);
+
+        // scale = 0 indicates that |x| = 0, which could be ok
+        if (scale != 0 && maxErr < err[i]/scale) {
+            maxErr = err[i]/scale;
+            maxErri = i;
+        }
+    }
+
+    // Update time step (the local error scales as dt^(order+1))
+    real_t fac = MAX_STEP_CHANGE;
+    if (maxErr > 0)
+        fac = SAFETY_FACTOR / pow(maxErr, 1.0/(order+1));
+    if (!isfinite(fac))
+        fac = MIN_STEP_CHANGE;
+
+    fac = max(MIN_STEP_CHANGE, min(MAX_STEP_CHANGE, fac));
+    real_t dt = fac * h;
+
+    if (this->verbose) {
+        DREAM::IO::PrintInfo(
+            "[TimeStepper] max error:  %.6e  (for unknown #" LEN_T_PRINTF_FMT ")\n"
+            "[TimeStepper] step %s:  %.6e  ->  %.6e",
+            maxErr, this->nontrivials[maxErri], ((dt < h)?"DECREASED":"INCREASED"),
+            h, dt
+        );
+    }
+
+    this->dt = dt;
+
+    return converged;
+}
+
+
+/**
+ * Write the state of this time stepper to the given
+ * checkpoint file. This should only be called when
+ * 'CanCheckpoint()' returns 'true'.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void TimeStepperEmbedded::SaveCheckpoint(SFile *sf, const std::string& path) {
+    sf->WriteScalar(path + "/currentTime", this->currentTime);
+    sf->WriteScalar(path + "/dt", this->dt);
+
+    int64_t step = (int64_t)this->currentStep;
+    sf->WriteInt64List(path + "/currentStep", &step, 1);
+}
+
+/**
+ * Restore the state of this time stepper from the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void TimeStepperEmbedded::LoadCheckpoint(SFile *sf, const std::string& path) {
+    this->currentTime = sf->GetScalar(path + "/currentTime");
+    this->dt          = sf->GetScalar(path + "/dt");
+    this->currentStep = (len_t)sf->GetInt(path + "/currentStep");
+
+    // The checkpoint was written after a successful step
+    this->stepSucceeded = true;
+    this->restoreSolution = false;
+    this->stepsWithException = 0;
+}
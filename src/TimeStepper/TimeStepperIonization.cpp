@@ -176,3 +176,53 @@ void TimeStepperIonization::PrintProgress() {
 	cout << flush;
 }
 
+
+/**
+ * Write the state of this time stepper to the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to write checkpoint data to.
+ * path: Group in the file to write data to (must exist).
+ */
+void TimeStepperIonization::SaveCheckpoint(SFile *sf, const std::string& path) {
+	sf->WriteScalar(path + "/currentTime", this->currentTime);
+	sf->WriteScalar(path + "/dt", this->dt);
+	sf->WriteScalar(path + "/dt0", this->dt0);
+	sf->WriteScalar(path + "/tscale0", this->tscale0);
+	sf->WriteScalar(path + "/lastSaveTime", this->lastSaveTime);
+
+	int64_t step = (int64_t)this->currentStep;
+	sf->WriteInt64List(path + "/currentStep", &step, 1);
+
+	sf->WriteList(path + "/ncold", this->ncold, this->nr);
+}
+
+/**
+ * Restore the state of this time stepper from the given
+ * checkpoint file.
+ *
+ * sf:   SFile object to read checkpoint data from.
+ * path: Group in the file to read data from.
+ */
+void TimeStepperIonization::LoadCheckpoint(SFile *sf, const std::string& path) {
+	sfilesize_t n;
+	real_t *nc = sf->GetList(path + "/ncold", &n);
+	if (n != this->nr) {
+		delete [] nc;
+		throw TimeStepperException(
+			"TimeStepperIonization: Invalid number of radial points in checkpoint file '%s'.",
+			sf->filename.c_str()
+		);
+	}
+
+	for (len_t ir = 0; ir < this->nr; ir++)
+		this->ncold[ir] = nc[ir];
+	delete [] nc;
+
+	this->currentTime  = sf->GetScalar(path + "/currentTime");
+	this->dt           = sf->GetScalar(path + "/dt");
+	this->dt0          = sf->GetScalar(path + "/dt0");
+	this->tscale0      = sf->GetScalar(path + "/tscale0");
+	this->lastSaveTime = sf->GetScalar(path + "/lastSaveTime");
+	this->currentStep  = (len_t)sf->GetInt(path + "/currentStep");
+}
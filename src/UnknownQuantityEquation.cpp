@@ -88,6 +88,20 @@ len_t UnknownQuantityEquation::NumberOfNonZeros_jac() {
     return nnz;
 }
 
+/**
+ * Returns the number of non-zero elements per row in the
+ * block of the jacobian matrix corresponding to differentiation
+ * of this equation with respect to the unknown 'derivId'.
+ * (NOTE: this is just an estimate)
+ */
+len_t UnknownQuantityEquation::NumberOfNonZeros_jac(const len_t derivId) {
+    len_t nnz = 0;
+    for (auto it = equations.begin(); it != equations.end(); it++)
+        nnz += it->second->GetNumberOfNonZerosPerRow_jac(it->first, derivId);
+
+    return nnz;
+}
+
 /**
  * If this quantity is predetermined, this routine
  * returns the predetermined parameter. Otherwise,
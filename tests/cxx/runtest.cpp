@@ -17,17 +17,24 @@
 #include "UnitTest.hpp"
 
 // Tests
+#include "tests/DREAM/ADASRateInterpolator.hpp"
 #include "tests/DREAM/BoundaryFlux.hpp"
 #include "tests/DREAM/IonRateEquation.hpp"
+#include "tests/DREAM/IonSpeciesTransientTerm.hpp"
 #include "tests/DREAM/RunawayFluid.hpp"
+#include "tests/DREAM/TimeStepperEmbedded.hpp"
 #include "tests/DREAM/AvalancheSourceRP.hpp"
 #include "tests/DREAM/MeanExcitationEnergy.hpp"
+#include "tests/DREAM/PsiFunctionTable.hpp"
+#include "tests/DREAM/SPIHandler.hpp"
+#include "tests/DREAM/TransportPrescribed.hpp"
 
 #include "tests/FVM/AdvectionTerm.hpp"
 #include "tests/FVM/AdvectionDiffusionTerm.hpp"
 #include "tests/FVM/AnalyticBRadialGridGenerator.hpp"
 #include "tests/FVM/DiffusionTerm.hpp"
 #include "tests/FVM/Grid.hpp"
+#include "tests/FVM/GridCache.hpp"
 #include "tests/FVM/Interpolator1D.hpp"
 #include "tests/FVM/Interpolator3D.hpp"
 #include "tests/FVM/PXiExternalKineticKinetic.hpp"
@@ -41,17 +48,24 @@ void add_test(UnitTest *t) {
 	tests.push_back(t);
 }
 void init() {
+    add_test(new DREAMTESTS::_DREAM::ADASRateInterpolator("dream/adasrateinterpolator"));
     add_test(new DREAMTESTS::_DREAM::AvalancheSourceRP("dream/avalanche"));
     add_test(new DREAMTESTS::_DREAM::BoundaryFlux("dream/boundaryflux"));
     add_test(new DREAMTESTS::_DREAM::IonRateEquation("dream/ionrateequation"));
+    add_test(new DREAMTESTS::_DREAM::IonSpeciesTransientTerm("dream/ionspeciestransientterm"));
     add_test(new DREAMTESTS::_DREAM::MeanExcitationEnergy("dream/meanexcitationenergy"));
+    add_test(new DREAMTESTS::_DREAM::PsiFunctionTable("dream/psifunctiontable"));
     add_test(new DREAMTESTS::_DREAM::RunawayFluid("dream/runawayfluid"));
+    add_test(new DREAMTESTS::_DREAM::SPIHandler("dream/spihandler"));
+    add_test(new DREAMTESTS::_DREAM::TimeStepperEmbedded("dream/timestepperembedded"));
+    add_test(new DREAMTESTS::_DREAM::TransportPrescribed("dream/transportprescribed"));
 
     add_test(new DREAMTESTS::FVM::AdvectionTerm("fvm/advectionterm"));
     add_test(new DREAMTESTS::FVM::DiffusionTerm("fvm/diffusionterm"));
     add_test(new DREAMTESTS::FVM::AdvectionDiffusionTerm("fvm/advectiondiffusionterm"));
     add_test(new DREAMTESTS::FVM::AnalyticBRadialGridGenerator("fvm/fluxsurfaceaverage"));
     add_test(new DREAMTESTS::FVM::Grid("fvm/grid"));
+    add_test(new DREAMTESTS::FVM::GridCache("fvm/gridcache"));
     add_test(new DREAMTESTS::FVM::Interpolator1D("fvm/interpolator1d"));
     add_test(new DREAMTESTS::FVM::Interpolator3D("fvm/interpolator3d"));
     add_test(new DREAMTESTS::FVM::PXiExternalKineticKinetic("fvm/boundaryflux/2kinetic"));
@@ -0,0 +1,269 @@
+/**
+ * Test of the ADAS rate coefficient interpolation. For all rate
+ * coefficients of all elements in the ADAS database, the batched
+ * evaluation of 'DREAM::ADASRateInterpolator' is compared to the scalar
+ * evaluation and to a reference interpolation done directly with GSL
+ * (bicubic inside the table, bilinear outside), and the analytic
+ * derivatives with respect to density and temperature are compared to
+ * finite differences of the interpolated rate coefficient.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <gsl/gsl_interp2d.h>
+#include "ADASRateInterpolator.hpp"
+#include "DREAM/adasdata.h"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+/**
+ * Generate the (n, T) points to evaluate the interpolation in. One
+ * point is placed inside every cell of the table (away from the knots,
+ * where the interpolant is not smooth outside of the table), and a few
+ * points are placed outside of the table on all sides to exercise the
+ * extrapolation. The last point has zero density, which should yield
+ * zero rates.
+ *
+ * nn, nT: Number of density/temperature points in table.
+ * logn:   Logarithm of density in table.
+ * logT:   Logarithm of temperature in table.
+ * n, T:   On return, contain the (newly allocated) points.
+ *
+ * RETURNS the number of points generated.
+ */
+len_t ADASRateInterpolator::GetTestPoints(
+    const len_t nn, const len_t nT, const real_t *logn, const real_t *logT,
+    real_t **n, real_t **T
+) {
+    const len_t N = (nn-1)*(nT-1) + 2*(nn-1) + 2*(nT-1) + 4 + 1;
+    real_t *ln = new real_t[N], *lT = new real_t[N];
+    len_t k = 0;
+
+    auto frac = [](const real_t *x, const len_t i, const real_t f) {
+        return x[i] + f*(x[i+1]-x[i]);
+    };
+
+    // Inside the table
+    for (len_t j = 0; j < nT-1; j++)
+        for (len_t i = 0; i < nn-1; i++, k++) {
+            ln[k] = frac(logn, i, 0.31);
+            lT[k] = frac(logT, j, 0.67);
+        }
+
+    // Below/above the density range
+    for (len_t j = 0; j < nT-1; j++) {
+        ln[k] = logn[0] - 0.37;    lT[k++] = frac(logT, j, 0.43);
+        ln[k] = logn[nn-1] + 0.41; lT[k++] = frac(logT, j, 0.43);
+    }
+
+    // Below/above the temperature range
+    for (len_t i = 0; i < nn-1; i++) {
+        ln[k] = frac(logn, i, 0.57); lT[k++] = logT[0] - 0.29;
+        ln[k] = frac(logn, i, 0.57); lT[k++] = logT[nT-1] + 0.53;
+    }
+
+    // Corners
+    ln[k] = logn[0] - 0.37;    lT[k++] = logT[0] - 0.29;
+    ln[k] = logn[0] - 0.37;    lT[k++] = logT[nT-1] + 0.53;
+    ln[k] = logn[nn-1] + 0.41; lT[k++] = logT[0] - 0.29;
+    ln[k] = logn[nn-1] + 0.41; lT[k++] = logT[nT-1] + 0.53;
+
+    *n = new real_t[N];
+    *T = new real_t[N];
+    for (len_t i = 0; i < k; i++) {
+        (*n)[i] = pow(10.0, ln[i]);
+        (*T)[i] = pow(10.0, lT[i]);
+    }
+
+    // Zero density
+    (*n)[k] = 0;
+    (*T)[k] = 10.0;
+
+    delete [] lT;
+    delete [] ln;
+
+    return N;
+}
+
+/**
+ * Check the interpolation of a single ADAS rate coefficient.
+ *
+ * name:     Name of rate coefficient (for error messages).
+ * Z:        Atomic charge of element.
+ * nn, nT:   Number of density/temperature points in table.
+ * logn:     Logarithm of density in table.
+ * logT:     Logarithm of temperature in table.
+ * coeff:    Tabulated (logarithm of) rate coefficient.
+ * shiftZ0:  Whether the rate coefficient is defined for Z0=1,...,Z
+ *           (as opposed to Z0=0,...,Z-1).
+ * okGSL:    Set to false if the interpolation differs from GSL.
+ * okBatch:  Set to false if the batched evaluation differs from the
+ *           scalar evaluation.
+ * okDeriv:  Set to false if the analytic derivatives differ from
+ *           finite differences.
+ *
+ * RETURNS true if all checks were successful.
+ */
+bool ADASRateInterpolator::CheckRate(
+    const string& name, const len_t Z, const len_t nn, const len_t nT,
+    const real_t *logn, const real_t *logT, const real_t *coeff,
+    const bool shiftZ0, bool &okGSL, bool &okBatch, bool &okDeriv
+) {
+    const real_t TOL_GSL = 1e-10;
+    const real_t TOL_BATCH = 1e-12;
+    const real_t TOL_DERIV = 1e-5;
+    const len_t Z0null = (shiftZ0 ? 0 : Z);
+
+    bool success = true;
+    DREAM::ADASRateInterpolator *ari = new DREAM::ADASRateInterpolator(
+        Z, nn, nT, logn, logT, coeff, shiftZ0, gsl_interp2d_bicubic
+    );
+
+    real_t *n, *T;
+    const len_t N = GetTestPoints(nn, nT, logn, logT, &n, &T);
+
+    real_t *rate = new real_t[(Z+1)*N];
+    real_t *drate_dn = new real_t[(Z+1)*N];
+    real_t *drate_dT = new real_t[(Z+1)*N];
+    ari->Eval(N, n, T, rate, drate_dn, drate_dT);
+
+    gsl_interp2d *gsl_c = gsl_interp2d_alloc(gsl_interp2d_bicubic, nn, nT);
+    gsl_interp2d *gsl_l = gsl_interp2d_alloc(gsl_interp2d_bilinear, nn, nT);
+
+    for (len_t Z0 = 0; Z0 <= Z; Z0++) {
+        const real_t *z = (Z0 == Z0null ? nullptr : coeff + (shiftZ0 ? Z0-1 : Z0)*nn*nT);
+        if (z != nullptr) {
+            gsl_interp2d_init(gsl_c, logn, logT, z, nn, nT);
+            gsl_interp2d_init(gsl_l, logn, logT, z, nn, nT);
+        }
+
+        for (len_t k = 0; k < N; k++) {
+            const len_t idx = Z0*N + k;
+
+            // Batched vs. scalar evaluation
+            real_t R = ari->Eval(Z0, n[k], T[k]);
+            real_t dRdn = ari->Eval_deriv_n(Z0, n[k], T[k]);
+            real_t dRdT = ari->Eval_deriv_T(Z0, n[k], T[k]);
+
+            real_t dR = abs(rate[idx]-R) / max(abs(R), 1e-300);
+            real_t dn = abs(drate_dn[idx]-dRdn) / max(abs(dRdn), 1e-300);
+            real_t dT = abs(drate_dT[idx]-dRdT) / max(abs(dRdT), 1e-300);
+            if (dR > TOL_BATCH || dn > TOL_BATCH || dT > TOL_BATCH) {
+                if (okBatch)
+                    this->PrintError(
+                        "%s (Z=" LEN_T_PRINTF_FMT "): batched evaluation differs from scalar "
+                        "evaluation for Z0=" LEN_T_PRINTF_FMT " at n=%.3e, T=%.3e. "
+                        "Relative errors: rate=%.3e, d/dn=%.3e, d/dT=%.3e.",
+                        name.c_str(), Z, Z0, n[k], T[k], dR, dn, dT
+                    );
+                okBatch = success = false;
+            }
+
+            // Null charge state and zero density should give zero rates
+            if (z == nullptr || n[k] == 0) {
+                if (rate[idx] != 0 || drate_dn[idx] != 0 || drate_dT[idx] != 0) {
+                    if (okBatch)
+                        this->PrintError(
+                            "%s (Z=" LEN_T_PRINTF_FMT "): non-zero rate for Z0=" LEN_T_PRINTF_FMT
+                            " at n=%.3e, T=%.3e.", name.c_str(), Z, Z0, n[k], T[k]
+                        );
+                    okBatch = success = false;
+                }
+                continue;
+            }
+
+            // Comparison with GSL interpolation
+            const real_t ln = log10(n[k]), lT = log10(T[k]);
+            gsl_interp2d *spln = gsl_c;
+            if (ln < logn[0] || lT < logT[0] || ln > logn[nn-1] || lT > logT[nT-1])
+                spln = gsl_l;
+
+            real_t Rgsl = pow(10.0, gsl_interp2d_eval_extrap(spln, logn, logT, z, ln, lT, nullptr, nullptr));
+            real_t dgsl = abs(rate[idx]-Rgsl) / Rgsl;
+            if (dgsl > TOL_GSL) {
+                if (okGSL)
+                    this->PrintError(
+                        "%s (Z=" LEN_T_PRINTF_FMT "): interpolated rate differs from GSL "
+                        "for Z0=" LEN_T_PRINTF_FMT " at n=%.3e, T=%.3e. Relative error: %.3e.",
+                        name.c_str(), Z, Z0, n[k], T[k], dgsl
+                    );
+                okGSL = success = false;
+            }
+
+            // Analytic derivatives vs. central finite differences. The
+            // error is measured in the logarithmic derivative, which is
+            // of order unity regardless of the magnitude of the rate.
+            const real_t hn = 1e-6*n[k], hT = 1e-6*T[k];
+            real_t dRdn_fd = (ari->Eval(Z0, n[k]+hn, T[k]) - ari->Eval(Z0, n[k]-hn, T[k])) / (2*hn);
+            real_t dRdT_fd = (ari->Eval(Z0, n[k], T[k]+hT) - ari->Eval(Z0, n[k], T[k]-hT)) / (2*hT);
+
+            real_t Dn = drate_dn[idx]*n[k]/rate[idx], Dn_fd = dRdn_fd*n[k]/rate[idx];
+            real_t DT = drate_dT[idx]*T[k]/rate[idx], DT_fd = dRdT_fd*T[k]/rate[idx];
+            real_t en = abs(Dn-Dn_fd) / max(1.0, abs(Dn));
+            real_t eT = abs(DT-DT_fd) / max(1.0, abs(DT));
+            if (en > TOL_DERIV || eT > TOL_DERIV) {
+                if (okDeriv)
+                    this->PrintError(
+                        "%s (Z=" LEN_T_PRINTF_FMT "): analytic derivatives differ from finite "
+                        "differences for Z0=" LEN_T_PRINTF_FMT " at n=%.3e, T=%.3e. "
+                        "dlogR/dlogn: %.6e (analytic), %.6e (FD); "
+                        "dlogR/dlogT: %.6e (analytic), %.6e (FD).",
+                        name.c_str(), Z, Z0, n[k], T[k], Dn, Dn_fd, DT, DT_fd
+                    );
+                okDeriv = success = false;
+            }
+        }
+    }
+
+    gsl_interp2d_free(gsl_l);
+    gsl_interp2d_free(gsl_c);
+
+    delete [] drate_dT;
+    delete [] drate_dn;
+    delete [] rate;
+    delete [] T;
+    delete [] n;
+    delete ari;
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool ADASRateInterpolator::Run(bool) {
+    bool okGSL = true, okBatch = true, okDeriv = true;
+
+    for (len_t i = 0; i < adas_rate_n; i++) {
+        const struct adas_rate *ar = adas_rate_table+i;
+        const string el(ar->name);
+
+        #define CHECKADAS(type,shiftZ0) \
+            CheckRate( \
+                el + " " #type, ar->Z, ar-> type ## _nn, ar-> type ## _nT, \
+                ar-> type ## _n, ar-> type ## _T, ar-> type, shiftZ0, \
+                okGSL, okBatch, okDeriv \
+            )
+
+        CHECKADAS(acd, true);
+        CHECKADAS(ccd, false);
+        CHECKADAS(scd, false);
+        CHECKADAS(plt, false);
+        CHECKADAS(prb, true);
+
+        #undef CHECKADAS
+    }
+
+    if (okGSL)
+        this->PrintOK("The ADAS rate interpolation agrees with GSL.");
+    if (okBatch)
+        this->PrintOK("Batched ADAS rate evaluation agrees with scalar evaluation.");
+    if (okDeriv)
+        this->PrintOK("Analytic ADAS rate derivatives agree with finite differences.");
+
+    return (okGSL && okBatch && okDeriv);
+}
@@ -0,0 +1,26 @@
+#ifndef _DREAMTESTS_DREAM_ADAS_RATE_INTERPOLATOR_HPP
+#define _DREAMTESTS_DREAM_ADAS_RATE_INTERPOLATOR_HPP
+
+#include <string>
+#include "DREAM/ADASRateInterpolator.hpp"
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class ADASRateInterpolator : public UnitTest {
+    private:
+        len_t GetTestPoints(const len_t, const len_t, const real_t*, const real_t*, real_t**, real_t**);
+
+    public:
+        ADASRateInterpolator(const std::string& s) : UnitTest(s) {}
+
+        bool CheckRate(
+            const std::string&, const len_t, const len_t, const len_t,
+            const real_t*, const real_t*, const real_t*, const bool,
+            bool&, bool&, bool&
+        );
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_ADAS_RATE_INTERPOLATOR_HPP*/
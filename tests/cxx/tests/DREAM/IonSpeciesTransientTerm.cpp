@@ -0,0 +1,162 @@
+/**
+ * Test of the time discretization of the 'IonSpeciesTransientTerm'.
+ * The ion density relaxation problem
+ *
+ *   dn/dt = -n/tau
+ *
+ * is solved using the transient term, and the error at the final time
+ * is compared to the exact solution n(t) = n0*exp(-t/tau) for a
+ * sequence of time steps, to verify that the backward Euler and BDF2
+ * discretizations converge with the expected order (also when the
+ * time step varies between steps).
+ */
+
+#include <cmath>
+#include <string>
+#include "DREAM/Equations/Fluid/IonSpeciesTransientTerm.hpp"
+#include "FVM/Grid/Grid.hpp"
+#include "FVM/Matrix.hpp"
+#include "FVM/UnknownQuantityHandler.hpp"
+#include "IonSpeciesTransientTerm.hpp"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+/**
+ * Solve the relaxation problem up to 'TMAX' and return the relative
+ * error of the solution at the final time.
+ *
+ * order:    Order of the time discretization to use.
+ * nSteps:   Number of time steps to take (should be even).
+ * variable: If 'true', the time step alternates between 0.7 and
+ *           1.3 times the average time step.
+ */
+real_t IonSpeciesTransientTerm::SolveRelaxation(
+    const len_t order, const len_t nSteps, bool variable
+) {
+    const real_t n0 = 1e19;
+    const real_t h = TMAX / nSteps;
+
+    DREAM::FVM::Grid *grid = this->InitializeFluidGrid(1);
+    DREAM::FVM::UnknownQuantityHandler *uqh = new DREAM::FVM::UnknownQuantityHandler();
+    const len_t id = uqh->InsertUnknown("n_i", "0", grid);
+    uqh->SetTimeIntegrationOrder(order);
+
+    real_t x = n0;
+    uqh->SetInitialValue(id, &x, 0);
+
+    DREAM::IonSpeciesTransientTerm *term = new DREAM::IonSpeciesTransientTerm(grid, 0, id);
+
+    real_t t = 0;
+    for (len_t k = 0; k < nSteps; k++) {
+        real_t dt = h;
+        if (variable)
+            dt *= (k%2 == 0 ? 0.7 : 1.3);
+        if (k+1 == nSteps)
+            dt = TMAX - t;
+
+        term->Rebuild(t+dt, dt, uqh);
+
+        // Linearized equation:  a*x + b + x/tau = 0
+        DREAM::FVM::Matrix *mat = new DREAM::FVM::Matrix(1, 1, 1);
+        real_t b = 0;
+        term->SetMatrixElements(mat, &b);
+        mat->Assemble();
+        const real_t a = mat->GetElement(0, 0);
+
+        x = -b / (a + 1/TAU);
+
+        // Jacobian and function vector must agree with the matrix
+        DREAM::FVM::Matrix *jac = new DREAM::FVM::Matrix(1, 1, 1);
+        term->SetJacobianBlock(id, id, jac, &x);
+        jac->Assemble();
+        real_t dJ = fabs(jac->GetElement(0, 0)/a - 1);
+
+        real_t F = 0;
+        term->SetVectorElements(&F, &x);
+        real_t dF = fabs((F + x/TAU) / (x/TAU));
+
+        maxInconsistency = max(maxInconsistency, max(dJ, dF));
+
+        delete jac;
+        delete mat;
+
+        t += dt;
+        uqh->Store(id, &x);
+        uqh->SaveStep(t, false);
+    }
+
+    delete term;
+    delete uqh;
+    delete grid;
+
+    const real_t exact = n0*exp(-TMAX/TAU);
+    return fabs(x/exact - 1);
+}
+
+/**
+ * Verify that the solution of the relaxation problem converges
+ * with the given order as the time step is decreased.
+ *
+ * order:    Order of the time discretization to test.
+ * variable: If 'true', use a time step which varies between steps.
+ */
+bool IonSpeciesTransientTerm::CheckConvergenceOrder(const len_t order, bool variable) {
+    const len_t NSTEPS = 20, NREFINE = 3;
+    const real_t ORDER_TOLERANCE = 0.15, CONSISTENCY_TOLERANCE = 1e-10;
+
+    this->maxInconsistency = 0;
+
+    real_t err[NREFINE];
+    for (len_t i = 0; i < NREFINE; i++)
+        err[i] = SolveRelaxation(order, NSTEPS << i, variable);
+
+    bool success = true;
+    for (len_t i = 1; i < NREFINE; i++) {
+        real_t p = log2(err[i-1] / err[i]);
+        if (fabs(p - order) > ORDER_TOLERANCE) {
+            this->PrintError(
+                "Observed order of convergence with %s time step is %.3f, expected " LEN_T_PRINTF_FMT
+                " (errors: %.6e, %.6e).", variable ? "variable" : "constant",
+                p, order, err[i-1], err[i]
+            );
+            success = false;
+        }
+    }
+
+    if (this->maxInconsistency > CONSISTENCY_TOLERANCE) {
+        this->PrintError(
+            "The matrix, jacobian and function vector of the transient term are "
+            "inconsistent (max. relative difference %.3e).", this->maxInconsistency
+        );
+        success = false;
+    }
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool IonSpeciesTransientTerm::Run(bool) {
+    bool success = true;
+
+    if (CheckConvergenceOrder(1, false))
+        this->PrintOK("The backward Euler ion species transient term is first-order accurate.");
+    else
+        success = false;
+
+    if (CheckConvergenceOrder(2, false))
+        this->PrintOK("The BDF2 ion species transient term is second-order accurate.");
+    else
+        success = false;
+
+    if (CheckConvergenceOrder(2, true))
+        this->PrintOK("The BDF2 ion species transient term is second-order accurate with a variable time step.");
+    else
+        success = false;
+
+    return success;
+}
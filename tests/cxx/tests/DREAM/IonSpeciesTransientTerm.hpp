@@ -0,0 +1,28 @@
+#ifndef _DREAMTESTS_DREAM_ION_SPECIES_TRANSIENT_TERM_HPP
+#define _DREAMTESTS_DREAM_ION_SPECIES_TRANSIENT_TERM_HPP
+
+#include <string>
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class IonSpeciesTransientTerm : public UnitTest {
+    private:
+        // Relaxation time and final time of the test problem
+        const real_t TAU = 0.5, TMAX = 1.0;
+
+        // Largest deviation between the matrix, jacobian and
+        // function vector representations of the term
+        real_t maxInconsistency;
+
+        real_t SolveRelaxation(const len_t, const len_t, bool);
+
+    public:
+        IonSpeciesTransientTerm(const std::string& s) : UnitTest(s) {}
+
+        bool CheckConvergenceOrder(const len_t, bool);
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_ION_SPECIES_TRANSIENT_TERM_HPP*/
@@ -0,0 +1,176 @@
+/**
+ * Test of the tabulated Psi functions used in the "full" collision
+ * frequencies. The interpolated Psi0, Psi1 and Psi2, as well as the
+ * differences Psi1-Psi0 and Psi2-Psi1 from which the T_cold derivatives
+ * of the collision frequencies are formed, are compared to adaptive
+ * quadrature in randomly chosen points of the tabulated region.
+ */
+
+#include <cmath>
+#include <string>
+#include "PsiFunctionTable.hpp"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+struct psitest_params { len_t n; real_t Theta; };
+
+/**
+ * Integrand of Psi_n (see 'CollisionFrequency::psi0Integrand()' etc.).
+ */
+static real_t psitest_integrand(real_t s, void *par) {
+    struct psitest_params *params = (struct psitest_params*)par;
+    real_t gs = sqrt(1+s*s);
+    real_t gsMinusOne = s*s/(1+gs);
+
+    return exp(-gsMinusOne/params->Theta) * pow(gs, (real_t)params->n-1);
+}
+
+/**
+ * Evaluate Psi_n(p, Theta) using adaptive quadrature.
+ */
+real_t PsiFunctionTable::EvaluatePsi(const len_t n, const real_t p, const real_t Theta) {
+    struct psitest_params params = {n, Theta};
+    gsl_function F;
+    F.function = &psitest_integrand;
+    F.params = &params;
+
+    real_t val, error;
+    gsl_integration_qag(&F, 0, p, 0, 1e-12, 1000, GSL_INTEG_GAUSS31, gsl_ad_w, &val, &error);
+
+    return val;
+}
+
+/**
+ * Compare the tabulated Psi functions, and the differences between
+ * them, to adaptive quadrature in randomly chosen points of the
+ * table. Since the table is built to a relative tolerance of 1e-6,
+ * allowing for a factor 10 in the points which are not cell
+ * mid-points.
+ */
+bool PsiFunctionTable::CheckAgainstQuadrature(const DREAM::PsiFunctionTable *table) {
+    const len_t NPOINTS = 200;
+    const real_t TOLERANCE = 1e-5;
+
+    const real_t lmin = log(DREAM::PsiFunctionTable::THETA_MIN);
+    const real_t lmax = log(DREAM::PsiFunctionTable::THETA_MAX);
+    const real_t umin = DREAM::PsiFunctionTable::U_MIN, umax = sqrt(10.0);
+
+    bool success = true;
+    for (len_t k = 0; k < NPOINTS; k++) {
+        real_t Theta = exp(lmin + Rand()*(lmax-lmin));
+        real_t u = umin + Rand()*(umax-umin);
+        real_t gammaMinusOne = u*u*Theta;
+        real_t p = sqrt(gammaMinusOne*(gammaMinusOne+2));
+
+        real_t tab[3], ex[3];
+        for (len_t n = 0; n < 3; n++) {
+            if (!table->Evaluate(n, p, Theta, tab+n)) {
+                this->PrintError(
+                    "Psi%d(p = %.8e, Theta = %.8e) was not evaluated from the table.",
+                    (int)n, p, Theta
+                );
+                return false;
+            }
+
+            ex[n] = EvaluatePsi(n, p, Theta);
+        }
+
+        for (len_t n = 0; n < 3; n++) {
+            real_t Delta = fabs(tab[n]/ex[n] - 1);
+            if (Delta > TOLERANCE) {
+                this->PrintError(
+                    "Psi%d(p = %.8e, Theta = %.8e): tabulated = %.12e, quadrature = %.12e, Delta = %.3e.",
+                    (int)n, p, Theta, tab[n], ex[n], Delta
+                );
+                success = false;
+            }
+        }
+
+        for (len_t n = 1; n < 3; n++) {
+            real_t dtab = tab[n]-tab[n-1], dex = ex[n]-ex[n-1];
+            real_t Delta = fabs(dtab/dex - 1);
+            if (Delta > TOLERANCE) {
+                this->PrintError(
+                    "Psi%d-Psi%d(p = %.8e, Theta = %.8e): tabulated = %.12e, quadrature = %.12e, Delta = %.3e.",
+                    (int)n, (int)n-1, p, Theta, dtab, dex, Delta
+                );
+                success = false;
+            }
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Verify that points outside of the table are rejected, and
+ * that the output value is then left unmodified.
+ */
+bool PsiFunctionTable::CheckOutsideTable(const DREAM::PsiFunctionTable *table) {
+    const real_t THETA_MIN = DREAM::PsiFunctionTable::THETA_MIN;
+    const real_t THETA_MAX = DREAM::PsiFunctionTable::THETA_MAX;
+    const real_t Theta = sqrt(THETA_MIN*THETA_MAX);
+
+    // (p, Theta) pairs outside of the table
+    auto pFromU = [](const real_t u, const real_t Theta) {
+        real_t gammaMinusOne = u*u*Theta;
+        return sqrt(gammaMinusOne*(gammaMinusOne+2));
+    };
+    const len_t NPOINTS = 4;
+    const real_t points[NPOINTS][2] = {
+        {pFromU(1.0, 0.5*THETA_MIN), 0.5*THETA_MIN},
+        {pFromU(1.0, 2*THETA_MAX), 2*THETA_MAX},
+        {pFromU(0.5*DREAM::PsiFunctionTable::U_MIN, Theta), Theta},
+        {pFromU(2*sqrt(10.0), Theta), Theta}
+    };
+
+    bool success = true;
+    for (len_t k = 0; k < NPOINTS; k++) {
+        real_t psi = -1;
+        if (table->Evaluate(0, points[k][0], points[k][1], &psi) || psi != -1) {
+            this->PrintError(
+                "Psi0(p = %.8e, Theta = %.8e) was evaluated from the table, "
+                "although the point lies outside of it.",
+                points[k][0], points[k][1]
+            );
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool PsiFunctionTable::Run(bool) {
+    bool success = true;
+
+    const DREAM::PsiFunctionTable *table = DREAM::PsiFunctionTable::Get();
+    if (!table->IsValid()) {
+        this->PrintError(
+            "The Psi function table could not be built to the requested tolerance "
+            "(max. relative error = %.3e).", table->GetMaxError()
+        );
+        return false;
+    }
+
+    this->gsl_ad_w = gsl_integration_workspace_alloc(1000);
+
+    if (CheckAgainstQuadrature(table))
+        this->PrintOK("The tabulated Psi functions agree with quadrature.");
+    else
+        success = false;
+
+    if (CheckOutsideTable(table))
+        this->PrintOK("Points outside of the Psi function table are rejected.");
+    else
+        success = false;
+
+    gsl_integration_workspace_free(this->gsl_ad_w);
+
+    return success;
+}
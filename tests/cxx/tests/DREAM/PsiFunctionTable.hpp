@@ -0,0 +1,26 @@
+#ifndef _DREAMTESTS_DREAM_PSI_FUNCTION_TABLE_HPP
+#define _DREAMTESTS_DREAM_PSI_FUNCTION_TABLE_HPP
+
+#include <string>
+#include <gsl/gsl_integration.h>
+#include "DREAM/Equations/PsiFunctionTable.hpp"
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class PsiFunctionTable : public UnitTest {
+    private:
+        gsl_integration_workspace *gsl_ad_w;
+
+        real_t EvaluatePsi(const len_t, const real_t, const real_t);
+
+    public:
+        PsiFunctionTable(const std::string& s) : UnitTest(s) {}
+
+        bool CheckAgainstQuadrature(const DREAM::PsiFunctionTable*);
+        bool CheckOutsideTable(const DREAM::PsiFunctionTable*);
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_PSI_FUNCTION_TABLE_HPP*/
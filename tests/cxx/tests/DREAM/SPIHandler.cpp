@@ -0,0 +1,485 @@
+/**
+ * Test of the deposition and heat absorption profiles of the SPI
+ * shards. The SPI handler only stores and visits the cells in which
+ * each shard deposits material (or absorbs heat), and this test compares
+ * the resulting deposition rate, heat absorption rate and their jacobians
+ * to a reference implementation which evaluates the profiles of all
+ * shards on the full radial grid. The shards move both inwards and
+ * outwards, with one shard close to the magnetic axis, one at the plasma
+ * edge and one entering the plasma from the outside. (None of the shards
+ * passes its turning point during the time step.)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "SPIHandler.hpp"
+#include "DREAM/Constants.hpp"
+#include "FVM/Grid/EmptyMomentumGrid.hpp"
+#include "FVM/Grid/EmptyRadialGrid.hpp"
+#include "FVM/Matrix.hpp"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+const len_t NR = 10;
+const len_t N_SHARD = 5;
+const real_t DT = 1e-4;
+
+// Shard positions at the start and end of the time step
+const real_t XP_PREVIOUS[3*N_SHARD] = {
+    0.73,  0.0,   0.0,      // Moving inwards
+    0.31,  0.12,  0.0,      // Moving outwards
+    0.06,  0.01,  0.0,      // Close to the magnetic axis
+    0.955, 0.01,  0.0,      // Moving outwards at the edge
+    1.03,  0.02,  0.0       // Entering the plasma
+};
+const real_t XP[3*N_SHARD] = {
+    0.58,  0.02,  0.0,
+    0.42,  0.15,  0.0,
+    0.012, 0.004, 0.0,
+    0.995, 0.012, 0.0,
+    0.96,  0.018, 0.0
+};
+// Shard radii at the start of the time step
+const real_t RP_PREVIOUS[N_SHARD] = {2e-3, 1.5e-3, 1e-3, 2.5e-3, 1.8e-3};
+
+// Deuterium pellets (molar mass and solid density as in 'DREAM::SPIHandler')
+const real_t PELLET_MOLAR_VOLUME = 0.0020141/205.9;
+
+
+/**
+ * Generate an unknown quantity handler.
+ *
+ * fluidGrid:  Radial grid on which the plasma quantities live.
+ * scalarGrid: Grid on which the shard quantities live.
+ */
+DREAM::FVM::UnknownQuantityHandler *SPIHandler::GetUnknownHandler(
+    DREAM::FVM::Grid *fluidGrid, DREAM::FVM::Grid *scalarGrid
+) {
+    DREAM::FVM::UnknownQuantityHandler *uqh = new DREAM::FVM::UnknownQuantityHandler();
+
+    this->id_ncold = uqh->InsertUnknown(DREAM::OptionConstants::UQTY_N_COLD, "0", fluidGrid);
+    this->id_Tcold = uqh->InsertUnknown(DREAM::OptionConstants::UQTY_T_COLD, "0", fluidGrid);
+    uqh->InsertUnknown(DREAM::OptionConstants::UQTY_W_COLD, "0", fluidGrid);
+    this->id_Yp = uqh->InsertUnknown(DREAM::OptionConstants::UQTY_Y_P, "0", scalarGrid, N_SHARD);
+    len_t id_xp = uqh->InsertUnknown(DREAM::OptionConstants::UQTY_X_P, "0", scalarGrid, 3*N_SHARD);
+    uqh->InsertUnknown(DREAM::OptionConstants::UQTY_V_P, "0", scalarGrid, 3*N_SHARD);
+
+    real_t ncold[NR], Tcold[NR];
+    for (len_t ir = 0; ir < NR; ir++) {
+        ncold[ir] = 1e19*(1+ir);
+        Tcold[ir] = 100.0*(NR-ir) + 5;
+    }
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_N_COLD, ncold);
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_T_COLD, Tcold);
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_W_COLD, nullptr);
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_V_P, nullptr);
+
+    // Set the shard quantities at the start of the time step...
+    real_t Yp[N_SHARD];
+    for (len_t ip = 0; ip < N_SHARD; ip++)
+        Yp[ip] = pow(RP_PREVIOUS[ip], 5.0/3.0);
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_Y_P, Yp);
+    uqh->SetInitialValue(DREAM::OptionConstants::UQTY_X_P, XP_PREVIOUS);
+
+    // ...and at the end of the time step
+    for (len_t ip = 0; ip < N_SHARD; ip++)
+        Yp[ip] *= 0.9;
+    uqh->Store(this->id_Yp, Yp);
+    uqh->Store(id_xp, XP);
+
+    return uqh;
+}
+
+/**
+ * Locate the shards on the radial grid (with a linear search).
+ */
+void SPIHandler::ReferenceIrp() {
+    for (len_t ip = 0; ip < nShard; ip++) {
+        irp[ip] = nr;
+        for (len_t ir = 0; ir < nr; ir++) {
+            if (rCoordPNext[ip] < rGrid->GetR_f(ir+1) && rCoordPNext[ip] > rGrid->GetR_f(ir)) {
+                irp[ip] = ir;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Evaluate the time averaged delta function source of all
+ * shards in all grid cells (size nr*nShard).
+ */
+void SPIHandler::ReferenceTimeAveragedDeltaSource(real_t *source) {
+    for (len_t ip = 0; ip < nShard; ip++) {
+        for (len_t ir = 0; ir < nr; ir++)
+            source[ir*nShard+ip] = 0;
+
+        if (irp[ip] >= nr)
+            continue;
+
+        real_t rSourceMax = max(rCoordPPrevious[ip], rCoordPNext[ip]);
+        real_t rSourceMin = min(rCoordPPrevious[ip], rCoordPNext[ip]);
+        for (len_t ir = 0; ir < nr; ir++) {
+            if (!(rGrid->GetR_f(ir) > rSourceMax || rGrid->GetR_f(ir+1) < rSourceMin))
+                source[ir*nShard+ip] += 1.0/(rGrid->GetVpVol(ir)*VpVolNormFactor*(rSourceMax-rSourceMin))*
+                    (min(rGrid->GetR_f(ir+1),rSourceMax)-max(rGrid->GetR_f(ir),rSourceMin))/rGrid->GetDr(ir);
+        }
+    }
+}
+
+/**
+ * Evaluate the Gaussian source of all shards in all
+ * grid cells (size nr*nShard).
+ */
+void SPIHandler::ReferenceGaussianSource(real_t *source) {
+    for (len_t ip = 0; ip < nShard; ip++) {
+        for (len_t ir = 0; ir < nr; ir++) {
+            const real_t r1 = rGrid->GetR_f(ir), r2 = rGrid->GetR_f(ir+1);
+            source[ir*nShard+ip] =
+                ((erf((r2-rCoordPNext[ip])/rCld[ip]) - erf((r1-rCoordPNext[ip])/rCld[ip]))/2 +
+                 (erf((-r2-rCoordPNext[ip])/rCld[ip]) - erf((-r1-rCoordPNext[ip])/rCld[ip]))/2) /
+                (2*M_PI*M_PI*VpVolNormFactor*(r2*r2 - r1*r1));
+        }
+    }
+}
+
+/**
+ * Shift the given source (size nr*nShard) to the last
+ * flux tube passed by each shard.
+ */
+void SPIHandler::ReferenceShiftLastFluxTube(real_t *source) {
+    for (len_t ip = 0; ip < nShard; ip++) {
+        if (rCoordPNext[ip] > rCoordPPrevious[ip]) {
+            for (len_t ir = 0; ir < nr-1; ir++)
+                source[ir*nShard+ip] = rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*source[(ir+1)*nShard+ip];
+        } else if (rCoordPNext[ip] < rCoordPPrevious[ip]) {
+            for (len_t ir = nr-1; ir > 0; ir--)
+                source[ir*nShard+ip] = rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*source[(ir-1)*nShard+ip];
+        }
+    }
+}
+
+/**
+ * Evaluate the deposition rate from the given deposition
+ * profiles (size nr*nShard).
+ */
+void SPIHandler::ReferenceDepositionRate(
+    const real_t *profiles, const real_t *SPIMolarFraction,
+    const real_t dt, real_t *rate
+) {
+    for (len_t ir = 0; ir < nr; ir++) {
+        rate[ir] = 0;
+        for (len_t ip = 0; ip < nShard; ip++) {
+            if (YpPrevious[ip] > 0 && irp[ip] < nr)
+                rate[ir] += -SPIMolarFraction[ip]*4.0*M_PI*(Yp[ip]/abs(Yp[ip])*pow(abs(Yp[ip]),9.0/5.0)-pow(YpPrevious[ip],9.0/5.0))
+                    /3.0/pelletMolarVolume[ip]*DREAM::Constants::N_Avogadro/dt*profiles[ir*nShard+ip];
+        }
+    }
+}
+
+/**
+ * Evaluate the heat absorption rate from the given heat
+ * absorption profiles (size nr*nShard).
+ */
+void SPIHandler::ReferenceHeatAbsorbtionRate(const real_t *profiles, real_t *rate) {
+    for (len_t ir = 0; ir < nr; ir++) {
+        rate[ir] = 0;
+        for (len_t ip = 0; ip < nShard; ip++) {
+            if (YpPrevious[ip] > 0 && irp[ip] < nr) {
+                const len_t i = irp[ip];
+                real_t prefactor = M_PI*rCld[ip]*rCld[ip]*ncold[i]*sqrt(8.0*DREAM::Constants::ec*Tcold[i]/(M_PI*DREAM::Constants::me))*DREAM::Constants::ec*Tcold[i];
+
+                rate[ir] += -prefactor*profiles[ir*nShard+ip];
+
+                if (rCoordPNext[ip] > rCoordPPrevious[ip] && ir < nr-1)
+                    rate[ir] += rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*profiles[(ir+1)*nShard+ip];
+                else if (rCoordPNext[ip] < rCoordPPrevious[ip] && ir > 0)
+                    rate[ir] += rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*profiles[(ir-1)*nShard+ip];
+            }
+        }
+    }
+}
+
+/**
+ * Evaluate the jacobian of the deposition rate with respect to
+ * Y_p as a dense nr-by-nr matrix (only the first nShard columns
+ * are used).
+ *
+ * RETURNS true if any element of the jacobian was set.
+ */
+bool SPIHandler::ReferenceDepositionRateJacobian(
+    const real_t *profiles, const real_t *scaleFactor,
+    const real_t *SPIMolarFraction, const real_t dt, real_t *jac
+) {
+    bool jacIsSet = false;
+    for (len_t ir = 0; ir < nr; ir++) {
+        for (len_t ip = 0; ip < nShard; ip++) {
+            if (YpPrevious[ip] > 0) {
+                jac[ir*nr+ip] += -scaleFactor[ir]*SPIMolarFraction[ip]*12.0/5.0*M_PI*pow(abs(Yp[ip]),4.0/5.0)
+                    /pelletMolarVolume[ip]*DREAM::Constants::N_Avogadro/dt*profiles[ir*nShard+ip];
+                jacIsSet = true;
+            }
+        }
+    }
+
+    return jacIsSet;
+}
+
+/**
+ * Evaluate the jacobian of the heat absorption rate with respect
+ * to the given unknown as a dense nr-by-nr matrix (for Y_p, only
+ * the first nShard columns are used).
+ *
+ * RETURNS true if any element of the jacobian was set.
+ */
+bool SPIHandler::ReferenceHeatAbsorbtionRateJacobian(
+    const len_t derivId, const real_t *profiles, const struct spitest_case& c,
+    const real_t scaleFactor, real_t *jac
+) {
+    bool jacIsSet = false;
+    for (len_t ir = 0; ir < nr; ir++) {
+        for (len_t ip = 0; ip < nShard; ip++) {
+            if (irp[ip] >= nr)
+                continue;
+
+            const len_t i = irp[ip];
+            const real_t vth = sqrt(8.0*DREAM::Constants::ec*Tcold[i]/(M_PI*DREAM::Constants::me));
+            real_t prefactor;
+            len_t col;
+            if (derivId == this->id_Yp) {
+                if (c.cloudRadius != DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_SELFCONSISTENT || YpPrevious[ip] <= 0)
+                    continue;
+
+                prefactor = -scaleFactor*6.0/5.0/Yp[ip]*M_PI*rCld[ip]*rCld[ip]*ncold[i]*vth*DREAM::Constants::ec*Tcold[i];
+                col = ip;
+            } else if (derivId == this->id_Tcold) {
+                prefactor = -scaleFactor*3.0/2.0*M_PI*rCld[ip]*rCld[ip]*ncold[i]*vth*DREAM::Constants::ec;
+                col = i;
+            } else {
+                prefactor = -scaleFactor*M_PI*rCld[ip]*rCld[ip]*vth*DREAM::Constants::ec*Tcold[i];
+                col = i;
+            }
+
+            real_t jacEl = prefactor*profiles[ir*nShard+ip];
+            if (rCoordPNext[ip] > rCoordPPrevious[ip] && ir < nr-1)
+                jacEl += -rGrid->GetVpVol(ir+1)/rGrid->GetVpVol(ir)*prefactor*profiles[(ir+1)*nShard+ip];
+            else if (rCoordPNext[ip] < rCoordPPrevious[ip] && ir > 0)
+                jacEl += -rGrid->GetVpVol(ir-1)/rGrid->GetVpVol(ir)*prefactor*profiles[(ir-1)*nShard+ip];
+
+            jac[ir*nr+col] += jacEl;
+            jacIsSet = true;
+        }
+    }
+
+    return jacIsSet;
+}
+
+/**
+ * Compare the given (assembled) nr-by-nr matrix to the
+ * given dense reference matrix.
+ *
+ * RETURNS the maximum difference between the matrices,
+ * relative to the largest element of the reference.
+ */
+real_t SPIHandler::CompareMatrix(DREAM::FVM::Matrix *mat, const real_t *ref) {
+    real_t maxDiff = 0, maxRef = 0;
+    for (len_t i = 0; i < nr; i++) {
+        for (len_t j = 0; j < nr; j++) {
+            maxDiff = max(maxDiff, abs(mat->GetElement(i, j) - ref[i*nr+j]));
+            maxRef = max(maxRef, abs(ref[i*nr+j]));
+        }
+    }
+
+    return (maxRef > 0 ? maxDiff/maxRef : maxDiff);
+}
+
+/**
+ * Run the SPI handler with the given deposition, heat absorption
+ * and cloud radius models, and compare with the reference.
+ */
+bool SPIHandler::CheckCase(const struct spitest_case& c) {
+    const real_t TOLERANCE = 1e-12;
+    bool success = true;
+
+    DREAM::FVM::Grid *fluidGrid = this->InitializeFluidGrid(NR);
+    DREAM::FVM::RadialGrid *scalarRGrid = new DREAM::FVM::EmptyRadialGrid();
+    DREAM::FVM::Grid *scalarGrid = new DREAM::FVM::Grid(scalarRGrid, new DREAM::FVM::EmptyMomentumGrid(scalarRGrid));
+    scalarGrid->Rebuild(0);
+    DREAM::FVM::UnknownQuantityHandler *uqh = GetUnknownHandler(fluidGrid, scalarGrid);
+
+    len_t Z[1] = {1}, isotopes[1] = {2};
+    real_t molarFraction[N_SHARD];
+    for (len_t ip = 0; ip < N_SHARD; ip++)
+        molarFraction[ip] = 1;
+
+    DREAM::SPIHandler *spi = new DREAM::SPIHandler(
+        fluidGrid, uqh, Z, isotopes, molarFraction, 1,
+        DREAM::OptionConstants::EQTERM_SPI_VELOCITY_MODE_PRESCRIBED,
+        DREAM::OptionConstants::EQTERM_SPI_ABLATION_MODE_NEGLECT,
+        c.deposition, c.heatAbsorbtion, c.cloudRadius,
+        DREAM::OptionConstants::EQTERM_SPI_MAGNETIC_FIELD_DEPENDENCE_MODE_NEGLECT,
+        1.0, c.rclPrescribedConstant
+    );
+    spi->Rebuild(DT);
+
+    // Set up the reference
+    this->rGrid = fluidGrid->GetRadialGrid();
+    this->nr = NR;
+    this->nShard = N_SHARD;
+    this->VpVolNormFactor = (isinf(rGrid->GetR0()) ? 1.0 : rGrid->GetR0());
+    this->ncold = uqh->GetUnknownData(this->id_ncold);
+    this->Tcold = uqh->GetUnknownData(this->id_Tcold);
+    this->Yp = uqh->GetUnknownData(this->id_Yp);
+    this->YpPrevious = uqh->GetUnknownDataPrevious(this->id_Yp);
+
+    rCoordPPrevious.resize(nShard);
+    rCoordPNext.resize(nShard);
+    rCld.resize(nShard);
+    pelletMolarVolume.assign(nShard, PELLET_MOLAR_VOLUME);
+    irp.resize(nShard);
+    for (len_t ip = 0; ip < nShard; ip++) {
+        // Cylindrical grid
+        rCoordPPrevious[ip] = hypot(XP_PREVIOUS[3*ip], XP_PREVIOUS[3*ip+1]);
+        rCoordPNext[ip] = hypot(XP[3*ip], XP[3*ip+1]);
+
+        if (c.cloudRadius == DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_SELFCONSISTENT)
+            rCld[ip] = 10*pow(Yp[ip], 3.0/5.0);
+        else
+            rCld[ip] = c.rclPrescribedConstant;
+    }
+    ReferenceIrp();
+
+    real_t *depositionProfiles = new real_t[nr*nShard];
+    real_t *heatAbsorbtionProfiles = new real_t[nr*nShard];
+    if (c.deposition == DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_GAUSSIAN)
+        ReferenceGaussianSource(depositionProfiles);
+    else {
+        ReferenceTimeAveragedDeltaSource(depositionProfiles);
+        if (c.deposition == DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_LAST_FLUX_TUBE)
+            ReferenceShiftLastFluxTube(depositionProfiles);
+    }
+
+    if (c.heatAbsorbtion == DREAM::OptionConstants::EQTERM_SPI_HEAT_ABSORBTION_MODE_LOCAL_FLUID_NGS_GAUSSIAN)
+        ReferenceGaussianSource(heatAbsorbtionProfiles);
+    else
+        ReferenceTimeAveragedDeltaSource(heatAbsorbtionProfiles);
+
+    // Compare deposition rate...
+    real_t SPIMolarFraction[N_SHARD], scaleFactor[NR];
+    for (len_t ip = 0; ip < nShard; ip++)
+        SPIMolarFraction[ip] = 0.5 + 0.1*ip;
+    for (len_t ir = 0; ir < nr; ir++)
+        scaleFactor[ir] = 1.0 + 0.1*ir;
+
+    real_t depositionRate[NR], heatAbsorbtionRate[NR];
+    ReferenceDepositionRate(depositionProfiles, SPIMolarFraction, DT, depositionRate);
+    ReferenceHeatAbsorbtionRate(heatAbsorbtionProfiles, heatAbsorbtionRate);
+
+    const real_t *spiDepositionRate = spi->CalculateDepositionRate(SPIMolarFraction);
+    const real_t *spiHeatAbsorbtionRate = spi->GetHeatAbsorbtionRate();
+
+    auto compareVectors = [this](const real_t *a, const real_t *ref) {
+        real_t maxDiff = 0, maxRef = 0;
+        for (len_t ir = 0; ir < nr; ir++) {
+            maxDiff = max(maxDiff, abs(a[ir]-ref[ir]));
+            maxRef = max(maxRef, abs(ref[ir]));
+        }
+        return (maxRef > 0 ? maxDiff/maxRef : maxDiff);
+    };
+
+    real_t Delta = compareVectors(spiDepositionRate, depositionRate);
+    if (Delta > TOLERANCE) {
+        this->PrintError("%s: deposition rate differs from reference. Delta = %.3e.", c.name.c_str(), Delta);
+        success = false;
+    }
+
+    // ...heat absorption rate...
+    Delta = compareVectors(spiHeatAbsorbtionRate, heatAbsorbtionRate);
+    if (Delta > TOLERANCE) {
+        this->PrintError("%s: heat absorption rate differs from reference. Delta = %.3e.", c.name.c_str(), Delta);
+        success = false;
+    }
+
+    // ...and jacobians
+    real_t *refJac = new real_t[nr*nr];
+    auto checkJacobian = [&](const string& name, bool isSet, bool refIsSet, DREAM::FVM::Matrix *jac) {
+        jac->Assemble();
+        if (isSet != refIsSet) {
+            this->PrintError("%s: %s jacobian %s set, but reference %s.",
+                c.name.c_str(), name.c_str(), isSet ? "was" : "was not", refIsSet ? "was" : "was not");
+            success = false;
+        }
+
+        real_t d = CompareMatrix(jac, refJac);
+        if (d > TOLERANCE) {
+            this->PrintError("%s: %s jacobian differs from reference. Delta = %.3e.", c.name.c_str(), name.c_str(), d);
+            success = false;
+        }
+    };
+
+    DREAM::FVM::Matrix *jac = new DREAM::FVM::Matrix(nr, nr, nr);
+    for (len_t i = 0; i < nr*nr; i++) refJac[i] = 0;
+    bool refIsSet = ReferenceDepositionRateJacobian(depositionProfiles, scaleFactor, SPIMolarFraction, DT, refJac);
+    bool isSet = spi->setJacobianDepositionRate(jac, this->id_Yp, scaleFactor, SPIMolarFraction, 0);
+    checkJacobian("d(deposition)/dYp", isSet, refIsSet, jac);
+    delete jac;
+
+    const len_t derivIds[3] = {this->id_Yp, this->id_Tcold, this->id_ncold};
+    const char *derivNames[3] = {"d(heat absorption)/dYp", "d(heat absorption)/dTcold", "d(heat absorption)/dncold"};
+    for (len_t k = 0; k < 3; k++) {
+        jac = new DREAM::FVM::Matrix(nr, nr, nr);
+        for (len_t i = 0; i < nr*nr; i++) refJac[i] = 0;
+
+        refIsSet = ReferenceHeatAbsorbtionRateJacobian(derivIds[k], heatAbsorbtionProfiles, c, 1.3, refJac);
+        isSet = spi->setJacobianAdiabaticHeatAbsorbtionRate(jac, derivIds[k], 1.3);
+        checkJacobian(derivNames[k], isSet, refIsSet, jac);
+
+        delete jac;
+    }
+
+    delete [] refJac;
+    delete [] heatAbsorbtionProfiles;
+    delete [] depositionProfiles;
+    delete spi;
+    delete uqh;
+    delete scalarGrid;
+    delete fluidGrid;
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool SPIHandler::Run(bool) {
+    bool success = true;
+
+    const struct spitest_case cases[] = {
+        {"delta source", DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL,
+            DREAM::OptionConstants::EQTERM_SPI_HEAT_ABSORBTION_MODE_LOCAL_FLUID_NGS,
+            DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_SELFCONSISTENT, 0.0},
+        {"delta source (last flux tube)", DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_LAST_FLUX_TUBE,
+            DREAM::OptionConstants::EQTERM_SPI_HEAT_ABSORBTION_MODE_LOCAL_FLUID_NGS,
+            DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_PRESCRIBED_CONSTANT, 0.05},
+        {"Gaussian source", DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_GAUSSIAN,
+            DREAM::OptionConstants::EQTERM_SPI_HEAT_ABSORBTION_MODE_LOCAL_FLUID_NGS_GAUSSIAN,
+            DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_SELFCONSISTENT, 0.0},
+        {"Gaussian source (wide cloud)", DREAM::OptionConstants::EQTERM_SPI_DEPOSITION_MODE_LOCAL_GAUSSIAN,
+            DREAM::OptionConstants::EQTERM_SPI_HEAT_ABSORBTION_MODE_LOCAL_FLUID_NGS_GAUSSIAN,
+            DREAM::OptionConstants::EQTERM_SPI_CLOUD_RADIUS_MODE_PRESCRIBED_CONSTANT, 0.15}
+    };
+
+    for (auto &c : cases) {
+        if (CheckCase(c))
+            this->PrintOK("%s: SPI rates and jacobians agree with the dense reference.", c.name.c_str());
+        else
+            success = false;
+    }
+
+    return success;
+}
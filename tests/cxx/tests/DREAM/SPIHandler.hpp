@@ -0,0 +1,55 @@
+#ifndef _DREAMTESTS_DREAM_SPI_HANDLER_HPP
+#define _DREAMTESTS_DREAM_SPI_HANDLER_HPP
+
+#include <string>
+#include <vector>
+#include "FVM/Grid/Grid.hpp"
+#include "FVM/UnknownQuantityHandler.hpp"
+#include "DREAM/Equations/SPIHandler.hpp"
+#include "DREAM/Settings/OptionConstants.hpp"
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class SPIHandler : public UnitTest {
+    public:
+        struct spitest_case {
+            std::string name;
+            enum DREAM::OptionConstants::eqterm_spi_deposition_mode deposition;
+            enum DREAM::OptionConstants::eqterm_spi_heat_absorbtion_mode heatAbsorbtion;
+            enum DREAM::OptionConstants::eqterm_spi_cloud_radius_mode cloudRadius;
+            real_t rclPrescribedConstant;
+        };
+
+    private:
+        len_t id_ncold, id_Tcold, id_Yp;
+
+        // Quantities used by the dense reference implementation
+        DREAM::FVM::RadialGrid *rGrid;
+        len_t nr, nShard;
+        real_t VpVolNormFactor;
+        const real_t *ncold, *Tcold, *Yp, *YpPrevious;
+        std::vector<real_t> rCoordPPrevious, rCoordPNext, rCld, pelletMolarVolume;
+        std::vector<len_t> irp;
+
+        void ReferenceIrp();
+        void ReferenceTimeAveragedDeltaSource(real_t*);
+        void ReferenceGaussianSource(real_t*);
+        void ReferenceShiftLastFluxTube(real_t*);
+        void ReferenceDepositionRate(const real_t*, const real_t*, const real_t, real_t*);
+        void ReferenceHeatAbsorbtionRate(const real_t*, real_t*);
+        bool ReferenceDepositionRateJacobian(const real_t*, const real_t*, const real_t*, const real_t, real_t*);
+        bool ReferenceHeatAbsorbtionRateJacobian(const len_t, const real_t*, const struct spitest_case&, const real_t, real_t*);
+
+        real_t CompareMatrix(DREAM::FVM::Matrix*, const real_t*);
+
+    public:
+        SPIHandler(const std::string& s) : UnitTest(s) {}
+
+        DREAM::FVM::UnknownQuantityHandler *GetUnknownHandler(DREAM::FVM::Grid*, DREAM::FVM::Grid*);
+        bool CheckCase(const struct spitest_case&);
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_SPI_HANDLER_HPP*/
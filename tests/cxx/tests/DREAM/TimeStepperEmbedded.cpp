@@ -0,0 +1,118 @@
+/**
+ * Test of the embedded error estimate used by 'TimeStepperEmbedded'.
+ * A single step of the relaxation problem
+ *
+ *   dx/dt = -x/tau
+ *
+ * is taken with the backward Euler or BDF2 method, starting from the
+ * exact solution at the previous (unevenly spaced) times. The error
+ * estimated by the time stepper is then compared to the true local
+ * error of the step, which it should approach as the time step is
+ * decreased.
+ */
+
+#include <cmath>
+#include <string>
+#include "DREAM/TimeStepper/TimeStepperEmbedded.hpp"
+#include "TimeStepperEmbedded.hpp"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+/**
+ * Take a single step of length 'h' and return the ratio of the
+ * estimated error to the true local error of the step. The two
+ * previous time steps have the lengths 1.6*h and 0.7*h.
+ *
+ * order: Order of the time discretization to use (1 or 2).
+ * h:     Length of the time step to take.
+ */
+real_t TimeStepperEmbedded::EstimateErrorRatio(const len_t order, const real_t h) {
+    const real_t t[3] = {1.0, 1.0-1.6*h, 1.0-2.3*h};
+    const real_t x0 = Solution(t[0]), x1 = Solution(t[1]), x2 = Solution(t[2]);
+
+    // Solve for the solution at t_{n+1} = t_n + h
+    real_t x;
+    if (order == 1)
+        x = x0 / (1 + h/TAU);
+    else {
+        const real_t w = h / (t[0]-t[1]);
+        const real_t c0 = (1+2*w)/(1+w), c1 = -(1+w), c2 = w*w/(1+w);
+        x = -(c1*x0 + c2*x1) / (c0 + h/TAU);
+    }
+
+    real_t xRef;
+    DREAM::TimeStepperEmbedded::EstimateSolution(
+        order, h, t, &x, &x0, &x1, &x2, &xRef, 1
+    );
+
+    const real_t estErr  = x - xRef;
+    const real_t trueErr = x - Solution(t[0]+h);
+
+    return estErr / trueErr;
+}
+
+/**
+ * Verify that the error estimate for a time discretization of
+ * the given order converges to the true local error.
+ *
+ * order: Order of the time discretization to test (1 or 2).
+ */
+bool TimeStepperEmbedded::CheckErrorEstimate(const len_t order) {
+    const len_t NSTEPS = 6;
+    const real_t H0 = 0.1, TOLERANCE = 0.02, ORDER_TOLERANCE = 0.2;
+
+    bool success = true;
+    real_t dev = 0, prevDev = 0;
+    for (len_t i = 0; i < NSTEPS; i++) {
+        const real_t h = H0 / (1 << i);
+        dev = fabs(EstimateErrorRatio(order, h) - 1);
+
+        // The leading-order error estimate should have a relative
+        // error proportional to h
+        if (i > 0) {
+            const real_t p = log2(prevDev / dev);
+            if (fabs(p - 1) > ORDER_TOLERANCE) {
+                this->PrintError(
+                    "Order " LEN_T_PRINTF_FMT " error estimate does not converge linearly "
+                    "to the true error at dt = %.4e (observed order: %.3f).",
+                    order, h, p
+                );
+                success = false;
+            }
+        }
+
+        prevDev = dev;
+    }
+
+    if (dev > TOLERANCE) {
+        this->PrintError(
+            "Order " LEN_T_PRINTF_FMT " error estimate deviates from the true error "
+            "by %.3f%% at dt = %.4e.", order, dev*100, H0 / (1 << (NSTEPS-1))
+        );
+        success = false;
+    }
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool TimeStepperEmbedded::Run(bool) {
+    bool success = true;
+
+    if (CheckErrorEstimate(1))
+        this->PrintOK("The backward Euler error estimate agrees with the true local error.");
+    else
+        success = false;
+
+    if (CheckErrorEstimate(2))
+        this->PrintOK("The BDF2 error estimate agrees with the true local error.");
+    else
+        success = false;
+
+    return success;
+}
@@ -0,0 +1,26 @@
+#ifndef _DREAMTESTS_DREAM_TIME_STEPPER_EMBEDDED_HPP
+#define _DREAMTESTS_DREAM_TIME_STEPPER_EMBEDDED_HPP
+
+#include <cmath>
+#include <string>
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class TimeStepperEmbedded : public UnitTest {
+    private:
+        // Relaxation time of the test problem
+        const real_t TAU = 0.5;
+
+        real_t Solution(const real_t t) { return exp(-t/TAU); }
+        real_t EstimateErrorRatio(const len_t, const real_t);
+
+    public:
+        TimeStepperEmbedded(const std::string& s) : UnitTest(s) {}
+
+        bool CheckErrorEstimate(const len_t);
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_TIME_STEPPER_EMBEDDED_HPP*/
@@ -0,0 +1,196 @@
+/**
+ * Test of the windowed interpolation in time of prescribed transport
+ * coefficients. With 'windowed' set, 'DREAM::TransportPrescribed' only
+ * keeps the two time slices bracketing the current time interpolated
+ * onto the simulation grid (optionally interpolating the next slice on a
+ * background thread), and this test compares the resulting coefficients
+ * to those obtained when all time slices are interpolated up front and
+ * evaluated with 'Interpolator1D'. Time is stepped both forwards and
+ * backwards (as after a rejected time step), jumps across several time
+ * slices at once and leaves the prescribed time interval on both sides.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "TransportPrescribed.hpp"
+
+
+using namespace DREAMTESTS::_DREAM;
+using namespace std;
+
+
+// Grid on which the coefficients are prescribed
+const len_t NR_IN = 5, NP_IN = 4, NXI_IN = 3;
+const real_t R_IN[NR_IN]   = {0.0, 0.2, 0.45, 0.7, 1.0};
+const real_t P_IN[NP_IN]   = {0.0, 2.0, 6.0, 12.0};
+const real_t XI_IN[NXI_IN] = {-1.0, 0.1, 1.0};
+
+// Times at which the simulation term is rebuilt. Besides stepping
+// forwards, time steps backwards after a rejected step (0.9 -> 0.7),
+// jumps back across several time slices (3.1 -> 1.2), lies before the
+// first prescribed time point (-0.4, -1) and after the last (6.5, 5.5).
+const len_t NT_SEQ = 19;
+const real_t T_SEQ[NT_SEQ] = {
+    -0.4, 0.0, 0.1, 0.5, 0.9, 0.7, 0.95, 1.7, 3.1, 1.2,
+    3.15, 3.3, 4.9, 5.0, 6.5, 5.5, 4.0, 0.3, -1.0
+};
+
+
+/**
+ * Compare the diffusion coefficients of two prescribed transport terms.
+ *
+ * RETURNS the largest relative difference between the two.
+ */
+real_t TransportPrescribed::CompareCoefficients(
+    DREAM::FVM::Grid *grid, DREAM::TransportPrescribedDiffusive *a,
+    DREAM::TransportPrescribedDiffusive *b
+) {
+    const len_t nr = grid->GetNr();
+    const len_t N  = grid->GetMomentumGrid(0)->GetNCells();
+
+    real_t delta = 0;
+    for (len_t ir = 0; ir < nr+1; ir++) {
+        const real_t *da = a->GetDiffusionCoeffRR(ir);
+        const real_t *db = b->GetDiffusionCoeffRR(ir);
+
+        for (len_t j = 0; j < N; j++) {
+            real_t d = abs(da[j]-db[j]) / max(abs(da[j]), 1.0);
+            delta = max(delta, d);
+        }
+    }
+
+    return delta;
+}
+
+/**
+ * Rebuild a prescribed transport term using the dense, windowed and
+ * windowed+prefetched interpolation in time at each of the given times,
+ * and verify that the resulting coefficients are the same.
+ *
+ * name:      Name of test case (for error messages).
+ * grid:      Grid to interpolate the coefficients onto.
+ * nt:        Number of prescribed time points.
+ * t:         Prescribed time points.
+ * nts:       Number of times to rebuild the terms at.
+ * ts:        Times to rebuild the terms at.
+ * rebuildAt: Index in 'ts' before which the grid is marked as rebuilt
+ *            (which discards the interpolated time slices).
+ *
+ * RETURNS true if the coefficients agree at all times.
+ */
+bool TransportPrescribed::CheckTimeSequence(
+    const string& name, DREAM::FVM::Grid *grid, const len_t nt,
+    const real_t *t, const len_t nts, const real_t *ts, const len_t rebuildAt
+) {
+    const real_t TOL = 1e-12;
+    const len_t N = NR_IN*NXI_IN*NP_IN;
+    bool success = true;
+
+    // Prescribed coefficient. The time dependence is deliberately
+    // non-linear so that interpolating between the wrong slices is
+    // detected.
+    real_t *data = new real_t[nt*N];
+    const real_t **coeff = new const real_t*[nt];
+    for (len_t it = 0; it < nt; it++) {
+        real_t *c = data + it*N;
+        const real_t ft = 1 + 0.37*it + sin(1.3*it);
+
+        for (len_t ir = 0; ir < NR_IN; ir++)
+            for (len_t j = 0; j < NXI_IN; j++)
+                for (len_t k = 0; k < NP_IN; k++)
+                    c[(ir*NXI_IN + j)*NP_IN + k] =
+                        ft * (1 + R_IN[ir]*R_IN[ir]) * (1 + 0.1*P_IN[k]) * (1 + 0.5*XI_IN[j]*ft);
+
+        coeff[it] = c;
+    }
+
+    #define CONSTRUCT(windowed,prefetch) \
+        new DREAM::TransportPrescribedDiffusive( \
+            grid, nt, NR_IN, NP_IN, NXI_IN, coeff, t, R_IN, P_IN, XI_IN, \
+            DREAM::FVM::Interpolator3D::GRID_PXI, DREAM::FVM::Interpolator3D::GRID_PXI, \
+            DREAM::FVM::Interpolator3D::INTERP_LINEAR, (windowed), (prefetch), true \
+        )
+
+    DREAM::TransportPrescribedDiffusive *dense    = CONSTRUCT(false, false);
+    DREAM::TransportPrescribedDiffusive *windowed = CONSTRUCT(true, false);
+    DREAM::TransportPrescribedDiffusive *prefetch = CONSTRUCT(true, true);
+
+    #undef CONSTRUCT
+
+    for (len_t i = 0; i < nts; i++) {
+        if (i == rebuildAt) {
+            dense->GridRebuilt();
+            windowed->GridRebuilt();
+            prefetch->GridRebuilt();
+        }
+
+        dense->Rebuild(ts[i], 0, nullptr);
+        windowed->Rebuild(ts[i], 0, nullptr);
+        prefetch->Rebuild(ts[i], 0, nullptr);
+
+        real_t dw = CompareCoefficients(grid, dense, windowed);
+        real_t dp = CompareCoefficients(grid, dense, prefetch);
+
+        if (dw > TOL) {
+            this->PrintError(
+                "%s: windowed interpolation differs from dense interpolation "
+                "at t = %.3f (step " LEN_T_PRINTF_FMT "). Max relative error: %.3e.",
+                name.c_str(), ts[i], i, dw
+            );
+            success = false;
+        }
+        if (dp > TOL) {
+            this->PrintError(
+                "%s: prefetched interpolation differs from dense interpolation "
+                "at t = %.3f (step " LEN_T_PRINTF_FMT "). Max relative error: %.3e.",
+                name.c_str(), ts[i], i, dp
+            );
+            success = false;
+        }
+
+        if (!success)
+            break;
+    }
+
+    delete prefetch;
+    delete windowed;
+    delete dense;
+
+    delete [] coeff;
+    delete [] data;
+
+    return success;
+}
+
+/**
+ * Run this test.
+ */
+bool TransportPrescribed::Run(bool) {
+    bool success = true;
+    DREAM::FVM::Grid *grid = InitializeGridRCylPXi(4, 6, 5);
+
+    // Non-uniform, increasing time points
+    const len_t NT = 6;
+    const real_t t_inc[NT] = {0.0, 0.8, 1.5, 3.0, 3.2, 5.0};
+    success &= CheckTimeSequence("increasing time", grid, NT, t_inc, NT_SEQ, T_SEQ, 12);
+
+    // Decreasing time points
+    real_t t_dec[NT];
+    for (len_t i = 0; i < NT; i++)
+        t_dec[i] = t_inc[NT-1-i];
+    success &= CheckTimeSequence("decreasing time", grid, NT, t_dec, NT_SEQ, T_SEQ, 7);
+
+    // Only two time points (a single window)
+    success &= CheckTimeSequence("two time points", grid, 2, t_inc+2, NT_SEQ, T_SEQ, NT_SEQ);
+
+    // Only a single time point (constant in time)
+    success &= CheckTimeSequence("single time point", grid, 1, t_inc+3, NT_SEQ, T_SEQ, NT_SEQ);
+
+    delete grid;
+
+    if (success)
+        this->PrintOK("Windowed interpolation of prescribed transport agrees with dense interpolation.");
+
+    return success;
+}
@@ -0,0 +1,29 @@
+#ifndef _DREAMTESTS_DREAM_TRANSPORT_PRESCRIBED_HPP
+#define _DREAMTESTS_DREAM_TRANSPORT_PRESCRIBED_HPP
+
+#include <string>
+#include "DREAM/Equations/TransportPrescribed.hpp"
+#include "FVM/Grid/Grid.hpp"
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::_DREAM {
+    class TransportPrescribed : public UnitTest {
+    private:
+        real_t CompareCoefficients(
+            DREAM::FVM::Grid*, DREAM::TransportPrescribedDiffusive*,
+            DREAM::TransportPrescribedDiffusive*
+        );
+
+    public:
+        TransportPrescribed(const std::string& s) : UnitTest(s) {}
+
+        bool CheckTimeSequence(
+            const std::string&, DREAM::FVM::Grid*, const len_t, const real_t*,
+            const len_t, const real_t*, const len_t
+        );
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_DREAM_TRANSPORT_PRESCRIBED_HPP*/
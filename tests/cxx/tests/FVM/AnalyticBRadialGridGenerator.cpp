@@ -45,6 +45,13 @@ bool AnalyticBRadialGridGenerator::Run(bool) {
         success = false;
         this->PrintError("General bounce average test failed.");
     }
+
+    if (TestInverseMapping())
+        this->PrintOK("The inverse flux-surface mapping recovers the flux surface coordinates.");
+    else {
+        success = false;
+        this->PrintError("Inverse flux-surface mapping test failed.");
+    }
     
     delete grid;
 
@@ -216,3 +223,62 @@ bool AnalyticBRadialGridGenerator::TestGeneralFluxSurfaceAverage(){
     
     return success;
 }
+
+/**
+ * Map a set of points given in flux surface coordinates (r, theta, phi)
+ * to cartesian coordinates, using the shape profiles set up in
+ * 'InitializeGridGeneralRPXi()' (which are linear in r), and verify
+ * that GetRThetaPhiFromCartesian() maps them back to the original
+ * flux surface coordinates.
+ */
+bool AnalyticBRadialGridGenerator::TestInverseMapping(){
+    real_t TOLERANCE = 1e-6;
+
+    // Parameters of the shape profiles used in 'InitializeGridGeneralRPXi()'
+    const real_t R0 = 4, ra = 2;
+    const real_t DeltaMax = 0.6, deltaMax = 0.2, kappaMin = 1.4, kappaMax = 1.9;
+
+    const len_t Nr = 4, Ntheta = 8, Nphi = 2;
+    real_t rs[Nr] = {0.3, 0.9, 1.5, 1.9};
+    real_t thetas[Ntheta] = {0.3, 1.2, 2.0, 2.9, 3.6, 4.4, 5.1, 6.0};
+    real_t phis[Nphi] = {0, 0.4};
+
+    const real_t lengthScale = 0.01;
+
+    bool success = true;
+    for(len_t ir=0; ir<Nr; ir++)
+        for(len_t it=0; it<Ntheta; it++)
+            for(len_t ip=0; ip<Nphi; ip++){
+                real_t r = rs[ir], theta = thetas[it], phi = phis[ip];
+
+                real_t kappa = kappaMin + (kappaMax-kappaMin)*r/ra;
+                real_t delta = deltaMax*r/ra;
+                real_t Delta = DeltaMax*r/ra;
+
+                // Forward mapping
+                real_t R = R0 + Delta + r*cos(theta + delta*sin(theta));
+                real_t x = R*cos(phi) - R0;
+                real_t y = kappa*r*sin(theta);
+                real_t z = R*sin(phi);
+
+                real_t rInv = -1, thetaInv = -1, phiInv = -1;
+                grid->GetRadialGrid()->GetRThetaPhiFromCartesian(
+                    &rInv, &thetaInv, &phiInv, x, y, z, lengthScale, ra/2
+                );
+
+                bool thisSuccess =
+                    abs(rInv-r) < TOLERANCE &&
+                    abs(thetaInv-theta) < TOLERANCE &&
+                    abs(phiInv-phi) < TOLERANCE;
+                success = success && thisSuccess;
+
+                if(!silentMode && !thisSuccess){
+                    cout << "TestInverseMapping:" << endl;
+                    cout << "-------------------" << endl;
+                    cout << "(r, theta, phi) = (" << r << ", " << theta << ", " << phi << ")" << endl;
+                    cout << "Inverse mapping:  (" << rInv << ", " << thetaInv << ", " << phiInv << ")" << endl;
+                }
+            }
+
+    return success;
+}
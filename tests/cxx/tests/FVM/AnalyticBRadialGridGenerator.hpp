@@ -20,6 +20,7 @@ namespace DREAMTESTS::FVM {
         virtual bool TestGeneralBounceAverage();
         virtual bool TestGeneralFluxSurfaceAverage();
         virtual bool CompareBounceAverageMethods();
+        virtual bool TestInverseMapping();
         virtual bool Run(bool) override;
 
     };
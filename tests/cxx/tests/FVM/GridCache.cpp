@@ -0,0 +1,208 @@
+/**
+ * Test for the 'GridCache' class in the FVM library. A grid is
+ * built twice using the same cache file: the first time the
+ * geometry is evaluated and written to the cache (miss), and the
+ * second time it is loaded from the cache (hit). Both grids are
+ * compared to a grid built without the cache.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "GridCache.hpp"
+
+
+using namespace DREAMTESTS::FVM;
+using namespace std;
+
+
+/**
+ * Returns 'true' if the named file exists.
+ */
+bool GridCache::FileExists(const string& fname) {
+    FILE *f = fopen(fname.c_str(), "r");
+    if (f == nullptr)
+        return false;
+
+    fclose(f);
+    return true;
+}
+
+/**
+ * Build a general (toroidal) grid using the cache file of this
+ * test, and verify that the cache is hit or missed as expected.
+ *
+ * expectHit: If 'true', the cache file is expected to exist.
+ *
+ * RETURNS the grid, or 'nullptr' if the cache did not behave
+ * as expected.
+ */
+DREAM::FVM::Grid *GridCache::BuildCachedGrid(bool expectHit) {
+    DREAM::FVM::GridCache *gc = new DREAM::FVM::GridCache(this->filename);
+    if (gc->IsHit() != expectHit) {
+        this->PrintError(
+            "Grid cache was %s, although it was expected to be %s.",
+            gc->IsHit() ? "hit" : "missed", expectHit ? "hit" : "missed"
+        );
+        delete gc;
+        return nullptr;
+    }
+
+    DREAM::FVM::Grid *grid = this->InitializeGridGeneralRPXi();
+
+    // Re-evaluate the geometry using the cache
+    grid->SetGeometryCache(gc, "hottailgrid");
+    grid->RebuildJacobians();
+    grid->SetGeometryCache(nullptr, "");
+
+    gc->Close();
+    delete gc;
+
+    return grid;
+}
+
+/**
+ * Compare two values of the named quantity.
+ */
+bool GridCache::Compare(
+    const real_t v, const real_t vref, const string& name,
+    const len_t ir, const len_t i, const len_t j
+) {
+    const real_t TOLERANCE = 1e-12;
+    real_t Delta = fabs(v - vref);
+    if (vref != 0)
+        Delta /= fabs(vref);
+
+    if (Delta > TOLERANCE) {
+        this->PrintError(
+            "%s differs at (ir, i, j) = (" LEN_T_PRINTF_FMT ", " LEN_T_PRINTF_FMT ", "
+            LEN_T_PRINTF_FMT "): %.12e (reference: %.12e, Delta = %.3e).",
+            name.c_str(), ir, i, j, v, vref, Delta
+        );
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Compare the cached quantities of the given grid to those of
+ * the reference grid.
+ *
+ * grid: Grid built using the cache.
+ * ref:  Grid built without the cache.
+ * desc: Description of the grid (for error messages).
+ */
+bool GridCache::CompareGrids(DREAM::FVM::Grid *grid, DREAM::FVM::Grid *ref, const string& desc) {
+    bool success = true;
+    const len_t nr = ref->GetNr();
+
+    for (len_t ir = 0; ir < nr; ir++) {
+        success &= Compare(grid->GetVpVol(ir), ref->GetVpVol(ir), desc + ": VpVol", ir, 0, 0);
+
+        const len_t n1 = ref->GetNp1(ir), n2 = ref->GetNp2(ir);
+        for (len_t j = 0; j < n2; j++)
+            for (len_t i = 0; i < n1; i++) {
+                success &= Compare(grid->GetVp(ir, i, j), ref->GetVp(ir, i, j), desc + ": Vp", ir, i, j);
+                success &= Compare(grid->GetThetaBounce1(ir, i, j), ref->GetThetaBounce1(ir, i, j), desc + ": theta_b1", ir, i, j);
+                success &= Compare(grid->GetThetaBounce2(ir, i, j), ref->GetThetaBounce2(ir, i, j), desc + ": theta_b2", ir, i, j);
+                success &= Compare(grid->GetAvalancheDeltaHat(ir, i, j), ref->GetAvalancheDeltaHat(ir, i, j), desc + ": avalancheDeltaHat", ir, i, j);
+            }
+    }
+
+    return success;
+}
+
+/**
+ * Build a grid with an empty cache (miss), and again with the
+ * cache file written in the first step (hit), and compare the
+ * results to a grid built without the cache.
+ */
+bool GridCache::CheckMissAndHit() {
+    bool success = true;
+
+    DREAM::FVM::Grid *ref = this->InitializeGridGeneralRPXi();
+
+    DREAM::FVM::Grid *miss = BuildCachedGrid(false);
+    if (miss == nullptr) {
+        delete ref;
+        return false;
+    }
+
+    if (!FileExists(this->filename)) {
+        this->PrintError("The grid cache file was not written.");
+        success = false;
+    } else {
+        DREAM::FVM::Grid *hit = BuildCachedGrid(true);
+        if (hit == nullptr)
+            success = false;
+        else {
+            success &= CompareGrids(hit, ref, "cache hit");
+            delete hit;
+        }
+    }
+
+    success &= CompareGrids(miss, ref, "cache miss");
+
+    delete miss;
+    delete ref;
+
+    std::remove(this->filename.c_str());
+
+    return success;
+}
+
+/**
+ * Verify that a cache which is destroyed without being closed
+ * does not leave any (possibly incomplete) files behind.
+ */
+bool GridCache::CheckDiscard() {
+    DREAM::FVM::GridCache *gc = new DREAM::FVM::GridCache(this->filename);
+    DREAM::FVM::Grid *grid = this->InitializeGridGeneralRPXi();
+    grid->SetGeometryCache(gc, "hottailgrid");
+    grid->RebuildJacobians();
+    grid->SetGeometryCache(nullptr, "");
+
+    delete gc;
+    delete grid;
+
+    const string tmpfilename = this->filename + "." + to_string(getpid()) + ".tmp";
+
+    bool success = true;
+    if (FileExists(this->filename)) {
+        this->PrintError("Grid cache file was written although the cache was never closed.");
+        std::remove(this->filename.c_str());
+        success = false;
+    }
+    if (FileExists(tmpfilename)) {
+        this->PrintError("Temporary grid cache file was not removed when the cache was destroyed.");
+        std::remove(tmpfilename.c_str());
+        success = false;
+    }
+
+    return success;
+}
+
+/**
+ * Run all GridCache tests.
+ * Returns 'true' if all tests passed. 'false' otherwise.
+ */
+bool GridCache::Run(bool) {
+    bool success = true;
+
+    this->filename = "dreamtests-gridcache-" + to_string(getpid()) + ".h5";
+    std::remove(this->filename.c_str());
+
+    if (CheckMissAndHit())
+        this->PrintOK("Grids loaded from the grid cache agree with the evaluated grid.");
+    else
+        success = false;
+
+    if (CheckDiscard())
+        this->PrintOK("Unclosed grid caches are discarded.");
+    else
+        success = false;
+
+    return success;
+}
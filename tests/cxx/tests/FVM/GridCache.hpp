@@ -0,0 +1,29 @@
+#ifndef _DREAMTESTS_FVM_GRID_CACHE_HPP
+#define _DREAMTESTS_FVM_GRID_CACHE_HPP
+
+#include <string>
+#include "FVM/Grid/Grid.hpp"
+#include "FVM/Grid/GridCache.hpp"
+#include "UnitTest.hpp"
+
+namespace DREAMTESTS::FVM {
+    class GridCache : public UnitTest {
+    private:
+        std::string filename;
+
+        DREAM::FVM::Grid *BuildCachedGrid(bool);
+        bool CompareGrids(DREAM::FVM::Grid*, DREAM::FVM::Grid*, const std::string&);
+        bool Compare(const real_t, const real_t, const std::string&, const len_t, const len_t, const len_t);
+        bool FileExists(const std::string&);
+
+    public:
+        GridCache(const std::string& name) : UnitTest(name) {}
+
+        bool CheckMissAndHit();
+        bool CheckDiscard();
+
+        virtual bool Run(bool) override;
+    };
+}
+
+#endif/*_DREAMTESTS_FVM_GRID_CACHE_HPP*/